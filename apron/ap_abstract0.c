@@ -14,6 +14,53 @@
 /* 0. Utility and checking functions */
 /* ********************************************************************** */
 
+/* ====================================================================== */
+/* 0.0 Profiling */
+/* ====================================================================== */
+
+/* Calls to the library are bracketed by ap_abstract0_prof_begin and
+   ap_abstract0_prof_end, which do nothing unless man->profile is set. */
+
+typedef struct ap_abstract0_prof_t {
+  double start;
+  size_t dim;
+} ap_abstract0_prof_t;
+
+/* Dimension of a value of the library, preserving the flags of man */
+static size_t ap_abstract0_prof_dim(ap_manager_t* man, void* value)
+{
+  ap_dimension_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_DIMENSION];
+  bool flag_exact = man->result.flag_exact;
+  bool flag_best = man->result.flag_best;
+  ap_dimension_t dim = ptr(man,value);
+  man->result.flag_exact = flag_exact;
+  man->result.flag_best = flag_best;
+  return dim.intdim+dim.realdim;
+}
+
+static inline ap_abstract0_prof_t ap_abstract0_prof_begin_dim(ap_manager_t* man, size_t dim)
+{
+  ap_abstract0_prof_t prof = { 0.0, dim };
+  if (man->profile) prof.start = ap_manager_profile_clock();
+  return prof;
+}
+static inline ap_abstract0_prof_t ap_abstract0_prof_begin(ap_manager_t* man, void* value)
+{
+  if (man->profile)
+    return ap_abstract0_prof_begin_dim(man, value ? ap_abstract0_prof_dim(man,value) : (size_t)-1);
+  else
+    return ap_abstract0_prof_begin_dim(man,0);
+}
+static inline void ap_abstract0_prof_end(ap_manager_t* man, ap_funid_t funid,
+					 ap_abstract0_prof_t* prof, void* value)
+{
+  if (man->profile){
+    double time = ap_manager_profile_clock() - prof->start;
+    ap_manager_profile_record(man,funid,time,prof->dim,
+			      value ? ap_abstract0_prof_dim(man,value) : (size_t)-1);
+  }
+}
+
 /* ====================================================================== */
 /* 0.1 Checking typing w.r.t. manager */
 /* ====================================================================== */
@@ -557,7 +604,10 @@ ap_abstract0_t* ap_abstract0_copy(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_COPY,man,a)){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_COPY];
-    return ap_abstract0_cons(man,ptr(man,a->value));
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    void* value = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_COPY,&prof,value);
+    return ap_abstract0_cons(man,value);
   }
   else {
     ap_dimension_t dimension = _ap_abstract0_dimension(a);
@@ -596,6 +646,21 @@ size_t ap_abstract0_size(ap_manager_t* man, ap_abstract0_t* a)
     return 0;
   }
 }
+size_t ap_abstract0_memory_size(ap_manager_t* man, ap_abstract0_t* a)
+{
+  if (ap_abstract0_checkman1(AP_FUNID_MEMORY_SIZE,man,a)){
+    size_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEMORY_SIZE];
+    if (ptr==NULL){
+      ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_MEMORY_SIZE,
+				 "memory_size not provided by the library");
+      return sizeof(ap_abstract0_t);
+    }
+    return sizeof(ap_abstract0_t) + ptr(man,a->value);
+  }
+  else {
+    return 0;
+  }
+}
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
@@ -604,14 +669,18 @@ void ap_abstract0_minimize(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_MINIMIZE,man,a)){
     void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MINIMIZE];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_MINIMIZE,&prof,NULL);
   }
 }
 void ap_abstract0_canonicalize(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_CANONICALIZE,man,a)){
     void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_CANONICALIZE];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_CANONICALIZE,&prof,NULL);
   }
 }
 int ap_abstract0_hash(ap_manager_t* man, ap_abstract0_t* a)
@@ -627,7 +696,9 @@ void ap_abstract0_approximate(ap_manager_t* man, ap_abstract0_t* a, int n)
 {
   if (ap_abstract0_checkman1(AP_FUNID_APPROXIMATE,man,a)){
     void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_APPROXIMATE];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     ptr(man,a->value,n);
+    ap_abstract0_prof_end(man,AP_FUNID_APPROXIMATE,&prof,NULL);
   }
 }
 
@@ -678,7 +749,10 @@ ap_membuf_t ap_abstract0_serialize_raw(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_SERIALIZE_RAW,man,a)){
     ap_membuf_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SERIALIZE_RAW];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_membuf_t res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_SERIALIZE_RAW,&prof,NULL);
+    return res;
   }
   else {
     ap_membuf_t res = { NULL, 0 };
@@ -688,7 +762,27 @@ ap_membuf_t ap_abstract0_serialize_raw(ap_manager_t* man, ap_abstract0_t* a)
 ap_abstract0_t* ap_abstract0_deserialize_raw(ap_manager_t* man, void* p, size_t* size)
 {
   void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_DESERIALIZE_RAW];
-  return ap_abstract0_cons(man,ptr(man,p,size));
+  ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,NULL);
+  void* value = ptr(man,p,size);
+  ap_abstract0_prof_end(man,AP_FUNID_DESERIALIZE_RAW,&prof,value);
+  return ap_abstract0_cons(man,value);
+}
+ap_abstract0_t* ap_abstract0_deserialize_mapped(ap_manager_t* man, void* p, size_t* size,
+						struct ap_checkpoint_t* ck)
+{
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_DESERIALIZE_MAPPED];
+  ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,NULL);
+  void* value;
+  if (ptr){
+    value = ptr(man,p,size,ck);
+    ap_abstract0_prof_end(man,AP_FUNID_DESERIALIZE_MAPPED,&prof,value);
+  }
+  else {
+    ptr = man->funptr[AP_FUNID_DESERIALIZE_RAW];
+    value = ptr(man,p,size);
+    ap_abstract0_prof_end(man,AP_FUNID_DESERIALIZE_RAW,&prof,value);
+  }
+  return value ? ap_abstract0_cons(man,value) : NULL;
 }
 
 /* ********************************************************************** */
@@ -700,17 +794,26 @@ ap_abstract0_t* ap_abstract0_deserialize_raw(ap_manager_t* man, void* p, size_t*
 ap_abstract0_t* ap_abstract0_bottom(ap_manager_t* man, size_t intdim, size_t realdim)
 {
   void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOTTOM];
-  return ap_abstract0_cons(man,ptr(man,intdim,realdim));
+  ap_abstract0_prof_t prof = ap_abstract0_prof_begin_dim(man,intdim+realdim);
+  void* value = ptr(man,intdim,realdim);
+  ap_abstract0_prof_end(man,AP_FUNID_BOTTOM,&prof,value);
+  return ap_abstract0_cons(man,value);
 }
 ap_abstract0_t* ap_abstract0_top(ap_manager_t* man, size_t intdim, size_t realdim){
   void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TOP];
-  return ap_abstract0_cons(man,ptr(man,intdim,realdim));
+  ap_abstract0_prof_t prof = ap_abstract0_prof_begin_dim(man,intdim+realdim);
+  void* value = ptr(man,intdim,realdim);
+  ap_abstract0_prof_end(man,AP_FUNID_TOP,&prof,value);
+  return ap_abstract0_cons(man,value);
 }
 ap_abstract0_t* ap_abstract0_of_box(ap_manager_t* man,
 				    size_t intdim, size_t realdim,
 				    ap_interval_t** tinterval){
   void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_OF_BOX];
-  return ap_abstract0_cons(man,ptr(man,intdim,realdim,tinterval));
+  ap_abstract0_prof_t prof = ap_abstract0_prof_begin_dim(man,intdim+realdim);
+  void* value = ptr(man,intdim,realdim,tinterval);
+  ap_abstract0_prof_end(man,AP_FUNID_OF_BOX,&prof,value);
+  return ap_abstract0_cons(man,value);
 }
 
 /* ============================================================ */
@@ -730,7 +833,10 @@ bool ap_abstract0_is_bottom(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_IS_BOTTOM,man,a)){
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_BOTTOM];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    bool res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_IS_BOTTOM,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -741,7 +847,10 @@ bool ap_abstract0_is_top(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_IS_TOP,man,a)){
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_TOP];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    bool res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_IS_TOP,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -757,7 +866,10 @@ bool ap_abstract0_is_leq(ap_manager_t* man, ap_abstract0_t* a1, ap_abstract0_t*
 	   ap_abstract0_check_abstract2(AP_FUNID_IS_EQ,man,a1,a2)){
     if (a1->value==a2->value) return true;
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_LEQ];
-    return ptr(man,a1->value,a2->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a1->value);
+    bool res = ptr(man,a1->value,a2->value);
+    ap_abstract0_prof_end(man,AP_FUNID_IS_LEQ,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -773,7 +885,10 @@ bool ap_abstract0_is_eq(ap_manager_t* man, ap_abstract0_t* a1, ap_abstract0_t* a
       ap_abstract0_check_abstract2(AP_FUNID_IS_EQ,man,a1,a2)){
     if (a1->value==a2->value) return true;
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_EQ];
-    return ptr(man,a1->value,a2->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a1->value);
+    bool res = ptr(man,a1->value,a2->value);
+    ap_abstract0_prof_end(man,AP_FUNID_IS_EQ,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -785,7 +900,10 @@ bool ap_abstract0_sat_lincons(ap_manager_t* man, ap_abstract0_t* a, ap_lincons0_
   if (ap_abstract0_checkman1(AP_FUNID_SAT_LINCONS,man,a) &&
       ap_abstract0_check_linexpr(AP_FUNID_SAT_LINCONS,man,_ap_abstract0_dimension(a),lincons->linexpr0) ){
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SAT_LINCONS];
-    return ptr(man,a->value,lincons);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    bool res = ptr(man,a->value,lincons);
+    ap_abstract0_prof_end(man,AP_FUNID_SAT_LINCONS,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -797,7 +915,10 @@ bool ap_abstract0_sat_tcons(ap_manager_t* man, ap_abstract0_t* a, ap_tcons0_t* t
   if (ap_abstract0_checkman1(AP_FUNID_SAT_TCONS,man,a) &&
       ap_abstract0_check_texpr(AP_FUNID_SAT_TCONS,man,_ap_abstract0_dimension(a),tcons->texpr0) ){
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SAT_TCONS];
-    return ptr(man,a->value,tcons);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    bool res = ptr(man,a->value,tcons);
+    ap_abstract0_prof_end(man,AP_FUNID_SAT_TCONS,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -810,7 +931,10 @@ bool ap_abstract0_sat_interval(ap_manager_t* man, ap_abstract0_t* a,
   if (ap_abstract0_checkman1(AP_FUNID_SAT_INTERVAL,man,a) &&
       ap_abstract0_check_dim(AP_FUNID_SAT_INTERVAL,man,_ap_abstract0_dimension(a),dim)){
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SAT_INTERVAL];
-    return ptr(man,a->value,dim,interval);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    bool res = ptr(man,a->value,dim,interval);
+    ap_abstract0_prof_end(man,AP_FUNID_SAT_INTERVAL,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -823,7 +947,10 @@ bool ap_abstract0_is_dimension_unconstrained(ap_manager_t* man, ap_abstract0_t*
   if (ap_abstract0_checkman1(AP_FUNID_IS_DIMENSION_UNCONSTRAINED,man,a) &&
       ap_abstract0_check_dim(AP_FUNID_IS_DIMENSION_UNCONSTRAINED,man,_ap_abstract0_dimension(a),dim)){
     bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_DIMENSION_UNCONSTRAINED];
-    return ptr(man,a->value,dim);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    bool res = ptr(man,a->value,dim);
+    ap_abstract0_prof_end(man,AP_FUNID_IS_DIMENSION_UNCONSTRAINED,&prof,NULL);
+    return res;
   }
   else {
     man->result.flag_exact = false;
@@ -840,7 +967,10 @@ ap_interval_t* ap_abstract0_bound_linexpr(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_BOUND_LINEXPR,man,a) &&
       ap_abstract0_check_linexpr(AP_FUNID_BOUND_LINEXPR,man,_ap_abstract0_dimension(a),expr)){
     ap_interval_t* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOUND_LINEXPR];
-    return ptr(man,a->value,expr);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_interval_t* res = ptr(man,a->value,expr);
+    ap_abstract0_prof_end(man,AP_FUNID_BOUND_LINEXPR,&prof,NULL);
+    return res;
   }
   else {
     ap_interval_t* itv = ap_interval_alloc();
@@ -855,7 +985,10 @@ ap_interval_t* ap_abstract0_bound_texpr(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_BOUND_TEXPR,man,a) &&
       ap_abstract0_check_texpr(AP_FUNID_BOUND_TEXPR,man,_ap_abstract0_dimension(a),expr)){
     ap_interval_t* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOUND_TEXPR];
-    return ptr(man,a->value,expr);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_interval_t* res = ptr(man,a->value,expr);
+    ap_abstract0_prof_end(man,AP_FUNID_BOUND_TEXPR,&prof,NULL);
+    return res;
   }
   else {
     ap_interval_t* itv = ap_interval_alloc();
@@ -870,7 +1003,10 @@ ap_interval_t* ap_abstract0_bound_dimension(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_BOUND_DIMENSION,man,a) &&
       ap_abstract0_check_dim(AP_FUNID_BOUND_DIMENSION,man,_ap_abstract0_dimension(a),dim)){
     ap_interval_t* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOUND_DIMENSION];
-    return ptr(man,a->value,dim);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_interval_t* res = ptr(man,a->value,dim);
+    ap_abstract0_prof_end(man,AP_FUNID_BOUND_DIMENSION,&prof,NULL);
+    return res;
   }
   else {
     ap_interval_t* itv = ap_interval_alloc();
@@ -883,7 +1019,10 @@ ap_lincons0_array_t ap_abstract0_to_lincons_array(ap_manager_t* man, ap_abstract
 {
   if (ap_abstract0_checkman1(AP_FUNID_TO_LINCONS_ARRAY,man,a)){
     ap_lincons0_array_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_LINCONS_ARRAY];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_lincons0_array_t res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_TO_LINCONS_ARRAY,&prof,NULL);
+    return res;
   }
   else {
     ap_lincons0_array_t res = { NULL, 0 };
@@ -894,7 +1033,10 @@ ap_tcons0_array_t ap_abstract0_to_tcons_array(ap_manager_t* man, ap_abstract0_t*
 {
   if (ap_abstract0_checkman1(AP_FUNID_TO_TCONS_ARRAY,man,a)){
     ap_tcons0_array_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_TCONS_ARRAY];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_tcons0_array_t res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_TO_TCONS_ARRAY,&prof,NULL);
+    return res;
   }
   else {
     ap_tcons0_array_t res = { NULL, 0 };
@@ -905,7 +1047,10 @@ ap_interval_t** ap_abstract0_to_box(ap_manager_t* man, ap_abstract0_t* a)
 {
   if (ap_abstract0_checkman1(AP_FUNID_TO_BOX,man,a)){
     ap_interval_t** (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_BOX];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_interval_t** res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_TO_BOX,&prof,NULL);
+    return res;
   }
   else {
     size_t i;
@@ -922,7 +1067,10 @@ ap_generator0_array_t ap_abstract0_to_generator_array(ap_manager_t* man, ap_abst
 {
   if (ap_abstract0_checkman1(AP_FUNID_TO_GENERATOR_ARRAY,man,a)){
     ap_generator0_array_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_GENERATOR_ARRAY];
-    return ptr(man,a->value);
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
+    ap_generator0_array_t res = ptr(man,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_TO_GENERATOR_ARRAY,&prof,NULL);
+    return res;
   }
   else {
     ap_generator0_array_t res = { NULL, 0 };
@@ -943,7 +1091,9 @@ ap_abstract0_t* ap_abstract0_meetjoin(ap_funid_t funid,
   if (ap_abstract0_checkman2(funid,man,a1,a2) &&
       ap_abstract0_check_abstract2(funid,man,a1,a2)){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a1->value);
     void* value = ptr(man,destructive,a1->value,a2->value);
+    ap_abstract0_prof_end(man,funid,&prof,value);
     return ap_abstract0_cons2(man,destructive,a1,value);
   }
   else {
@@ -970,7 +1120,10 @@ ap_abstract0_t* ap_abstract0_meetjoin_array(ap_funid_t funid, ap_manager_t* man,
     void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
     void** ntab = malloc(size*sizeof(void*));
     for (i=0;i<size;i++) ntab[i] = tab[i]->value;
-    res = ap_abstract0_cons(man,ptr(man,ntab,size));
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,tab[0]->value);
+    void* value = ptr(man,ntab,size);
+    ap_abstract0_prof_end(man,funid,&prof,value);
+    res = ap_abstract0_cons(man,value);
     free(ntab);
     return res;
   }
@@ -999,7 +1152,9 @@ ap_abstract0_t* ap_abstract0_meet_lincons_array(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_MEET_LINCONS_ARRAY,man,a) &&
       ap_abstract0_check_lincons_array(AP_FUNID_MEET_LINCONS_ARRAY,man,dimension,array) ){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEET_LINCONS_ARRAY];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     void* value = ptr(man,destructive,a->value,array);
+    ap_abstract0_prof_end(man,AP_FUNID_MEET_LINCONS_ARRAY,&prof,value);
     return ap_abstract0_cons2(man,destructive,a,value);
   }
   else {
@@ -1018,7 +1173,9 @@ ap_abstract0_t* ap_abstract0_meet_tcons_array(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_MEET_TCONS_ARRAY,man,a) &&
       ap_abstract0_check_tcons_array(AP_FUNID_MEET_TCONS_ARRAY,man,dimension,array) ){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEET_TCONS_ARRAY];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     void* value = ptr(man,destructive,a->value,array);
+    ap_abstract0_prof_end(man,AP_FUNID_MEET_TCONS_ARRAY,&prof,value);
     return ap_abstract0_cons2(man,destructive,a,value);
   }
   else {
@@ -1037,7 +1194,9 @@ ap_abstract0_t* ap_abstract0_add_ray_array(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_ADD_RAY_ARRAY,man,a) &&
       ap_abstract0_check_generator_array(AP_FUNID_ADD_RAY_ARRAY,man,dimension,array)){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_ADD_RAY_ARRAY];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     void* value = ptr(man,destructive,a->value,array);
+    ap_abstract0_prof_end(man,AP_FUNID_ADD_RAY_ARRAY,&prof,value);
     return ap_abstract0_cons2(man,destructive,a,value);
   }
   else {
@@ -1079,7 +1238,9 @@ ap_abstract0_t* ap_abstract0_asssub_linexpr_array(ap_funid_t funid,
 	ap_abstract0_check_dim_array(funid,man,dimension,tdim,size) &&
 	ap_abstract0_check_linexpr_array(funid,man,dimension,texpr,size) ){
       void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,tdim,texpr,size,dest ? dest->value : NULL);
+      ap_abstract0_prof_end(man,funid,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
     else {
@@ -1139,7 +1300,9 @@ ap_abstract0_t* ap_abstract0_asssub_texpr_array(ap_funid_t funid,
 	ap_abstract0_check_dim_array(funid,man,dimension,tdim,size) &&
 	ap_abstract0_check_texpr_array(funid,man,dimension,texpr,size) ){
       void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,tdim,texpr,size,dest ? dest->value : NULL);
+      ap_abstract0_prof_end(man,funid,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
     else {
@@ -1196,7 +1359,9 @@ ap_abstract0_t* ap_abstract0_forget_array(ap_manager_t* man,
     if (ap_abstract0_checkman1(AP_FUNID_FORGET_ARRAY,man,a) &&
 	ap_abstract0_check_dim_array(AP_FUNID_FORGET_ARRAY,man,dimension,tdim,size)){
       void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_FORGET_ARRAY];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,tdim,size,project);
+      ap_abstract0_prof_end(man,AP_FUNID_FORGET_ARRAY,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
     else {
@@ -1231,7 +1396,9 @@ ap_abstract0_t* ap_abstract0_add_dimensions(ap_manager_t* man,
     if (ap_abstract0_checkman1(AP_FUNID_ADD_DIMENSIONS,man,a) &&
 	ap_abstract0_check_ap_dimchange_add(AP_FUNID_ADD_DIMENSIONS,man,dimension,dimchange)){
       void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_ADD_DIMENSIONS];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,dimchange,project);
+      ap_abstract0_prof_end(man,AP_FUNID_ADD_DIMENSIONS,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
     else {
@@ -1260,7 +1427,9 @@ ap_abstract0_t* ap_abstract0_remove_dimensions(ap_manager_t* man,
     if (ap_abstract0_checkman1(AP_FUNID_REMOVE_DIMENSIONS,man,a) &&
 	ap_abstract0_check_ap_dimchange_remove(AP_FUNID_REMOVE_DIMENSIONS,man,dimension,dimchange)){
       void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_REMOVE_DIMENSIONS];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,dimchange);
+      ap_abstract0_prof_end(man,AP_FUNID_REMOVE_DIMENSIONS,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
     else {
@@ -1280,7 +1449,9 @@ ap_abstract0_t* ap_abstract0_permute_dimensions(ap_manager_t* man,
   if (ap_abstract0_checkman1(AP_FUNID_PERMUTE_DIMENSIONS,man,a) &&
       ap_abstract0_check_dimperm(AP_FUNID_PERMUTE_DIMENSIONS,man,dimension,perm)){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_PERMUTE_DIMENSIONS];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     void* value = ptr(man,destructive,a->value,perm);
+    ap_abstract0_prof_end(man,AP_FUNID_PERMUTE_DIMENSIONS,&prof,value);
     return ap_abstract0_cons2(man,destructive,a,value);
   }
   else {
@@ -1313,7 +1484,9 @@ ap_abstract0_t* ap_abstract0_expand(ap_manager_t* man,
     if (ap_abstract0_checkman1(AP_FUNID_EXPAND,man,a) &&
 	ap_abstract0_check_dim(AP_FUNID_EXPAND,man,dimension,dim)){
       void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_EXPAND];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,dim,n);
+      ap_abstract0_prof_end(man,AP_FUNID_EXPAND,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
     else {
@@ -1371,7 +1544,9 @@ ap_abstract0_t* ap_abstract0_fold(ap_manager_t* man,
     }
     else {
       void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_FOLD];
+      ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
       void* value = ptr(man,destructive,a->value,tdim,size);
+      ap_abstract0_prof_end(man,AP_FUNID_FOLD,&prof,value);
       return ap_abstract0_cons2(man,destructive,a,value);
     }
   }
@@ -1392,7 +1567,9 @@ ap_abstract0_t* ap_abstract0_widening(ap_manager_t* man,
   if (ap_abstract0_checkman2(AP_FUNID_WIDENING,man,a1,a2) &&
       ap_abstract0_check_abstract2(AP_FUNID_WIDENING,man,a1,a2)){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_WIDENING];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a1->value);
     void* value = ptr(man,a1->value,a2->value);
+    ap_abstract0_prof_end(man,AP_FUNID_WIDENING,&prof,value);
     return ap_abstract0_cons(man,value);
   }
   else {
@@ -1411,7 +1588,9 @@ ap_abstract0_t* ap_abstract0_closure(ap_manager_t* man, bool destructive, ap_abs
   ap_dimension_t dimension = _ap_abstract0_dimension(a);
   if (ap_abstract0_checkman1(AP_FUNID_CLOSURE,man,a)){
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_CLOSURE];
+    ap_abstract0_prof_t prof = ap_abstract0_prof_begin(man,a->value);
     void* value = ptr(man,destructive,a->value);
+    ap_abstract0_prof_end(man,AP_FUNID_CLOSURE,&prof,value);
     return ap_abstract0_cons2(man,destructive,a,value);
   }
   else {
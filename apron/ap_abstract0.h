@@ -44,6 +44,14 @@ void ap_abstract0_free(ap_manager_t* man, ap_abstract0_t* a);
 size_t ap_abstract0_size(ap_manager_t* man, ap_abstract0_t* a);
   /* Return the abstract size of an abstract value (see ap_manager_t) */
 
+size_t ap_abstract0_memory_size(ap_manager_t* man, ap_abstract0_t* a);
+  /* Return the number of bytes of heap memory owned by the abstract value,
+     including internal caches and the limbs of multiprecision numbers.
+     Raises AP_EXC_NOT_IMPLEMENTED and only counts the wrapper if the
+     underlying library does not provide it. The value and the result
+     flags of the manager are left unchanged, so that the query can follow
+     any operation (the OCaml bindings call it on every returned value). */
+
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
@@ -111,7 +119,19 @@ ap_membuf_t ap_abstract0_serialize_raw(ap_manager_t* man, ap_abstract0_t* a);
 
 ap_abstract0_t* ap_abstract0_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size);
   /* Return the abstract value read in raw binary format from the input stream
-     and store in size the number of bytes read */
+     and store in size the number of bytes read.  If size is not NULL, *size
+     holds on input the number of bytes available at ptr: libraries check
+     the dimensions they read against it, and raise AP_EXC_INVALID_ARGUMENT
+     instead of reading past the buffer. */
+
+struct ap_checkpoint_t;
+ap_abstract0_t* ap_abstract0_deserialize_mapped(ap_manager_t* man, void* ptr, size_t* size,
+						struct ap_checkpoint_t* ck);
+  /* Same as ap_abstract0_deserialize_raw, for a buffer lying in the mapping
+     of the checkpoint file ck (see ap_checkpoint.h).  The result may point
+     into the buffer instead of copying it.  Libraries that do not provide
+     this function fall back to their AP_FUNID_DESERIALIZE_RAW function.
+     Return NULL if the library raised an exception. */
 
 /* ********************************************************************** */
 /* II. Constructor, accessors, tests and property extraction */
@@ -611,6 +631,11 @@ ap_abstract0_meetjoin(ap_funid_t funid,
 		      ap_manager_t* man, bool destructive,
 		      ap_abstract0_t* a1, ap_abstract0_t* a2);
 ap_abstract0_t*
+ap_abstract0_meetjoin_array(ap_funid_t funid,
+			    /* either meet_array or join_array */
+			    ap_manager_t* man,
+			    ap_abstract0_t** tab, size_t size);
+ap_abstract0_t*
 ap_abstract0_asssub_linexpr(ap_funid_t funid,
 			    /* either assign or substitute */
 			    ap_manager_t* man,
@@ -51,7 +51,8 @@ ap_abstract1_t ap_abstract1_consres(bool destructive, ap_abstract1_t* a, ap_abst
 
 Build a new abstract value level 1 from the old one, a new
 value level 0 and a new environment, depending on
-destructive.
+destructive. The reference env is taken over by the result, or freed if
+the result is the old value.
 */
 static
 ap_abstract1_t ap_abstract1_consres2(bool destructive, ap_abstract1_t* a,
@@ -60,8 +61,10 @@ ap_abstract1_t ap_abstract1_consres2(bool destructive, ap_abstract1_t* a,
 {
   ap_abstract1_t res;
   if (destructive){
-    if (value==a->abstract0 && env==a->env)
+    if (value==a->abstract0 && env==a->env){
       res = *a;
+      ap_environment_free(env);
+    }
     else {
       res.abstract0 = value;
       res.env = env;
@@ -215,6 +218,10 @@ void ap_abstract1_clear(ap_manager_t* man, ap_abstract1_t* a)
 size_t ap_abstract1_size(ap_manager_t* man, ap_abstract1_t* a){
   return ap_abstract0_size(man,a->abstract0);
 }
+/* Return the number of bytes of heap memory owned by the abstract value */
+size_t ap_abstract1_memory_size(ap_manager_t* man, ap_abstract1_t* a){
+  return ap_abstract0_memory_size(man,a->abstract0);
+}
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
@@ -645,14 +652,43 @@ ap_generator1_array_t ap_abstract1_to_generator_array(ap_manager_t* man, ap_abst
 
 ap_abstract1_t ap_abstract1_meetjoin(ap_funid_t funid, ap_manager_t* man, bool destructive, ap_abstract1_t* a1, ap_abstract1_t* a2)
 {
+  ap_dimchange_t* dimchange1;
+  ap_dimchange_t* dimchange2;
+  ap_environment_t* env;
+  ap_abstract0_t* value1;
+  ap_abstract0_t* value2;
+  ap_abstract0_t* value;
   ap_abstract1_t res;
-  if (ap_abstract1_check_env2(funid,man,a1,a2)){
-    ap_abstract0_t* value = ap_abstract0_meetjoin(funid,man,destructive,a1->abstract0,a2->abstract0);
-    res = ap_abstract1_consres(destructive, a1, value);
+
+  /* Usual case: same environment, no environment computation */
+  if (ap_environment_is_eq(a1->env,a2->env)){
+    value = ap_abstract0_meetjoin(funid,man,destructive,a1->abstract0,a2->abstract0);
+    return ap_abstract1_consres(destructive, a1, value);
   }
-  else {
+  env = ap_environment_lce(a1->env,a2->env,&dimchange1,&dimchange2);
+  if (env==NULL){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,funid,
+			       "a variable is defined with different types in the two abstract values");
     res = ap_abstract1_top(man,a1->env);
     if (destructive) ap_abstract1_clear(man,a1);
+    return res;
+  }
+  value1 =
+    dimchange1 ?
+    ap_abstract0_add_dimensions(man,destructive,a1->abstract0,dimchange1,false) :
+    (destructive ?
+     a1->abstract0 :
+     ap_abstract0_copy(man,a1->abstract0));
+  value2 =
+    dimchange2 ?
+    ap_abstract0_add_dimensions(man,false,a2->abstract0,dimchange2,false) :
+    a2->abstract0;
+  value = ap_abstract0_meetjoin(funid,man,true,value1,value2);
+  res = ap_abstract1_consres2(destructive, a1, value, env);
+  if (dimchange1) ap_dimchange_free(dimchange1);
+  if (dimchange2){
+    ap_dimchange_free(dimchange2);
+    ap_abstract0_free(man,value2);
   }
   return res;
 }
@@ -662,12 +698,100 @@ ap_abstract1_t ap_abstract1_meet(ap_manager_t* man, bool destructive, ap_abstrac
 ap_abstract1_t ap_abstract1_join(ap_manager_t* man, bool destructive, ap_abstract1_t* a1, ap_abstract1_t* a2){
   return ap_abstract1_meetjoin(AP_FUNID_JOIN,man,destructive,a1,a2);
 }
+
+/* Case of an array of abstract values defined on different environments:
+   the least common environment is computed once, as well as one dimchange
+   per distinct environment, then the values are embedded and the array
+   operation is called once at level 0. */
+static
+ap_abstract1_t ap_abstract1_meetjoin_array_lce(ap_funid_t funid, ap_manager_t* man, ap_abstract1_t* tab, size_t size)
+{
+  ap_environment_t* env;
+  ap_environment_t* nenv;
+  ap_environment_t** tenv;
+  ap_dimchange_t** tdimchange;
+  ap_dimchange_t* dimchange1;
+  ap_dimchange_t* dimchange2;
+  ap_abstract0_t** ntab;
+  ap_abstract1_t res;
+  size_t i,j,nbenv;
+
+  /* Distinct environments and their least common environment */
+  tenv = malloc(size*sizeof(ap_environment_t*));
+  nbenv = 0;
+  env = ap_environment_copy(tab[0].env);
+  for (i=0;i<size;i++){
+    for (j=0;j<nbenv;j++){
+      if (tenv[j]==tab[i].env) break;
+    }
+    if (j<nbenv) continue;
+    tenv[nbenv++] = tab[i].env;
+    if (ap_environment_is_leq(tab[i].env,env)) continue;
+    nenv = ap_environment_lce(env,tab[i].env,&dimchange1,&dimchange2);
+    if (dimchange1) ap_dimchange_free(dimchange1);
+    if (dimchange2) ap_dimchange_free(dimchange2);
+    ap_environment_free(env);
+    if (nenv==NULL){
+      free(tenv);
+      ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,funid,
+				 "a variable is defined with different types in the abstract values");
+      return ap_abstract1_top(man,tab[0].env);
+    }
+    env = nenv;
+  }
+  /* Dimchanges from each distinct environment to env */
+  tdimchange = malloc(nbenv*sizeof(ap_dimchange_t*));
+  for (j=0;j<nbenv;j++){
+    tdimchange[j] =
+      ap_environment_is_eq(tenv[j],env) ?
+      NULL :
+      ap_environment_dimchange(tenv[j],env);
+  }
+  /* Embedding, and operation at level 0 */
+  ntab = malloc(size*sizeof(ap_abstract0_t*));
+  for (i=0;i<size;i++){
+    for (j=0;tenv[j]!=tab[i].env;j++);
+    ntab[i] =
+      tdimchange[j] ?
+      ap_abstract0_add_dimensions(man,false,tab[i].abstract0,tdimchange[j],false) :
+      tab[i].abstract0;
+  }
+  res.abstract0 = ap_abstract0_meetjoin_array(funid,man,ntab,size);
+  res.env = env;
+  for (i=0;i<size;i++){
+    if (ntab[i]!=tab[i].abstract0) ap_abstract0_free(man,ntab[i]);
+  }
+  for (j=0;j<nbenv;j++){
+    if (tdimchange[j]) ap_dimchange_free(tdimchange[j]);
+  }
+  free(ntab);
+  free(tdimchange);
+  free(tenv);
+  return res;
+}
+
 ap_abstract1_t ap_abstract1_meetjoin_array(ap_funid_t funid, ap_manager_t* man, ap_abstract1_t* tab, size_t size)
 {
   ap_abstract1_t res;
-  if (ap_abstract1_checkman_array(funid,man,tab,size) &&
-      ap_abstract1_check_env_array(funid,man,tab,size)){
-    size_t i;
+  size_t i;
+
+  if (size==0){
+    ap_manager_raise_exception(man,
+			       AP_EXC_INVALID_ARGUMENT,
+			       funid,"array of abstract values of size 0");
+    ap_environment_t* env = ap_environment_alloc_empty();
+    res = ap_abstract1_top(man,env);
+    ap_environment_free(env);
+    return res;
+  }
+  if (!ap_abstract1_checkman_array(funid,man,tab,size)){
+    return ap_abstract1_top(man,tab[0].env);
+  }
+  for (i=1;i<size;i++){
+    if (!ap_environment_is_eq(tab[0].env,tab[i].env))
+      return ap_abstract1_meetjoin_array_lce(funid,man,tab,size);
+  }
+  {
     ap_abstract0_t* res0;
     void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
     void** ntab = malloc(size*sizeof(void*));
@@ -679,9 +803,6 @@ ap_abstract1_t ap_abstract1_meetjoin_array(ap_funid_t funid, ap_manager_t* man,
     res.env = ap_environment_copy(tab[0].env);
     free(ntab);
   }
-  else {
-    res = ap_abstract1_top(man, size==0 ? ap_environment_alloc_empty() : tab[0].env);
-  }
   return res;
 }
 ap_abstract1_t ap_abstract1_meet_array(ap_manager_t* man, ap_abstract1_t* tab, size_t size){
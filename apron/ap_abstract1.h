@@ -54,6 +54,11 @@ void ap_abstract1_clear(ap_manager_t* man, ap_abstract1_t* a);
 size_t ap_abstract1_size(ap_manager_t* man, ap_abstract1_t* a);
   /* Return the abstract size of an abstract value (see ap_manager_t) */
 
+size_t ap_abstract1_memory_size(ap_manager_t* man, ap_abstract1_t* a);
+  /* Return the number of bytes of heap memory owned by the abstract value
+     (see ap_abstract0_memory_size). The environment, which is shared, is
+     not counted. */
+
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
@@ -231,8 +236,13 @@ ap_generator1_array_t ap_abstract1_to_generator_array(ap_manager_t* man, ap_abst
 ap_abstract1_t ap_abstract1_meet(ap_manager_t* man, bool destructive, ap_abstract1_t* a1, ap_abstract1_t* a2);
 ap_abstract1_t ap_abstract1_join(ap_manager_t* man, bool destructive, ap_abstract1_t* a1, ap_abstract1_t* a2);
   /* Meet and Join of 2 abstract values
-     - The environment of the result is the lce of the arguments
+     - The environment of the result is the lce of the arguments: arguments
+       defined on different environments are first embedded in it, and no
+       exception is raised for them
      - Raises an EXC_INVALID_ARGUMENT exception if the lce does not exists
+     - If the arguments have the same environment, the level 0 function is
+       called directly (the test is a pointer comparison on hash-consed
+       environments, see ap_environment_set_hashcons)
   */
 
 ap_abstract1_t ap_abstract1_meet_array(ap_manager_t* man, ap_abstract1_t* tab, size_t size);
@@ -240,8 +250,10 @@ ap_abstract1_t ap_abstract1_join_array(ap_manager_t* man, ap_abstract1_t* tab, s
   /* Meet and Join of an array of abstract values.
      - Raises an [[exc_invalid_argument]] exception if [[size==0]]
        (no way to define the dimensionality of the result in such a case
-     - The environment of the result is the lce of the arguments
+     - The environment of the result is the lce of the arguments, in which
+       the arguments are embedded as for meet and join
      - Raises an EXC_INVALID_ARGUMENT exception if the lce does not exists
+     - The lce and the dimchanges are computed once for the whole array
   */
 
 ap_abstract1_t ap_abstract1_meet_lincons_array(ap_manager_t* man,
@@ -0,0 +1,1039 @@
+/* ************************************************************************* */
+/* ap_cache.c: memoization of the operations of an underlying domain */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "ap_global0.h"
+#include "ap_cache.h"
+
+/* ------------------------------------------------------------ */
+/* Get internal and transmit the options of funid to the underlying manager */
+static inline
+ap_cache_internal_t* get_internal(ap_manager_t* manager, ap_funid_t funid)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  intern->manager->option.funopt[funid] = manager->option.funopt[funid];
+  return intern;
+}
+
+/* ------------------------------------------------------------ */
+/* Transmit the result flags and the exceptions of the underlying manager.
+   Return true if an exception has been raised. */
+static
+bool collect_results(ap_manager_t* manager)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  ap_result_t* result = &intern->manager->result;
+  ap_result_t* gresult = &manager->result;
+
+  gresult->flag_exact = result->flag_exact;
+  gresult->flag_best = result->flag_best;
+  if (result->exclog != NULL){
+    ap_exclog_t* last = result->exclog;
+    while (last->tail) last = last->tail;
+    last->tail = gresult->exclog;
+    gresult->exclog = result->exclog;
+    result->exclog = NULL;
+    return true;
+  }
+  else
+    return false;
+}
+
+/* ============================================================ */
+/* Cache */
+/* ============================================================ */
+
+static
+bool lincons0_array_is_eq(ap_lincons0_array_t* array1, ap_lincons0_array_t* array2)
+{
+  size_t i;
+  if (array1->size!=array2->size) return false;
+  for (i=0; i<array1->size; i++){
+    ap_lincons0_t* cons1 = &array1->p[i];
+    ap_lincons0_t* cons2 = &array2->p[i];
+    if (cons1->constyp!=cons2->constyp ||
+	!ap_linexpr0_equal(cons1->linexpr0,cons2->linexpr0) ||
+	(cons1->scalar==NULL) != (cons2->scalar==NULL) ||
+	(cons1->scalar && !ap_scalar_equal(cons1->scalar,cons2->scalar)))
+      return false;
+  }
+  return true;
+}
+
+static
+ap_lincons0_array_t lincons0_array_copy(ap_lincons0_array_t* array)
+{
+  size_t i;
+  ap_lincons0_array_t res = ap_lincons0_array_make(array->size);
+  for (i=0; i<array->size; i++){
+    res.p[i] = ap_lincons0_copy(&array->p[i]);
+  }
+  return res;
+}
+
+/* The operation funid is looked up only if the underlying domain provides
+   the hash and equality functions, otherwise it is just delegated */
+static inline
+bool cache_enabled(ap_cache_internal_t* intern, ap_funid_t funid)
+{
+  ap_manager_t* man = intern->manager;
+  return
+    intern->cached[funid] &&
+    man->funptr[AP_FUNID_HASH]!=NULL &&
+    man->funptr[AP_FUNID_IS_EQ]!=NULL;
+}
+
+static
+int cache_hash(ap_cache_internal_t* intern, ap_funid_t funid,
+	       void* a1, void* a2, ap_lincons0_array_t* array)
+{
+  size_t i;
+  ap_manager_t* man = intern->manager;
+  int (*hash)(ap_manager_t*,...) = man->funptr[AP_FUNID_HASH];
+  unsigned res = (unsigned)funid*11 + (unsigned)hash(man,a1);
+  if (a2) res = res*31 + (unsigned)hash(man,a2);
+  if (array){
+    for (i=0; i<array->size; i++){
+      res = res*31 + (unsigned)array->p[i].constyp +
+	(unsigned)ap_linexpr0_hash(array->p[i].linexpr0);
+    }
+  }
+  return (int)res;
+}
+
+static
+void cache_lru_unlink(ap_cache_internal_t* intern, ap_cache_entry_t* e)
+{
+  if (e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+  else intern->lru_first = e->lru_next;
+  if (e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+  else intern->lru_last = e->lru_prev;
+  e->lru_prev = e->lru_next = NULL;
+}
+static
+void cache_lru_push(ap_cache_internal_t* intern, ap_cache_entry_t* e)
+{
+  e->lru_prev = NULL;
+  e->lru_next = intern->lru_first;
+  if (intern->lru_first) intern->lru_first->lru_prev = e;
+  else intern->lru_last = e;
+  intern->lru_first = e;
+}
+
+/* Unlink the entry from the table and the LRU list, and free it */
+static
+void cache_remove(ap_cache_internal_t* intern, ap_cache_entry_t* e)
+{
+  ap_manager_t* man = intern->manager;
+  void (*absfree)(ap_manager_t*,...) = man->funptr[AP_FUNID_FREE];
+  ap_cache_entry_t** pe;
+
+  pe = &intern->table[(unsigned)e->hash & (intern->tablesize-1)];
+  while (*pe!=e) pe = &(*pe)->next;
+  *pe = e->next;
+  cache_lru_unlink(intern,e);
+
+  absfree(man,e->arg1);
+  if (e->arg2) absfree(man,e->arg2);
+  if (e->res) absfree(man,e->res);
+  ap_lincons0_array_clear(&e->array);
+  free(e);
+  intern->size--;
+}
+
+static
+void cache_resize(ap_cache_internal_t* intern, size_t tablesize)
+{
+  size_t i,h;
+  ap_cache_entry_t** table;
+  ap_cache_entry_t* e;
+  ap_cache_entry_t* next;
+
+  table = malloc(tablesize*sizeof(ap_cache_entry_t*));
+  for (i=0; i<tablesize; i++) table[i] = NULL;
+  for (i=0; i<intern->tablesize; i++){
+    for (e=intern->table[i]; e!=NULL; e=next){
+      next = e->next;
+      h = (unsigned)e->hash & (tablesize-1);
+      e->next = table[h];
+      table[h] = e;
+    }
+  }
+  free(intern->table);
+  intern->table = table;
+  intern->tablesize = tablesize;
+}
+
+/* Look for an entry with equal arguments. On success, the entry becomes the
+   most recently used one. */
+static
+ap_cache_entry_t* cache_find(ap_cache_internal_t* intern,
+			     ap_funid_t funid, int hash,
+			     void* a1, void* a2, ap_lincons0_array_t* array)
+{
+  ap_manager_t* man = intern->manager;
+  bool (*is_eq)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_EQ];
+  ap_dimension_t (*dimension)(ap_manager_t*,...) = man->funptr[AP_FUNID_DIMENSION];
+  ap_dimension_t dim,edim;
+  ap_cache_entry_t* e;
+
+  dim = dimension(man,a1);
+  for (e=intern->table[(unsigned)hash & (intern->tablesize-1)]; e!=NULL; e=e->next){
+    if (e->funid!=funid || e->hash!=hash) continue;
+    edim = dimension(man,e->arg1);
+    if (edim.intdim!=dim.intdim || edim.realdim!=dim.realdim) continue;
+    if (array && !lincons0_array_is_eq(&e->array,array)) continue;
+    if (is_eq(man,e->arg1,a1) && (a2==NULL || is_eq(man,e->arg2,a2))){
+      cache_lru_unlink(intern,e);
+      cache_lru_push(intern,e);
+      intern->hits++;
+      return e;
+    }
+  }
+  intern->misses++;
+  return NULL;
+}
+
+/* Add an entry. The abstract values arg1, arg2 and res should be copies,
+   which are owned by the entry, as well as array. */
+static
+void cache_add(ap_manager_t* manager,
+	       ap_funid_t funid, int hash,
+	       void* arg1, void* arg2, ap_lincons0_array_t array,
+	       void* res, bool bres)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  ap_cache_entry_t* e;
+  size_t h;
+
+  if (intern->size>=intern->maxsize){
+    cache_remove(intern,intern->lru_last);
+  }
+  e = malloc(sizeof(ap_cache_entry_t));
+  e->funid = funid;
+  e->hash = hash;
+  e->arg1 = arg1;
+  e->arg2 = arg2;
+  e->array = array;
+  e->res = res;
+  e->bres = bres;
+  e->flag_exact = manager->result.flag_exact;
+  e->flag_best = manager->result.flag_best;
+  h = (unsigned)hash & (intern->tablesize-1);
+  e->next = intern->table[h];
+  intern->table[h] = e;
+  cache_lru_push(intern,e);
+  intern->size++;
+  if (intern->size>intern->tablesize) cache_resize(intern,2*intern->tablesize);
+}
+
+static inline
+void cache_set_results(ap_manager_t* manager, ap_cache_entry_t* e)
+{
+  collect_results(manager);
+  manager->result.flag_exact = e->flag_exact;
+  manager->result.flag_best = e->flag_best;
+}
+
+/* ============================================================ */
+/* I.1 Memory */
+/* ============================================================ */
+
+void* ap_cache_copy(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_COPY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_COPY];
+  void* res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+void ap_cache_free(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_FREE);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_FREE];
+  ptr(man,a);
+  collect_results(manager);
+}
+size_t ap_cache_size(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_ASIZE);
+  ap_manager_t* man = intern->manager;
+  size_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_ASIZE];
+  size_t res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+/* A pure query, the result of the last operation is left untouched */
+size_t ap_cache_memory_size(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  ap_manager_t* man = intern->manager;
+  size_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEMORY_SIZE];
+  if (ptr==NULL){
+    ap_manager_raise_exception(manager,AP_EXC_NOT_IMPLEMENTED,
+			       AP_FUNID_MEMORY_SIZE,
+			       "memory_size not provided by the underlying library");
+    return 0;
+  }
+  return ptr(man,a);
+}
+
+/* ============================================================ */
+/* I.2 Control of internal representation */
+/* ============================================================ */
+
+void ap_cache_minimize(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_MINIMIZE);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MINIMIZE];
+  ptr(man,a);
+  collect_results(manager);
+}
+void ap_cache_canonicalize(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_CANONICALIZE);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_CANONICALIZE];
+  ptr(man,a);
+  collect_results(manager);
+}
+int ap_cache_hash(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_HASH);
+  ap_manager_t* man = intern->manager;
+  int (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_HASH];
+  int res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+void ap_cache_approximate(ap_manager_t* manager, void* a, int n)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_APPROXIMATE);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_APPROXIMATE];
+  ptr(man,a,n);
+  collect_results(manager);
+}
+
+/* ============================================================ */
+/* I.3 Printing */
+/* ============================================================ */
+
+void ap_cache_fprint(FILE* stream, ap_manager_t* manager, void* a,
+		     char** name_of_dim)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_FPRINT);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(FILE*,ap_manager_t*,...) = man->funptr[AP_FUNID_FPRINT];
+  ptr(stream,man,a,name_of_dim);
+  collect_results(manager);
+}
+void ap_cache_fprintdiff(FILE* stream, ap_manager_t* manager, void* a, void* b,
+			 char** name_of_dim)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_FPRINTDIFF);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(FILE*,ap_manager_t*,...) = man->funptr[AP_FUNID_FPRINTDIFF];
+  ptr(stream,man,a,b,name_of_dim);
+  collect_results(manager);
+}
+void ap_cache_fdump(FILE* stream, ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_FDUMP);
+  ap_manager_t* man = intern->manager;
+  void (*ptr)(FILE*,ap_manager_t*,...) = man->funptr[AP_FUNID_FDUMP];
+  ptr(stream,man,a);
+  collect_results(manager);
+}
+
+/* ============================================================ */
+/* I.4 Serialization */
+/* ============================================================ */
+
+ap_membuf_t ap_cache_serialize_raw(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_SERIALIZE_RAW);
+  ap_manager_t* man = intern->manager;
+  ap_membuf_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SERIALIZE_RAW];
+  ap_membuf_t res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_deserialize_raw(ap_manager_t* manager, void* p, size_t* size)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_DESERIALIZE_RAW);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_DESERIALIZE_RAW];
+  void* res = ptr(man,p,size);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* II.1 Basic constructors */
+/* ============================================================ */
+
+void* ap_cache_bottom(ap_manager_t* manager, size_t intdim, size_t realdim)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_BOTTOM);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOTTOM];
+  void* res = ptr(man,intdim,realdim);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_top(ap_manager_t* manager, size_t intdim, size_t realdim)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_TOP);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TOP];
+  void* res = ptr(man,intdim,realdim);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_of_box(ap_manager_t* manager, size_t intdim, size_t realdim,
+		      ap_interval_t** tinterval)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_OF_BOX);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_OF_BOX];
+  void* res = ptr(man,intdim,realdim,tinterval);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* II.2 Accessors */
+/* ============================================================ */
+
+ap_dimension_t ap_cache_dimension(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_DIMENSION);
+  ap_manager_t* man = intern->manager;
+  ap_dimension_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_DIMENSION];
+  ap_dimension_t res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* II.3 Tests */
+/* ============================================================ */
+
+bool ap_cache_is_bottom(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_IS_BOTTOM);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_BOTTOM];
+  bool res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+bool ap_cache_is_top(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_IS_TOP);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_TOP];
+  bool res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+bool ap_cache_is_leq(ap_manager_t* manager, void* a1, void* a2)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_IS_LEQ);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_LEQ];
+  void* (*copy)(ap_manager_t*,...) = man->funptr[AP_FUNID_COPY];
+  ap_cache_entry_t* e;
+  int hash;
+  bool res;
+
+  if (!cache_enabled(intern,AP_FUNID_IS_LEQ)){
+    res = ptr(man,a1,a2);
+    collect_results(manager);
+    return res;
+  }
+  hash = cache_hash(intern,AP_FUNID_IS_LEQ,a1,a2,NULL);
+  e = cache_find(intern,AP_FUNID_IS_LEQ,hash,a1,a2,NULL);
+  if (e){
+    cache_set_results(manager,e);
+    return e->bres;
+  }
+  res = ptr(man,a1,a2);
+  if (!collect_results(manager)){
+    cache_add(manager,AP_FUNID_IS_LEQ,hash,
+	      copy(man,a1),copy(man,a2),ap_lincons0_array_make(0),
+	      NULL,res);
+  }
+  return res;
+}
+bool ap_cache_is_eq(ap_manager_t* manager, void* a1, void* a2)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_IS_EQ);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_EQ];
+  bool res = ptr(man,a1,a2);
+  collect_results(manager);
+  return res;
+}
+bool ap_cache_is_dimension_unconstrained(ap_manager_t* manager, void* a,
+					 ap_dim_t dim)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_IS_DIMENSION_UNCONSTRAINED);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_DIMENSION_UNCONSTRAINED];
+  bool res = ptr(man,a,dim);
+  collect_results(manager);
+  return res;
+}
+bool ap_cache_sat_interval(ap_manager_t* manager, void* a,
+			   ap_dim_t dim, ap_interval_t* interval)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_SAT_INTERVAL);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SAT_INTERVAL];
+  bool res = ptr(man,a,dim,interval);
+  collect_results(manager);
+  return res;
+}
+bool ap_cache_sat_lincons(ap_manager_t* manager, void* a, ap_lincons0_t* cons)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_SAT_LINCONS);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SAT_LINCONS];
+  bool res = ptr(man,a,cons);
+  collect_results(manager);
+  return res;
+}
+bool ap_cache_sat_tcons(ap_manager_t* manager, void* a, ap_tcons0_t* cons)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_SAT_TCONS);
+  ap_manager_t* man = intern->manager;
+  bool (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_SAT_TCONS];
+  bool res = ptr(man,a,cons);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* II.4 Extraction of properties */
+/* ============================================================ */
+
+ap_interval_t* ap_cache_bound_dimension(ap_manager_t* manager, void* a, ap_dim_t dim)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_BOUND_DIMENSION);
+  ap_manager_t* man = intern->manager;
+  ap_interval_t* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOUND_DIMENSION];
+  ap_interval_t* res = ptr(man,a,dim);
+  collect_results(manager);
+  return res;
+}
+ap_interval_t* ap_cache_bound_linexpr(ap_manager_t* manager, void* a,
+				      ap_linexpr0_t* expr)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_BOUND_LINEXPR);
+  ap_manager_t* man = intern->manager;
+  ap_interval_t* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOUND_LINEXPR];
+  ap_interval_t* res = ptr(man,a,expr);
+  collect_results(manager);
+  return res;
+}
+ap_interval_t* ap_cache_bound_texpr(ap_manager_t* manager, void* a,
+				    ap_texpr0_t* expr)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_BOUND_TEXPR);
+  ap_manager_t* man = intern->manager;
+  ap_interval_t* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_BOUND_TEXPR];
+  ap_interval_t* res = ptr(man,a,expr);
+  collect_results(manager);
+  return res;
+}
+ap_interval_t** ap_cache_to_box(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_TO_BOX);
+  ap_manager_t* man = intern->manager;
+  ap_interval_t** (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_BOX];
+  ap_interval_t** res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+ap_lincons0_array_t ap_cache_to_lincons_array(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_TO_LINCONS_ARRAY);
+  ap_manager_t* man = intern->manager;
+  ap_lincons0_array_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_LINCONS_ARRAY];
+  ap_lincons0_array_t res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+ap_tcons0_array_t ap_cache_to_tcons_array(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_TO_TCONS_ARRAY);
+  ap_manager_t* man = intern->manager;
+  ap_tcons0_array_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_TCONS_ARRAY];
+  ap_tcons0_array_t res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+ap_generator0_array_t ap_cache_to_generator_array(ap_manager_t* manager, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_TO_GENERATOR_ARRAY);
+  ap_manager_t* man = intern->manager;
+  ap_generator0_array_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_TO_GENERATOR_ARRAY];
+  ap_generator0_array_t res = ptr(man,a);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* III.1 Meet and Join */
+/* ============================================================ */
+
+/* Meet, join or widening (for which destructive is ignored) */
+static
+void* ap_cache_binop(ap_funid_t funid, ap_manager_t* manager,
+		     bool destructive, void* a1, void* a2)
+{
+  ap_cache_internal_t* intern = get_internal(manager,funid);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
+  void* (*copy)(ap_manager_t*,...) = man->funptr[AP_FUNID_COPY];
+  void (*absfree)(ap_manager_t*,...) = man->funptr[AP_FUNID_FREE];
+  ap_cache_entry_t* e;
+  void* arg1;
+  void* res;
+  int hash;
+
+  if (!cache_enabled(intern,funid)){
+    res =
+      funid==AP_FUNID_WIDENING ?
+      ptr(man,a1,a2) :
+      ptr(man,destructive,a1,a2);
+    collect_results(manager);
+    return res;
+  }
+  hash = cache_hash(intern,funid,a1,a2,NULL);
+  e = cache_find(intern,funid,hash,a1,a2,NULL);
+  if (e){
+    res = copy(man,e->res);
+    if (destructive) absfree(man,a1);
+    cache_set_results(manager,e);
+    return res;
+  }
+  if (funid==AP_FUNID_WIDENING){
+    res = ptr(man,a1,a2);
+    arg1 = NULL;
+  }
+  else {
+    arg1 = destructive ? copy(man,a1) : NULL;
+    res = ptr(man,destructive,a1,a2);
+  }
+  if (!collect_results(manager)){
+    cache_add(manager,funid,hash,
+	      arg1 ? arg1 : copy(man,a1),copy(man,a2),ap_lincons0_array_make(0),
+	      copy(man,res),false);
+  }
+  else if (arg1){
+    absfree(man,arg1);
+  }
+  return res;
+}
+
+void* ap_cache_meet(ap_manager_t* manager, bool destructive, void* a1, void* a2)
+{
+  return ap_cache_binop(AP_FUNID_MEET,manager,destructive,a1,a2);
+}
+void* ap_cache_join(ap_manager_t* manager, bool destructive, void* a1, void* a2)
+{
+  return ap_cache_binop(AP_FUNID_JOIN,manager,destructive,a1,a2);
+}
+void* ap_cache_meet_array(ap_manager_t* manager, void** tab, size_t size)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_MEET_ARRAY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEET_ARRAY];
+  void* res = ptr(man,tab,size);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_join_array(ap_manager_t* manager, void** tab, size_t size)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_JOIN_ARRAY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_JOIN_ARRAY];
+  void* res = ptr(man,tab,size);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_meet_lincons_array(ap_manager_t* manager, bool destructive,
+				  void* a, ap_lincons0_array_t* array)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_MEET_LINCONS_ARRAY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEET_LINCONS_ARRAY];
+  void* (*copy)(ap_manager_t*,...) = man->funptr[AP_FUNID_COPY];
+  void (*absfree)(ap_manager_t*,...) = man->funptr[AP_FUNID_FREE];
+  ap_cache_entry_t* e;
+  void* arg1;
+  void* res;
+  int hash;
+
+  if (!cache_enabled(intern,AP_FUNID_MEET_LINCONS_ARRAY)){
+    res = ptr(man,destructive,a,array);
+    collect_results(manager);
+    return res;
+  }
+  hash = cache_hash(intern,AP_FUNID_MEET_LINCONS_ARRAY,a,NULL,array);
+  e = cache_find(intern,AP_FUNID_MEET_LINCONS_ARRAY,hash,a,NULL,array);
+  if (e){
+    res = copy(man,e->res);
+    if (destructive) absfree(man,a);
+    cache_set_results(manager,e);
+    return res;
+  }
+  arg1 = destructive ? copy(man,a) : NULL;
+  res = ptr(man,destructive,a,array);
+  if (!collect_results(manager)){
+    cache_add(manager,AP_FUNID_MEET_LINCONS_ARRAY,hash,
+	      arg1 ? arg1 : copy(man,a),NULL,lincons0_array_copy(array),
+	      copy(man,res),false);
+  }
+  else if (arg1){
+    absfree(man,arg1);
+  }
+  return res;
+}
+void* ap_cache_meet_tcons_array(ap_manager_t* manager, bool destructive,
+				void* a, ap_tcons0_array_t* array)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_MEET_TCONS_ARRAY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEET_TCONS_ARRAY];
+  void* res = ptr(man,destructive,a,array);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_add_ray_array(ap_manager_t* manager, bool destructive,
+			     void* a, ap_generator0_array_t* array)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_ADD_RAY_ARRAY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_ADD_RAY_ARRAY];
+  void* res = ptr(man,destructive,a,array);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* III.2 Assignement and Substitutions */
+/* ============================================================ */
+
+static
+void* ap_cache_asssub_array(ap_funid_t funid, ap_manager_t* manager,
+			    bool destructive, void* a,
+			    ap_dim_t* tdim, void** texpr, size_t size,
+			    void* dest)
+{
+  ap_cache_internal_t* intern = get_internal(manager,funid);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[funid];
+  void* res = ptr(man,destructive,a,tdim,texpr,size,dest);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_assign_linexpr_array(ap_manager_t* manager, bool destructive,
+				    void* a,
+				    ap_dim_t* tdim, ap_linexpr0_t** texpr, size_t size,
+				    void* dest)
+{
+  return ap_cache_asssub_array(AP_FUNID_ASSIGN_LINEXPR_ARRAY,manager,destructive,
+			       a,tdim,(void**)texpr,size,dest);
+}
+void* ap_cache_substitute_linexpr_array(ap_manager_t* manager, bool destructive,
+					void* a,
+					ap_dim_t* tdim, ap_linexpr0_t** texpr, size_t size,
+					void* dest)
+{
+  return ap_cache_asssub_array(AP_FUNID_SUBSTITUTE_LINEXPR_ARRAY,manager,destructive,
+			       a,tdim,(void**)texpr,size,dest);
+}
+void* ap_cache_assign_texpr_array(ap_manager_t* manager, bool destructive,
+				  void* a,
+				  ap_dim_t* tdim, ap_texpr0_t** texpr, size_t size,
+				  void* dest)
+{
+  return ap_cache_asssub_array(AP_FUNID_ASSIGN_TEXPR_ARRAY,manager,destructive,
+			       a,tdim,(void**)texpr,size,dest);
+}
+void* ap_cache_substitute_texpr_array(ap_manager_t* manager, bool destructive,
+				      void* a,
+				      ap_dim_t* tdim, ap_texpr0_t** texpr, size_t size,
+				      void* dest)
+{
+  return ap_cache_asssub_array(AP_FUNID_SUBSTITUTE_TEXPR_ARRAY,manager,destructive,
+			       a,tdim,(void**)texpr,size,dest);
+}
+
+/* ============================================================ */
+/* III.3 Projections */
+/* ============================================================ */
+
+void* ap_cache_forget_array(ap_manager_t* manager, bool destructive, void* a,
+			    ap_dim_t* tdim, size_t size, bool project)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_FORGET_ARRAY);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_FORGET_ARRAY];
+  void* res = ptr(man,destructive,a,tdim,size,project);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* III.4 Change and permutation of dimensions */
+/* ============================================================ */
+
+void* ap_cache_add_dimensions(ap_manager_t* manager, bool destructive, void* a,
+			      ap_dimchange_t* dimchange, bool project)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_ADD_DIMENSIONS);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_ADD_DIMENSIONS];
+  void* res = ptr(man,destructive,a,dimchange,project);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_remove_dimensions(ap_manager_t* manager, bool destructive, void* a,
+				 ap_dimchange_t* dimchange)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_REMOVE_DIMENSIONS);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_REMOVE_DIMENSIONS];
+  void* res = ptr(man,destructive,a,dimchange);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_permute_dimensions(ap_manager_t* manager, bool destructive, void* a,
+				  ap_dimperm_t* perm)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_PERMUTE_DIMENSIONS);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_PERMUTE_DIMENSIONS];
+  void* res = ptr(man,destructive,a,perm);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* III.5 Expansion and folding of dimensions */
+/* ============================================================ */
+
+void* ap_cache_expand(ap_manager_t* manager, bool destructive, void* a,
+		      ap_dim_t dim, size_t n)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_EXPAND);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_EXPAND];
+  void* res = ptr(man,destructive,a,dim,n);
+  collect_results(manager);
+  return res;
+}
+void* ap_cache_fold(ap_manager_t* manager, bool destructive, void* a,
+		    ap_dim_t* tdim, size_t size)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_FOLD);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_FOLD];
+  void* res = ptr(man,destructive,a,tdim,size);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* III.6 Widening */
+/* ============================================================ */
+
+void* ap_cache_widening(ap_manager_t* manager, void* a1, void* a2)
+{
+  return ap_cache_binop(AP_FUNID_WIDENING,manager,false,a1,a2);
+}
+
+/* ============================================================ */
+/* III.7 Closure operation */
+/* ============================================================ */
+
+void* ap_cache_closure(ap_manager_t* manager, bool destructive, void* a)
+{
+  ap_cache_internal_t* intern = get_internal(manager,AP_FUNID_CLOSURE);
+  ap_manager_t* man = intern->manager;
+  void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_CLOSURE];
+  void* res = ptr(man,destructive,a);
+  collect_results(manager);
+  return res;
+}
+
+/* ============================================================ */
+/* IV. Allocating a manager */
+/* ============================================================ */
+
+void ap_cache_internal_free(void* p)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)p;
+  while (intern->lru_first) cache_remove(intern,intern->lru_first);
+  free(intern->table);
+  ap_manager_free(intern->manager);
+  free(intern->library);
+  free(intern);
+}
+
+ap_manager_t* ap_cache_manager_alloc(ap_manager_t* underlying, size_t maxsize)
+{
+  ap_cache_internal_t* internal;
+  ap_manager_t* man;
+  ap_funid_t funid;
+  void** funptr;
+  size_t i;
+
+  /* creating internal */
+  internal = malloc(sizeof(ap_cache_internal_t));
+  internal->manager = ap_manager_copy(underlying);
+  internal->library = malloc(10+strlen(underlying->library));
+  sprintf(internal->library,"cache of %s",underlying->library);
+  for (funid = 0; funid < AP_FUNID_SIZE; funid++) {
+    internal->cached[funid] = false;
+  }
+  if (maxsize>0){
+    internal->cached[AP_FUNID_IS_LEQ] = true;
+    internal->cached[AP_FUNID_JOIN] = true;
+    internal->cached[AP_FUNID_MEET_LINCONS_ARRAY] = true;
+  }
+  internal->maxsize = maxsize;
+  internal->size = 0;
+  internal->tablesize = 16;
+  internal->table = malloc(internal->tablesize*sizeof(ap_cache_entry_t*));
+  for (i=0; i<internal->tablesize; i++) internal->table[i] = NULL;
+  internal->lru_first = internal->lru_last = NULL;
+  internal->hits = internal->misses = 0;
+
+  /* allocating managers */
+  man = ap_manager_alloc(internal->library, underlying->version, internal,
+			 &ap_cache_internal_free);
+  /* default options */
+  man->option = underlying->option;
+
+  /* Virtual table */
+  funptr = man->funptr;
+
+  funptr[AP_FUNID_COPY] = &ap_cache_copy;
+  funptr[AP_FUNID_FREE] = &ap_cache_free;
+  funptr[AP_FUNID_ASIZE] = &ap_cache_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &ap_cache_memory_size;
+  funptr[AP_FUNID_MINIMIZE] = &ap_cache_minimize;
+  funptr[AP_FUNID_CANONICALIZE] = &ap_cache_canonicalize;
+  funptr[AP_FUNID_HASH] = &ap_cache_hash;
+  funptr[AP_FUNID_APPROXIMATE] = &ap_cache_approximate;
+  funptr[AP_FUNID_FPRINT] = &ap_cache_fprint;
+  funptr[AP_FUNID_FPRINTDIFF] = &ap_cache_fprintdiff;
+  funptr[AP_FUNID_FDUMP] = &ap_cache_fdump;
+  funptr[AP_FUNID_SERIALIZE_RAW] = &ap_cache_serialize_raw;
+  funptr[AP_FUNID_DESERIALIZE_RAW] = &ap_cache_deserialize_raw;
+  funptr[AP_FUNID_BOTTOM] = &ap_cache_bottom;
+  funptr[AP_FUNID_TOP] = &ap_cache_top;
+  funptr[AP_FUNID_OF_BOX] = &ap_cache_of_box;
+  funptr[AP_FUNID_DIMENSION] = &ap_cache_dimension;
+  funptr[AP_FUNID_IS_BOTTOM] = &ap_cache_is_bottom;
+  funptr[AP_FUNID_IS_TOP] = &ap_cache_is_top;
+  funptr[AP_FUNID_IS_LEQ] = &ap_cache_is_leq;
+  funptr[AP_FUNID_IS_EQ] = &ap_cache_is_eq;
+  funptr[AP_FUNID_IS_DIMENSION_UNCONSTRAINED]
+    = &ap_cache_is_dimension_unconstrained;
+  funptr[AP_FUNID_SAT_INTERVAL] = &ap_cache_sat_interval;
+  funptr[AP_FUNID_SAT_LINCONS] = &ap_cache_sat_lincons;
+  funptr[AP_FUNID_SAT_TCONS] = &ap_cache_sat_tcons;
+  funptr[AP_FUNID_BOUND_DIMENSION] = &ap_cache_bound_dimension;
+  funptr[AP_FUNID_BOUND_LINEXPR] = &ap_cache_bound_linexpr;
+  funptr[AP_FUNID_BOUND_TEXPR] = &ap_cache_bound_texpr;
+  funptr[AP_FUNID_TO_BOX] = &ap_cache_to_box;
+  funptr[AP_FUNID_TO_LINCONS_ARRAY] = &ap_cache_to_lincons_array;
+  funptr[AP_FUNID_TO_TCONS_ARRAY] = &ap_cache_to_tcons_array;
+  funptr[AP_FUNID_TO_GENERATOR_ARRAY] = &ap_cache_to_generator_array;
+  funptr[AP_FUNID_MEET] = &ap_cache_meet;
+  funptr[AP_FUNID_MEET_ARRAY] = &ap_cache_meet_array;
+  funptr[AP_FUNID_MEET_LINCONS_ARRAY] = &ap_cache_meet_lincons_array;
+  funptr[AP_FUNID_MEET_TCONS_ARRAY] = &ap_cache_meet_tcons_array;
+  funptr[AP_FUNID_JOIN] = &ap_cache_join;
+  funptr[AP_FUNID_JOIN_ARRAY] = &ap_cache_join_array;
+  funptr[AP_FUNID_ADD_RAY_ARRAY] = &ap_cache_add_ray_array;
+  funptr[AP_FUNID_ASSIGN_LINEXPR_ARRAY] = &ap_cache_assign_linexpr_array;
+  funptr[AP_FUNID_SUBSTITUTE_LINEXPR_ARRAY]
+    = &ap_cache_substitute_linexpr_array;
+  funptr[AP_FUNID_ASSIGN_TEXPR_ARRAY] = &ap_cache_assign_texpr_array;
+  funptr[AP_FUNID_SUBSTITUTE_TEXPR_ARRAY]
+    = &ap_cache_substitute_texpr_array;
+  funptr[AP_FUNID_ADD_DIMENSIONS] = &ap_cache_add_dimensions;
+  funptr[AP_FUNID_REMOVE_DIMENSIONS] = &ap_cache_remove_dimensions;
+  funptr[AP_FUNID_PERMUTE_DIMENSIONS] = &ap_cache_permute_dimensions;
+  funptr[AP_FUNID_FORGET_ARRAY] = &ap_cache_forget_array;
+  funptr[AP_FUNID_EXPAND] = &ap_cache_expand;
+  funptr[AP_FUNID_FOLD] = &ap_cache_fold;
+  funptr[AP_FUNID_WIDENING] = &ap_cache_widening;
+  funptr[AP_FUNID_CLOSURE] = &ap_cache_closure;
+
+  /* Functions not provided by the underlying domain */
+  for (funid = 0; funid < AP_FUNID_SIZE; funid++) {
+    if (underlying->funptr[funid]==NULL) funptr[funid] = NULL;
+  }
+  return man;
+}
+
+/* ============================================================ */
+/* V. Extra functions */
+/* ============================================================ */
+
+bool ap_cache_manager_set_cached(ap_manager_t* manager, ap_funid_t funid, bool cached)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  switch (funid){
+  case AP_FUNID_IS_LEQ:
+  case AP_FUNID_MEET:
+  case AP_FUNID_JOIN:
+  case AP_FUNID_WIDENING:
+  case AP_FUNID_MEET_LINCONS_ARRAY:
+    intern->cached[funid] = cached && intern->maxsize>0;
+    return true;
+  default:
+    return false;
+  }
+}
+
+void ap_cache_manager_stats(ap_manager_t* manager, size_t* hits, size_t* misses)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  *hits = intern->hits;
+  *misses = intern->misses;
+}
+
+void ap_cache_manager_clear(ap_manager_t* manager)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  while (intern->lru_first) cache_remove(intern,intern->lru_first);
+  intern->hits = intern->misses = 0;
+}
+
+ap_manager_t* ap_cache_manager_decompose(ap_manager_t* manager)
+{
+  ap_cache_internal_t* intern = (ap_cache_internal_t*)manager->internal;
+  return intern->manager;
+}
@@ -0,0 +1,110 @@
+/* ************************************************************************* */
+/* ap_cache.h: memoization of the operations of an underlying domain */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#ifndef _AP_CACHE_H_
+#define _AP_CACHE_H_
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "ap_global0.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The abstract values of the cache manager are the abstract values of the
+   underlying domain. Non cached operations are delegated to the underlying
+   manager.
+
+   For a cached operation, the arguments are hashed with the AP_FUNID_HASH
+   function of the underlying domain, and the cache is looked up. A hit is
+   validated with AP_FUNID_IS_EQ on the stored copies of the abstract
+   arguments, and returns a copy of the stored result. The cache holds at
+   most maxsize entries, the least recently used entry being discarded
+   first.
+
+   The functions that may be cached are AP_FUNID_IS_LEQ, AP_FUNID_MEET,
+   AP_FUNID_JOIN, AP_FUNID_WIDENING and AP_FUNID_MEET_LINCONS_ARRAY. By
+   default, AP_FUNID_IS_LEQ, AP_FUNID_JOIN and AP_FUNID_MEET_LINCONS_ARRAY
+   are cached.
+
+   If the underlying domain does not provide AP_FUNID_HASH or
+   AP_FUNID_IS_EQ, nothing is cached and all operations are delegated.
+
+   Caching is effective only if the hash function of the underlying domain
+   returns the same code for equal abstract values; canonical forms may be
+   required for this (see AP_FUNID_CANONICALIZE). Entries are not
+   invalidated when the options of the manager are modified, which may
+   require a call to ap_cache_manager_clear.
+*/
+
+/* (internal) entry of the cache */
+typedef struct ap_cache_entry_t {
+  ap_funid_t funid;
+  int hash;
+  void* arg1;                  /* copy of the first abstract argument */
+  void* arg2;                  /* copy of the second one, or NULL */
+  ap_lincons0_array_t array;   /* copy of the constraints, or empty array */
+  void* res;                   /* copy of the result, or NULL for tests */
+  bool bres;                   /* result of tests */
+  bool flag_exact;             /* result flags of the operation */
+  bool flag_best;
+  struct ap_cache_entry_t* next;      /* next entry in the same bucket */
+  struct ap_cache_entry_t* lru_prev;  /* more recently used entry */
+  struct ap_cache_entry_t* lru_next;  /* less recently used entry */
+} ap_cache_entry_t;
+
+/* internal fields of manager */
+typedef struct ap_cache_internal_t {
+  char* library;               /* (constructed) library name */
+  ap_manager_t* manager;       /* Manager of the underlying domain */
+  bool cached[AP_FUNID_SIZE];  /* Operations that are cached */
+  size_t maxsize;              /* Maximum number of entries */
+  size_t size;                 /* Current number of entries */
+  ap_cache_entry_t** table;    /* Hash table, of size tablesize */
+  size_t tablesize;            /* Power of 2 */
+  ap_cache_entry_t* lru_first; /* Most recently used entry */
+  ap_cache_entry_t* lru_last;  /* Least recently used entry */
+  size_t hits;
+  size_t misses;
+} ap_cache_internal_t;
+
+/* ============================================================ */
+/* IV. Allocating a manager */
+/* ============================================================ */
+
+ap_manager_t* ap_cache_manager_alloc(ap_manager_t* underlying, size_t maxsize);
+  /* Create a manager memoizing the results of underlying, with a cache of
+     at most maxsize entries */
+
+/* ============================================================ */
+/* V. Extra functions */
+/* ============================================================ */
+
+bool ap_cache_manager_set_cached(ap_manager_t* manager, ap_funid_t funid, bool cached);
+  /* Enable or disable the caching of the operation funid. Return false if
+     the operation cannot be cached. */
+
+void ap_cache_manager_stats(ap_manager_t* manager, size_t* hits, size_t* misses);
+  /* Number of hits and misses since the allocation of the manager or the
+     last call to ap_cache_manager_clear */
+
+void ap_cache_manager_clear(ap_manager_t* manager);
+  /* Remove all entries and reset the counters */
+
+ap_manager_t* ap_cache_manager_decompose(ap_manager_t* manager);
+  /* Return the underlying manager (not a copy) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
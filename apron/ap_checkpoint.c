@@ -0,0 +1,366 @@
+/* ************************************************************************* */
+/* ap_checkpoint.c: checkpoint files of abstract values */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ap_checkpoint.h"
+
+#define AP_CHECKPOINT_MAGIC "APRONCKP"
+#define AP_CHECKPOINT_BYTEORDER 0x01020304
+#define AP_CHECKPOINT_NAMESIZE 64
+
+typedef struct ap_checkpoint_header_t {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteorder;
+  char library[AP_CHECKPOINT_NAMESIZE];
+  char libversion[AP_CHECKPOINT_NAMESIZE];
+  uint64_t nbenv;
+  uint64_t nbval;
+  uint64_t envtab;
+  uint64_t valtab;
+} ap_checkpoint_header_t;
+
+struct ap_checkpoint_t {
+  char* data;               /* content of the file */
+  size_t size;              /* size of the file */
+  bool mapped;              /* data is mapped, otherwise allocated */
+  const uint64_t* valtab;   /* table of values, in data */
+  size_t nbval;
+  ap_environment_t** env;   /* environments, built at opening */
+  size_t nbenv;
+  size_t count;             /* reference counter (updated atomically) */
+};
+
+/* ********************************************************************** */
+/* I. Writing */
+/* ********************************************************************** */
+
+static bool write_at(FILE* stream, const void* p, size_t size)
+{
+  return fwrite(p,1,size,stream)==size;
+}
+
+/* Pad with zeros up to a multiple of align */
+static bool write_pad(FILE* stream, size_t align)
+{
+  static const char zero[AP_CHECKPOINT_ALIGN] = { 0 };
+  long pos = ftell(stream);
+  if (pos<0) return false;
+  return write_at(stream,zero,(align-(size_t)pos%align)%align);
+}
+
+static bool write_env(FILE* stream, ap_environment_t* env)
+{
+  uint64_t dims[2] = { env->intdim, env->realdim };
+  size_t i;
+  bool ok = write_at(stream,dims,sizeof(dims));
+  for (i=0; ok && i<env->intdim+env->realdim; i++){
+    char* name = ap_var_operations->to_string(env->var_of_dim[i]);
+    ok = write_at(stream,name,strlen(name)+1);
+    free(name);
+  }
+  return ok;
+}
+
+bool ap_checkpoint_save(ap_manager_t* man, const char* filename,
+			ap_abstract1_t* tab, size_t size)
+{
+  ap_checkpoint_header_t header;
+  ap_environment_t** env;
+  uint64_t *envtab, *valtab;
+  size_t i,j,nbenv;
+  FILE* stream;
+  bool ok;
+
+  stream = fopen(filename,"wb");
+  if (stream==NULL){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_SERIALIZE_RAW,
+			       "ap_checkpoint_save: cannot open the file");
+    return false;
+  }
+  memset(&header,0,sizeof(header));
+  memcpy(header.magic,AP_CHECKPOINT_MAGIC,8);
+  header.version = AP_CHECKPOINT_VERSION;
+  header.byteorder = AP_CHECKPOINT_BYTEORDER;
+  strncpy(header.library,man->library,AP_CHECKPOINT_NAMESIZE-1);
+  strncpy(header.libversion,man->version,AP_CHECKPOINT_NAMESIZE-1);
+  header.nbval = size;
+
+  env = malloc((size ? size : 1)*sizeof(ap_environment_t*));
+  envtab = malloc((size ? 2*size : 1)*sizeof(uint64_t));
+  valtab = malloc((size ? 3*size : 1)*sizeof(uint64_t));
+  nbenv = 0;
+
+  /* the header is rewritten at the end */
+  ok = write_at(stream,&header,sizeof(header));
+
+  /* environments, shared between values */
+  for (i=0; ok && i<size; i++){
+    for (j=0; j<nbenv; j++){
+      if (env[j]==tab[i].env || ap_environment_is_eq(env[j],tab[i].env))
+	break;
+    }
+    valtab[3*i+2] = j;
+    if (j==nbenv){
+      env[nbenv] = tab[i].env;
+      envtab[2*nbenv] = (uint64_t)ftell(stream);
+      ok = write_env(stream,tab[i].env);
+      envtab[2*nbenv+1] = (uint64_t)ftell(stream) - envtab[2*nbenv];
+      nbenv++;
+    }
+  }
+  /* values, serialized one at a time */
+  for (i=0; ok && i<size; i++){
+    ap_membuf_t buf = ap_abstract0_serialize_raw(man,tab[i].abstract0);
+    if (buf.ptr==NULL){
+      ok = false;
+      break;
+    }
+    ok = write_pad(stream,AP_CHECKPOINT_ALIGN);
+    valtab[3*i] = (uint64_t)ftell(stream);
+    valtab[3*i+1] = buf.size;
+    ok = ok && write_at(stream,buf.ptr,buf.size);
+    free(buf.ptr);
+  }
+  /* tables and header */
+  if (ok){
+    ok = write_pad(stream,sizeof(uint64_t));
+    header.nbenv = nbenv;
+    header.envtab = (uint64_t)ftell(stream);
+    ok = ok && write_at(stream,envtab,2*nbenv*sizeof(uint64_t));
+    header.valtab = (uint64_t)ftell(stream);
+    ok = ok && write_at(stream,valtab,3*size*sizeof(uint64_t));
+    ok = ok && fseek(stream,0,SEEK_SET)==0;
+    ok = ok && write_at(stream,&header,sizeof(header));
+    if (!ok)
+      ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_SERIALIZE_RAW,
+				 "ap_checkpoint_save: cannot write the file");
+  }
+  free(env);
+  free(envtab);
+  free(valtab);
+  if (fclose(stream)!=0 && ok){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_SERIALIZE_RAW,
+			       "ap_checkpoint_save: cannot write the file");
+    ok = false;
+  }
+  if (!ok) remove(filename);
+  return ok;
+}
+
+/* ********************************************************************** */
+/* II. Reading */
+/* ********************************************************************** */
+
+/* Is [offset,offset+size) within the file ? */
+static inline bool in_file(ap_checkpoint_t* ck, uint64_t offset, uint64_t size)
+{
+  return offset<=ck->size && size<=ck->size-offset;
+}
+
+/* Map the file, or read it if it cannot be mapped */
+static bool map_file(ap_checkpoint_t* ck, const char* filename)
+{
+  struct stat st;
+  int fd = open(filename,O_RDONLY);
+  if (fd<0) return false;
+  if (fstat(fd,&st)!=0 || st.st_size<(off_t)sizeof(ap_checkpoint_header_t)){
+    close(fd);
+    return false;
+  }
+  ck->size = (size_t)st.st_size;
+  ck->data = mmap(NULL,ck->size,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+  ck->mapped = ck->data!=MAP_FAILED;
+  if (!ck->mapped){
+    size_t n = 0;
+    ssize_t r = 1;
+    ck->data = malloc(ck->size);
+    while (ck->data && n<ck->size && r>0){
+      r = read(fd,ck->data+n,ck->size-n);
+      if (r>0) n += (size_t)r;
+    }
+    if (ck->data && n<ck->size){
+      free(ck->data);
+      ck->data = NULL;
+    }
+  }
+  close(fd);
+  return ck->data!=NULL;
+}
+
+static void unmap_file(ap_checkpoint_t* ck)
+{
+  if (ck->mapped) munmap(ck->data,ck->size);
+  else free(ck->data);
+}
+
+/* Build the environment stored in [offset,offset+size) */
+static ap_environment_t* read_env(ap_checkpoint_t* ck, uint64_t offset, uint64_t size,
+				  ap_var_t (*var_of_name)(const char*))
+{
+  ap_environment_t* env = NULL;
+  ap_var_t* var;
+  uint64_t dims[2];
+  char* p = ck->data+offset;
+  char* end = p+size;
+  size_t i,nbdims;
+
+  if (size<sizeof(dims)) return NULL;
+  memcpy(dims,p,sizeof(dims));
+  p += sizeof(dims);
+  if (dims[0]>size || dims[1]>size-dims[0]) return NULL;
+  nbdims = dims[0]+dims[1];
+  var = malloc((nbdims ? nbdims : 1)*sizeof(ap_var_t));
+  for (i=0; i<nbdims; i++){
+    char* name = memchr(p,0,(size_t)(end-p));
+    if (name==NULL) break;
+    var[i] = var_of_name ? var_of_name(p) : (ap_var_t)p;
+    p = name+1;
+  }
+  if (i==nbdims)
+    env = ap_environment_alloc(var,dims[0],var+dims[0],dims[1]);
+  if (var_of_name){
+    while (i>0){
+      i--;
+      ap_var_operations->free(var[i]);
+    }
+  }
+  free(var);
+  return env;
+}
+
+static void checkpoint_free(ap_checkpoint_t* ck)
+{
+  size_t i;
+  for (i=0; i<ck->nbenv; i++){
+    if (ck->env[i]) ap_environment_free(ck->env[i]);
+  }
+  free(ck->env);
+  unmap_file(ck);
+  free(ck);
+}
+
+ap_checkpoint_t* ap_checkpoint_open(ap_manager_t* man, const char* filename,
+				    ap_var_t (*var_of_name)(const char*))
+{
+  ap_checkpoint_header_t header;
+  ap_checkpoint_t* ck;
+  const uint64_t* envtab;
+  const char* msg = NULL;
+  size_t i;
+
+  if (var_of_name==NULL && ap_var_operations!=&ap_var_operations_default){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,
+			       "ap_checkpoint_open: var_of_name is required with non-default variables");
+    return NULL;
+  }
+  ck = malloc(sizeof(ap_checkpoint_t));
+  ck->env = NULL;
+  ck->nbenv = 0;
+  ck->count = 1;
+  if (!map_file(ck,filename)){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,
+			       "ap_checkpoint_open: cannot read the file");
+    free(ck);
+    return NULL;
+  }
+  memcpy(&header,ck->data,sizeof(header));
+  if (memcmp(header.magic,AP_CHECKPOINT_MAGIC,8)!=0 ||
+      header.version!=AP_CHECKPOINT_VERSION)
+    msg = "ap_checkpoint_open: not a checkpoint file";
+  else if (header.byteorder!=AP_CHECKPOINT_BYTEORDER)
+    msg = "ap_checkpoint_open: file saved with another byte order";
+  else if (strncmp(header.library,man->library,AP_CHECKPOINT_NAMESIZE-1)!=0 ||
+	   strncmp(header.libversion,man->version,AP_CHECKPOINT_NAMESIZE-1)!=0)
+    msg = "ap_checkpoint_open: file saved by another library or numeric type";
+  else if (header.envtab%sizeof(uint64_t) || header.valtab%sizeof(uint64_t) ||
+	   header.nbenv>ck->size/(2*sizeof(uint64_t)) ||
+	   header.nbval>ck->size/(3*sizeof(uint64_t)) ||
+	   !in_file(ck,header.envtab,2*sizeof(uint64_t)*header.nbenv) ||
+	   !in_file(ck,header.valtab,3*sizeof(uint64_t)*header.nbval))
+    msg = "ap_checkpoint_open: corrupted file";
+  if (msg==NULL){
+    envtab = (const uint64_t*)(ck->data+header.envtab);
+    ck->valtab = (const uint64_t*)(ck->data+header.valtab);
+    ck->nbval = header.nbval;
+    ck->env = malloc((header.nbenv ? header.nbenv : 1)*sizeof(ap_environment_t*));
+    for (i=0; i<header.nbenv; i++){
+      ck->env[i] = in_file(ck,envtab[2*i],envtab[2*i+1]) ?
+	read_env(ck,envtab[2*i],envtab[2*i+1],var_of_name) : NULL;
+      if (ck->env[i]==NULL) break;
+    }
+    ck->nbenv = i;
+    if (i<header.nbenv)
+      msg = "ap_checkpoint_open: corrupted environment";
+    for (i=0; msg==NULL && i<ck->nbval; i++){
+      if (!in_file(ck,ck->valtab[3*i],ck->valtab[3*i+1]) ||
+	  ck->valtab[3*i+2]>=ck->nbenv)
+	msg = "ap_checkpoint_open: corrupted value table";
+    }
+  }
+  if (msg){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,msg);
+    checkpoint_free(ck);
+    return NULL;
+  }
+  return ck;
+}
+
+size_t ap_checkpoint_size(ap_checkpoint_t* ck)
+{
+  return ck->nbval;
+}
+
+ap_abstract1_t ap_checkpoint_load(ap_manager_t* man, ap_checkpoint_t* ck,
+				  size_t i)
+{
+  ap_abstract1_t res;
+  size_t size;
+
+  if (i>=ck->nbval){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,
+			       "ap_checkpoint_load: index out of range");
+    return ap_abstract1_top(man,ap_environment_alloc_empty());
+  }
+  res.env = ap_environment_copy(ck->env[ck->valtab[3*i+2]]);
+  /* the bytes of the value, the library does not read beyond them */
+  size = ck->valtab[3*i+1];
+  res.abstract0 = ap_abstract0_deserialize_mapped(man,ck->data+ck->valtab[3*i],&size,ck);
+  if (res.abstract0){
+    ap_dimension_t dim = ap_abstract0_dimension(man,res.abstract0);
+    if (size<=ck->valtab[3*i+1] &&
+	dim.intdim==res.env->intdim && dim.realdim==res.env->realdim)
+      return res;
+    ap_abstract0_free(man,res.abstract0);
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,
+			       "ap_checkpoint_load: corrupted value");
+  }
+  res.abstract0 = ap_abstract0_top(man,res.env->intdim,res.env->realdim);
+  return res;
+}
+
+ap_checkpoint_t* ap_checkpoint_copy(ap_checkpoint_t* ck)
+{
+  __atomic_add_fetch(&ck->count,1,__ATOMIC_RELAXED);
+  return ck;
+}
+
+void ap_checkpoint_free(ap_checkpoint_t* ck)
+{
+  assert(ck->count>=1);
+  if (__atomic_sub_fetch(&ck->count,1,__ATOMIC_ACQ_REL)==0)
+    checkpoint_free(ck);
+}
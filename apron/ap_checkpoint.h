@@ -0,0 +1,106 @@
+/* ************************************************************************* */
+/* ap_checkpoint.h: checkpoint files of abstract values */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+/* A checkpoint file saves the state of an analysis: an array of abstract
+   values of level 1 of the same library, with their environments.
+
+   Files are read by mapping them in memory.  Libraries providing
+   AP_FUNID_DESERIALIZE_MAPPED (boxes and octagons with a native numeric
+   type such as double, octagons being saved as flat matrices when the
+   algorithm of AP_FUNID_SERIALIZE_RAW is positive) then build values
+   pointing into the mapping, so
+   that opening a file and loading a value do not depend on its size.
+   The mapping is private: a page is copied on its first write, and the
+   file itself is never modified.  Other libraries copy the serialized data
+   as ap_abstract0_deserialize_raw does.
+
+   Layout (integers in native byte order, so that the data of native
+   numeric types can be used in place; files are not portable across byte
+   orders):
+
+   header   char[8]  magic         "APRONCKP"
+            uint32   version       AP_CHECKPOINT_VERSION
+            uint32   byteorder     0x01020304
+            char[64] library       ap_manager_get_library, NUL padded
+            char[64] libversion    ap_manager_get_version, NUL padded
+                                   (which names the numeric type)
+            uint64   nbenv, nbval
+            uint64   envtab, valtab   file offsets of the tables
+   envtab   nbenv * (uint64 offset, uint64 size)
+   valtab   nbval * (uint64 offset, uint64 size, uint64 env index)
+   env      uint64 intdim, uint64 realdim,
+            intdim+realdim NUL-terminated variable names
+   value    output of ap_abstract0_serialize_raw
+
+   Values start on AP_CHECKPOINT_ALIGN boundaries.
+*/
+
+#ifndef _AP_CHECKPOINT_H_
+#define _AP_CHECKPOINT_H_
+
+#include "ap_abstract1.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AP_CHECKPOINT_VERSION 1
+#define AP_CHECKPOINT_ALIGN 64
+
+typedef struct ap_checkpoint_t ap_checkpoint_t;
+  /* Opened checkpoint file (opaque, reference counted) */
+
+/* ====================================================================== */
+/* Writing */
+/* ====================================================================== */
+
+bool ap_checkpoint_save(ap_manager_t* man, const char* filename,
+			ap_abstract1_t* tab, size_t size);
+  /* Save the array tab of size abstract values to filename.
+     Return false, raise an exception and remove the file if a value cannot
+     be serialized or the file cannot be written. */
+
+/* ====================================================================== */
+/* Reading */
+/* ====================================================================== */
+
+ap_checkpoint_t* ap_checkpoint_open(ap_manager_t* man, const char* filename,
+				    ap_var_t (*var_of_name)(const char* name));
+  /* Map filename, check that it was saved by the library of man with the
+     same numeric type, and build its environments.
+
+     var_of_name builds a variable from its name, the result being freed
+     with ap_var_operations->free. If NULL, the default ap_var_operations
+     should be in use, and variables are strings.
+
+     Return NULL and raise an exception if the file is not a valid
+     checkpoint for man. */
+
+size_t ap_checkpoint_size(ap_checkpoint_t* ck);
+  /* Number of values in the file */
+
+ap_abstract1_t ap_checkpoint_load(ap_manager_t* man, ap_checkpoint_t* ck,
+				  size_t i);
+  /* Build the i-th value of the file.  If it cannot be read, raise an
+     exception and return top in its environment (in the empty one if i is
+     out of range). */
+
+ap_checkpoint_t* ap_checkpoint_copy(ap_checkpoint_t* ck);
+  /* Increment the reference counter and return its argument */
+void ap_checkpoint_free(ap_checkpoint_t* ck);
+  /* Decrement the reference counter, and unmap the file when it reaches 0.
+     Values pointing into the mapping hold a reference, so that the file can
+     be freed after loading them. */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -112,6 +112,18 @@ void ap_coeff_free(ap_coeff_t* coeff)
   free(coeff);
 }
 
+size_t ap_coeff_memory_size(ap_coeff_t* coeff)
+{
+  switch (coeff->discr){
+  case AP_COEFF_SCALAR:
+    return ap_scalar_memory_size(coeff->val.scalar);
+  case AP_COEFF_INTERVAL:
+    return ap_interval_memory_size(coeff->val.interval);
+  default:
+    abort();
+  }
+}
+
 void ap_coeff_fprint(FILE* stream, ap_coeff_t* a)
 {
   switch(a->discr){
@@ -47,6 +47,9 @@ void ap_coeff_reinit(ap_coeff_t* coeff, ap_coeff_discr_t ap_coeff_discr, ap_scal
   /* Changing the type of scalar(s) and the type of the coefficient */
 void ap_coeff_free(ap_coeff_t* a);
   /* Free a coefficient */
+size_t ap_coeff_memory_size(ap_coeff_t* a);
+  /* Number of bytes of heap memory referenced by a coefficient
+     (not counting the ap_coeff_t structure itself) */
 void ap_coeff_fprint(FILE* stream, ap_coeff_t* a);
 static inline 
 void ap_coeff_print(ap_coeff_t* a)
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 #include "ap_global0.h"
 #include "ap_disjunction.h"
 
@@ -26,14 +27,30 @@ static ap_disjunction_t* ap_disjunction_alloc(size_t size)
   res->p = malloc(size * sizeof(void*));
   for (i = 0; i < size; i++)
     res->p[i] = NULL;
+  res->box = NULL;
+  res->nbdims = 0;
   return res;
 }
+/* Frees the bounding boxes, to be called when the abstract values are
+   modified in place */
+static void ap_disjunction_clear_box(ap_disjunction_t* a)
+{
+  size_t i;
+  if (a->box!=NULL){
+    for (i=0; i < a->size; i++) {
+      if (a->box[i]!=NULL) ap_interval_array_free(a->box[i],a->nbdims);
+    }
+    free(a->box);
+    a->box = NULL;
+  }
+}
 static void ap_disjunction_clear(ap_disjunction_internal_t* intern,
 			    ap_disjunction_t* a)
 {
   size_t i;
   ap_manager_t* man = intern->manager;
   void (*absfree)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FREE];
+  ap_disjunction_clear_box(a);
   for (i=0; i < a->size; i++) {
     if (a->p[i]!=NULL){
       absfree(man, a->p[i]);
@@ -50,6 +67,274 @@ ap_disjunction_internal_t* get_internal(ap_manager_t* manager)
   return (ap_disjunction_internal_t*)manager->internal;
 }
 
+/* ============================================================ */
+/* Index of bounding boxes */
+/* ============================================================ */
+
+/* Returns the bounding box of a->p[i], computed on demand with the
+   AP_FUNID_TO_BOX function of the underlying domain */
+static ap_interval_t** ap_disjunction_get_box(ap_disjunction_internal_t* intern,
+					      ap_disjunction_t* a, size_t i)
+{
+  ap_manager_t* man = intern->manager;
+  if (a->box==NULL){
+    ap_dimension_t (*dimension)(ap_manager_t*, ...) = man->funptr[AP_FUNID_DIMENSION];
+    ap_dimension_t dim = dimension(man, a->p[i]);
+    a->box = calloc(a->size, sizeof(ap_interval_t**));
+    a->nbdims = dim.intdim + dim.realdim;
+  }
+  if (a->box[i]==NULL){
+    ap_interval_t** (*to_box)(ap_manager_t*, ...) = man->funptr[AP_FUNID_TO_BOX];
+    a->box[i] = to_box(man, a->p[i]);
+  }
+  return a->box[i];
+}
+
+/* Copies (or moves, if destructive) the bounding box of b->p[j], if any,
+   to the one of a->p[i] */
+static void ap_disjunction_copy_box(ap_disjunction_t* a, size_t i,
+				    bool destructive, ap_disjunction_t* b, size_t j)
+{
+  size_t k;
+  if (b->box==NULL || b->box[j]==NULL) return;
+  if (a->box==NULL){
+    a->box = calloc(a->size, sizeof(ap_interval_t**));
+    a->nbdims = b->nbdims;
+  }
+  if (destructive){
+    a->box[i] = b->box[j];
+    b->box[j] = NULL;
+  }
+  else {
+    a->box[i] = ap_interval_array_alloc(b->nbdims);
+    for (k=0; k < b->nbdims; k++) ap_interval_set(a->box[i][k],b->box[j][k]);
+  }
+}
+
+/* Necessary condition for a->p[i] to be included in b->p[j] */
+static bool ap_disjunction_box_is_leq(ap_disjunction_internal_t* intern,
+				      ap_disjunction_t* a, size_t i,
+				      ap_disjunction_t* b, size_t j)
+{
+  size_t k;
+  ap_interval_t** boxa = ap_disjunction_get_box(intern,a,i);
+  ap_interval_t** boxb = ap_disjunction_get_box(intern,b,j);
+  for (k=0; k < a->nbdims; k++) {
+    if (!ap_interval_is_leq(boxa[k],boxb[k])) return false;
+  }
+  return true;
+}
+
+/* Frees a->p[i] and its bounding box */
+static void ap_disjunction_remove(ap_disjunction_internal_t* intern,
+				  ap_disjunction_t* a, size_t i)
+{
+  ap_manager_t* man = intern->manager;
+  void (*absfree)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FREE];
+  absfree(man, a->p[i]);
+  a->p[i] = NULL;
+  if (a->box!=NULL && a->box[i]!=NULL){
+    ap_interval_array_free(a->box[i],a->nbdims);
+    a->box[i] = NULL;
+  }
+}
+
+/* ============================================================ */
+/* Per-disjunct operations and workers */
+/* ============================================================ */
+
+/* An operation of the underlying domain applied to each disjunct */
+typedef struct ap_disjunction_job_t {
+  ap_funid_t funid;
+  bool destructive;
+  void** src;          /* arguments */
+  void** src2;         /* for AP_FUNID_MEET, second arguments, the result
+			  i being the meet of src[i/size2] and src2[i%size2] */
+  size_t size2;
+  bool shared;         /* for AP_FUNID_MEET, the arguments are used by
+			  several threads */
+  void** dst;          /* results, may be equal to src */
+  size_t n;            /* number of results */
+  size_t next;         /* next result to compute, protected by the mutex
+			  of the pool */
+  void* arg1;          /* other arguments, depending on funid */
+  void* arg2;
+  size_t size;
+  bool project;
+  ap_dim_t dim;
+} ap_disjunction_job_t;
+
+struct ap_disjunction_pool_t {
+  size_t size;                 /* number of worker threads */
+  ap_manager_t** tman;         /* underlying manager of each worker */
+  pthread_t* thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t start;        /* a job is posted, or shutdown */
+  pthread_cond_t done;         /* the last worker has finished the job */
+  unsigned long generation;    /* number of posted jobs */
+  size_t running;              /* workers still on the current job */
+  bool shutdown;
+  ap_disjunction_job_t* job;
+};
+
+typedef struct ap_disjunction_worker_t {
+  struct ap_disjunction_pool_t* pool;
+  size_t index;
+} ap_disjunction_worker_t;
+
+static void ap_disjunction_job_run(ap_manager_t* man, ap_disjunction_job_t* job, size_t i)
+{
+  void* (*ptr)(ap_manager_t*, ...) = man->funptr[job->funid];
+  switch (job->funid){
+  case AP_FUNID_MEET:
+    if (job->shared){
+      /* a meet may modify its arguments (e.g. polka computes their
+	 representations), so each thread works on copies */
+      void* (*copy)(ap_manager_t*, ...) = man->funptr[AP_FUNID_COPY];
+      void (*absfree)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FREE];
+      void* a1 = copy(man, job->src[i / job->size2]);
+      void* a2 = copy(man, job->src2[i % job->size2]);
+      job->dst[i] = ptr(man, true, a1, a2);
+      absfree(man, a2);
+    }
+    else
+      job->dst[i] = ptr(man, false, job->src[i / job->size2], job->src2[i % job->size2]);
+    break;
+  case AP_FUNID_MEET_LINCONS_ARRAY:
+  case AP_FUNID_MEET_TCONS_ARRAY:
+  case AP_FUNID_ADD_RAY_ARRAY:
+  case AP_FUNID_REMOVE_DIMENSIONS:
+  case AP_FUNID_PERMUTE_DIMENSIONS:
+    job->dst[i] = ptr(man, job->destructive, job->src[i], job->arg1);
+    break;
+  case AP_FUNID_ASSIGN_LINEXPR_ARRAY:
+  case AP_FUNID_SUBSTITUTE_LINEXPR_ARRAY:
+  case AP_FUNID_ASSIGN_TEXPR_ARRAY:
+  case AP_FUNID_SUBSTITUTE_TEXPR_ARRAY:
+    job->dst[i] = ptr(man, job->destructive, job->src[i], job->arg1, job->arg2, job->size, NULL);
+    break;
+  case AP_FUNID_FORGET_ARRAY:
+    job->dst[i] = ptr(man, job->destructive, job->src[i], job->arg1, job->size, job->project);
+    break;
+  case AP_FUNID_ADD_DIMENSIONS:
+    job->dst[i] = ptr(man, job->destructive, job->src[i], job->arg1, job->project);
+    break;
+  case AP_FUNID_EXPAND:
+    job->dst[i] = ptr(man, job->destructive, job->src[i], job->dim, job->size);
+    break;
+  case AP_FUNID_FOLD:
+    job->dst[i] = ptr(man, job->destructive, job->src[i], job->arg1, job->size);
+    break;
+  case AP_FUNID_CLOSURE:
+    job->dst[i] = ptr(man, job->destructive, job->src[i]);
+    break;
+  default:
+    abort();
+  }
+}
+
+/* Computes the results of the job not yet taken by another thread */
+static void ap_disjunction_job_work(struct ap_disjunction_pool_t* pool,
+				    ap_manager_t* man, ap_disjunction_job_t* job)
+{
+  size_t i;
+  while (true){
+    pthread_mutex_lock(&pool->mutex);
+    i = job->next++;
+    pthread_mutex_unlock(&pool->mutex);
+    if (i >= job->n) break;
+    ap_disjunction_job_run(man,job,i);
+  }
+}
+
+static void* ap_disjunction_worker(void* arg)
+{
+  ap_disjunction_worker_t* worker = (ap_disjunction_worker_t*)arg;
+  struct ap_disjunction_pool_t* pool = worker->pool;
+  ap_manager_t* man = pool->tman[worker->index];
+  unsigned long generation = 0;
+  ap_disjunction_job_t* job;
+
+  free(worker);
+  pthread_mutex_lock(&pool->mutex);
+  while (true){
+    while (!pool->shutdown && pool->generation==generation)
+      pthread_cond_wait(&pool->start,&pool->mutex);
+    if (pool->shutdown) break;
+    generation = pool->generation;
+    job = pool->job;
+    pthread_mutex_unlock(&pool->mutex);
+    ap_disjunction_job_work(pool,man,job);
+    pthread_mutex_lock(&pool->mutex);
+    pool->running--;
+    if (pool->running==0) pthread_cond_signal(&pool->done);
+  }
+  pthread_mutex_unlock(&pool->mutex);
+  return NULL;
+}
+
+static void ap_disjunction_pool_free(struct ap_disjunction_pool_t* pool)
+{
+  size_t i;
+  pthread_mutex_lock(&pool->mutex);
+  pool->shutdown = true;
+  pthread_cond_broadcast(&pool->start);
+  pthread_mutex_unlock(&pool->mutex);
+  for (i=0; i < pool->size; i++) {
+    pthread_join(pool->thread[i],NULL);
+    ap_manager_free(pool->tman[i]);
+  }
+  pthread_mutex_destroy(&pool->mutex);
+  pthread_cond_destroy(&pool->start);
+  pthread_cond_destroy(&pool->done);
+  free(pool->thread);
+  free(pool->tman);
+  free(pool);
+}
+
+/* Computes the n results of the job, with the workers if any, the calling
+   thread using the underlying manager. In place (dst==src), the bounding
+   boxes of a are freed. */
+static void ap_disjunction_map(ap_disjunction_internal_t* intern,
+			       ap_disjunction_job_t* job, ap_disjunction_t* a)
+{
+  struct ap_disjunction_pool_t* pool = intern->pool;
+  size_t i;
+
+  if (job->dst==job->src) ap_disjunction_clear_box(a);
+  job->next = 0;
+  if (pool==NULL || job->n < 2){
+    for (i=0; i < job->n; i++) ap_disjunction_job_run(intern->manager,job,i);
+    return;
+  }
+  job->shared = true;
+  pthread_mutex_lock(&pool->mutex);
+  pool->job = job;
+  pool->running = pool->size;
+  pool->generation++;
+  pthread_cond_broadcast(&pool->start);
+  pthread_mutex_unlock(&pool->mutex);
+  ap_disjunction_job_work(pool,intern->manager,job);
+  pthread_mutex_lock(&pool->mutex);
+  while (pool->running > 0)
+    pthread_cond_wait(&pool->done,&pool->mutex);
+  pool->job = NULL;
+  pthread_mutex_unlock(&pool->mutex);
+}
+
+static ap_disjunction_job_t ap_disjunction_job(ap_funid_t funid, bool destructive,
+					       ap_disjunction_t* a, ap_disjunction_t* res)
+{
+  ap_disjunction_job_t job;
+  memset(&job,0,sizeof(job));
+  job.funid = funid;
+  job.destructive = destructive;
+  job.src = a->p;
+  job.dst = res->p;
+  job.n = a->size;
+  return job;
+}
+
 /* ============================================================ */
 /*   */
 /* ============================================================ */
@@ -90,11 +375,13 @@ static void ap_disjunction_resize(ap_disjunction_t* a)
     }
     if (dec>0 && i+dec<a->size){
       a->p[i] = a->p[i+dec];
+      if (a->box!=NULL) a->box[i] = a->box[i+dec];
     }
     i++;
   }
   a->size = a->size-dec;
   a->p=realloc(a->p,a->size*sizeof(void*));
+  if (a->box!=NULL) a->box=realloc(a->box,a->size*sizeof(ap_interval_t**));
 }
 
 /* If only bottom values, leaves exactly one such value and frees the other.
@@ -106,7 +393,6 @@ static void ap_disjunction_null_bottom_top(
     bool* const notbottom)
 {
   ap_manager_t* man = intern->manager;
-  void (*free)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FREE];
   bool (*is_bottom)(ap_manager_t*, ...) = man->funptr[AP_FUNID_IS_BOTTOM];
   bool (*is_top)(ap_manager_t*, ...) = man->funptr[AP_FUNID_IS_TOP];
 
@@ -118,12 +404,12 @@ static void ap_disjunction_null_bottom_top(
   for (i = 0; i < a->size; i++) {
     if (a->p[i] != NULL){
       if (is_bottom(man,a->p[i])){
-	if (bottom>=0) { free(man,a->p[i]); a->p[i]=NULL; }
+	if (bottom>=0) ap_disjunction_remove(intern,a,i);
 	else bottom = (int)i;
       }
       else {
 	if (is_top(man,a->p[i])){
-	  if (*top>=0) { free(man,a->p[i]); a->p[i]=NULL; }
+	  if (*top>=0) ap_disjunction_remove(intern,a,i);
 	  else *top = (int)i;
 	}
 	*notbottom = true;
@@ -131,19 +417,19 @@ static void ap_disjunction_null_bottom_top(
     }
   }
   if (bottom>=0 && *notbottom){
-    free(man,a->p[bottom]);
-    a->p[bottom]=NULL;
+    ap_disjunction_remove(intern,a,(size_t)bottom);
   }
 }
 
 
-/* applies previous function and remove equal elements */
+/* applies previous function and removes the elements included in another
+   one. The bounding boxes are compared first, so that the inclusion test of
+   the underlying domain is only called when they are included. */
 static void ap_disjunction_elim_redundant(ap_disjunction_internal_t* intern,
 					  ap_disjunction_t* a)
 {
   ap_manager_t* man = intern->manager;
-  void (*free)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FREE];
-  bool (*is_eq)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_EQ];
+  bool (*is_leq)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_LEQ];
   int top;
   bool notbottom;
 
@@ -154,12 +440,16 @@ static void ap_disjunction_elim_redundant(ap_disjunction_internal_t* intern,
     /* From now on, no bottom and at most one top values */
     for (i = 0; i < a->size; i++) {
       if ((int)i!=top && a->p[i]!=NULL){
-	for (j = i+1; j<a->size; j++){
-	  if ((int)j!=top && a->p[j]!=NULL){
-	    if (is_eq(man,a->p[i],a->p[j])){
-	      free(man,a->p[j]);
-	      a->p[j]=NULL;
-	    }
+	if (top>=0){
+	  ap_disjunction_remove(intern,a,i);
+	  continue;
+	}
+	for (j = 0; j<a->size; j++){
+	  if (j!=i && a->p[j]!=NULL &&
+	      ap_disjunction_box_is_leq(intern,a,i,a,j) &&
+	      is_leq(man,a->p[i],a->p[j])){
+	    ap_disjunction_remove(intern,a,i);
+	    break;
 	  }
 	}
       }
@@ -168,6 +458,18 @@ static void ap_disjunction_elim_redundant(ap_disjunction_internal_t* intern,
   ap_disjunction_resize(a);
 }
 
+/* Eliminates the redundant elements, and calls the merge function if there
+   are still more than maxsize of them */
+static void ap_disjunction_normalize(ap_manager_t* manager, ap_disjunction_t* a)
+{
+  ap_disjunction_internal_t* intern = get_internal(manager);
+  ap_disjunction_elim_redundant(intern,a);
+  if (intern->maxsize>0 && a->size>intern->maxsize){
+    if (intern->merge!=NULL) intern->merge(manager,a);
+    else ap_disjunction_merge_box(manager,a);
+  }
+}
+
 
 /* ============================================================ */
 /* I.1 Memory */
@@ -211,6 +513,35 @@ size_t ap_disjunction_size(ap_manager_t* manager,
   return res;
 }
 
+size_t ap_disjunction_memory_size(ap_manager_t* manager,
+				  ap_disjunction_t* a)
+{
+  size_t i,res;
+  ap_disjunction_internal_t* intern = get_internal(manager);
+  ap_manager_t* man = intern->manager;
+  size_t (*memory_size)(ap_manager_t*, ...) = man->funptr[AP_FUNID_MEMORY_SIZE];
+
+  res = sizeof(ap_disjunction_t) + a->size*sizeof(void*);
+  if (memory_size==NULL){
+    ap_manager_raise_exception(manager,AP_EXC_NOT_IMPLEMENTED,
+			       AP_FUNID_MEMORY_SIZE,
+			       "memory_size not provided by the underlying library");
+  }
+  else {
+    for (i = 0; i < a->size; i++) {
+      res += memory_size(man, a->p[i]);
+    }
+  }
+  if (a->box!=NULL){
+    res += a->size*sizeof(ap_interval_t**);
+    for (i = 0; i < a->size; i++) {
+      if (a->box[i]!=NULL)
+	res += ap_interval_array_memory_size(a->box[i],a->nbdims);
+    }
+  }
+  return res;
+}
+
 void ap_disjunction_minimize(ap_manager_t* manager,
 			     ap_disjunction_t* a)
 {
@@ -424,27 +755,29 @@ bool ap_disjunction_is_leq(ap_manager_t* manager, ap_disjunction_t* a,
   ap_disjunction_internal_t* intern = get_internal(manager);
   ap_manager_t* man = intern->manager;
 
-  return false;
-  /*
   bool (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_IS_LEQ];
   size_t i,j;
   bool leq;
 
   if (ap_disjunction_is_bottom(manager,a) || ap_disjunction_is_top(manager,b)){
+    manager->result.flag_exact = manager->result.flag_best = true;
     return true;
   }
+  /* sufficient condition: each element of a is included in an element of
+     b. true is exact, false only means that the inclusion is not proved */
   leq = true;
-  for (i=0; i<a->size; i++){
-    bool ileq = false;
+  for (i=0; i<a->size && leq; i++){
+    leq = false;
     for (j=0;j<b->size;j++){
-      ileq = ptr(man,a->p[i],b->p[i]);
-      if (ileq) break;
+      if (ap_disjunction_box_is_leq(intern,a,i,b,j) &&
+	  ptr(man,a->p[i],b->p[j])){
+	leq = true;
+	break;
+      }
     }
-    leq = ileq;
-    if (!leq) break;
   }
+  manager->result.flag_exact = manager->result.flag_best = leq;
   return leq;
-  */
 }
 
 
@@ -729,22 +1062,21 @@ ap_disjunction_t* ap_disjunction_join(ap_manager_t* manager,
   ap_manager_t* man = intern->manager;
   void* (*copy)(ap_manager_t*, ...) = man->funptr[AP_FUNID_COPY];
   ap_disjunction_t* res = ap_disjunction_alloc(a1->size+a2->size);
-  size_t i,j;
+  size_t i;
   for (i=0; i<a1->size; i++){
     res->p[i] = destructive ? a1->p[i] : copy(man,a1->p[i]);
+    ap_disjunction_copy_box(res,i,destructive,a1,i);
   }
   for (i=0; i<a2->size; i++){
     res->p[a1->size+i] = copy(man,a2->p[i]);
+    ap_disjunction_copy_box(res,a1->size+i,false,a2,i);
   }
-  {
-    int top;
-    bool notbottom;
-    ap_disjunction_null_bottom_top(intern,res,&top,&notbottom);
-    ap_disjunction_resize(res);
+  if (destructive){
+    ap_disjunction_clear_box(a1);
+    free(a1->p);
+    free(a1);
   }
-  /*
-  ap_disjunction_elim_redundant(intern, res);
-  */
+  ap_disjunction_normalize(manager,res);
   return res;
 }
 
@@ -773,38 +1105,31 @@ ap_disjunction_t* ap_disjunction_join_array(ap_manager_t* manager,
     int bottom = -1;
 
     length = 0;
-    for (i=0; i<size; i++) length += tab[i]->size;
-    res = ap_disjunction_alloc(length);
-
-    l = 0;
     for (i=0; i<size; i++){
       if (ap_disjunction_is_bottom(manager,tab[i])){
 	bottom = (int)i;
       }
       else {
-	for (j=0; j<tab[i]->size; j++){
-	  res->p[l] = copy(man,tab[i]->p[j]);
-	  l++;
-	}
+	length += tab[i]->size;
       }
     }
     if (length==0){
       assert(bottom>=0);
-      ap_disjunction_free(manager,res);
       return ap_disjunction_copy(manager,tab[bottom]);
     }
-    else {
-      {
-	int top;
-	bool notbottom;
-	ap_disjunction_null_bottom_top(intern,res,&top,&notbottom);
-	ap_disjunction_resize(res);
+    res = ap_disjunction_alloc(length);
+    l = 0;
+    for (i=0; i<size; i++){
+      if (!ap_disjunction_is_bottom(manager,tab[i])){
+	for (j=0; j<tab[i]->size; j++){
+	  res->p[l] = copy(man,tab[i]->p[j]);
+	  ap_disjunction_copy_box(res,l,false,tab[i],j);
+	  l++;
+	}
       }
-      /*
-	ap_disjunction_elim_redundant(intern, res);
-      */
-      return res;
     }
+    ap_disjunction_normalize(manager,res);
+    return res;
   }
 }
 
@@ -823,34 +1148,34 @@ ap_disjunction_t* ap_disjunction_meet(ap_manager_t* manager, bool destructive,
 
   ap_disjunction_internal_t* intern = get_internal(manager);
   ap_manager_t* man = intern->manager;
-  void* (*meet)(ap_manager_t*, ...) = man->funptr[AP_FUNID_MEET];
-  void* (*is_bottom)(ap_manager_t*, ...) = man->funptr[AP_FUNID_IS_BOTTOM];
+  void (*absfree)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FREE];
+  bool (*is_bottom)(ap_manager_t*, ...) = man->funptr[AP_FUNID_IS_BOTTOM];
+  ap_disjunction_job_t job;
 
   ap_disjunction_elim_redundant(intern, a1);
   ap_disjunction_elim_redundant(intern, a2);
 
   ap_disjunction_t* res = ap_disjunction_alloc(a1->size*a2->size);
-  size_t i,j,k;
+  size_t i,k;
+  job = ap_disjunction_job(AP_FUNID_MEET,false,res,res);
+  job.src = a1->p;
+  job.src2 = a2->p;
+  job.size2 = a2->size;
+  ap_disjunction_map(intern,&job,res);
   k = 0;
-  for (i=0; i<a1->size; i++){
-    for (j=0; j<a2->size; j++){
-      void* res1 = meet(man,false,a1->p[i],a2->p[j]);
-      if (!is_bottom(man,res1)){
-	res->p[k] = res1;
-	k++;
+  for (i=0; i<res->size; i++){
+    if (is_bottom(man,res->p[i])){
+      if (k>0 || i+1<res->size){
+	absfree(man,res->p[i]);
+	continue;
       }
     }
+    /* keep the last element if all of them are bottom */
+    res->p[k] = res->p[i];
+    k++;
   }
-  if (k==0){
-    assert(res->size>=1);
-    ap_dimension_t dim = ap_abstract0_dimension(man,a1->p[0]);
-    res->p[0] = ap_abstract0_top(man,dim.intdim,dim.realdim);
-    res->size = 1;
-  }
-  else {
-    res->size = k;
-    ap_disjunction_elim_redundant(intern, res);
-  }
+  res->size = k;
+  ap_disjunction_normalize(manager,res);
   if (destructive){
     ap_disjunction_free(manager,a1);
   }
@@ -873,18 +1198,15 @@ ap_disjunction_t* ap_disjunction_meet_lincons_array(ap_manager_t* manager,
 {
 
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_MEET_LINCONS_ARRAY];
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_MEET_LINCONS_ARRAY,destructive,a,res);
+  job.arg1 = array;
 
   int top;
   bool notbottom;
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], array);
-  }
+  ap_disjunction_map(intern,&job,a);
   ap_disjunction_null_bottom_top(intern,res,&top,&notbottom);
   ap_disjunction_resize(res);
   return res;
@@ -894,16 +1216,13 @@ ap_disjunction_t* ap_disjunction_meet_tcons_array(ap_manager_t* manager,bool des
 						  ap_disjunction_t* a, ap_tcons0_array_t* array)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res= destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_MEET_TCONS_ARRAY];
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_MEET_TCONS_ARRAY,destructive,a,res);
+  job.arg1 = array;
 
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], array);
-  }
+  ap_disjunction_map(intern,&job,a);
   {
     int top;
     bool notbottom;
@@ -919,16 +1238,13 @@ ap_disjunction_t* ap_disjunction_add_ray_array(ap_manager_t* manager,
 					       bool destructive, ap_disjunction_t* a, ap_lincons0_array_t* array)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res= destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_ADD_RAY_ARRAY];
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_ADD_RAY_ARRAY,destructive,a,res);
+  job.arg1 = array;
 
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], array);
-  }
+  ap_disjunction_map(intern,&job,a);
   {
     int top;
     bool notbottom;
@@ -952,22 +1268,19 @@ ap_disjunction_t* ap_disjunction_asssub_linexpr_array(
     ap_linexpr0_t** texpr, size_t size, ap_disjunction_t* dest)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
-
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[funid];
-  bool (*is_bottom)(ap_manager_t*, ...) =	man->funptr[AP_FUNID_IS_BOTTOM];
 
   if (dest!=NULL){
     ap_manager_raise_exception(manager, AP_EXC_NOT_IMPLEMENTED, funid, "assign or substitute supported only when dest==NULL");
     return NULL;
   }
 
-  size_t i;
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], tdim, texpr, size, NULL);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(funid,destructive,a,res);
+  job.arg1 = tdim;
+  job.arg2 = texpr;
+  job.size = size;
+  ap_disjunction_map(intern,&job,a);
   return res;
 }
 
@@ -995,21 +1308,19 @@ ap_disjunction_t* ap_disjunction_asssub_texpr_array(
     ap_texpr0_t** texpr, size_t size, ap_disjunction_t* dest)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
-
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[funid];
-  bool (*is_bottom)(ap_manager_t*, ...) =	man->funptr[AP_FUNID_IS_BOTTOM];
 
   if (dest!=NULL){
     ap_manager_raise_exception(manager, AP_EXC_NOT_IMPLEMENTED, funid, "assign or substitute supported only when dest==NULL");
     return NULL;
   }
 
-  size_t i;
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], tdim, texpr, size, NULL);
-  }
+
+  ap_disjunction_job_t job = ap_disjunction_job(funid,destructive,a,res);
+  job.arg1 = tdim;
+  job.arg2 = texpr;
+  job.size = size;
+  ap_disjunction_map(intern,&job,a);
   return res;
 }
 
@@ -1039,16 +1350,14 @@ ap_disjunction_t* ap_disjunction_forget_array(
     bool project)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res= destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FORGET_ARRAY];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], tdim, size, project);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_FORGET_ARRAY,destructive,a,res);
+  job.arg1 = tdim;
+  job.size = size;
+  job.project = project;
+  ap_disjunction_map(intern,&job,a);
   /*
   {
     int top;
@@ -1068,15 +1377,12 @@ ap_disjunction_t* ap_disjunction_add_dimensions(
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
 
-  ap_manager_t* man = intern->manager;
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_ADD_DIMENSIONS];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], dimchange, project);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_ADD_DIMENSIONS,destructive,a,res);
+  job.arg1 = dimchange;
+  job.project = project;
+  ap_disjunction_map(intern,&job,a);
   return res;
 }
 
@@ -1084,16 +1390,12 @@ ap_disjunction_t* ap_disjunction_remove_dimensions(ap_manager_t* manager,
 						   bool destructive, ap_disjunction_t* a, ap_dimchange_t* dimchange)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_REMOVE_DIMENSIONS];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], dimchange);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_REMOVE_DIMENSIONS,destructive,a,res);
+  job.arg1 = dimchange;
+  ap_disjunction_map(intern,&job,a);
   /*
   {
     int top;
@@ -1110,16 +1412,12 @@ ap_disjunction_t* ap_disjunction_permute_dimensions(ap_manager_t* manager,
 						    bool destructive, ap_disjunction_t* a, ap_dimperm_t* perm)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res= destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_PERMUTE_DIMENSIONS];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], perm);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_PERMUTE_DIMENSIONS,destructive,a,res);
+  job.arg1 = perm;
+  ap_disjunction_map(intern,&job,a);
   return res;
 }
 
@@ -1136,16 +1434,13 @@ ap_disjunction_t* ap_disjunction_expand(ap_manager_t* manager,
 					size_t n)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_EXPAND];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], dim, n);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_EXPAND,destructive,a,res);
+  job.dim = dim;
+  job.size = n;
+  ap_disjunction_map(intern,&job,a);
   return res;
 }
 
@@ -1158,16 +1453,13 @@ ap_disjunction_t* ap_disjunction_fold(ap_manager_t* manager,
 				      size_t size)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_FOLD];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i], tdim, size);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_FOLD,destructive,a,res);
+  job.arg1 = tdim;
+  job.size = size;
+  ap_disjunction_map(intern,&job,a);
   /*
   ap_disjunction_elim_redundant(intern,res);
   */
@@ -1195,16 +1487,11 @@ ap_disjunction_t* ap_disjunction_closure(ap_manager_t* manager,
 					 bool destructive, ap_disjunction_t* a)
 {
   ap_disjunction_internal_t* intern = get_internal(manager);
-  ap_manager_t* man = intern->manager;
 
   ap_disjunction_t* res = destructive ? a : ap_disjunction_alloc(a->size);
 
-  void* (*ptr)(ap_manager_t*, ...) = man->funptr[AP_FUNID_CLOSURE];
-
-  size_t i;
-  for (i = 0; i < a->size; i++) {
-    res->p[i] = ptr(man, destructive, a->p[i]);
-  }
+  ap_disjunction_job_t job = ap_disjunction_job(AP_FUNID_CLOSURE,destructive,a,res);
+  ap_disjunction_map(intern,&job,a);
   return res;
 }
 
@@ -1216,6 +1503,10 @@ void ap_disjunction_internal_free(void* p)
 {
   ap_disjunction_internal_t* intern = (ap_disjunction_internal_t*) p;
 
+  if (intern->pool!=NULL){
+    ap_disjunction_pool_free(intern->pool);
+    intern->pool = NULL;
+  }
   ap_manager_free(intern->manager);
   intern->manager = NULL;
   free(intern->library);
@@ -1236,6 +1527,8 @@ ap_manager_t* ap_disjunction_manager_alloc(
   internal = malloc(sizeof(ap_disjunction_internal_t));
   internal->manager = ap_manager_copy(underlying);
   internal->merge = merge;
+  internal->maxsize = 0;
+  internal->pool = NULL;
 
   internal->library = malloc(20+strlen(underlying->library));
   sprintf(internal->library,"disjunction of %s",underlying->library);
@@ -1285,10 +1578,14 @@ ap_manager_t* ap_disjunction_manager_alloc(
   funptr[AP_FUNID_COPY] = &ap_disjunction_copy;
   funptr[AP_FUNID_FREE] = &ap_disjunction_free;
   funptr[AP_FUNID_ASIZE] = &ap_disjunction_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &ap_disjunction_memory_size;
   funptr[AP_FUNID_MINIMIZE] = &ap_disjunction_minimize;
   funptr[AP_FUNID_CANONICALIZE] = &ap_disjunction_canonicalize;
   funptr[AP_FUNID_HASH] = &ap_disjunction_hash;
   funptr[AP_FUNID_APPROXIMATE] = &ap_disjunction_approximate;
+  funptr[AP_FUNID_FPRINT] = &ap_disjunction_fprint;
+  funptr[AP_FUNID_FPRINTDIFF] = &ap_disjunction_fprintdiff;
+  funptr[AP_FUNID_FDUMP] = &ap_disjunction_fdump;
   funptr[AP_FUNID_BOTTOM] = &ap_disjunction_bottom;
   funptr[AP_FUNID_TOP] = &ap_disjunction_top;
   funptr[AP_FUNID_OF_BOX] = &ap_disjunction_of_box;
@@ -1352,6 +1649,7 @@ void** ap_disjunction_decompose(ap_manager_t* manager, bool destructive,
 
   if (destructive){
     void** res = a->p;
+    ap_disjunction_clear_box(a);
     free(a);
     return res;
   }
@@ -1383,3 +1681,110 @@ ap_disjunction_t* ap_disjunction_compose(ap_manager_t* manager,
   }
   return res;
 }
+
+void ap_disjunction_manager_set_maxsize(ap_manager_t* manager, size_t maxsize)
+{
+  ap_disjunction_internal_t* intern = get_internal(manager);
+  intern->maxsize = maxsize;
+}
+
+/* Cost of the merge of two disjuncts: number of finite bounds of their
+   bounding boxes lost by the join, then increase of the widths */
+static void ap_disjunction_merge_cost(ap_interval_t** box1, ap_interval_t** box2,
+				      size_t nbdims, size_t* lost, double* growth)
+{
+  size_t k;
+  double inf1,sup1,inf2,sup2,inf,sup,w;
+  *lost = 0;
+  *growth = 0.0;
+  for (k=0; k<nbdims; k++){
+    ap_double_set_scalar(&inf1,box1[k]->inf,GMP_RNDD);
+    ap_double_set_scalar(&sup1,box1[k]->sup,GMP_RNDU);
+    ap_double_set_scalar(&inf2,box2[k]->inf,GMP_RNDD);
+    ap_double_set_scalar(&sup2,box2[k]->sup,GMP_RNDU);
+    inf = inf1<inf2 ? inf1 : inf2;
+    sup = sup1>sup2 ? sup1 : sup2;
+    if (inf==-INFINITY && (inf1!=-INFINITY || inf2!=-INFINITY)) (*lost)++;
+    if (sup==INFINITY && (sup1!=INFINITY || sup2!=INFINITY)) (*lost)++;
+    if (inf!=-INFINITY && sup!=INFINITY){
+      w = (sup1-inf1)>(sup2-inf2) ? sup1-inf1 : sup2-inf2;
+      *growth += (sup-inf)-w;
+    }
+  }
+}
+
+void ap_disjunction_merge_box(ap_manager_t* manager, ap_disjunction_t* a)
+{
+  ap_disjunction_internal_t* intern = get_internal(manager);
+  ap_manager_t* man = intern->manager;
+  void* (*join)(ap_manager_t*, ...) = man->funptr[AP_FUNID_JOIN];
+  size_t i,j,bi,bj,lost,blost;
+  double growth,bgrowth;
+
+  while (a->size>1 && a->size>intern->maxsize){
+    bi = 0; bj = 1;
+    blost = (size_t)-1; bgrowth = 0.0;
+    for (i=0; i<a->size; i++){
+      for (j=i+1; j<a->size; j++){
+	ap_disjunction_merge_cost(ap_disjunction_get_box(intern,a,i),
+				  ap_disjunction_get_box(intern,a,j),
+				  a->nbdims,&lost,&growth);
+	if (lost<blost || (lost==blost && growth<bgrowth)){
+	  bi = i; bj = j; blost = lost; bgrowth = growth;
+	}
+      }
+    }
+    a->p[bi] = join(man,true,a->p[bi],a->p[bj]);
+    ap_interval_array_free(a->box[bi],a->nbdims);
+    a->box[bi] = NULL;
+    ap_disjunction_remove(intern,a,bj);
+    ap_disjunction_resize(a);
+  }
+}
+
+bool ap_disjunction_manager_set_workers(ap_manager_t* manager,
+					ap_manager_t** tman, size_t size)
+{
+  ap_disjunction_internal_t* intern = get_internal(manager);
+  struct ap_disjunction_pool_t* pool;
+  ap_disjunction_worker_t* worker;
+  size_t i;
+
+  if (intern->pool!=NULL){
+    ap_disjunction_pool_free(intern->pool);
+    intern->pool = NULL;
+  }
+  for (i=0; i<size; i++){
+    if (strcmp(tman[i]->library,intern->manager->library)!=0)
+      return false;
+  }
+  if (size==0)
+    return true;
+
+  pool = malloc(sizeof(struct ap_disjunction_pool_t));
+  pool->size = 0;
+  pool->tman = malloc(size*sizeof(ap_manager_t*));
+  pool->thread = malloc(size*sizeof(pthread_t));
+  pthread_mutex_init(&pool->mutex,NULL);
+  pthread_cond_init(&pool->start,NULL);
+  pthread_cond_init(&pool->done,NULL);
+  pool->generation = 0;
+  pool->running = 0;
+  pool->shutdown = false;
+  pool->job = NULL;
+  for (i=0; i<size; i++){
+    pool->tman[i] = ap_manager_copy(tman[i]);
+    worker = malloc(sizeof(ap_disjunction_worker_t));
+    worker->pool = pool;
+    worker->index = i;
+    if (pthread_create(&pool->thread[i],NULL,ap_disjunction_worker,worker)!=0){
+      free(worker);
+      ap_manager_free(pool->tman[i]);
+      ap_disjunction_pool_free(pool);
+      return false;
+    }
+    pool->size++;
+  }
+  intern->pool = pool;
+  return true;
+}
@@ -20,10 +20,33 @@
 extern "C" {
 #endif
 
+/* The elements of a disjunction are kept with their bounding boxes (given
+   by AP_FUNID_TO_BOX of the base domain, computed on demand). An element
+   included in another one is removed after joins, meets and projections;
+   the inclusion test of the base domain is called only if the bounding
+   boxes are included.
+
+   If a maximum size is set, the result of a join or a meet with more
+   elements calls the merge function of the manager, or
+   ap_disjunction_merge_box if it is NULL.
+
+   The inclusion test is sufficient only: a1 <= a2 if each element of a1 is
+   included in some element of a2. A true answer is exact; a false answer
+   sets flag_exact and flag_best to false, as a1 may still be included in
+   the union of several elements of a2.
+
+   Operations applied to each element separately (meet with constraints,
+   assignments, projections, changes of dimensions, and the pairwise meets
+   of ap_disjunction_meet) may be distributed over worker threads, see
+   ap_disjunction_manager_set_workers. */
+
 /* (internal) abstract value for disjunction */
 typedef struct ap_disjunction_t {
   size_t size;  /* size of abstract value */
   void** p;   /* array of internal abstract values of size "size" */
+  ap_interval_t*** box; /* bounding boxes of the elements of p, box[i] is
+			   NULL if not yet computed, box is NULL if none is */
+  size_t nbdims;        /* dimension of the bounding boxes */
 } ap_disjunction_t;
 
 /* internal fields of manager */
@@ -32,6 +55,8 @@ typedef struct ap_disjunction_internal_t {
 						      NULL */
   char* library;               /* (constructed) library name  */
   ap_manager_t* manager;   /* Manager of the base domain */
+  size_t maxsize;          /* maximum number of elements, 0 if unbounded */
+  struct ap_disjunction_pool_t* pool; /* worker threads, or NULL */
 } ap_disjunction_internal_t;
 
 /* ============================================================ */
@@ -52,6 +77,30 @@ ap_manager_t* ap_disjunction_manager_alloc
 ap_lincons0_array_t ap_disjunction_to_lincons0_set(ap_manager_t* manager,
 						   ap_disjunction_t* a);
 
+void ap_disjunction_manager_set_maxsize(ap_manager_t* manager, size_t maxsize);
+  /* Bound the number of elements of the results of joins and meets, 0 (the
+     default) for no bound. The merge function given to
+     ap_disjunction_manager_alloc is then called with the disjunctive
+     manager on a result with more than maxsize elements, and should reduce
+     it to at most maxsize elements. */
+
+void ap_disjunction_merge_box(ap_manager_t* manager, ap_disjunction_t* a);
+  /* Default merge function: join the two elements whose bounding boxes
+     are the closest (fewest finite bounds lost, then smallest increase of
+     the widths) until a has at most maxsize elements (at least one). */
+
+bool ap_disjunction_manager_set_workers(ap_manager_t* manager,
+					ap_manager_t** tman, size_t size);
+  /* Distribute the operations applied to each element over size worker
+     threads, the calling thread taking part with the base manager. The
+     worker i uses the manager tman[i], which must be of the same library
+     as the base manager and must not be used meanwhile by other threads;
+     the workers keep a reference on it. The result does not depend on the
+     number of workers. size==0 stops the workers.
+
+     Return false if a manager is not of the right library or a thread
+     cannot be created, in which case there is no worker. */
+
 
 /* ap_abstract0_t */
 void** ap_disjunction_decompose(ap_manager_t* manager, bool destructive,
@@ -414,14 +414,237 @@ static ap_environment_t* environment_of_denv(denv_t* denv)
   res->intdim = denv->envint.size;
   res->realdim = denv->envreal.size;
   res->count = 1;
+  res->dim_of_var = NULL;
+  res->dim_of_var_size = 0;
+  res->next = NULL;
+  res->hash = 0;
   return res;
 }
 
+/* ========================================================================= */
+/* Hash index and hash-consing */
+/* ========================================================================= */
+
+/* Environments with less variables are searched by dichotomy */
+#define AP_ENVIRONMENT_INDEX_MIN 8
+
+static inline size_t var_hash(ap_var_t var, size_t mask)
+{
+  return ((unsigned)ap_var_operations->hash(var) * 2654435761U) & mask;
+}
+
+/* Build the hash index of a (normalized) environment */
+static void environment_index(ap_environment_t* env)
+{
+  size_t i,h,mask,size;
+
+  size = env->intdim+env->realdim;
+  if (size<AP_ENVIRONMENT_INDEX_MIN) return;
+  env->dim_of_var_size = 2*AP_ENVIRONMENT_INDEX_MIN;
+  while (env->dim_of_var_size<2*size) env->dim_of_var_size *= 2;
+  mask = env->dim_of_var_size-1;
+  env->dim_of_var = malloc(env->dim_of_var_size*sizeof(ap_dim_t));
+  for (i=0; i<env->dim_of_var_size; i++){
+    env->dim_of_var[i] = AP_DIM_MAX;
+  }
+  for (i=0; i<size; i++){
+    h = var_hash(env->var_of_dim[i],mask);
+    while (env->dim_of_var[h]!=AP_DIM_MAX) h = (h+1) & mask;
+    env->dim_of_var[h] = i;
+  }
+}
+
+/* Hash-consing table, with chaining through the field next */
+typedef struct hashcons_t {
+  ap_environment_t** p;
+  size_t size;   /* Number of buckets, a power of 2 */
+  size_t nbenv;  /* Number of environments in the table */
+  bool enabled;
+} hashcons_t;
+
+static hashcons_t hashcons = { NULL, 0, 0, false };
+
+/* Memoization of ap_environment_lce and ap_environment_dimchange, indexed
+   by the pointers of the arguments, on which the entries hold a
+   reference */
+#define AP_ENVIRONMENT_MEMO_SIZE 64
+
+typedef struct lce_memo_t {
+  ap_environment_t* env1;
+  ap_environment_t* env2;
+  ap_environment_t* lce;
+  ap_dimchange_t* dimchange1;
+  ap_dimchange_t* dimchange2;
+} lce_memo_t;
+
+typedef struct dimchange_memo_t {
+  ap_environment_t* env1;
+  ap_environment_t* env;
+  ap_dimchange_t* dimchange;
+} dimchange_memo_t;
+
+static lce_memo_t lce_memo[AP_ENVIRONMENT_MEMO_SIZE];
+static dimchange_memo_t dimchange_memo[AP_ENVIRONMENT_MEMO_SIZE];
+
+static inline size_t memo_index(ap_environment_t* env1, ap_environment_t* env2)
+{
+  size_t h = ((size_t)env1 >> 4)*31 + ((size_t)env2 >> 4);
+  return (h ^ (h >> 7)) & (AP_ENVIRONMENT_MEMO_SIZE-1);
+}
+
+static ap_dimchange_t* dimchange_copy(ap_dimchange_t* dimchange)
+{
+  ap_dimchange_t* res;
+  if (dimchange==NULL) return NULL;
+  res = ap_dimchange_alloc(dimchange->intdim,dimchange->realdim);
+  memcpy(res->dim,dimchange->dim,
+	 (dimchange->intdim+dimchange->realdim)*sizeof(ap_dim_t));
+  return res;
+}
+
+static void lce_memo_clear(lce_memo_t* m)
+{
+  if (m->env1){
+    ap_environment_free(m->env1);
+    ap_environment_free(m->env2);
+    ap_environment_free(m->lce);
+    if (m->dimchange1) ap_dimchange_free(m->dimchange1);
+    if (m->dimchange2) ap_dimchange_free(m->dimchange2);
+    m->env1 = m->env2 = m->lce = NULL;
+    m->dimchange1 = m->dimchange2 = NULL;
+  }
+}
+static void dimchange_memo_clear(dimchange_memo_t* m)
+{
+  if (m->env1){
+    ap_environment_free(m->env1);
+    ap_environment_free(m->env);
+    if (m->dimchange) ap_dimchange_free(m->dimchange);
+    m->env1 = m->env = NULL;
+    m->dimchange = NULL;
+  }
+}
+
+/* Hash code on all the variables, never 0 */
+static unsigned environment_hash_full(ap_environment_t* env)
+{
+  size_t i;
+  unsigned res = 7*env->intdim + 11*env->realdim;
+  for (i=0; i<env->intdim+env->realdim; i++){
+    res = res*31 + (unsigned)ap_var_operations->hash(env->var_of_dim[i]);
+  }
+  return res | 1;
+}
+
+static void hashcons_resize(size_t size)
+{
+  size_t i,h;
+  ap_environment_t** p;
+  ap_environment_t* e;
+  ap_environment_t* next;
+
+  p = malloc(size*sizeof(ap_environment_t*));
+  for (i=0; i<size; i++) p[i] = NULL;
+  for (i=0; i<hashcons.size; i++){
+    for (e=hashcons.p[i]; e!=NULL; e=next){
+      next = e->next;
+      h = e->hash & (size-1);
+      e->next = p[h];
+      p[h] = e;
+    }
+  }
+  free(hashcons.p);
+  hashcons.p = p;
+  hashcons.size = size;
+}
+
+/* Remove env from the hash-consing table, if it is there */
+static void hashcons_remove(ap_environment_t* env)
+{
+  ap_environment_t** pe;
+  if (env->hash==0) return;
+  pe = &hashcons.p[env->hash & (hashcons.size-1)];
+  while (*pe!=NULL){
+    if (*pe==env){
+      *pe = env->next;
+      env->next = NULL;
+      env->hash = 0;
+      hashcons.nbenv--;
+      break;
+    }
+    pe = &(*pe)->next;
+  }
+  if (hashcons.nbenv==0 && !hashcons.enabled){
+    free(hashcons.p);
+    hashcons.p = NULL;
+    hashcons.size = 0;
+  }
+}
+
+/* To be called on each newly built and valid environment before returning
+   it: build its hash index, and if hash-consing is enabled, return instead
+   an equal environment already built, if any. */
+static ap_environment_t* environment_finalize(ap_environment_t* env)
+{
+  size_t h;
+  unsigned hash;
+  ap_environment_t* e;
+
+  if (!hashcons.enabled){
+    environment_index(env);
+    return env;
+  }
+  if (hashcons.size==0) hashcons_resize(256);
+  hash = environment_hash_full(env);
+  h = hash & (hashcons.size-1);
+  for (e=hashcons.p[h]; e!=NULL; e=e->next){
+    if (e->hash==hash && ap_environment_is_eq(e,env)){
+      ap_environment_free2(env);
+      return ap_environment_copy(e);
+    }
+  }
+  environment_index(env);
+  env->hash = hash;
+  env->next = hashcons.p[h];
+  hashcons.p[h] = env;
+  hashcons.nbenv++;
+  if (hashcons.nbenv>2*hashcons.size) hashcons_resize(2*hashcons.size);
+  return env;
+}
+
+void ap_environment_set_hashcons(bool b)
+{
+  size_t i;
+  hashcons.enabled = b;
+  if (!b){
+    for (i=0; i<AP_ENVIRONMENT_MEMO_SIZE; i++){
+      lce_memo_clear(&lce_memo[i]);
+      dimchange_memo_clear(&dimchange_memo[i]);
+    }
+    if (hashcons.nbenv==0 && hashcons.p){
+      free(hashcons.p);
+      hashcons.p = NULL;
+      hashcons.size = 0;
+    }
+  }
+}
+
 /* ========================================================================= */
 /* Access */
 /* ========================================================================= */
 ap_dim_t ap_environment_dim_of_var(ap_environment_t* env, ap_var_t name){
   ap_var_t* res;
+  if (env->dim_of_var){
+    size_t mask = env->dim_of_var_size-1;
+    size_t h = var_hash(name,mask);
+    ap_dim_t dim;
+    while ((dim=env->dim_of_var[h])!=AP_DIM_MAX){
+      if (ap_var_operations->compare(env->var_of_dim[dim],name)==0)
+	return dim;
+      h = (h+1) & mask;
+    }
+    return AP_DIM_MAX;
+  }
   res = bsearch(&name,env->var_of_dim,env->intdim,sizeof(ap_var_t),var_cmp);
   if (res!=NULL){
     return ((long int)res - (long int)env->var_of_dim)/sizeof(ap_var_t);
@@ -485,7 +708,7 @@ ap_environment_t* ap_environment_add(ap_environment_t* env,
     ap_environment_free(res);
     return NULL;
   }
-  return res;
+  return environment_finalize(res);
 }
 
 ap_environment_t* ap_environment_add_perm(ap_environment_t* env,
@@ -514,6 +737,9 @@ ap_environment_t* ap_environment_add_perm(ap_environment_t* env,
     ap_dimperm_clear(perm);
     res = NULL;
   }
+  else {
+    res = environment_finalize(res);
+  }
   return res;
 }
 
@@ -561,7 +787,7 @@ ap_environment_t* ap_environment_remove(ap_environment_t* env,
       denv2.envreal.size==UINT_MAX){
     res = NULL;
   } else {
-    res = environment_of_denv(&denv2);
+    res = environment_finalize(environment_of_denv(&denv2));
   }
   free(tvar2);
   return res;
@@ -570,7 +796,7 @@ ap_environment_t* ap_environment_remove(ap_environment_t* env,
 ap_environment_t* ap_environment_alloc(ap_var_t* name_of_intdim, size_t intdim,
 				       ap_var_t* name_of_realdim, size_t realdim)
 {
-  ap_environment_t env = { NULL, 0,0,0 };
+  ap_environment_t env = { NULL, 0,0,0, NULL,0, NULL,0 };
   return ap_environment_add(&env,
 			    name_of_intdim, intdim,
 			    name_of_realdim, realdim);
@@ -583,6 +809,11 @@ ap_environment_t* ap_environment_alloc_empty()
 void ap_environment_free2(ap_environment_t* env)
 {
   size_t i;
+  hashcons_remove(env);
+  if (env->dim_of_var){
+    free(env->dim_of_var); env->dim_of_var = NULL;
+    env->dim_of_var_size = 0;
+  }
   if (env->var_of_dim){
     for(i=0;i<env->intdim+env->realdim;i++){
       if(env->var_of_dim[i]){
@@ -637,7 +868,8 @@ bool ap_environment_is_eq(ap_environment_t* env1,
 			  ap_environment_t* env2)
 {
   bool res = (env1==env2);
-  if (!res){
+  /* Two distinct hash-consed environments are different */
+  if (!res && !(env1->hash && env2->hash)){
     res =
       (env1->intdim==env2->intdim) &&
       (env1->realdim==env2->realdim);
@@ -713,8 +945,8 @@ int ap_environment_hash(ap_environment_t* env)
 /* Compute least common environment of 2 environments */
 /* ========================================================================= */
 
-ap_dimchange_t* ap_environment_dimchange(ap_environment_t* env1,
-					 ap_environment_t* env)
+static ap_dimchange_t* environment_dimchange(ap_environment_t* env1,
+					     ap_environment_t* env)
 {
   bool b;
   ap_dimchange_t* dimchange;
@@ -738,6 +970,26 @@ ap_dimchange_t* ap_environment_dimchange(ap_environment_t* env1,
   return dimchange;
 }
 
+ap_dimchange_t* ap_environment_dimchange(ap_environment_t* env1,
+					 ap_environment_t* env)
+{
+  dimchange_memo_t* m;
+  ap_dimchange_t* dimchange;
+
+  if (!hashcons.enabled)
+    return environment_dimchange(env1,env);
+
+  m = &dimchange_memo[memo_index(env1,env)];
+  if (m->env1==env1 && m->env==env)
+    return dimchange_copy(m->dimchange);
+  dimchange = environment_dimchange(env1,env);
+  dimchange_memo_clear(m);
+  m->env1 = ap_environment_copy(env1);
+  m->env = ap_environment_copy(env);
+  m->dimchange = dimchange_copy(dimchange);
+  return dimchange;
+}
+
 /*
   Compute the transformation for switching from one environment to another one (adding and then removal of dimensions.
 
@@ -803,10 +1055,10 @@ ap_dimchange2_t* ap_environment_dimchange2(ap_environment_t* env1,
   - If no dimensions to add to env1, this implies that env is
     actually env1. In this case, *dimchange1==NULL.
 */
-ap_environment_t* ap_environment_lce(ap_environment_t* env1,
-				     ap_environment_t* env2,
-				     ap_dimchange_t** dimchange1,
-				     ap_dimchange_t** dimchange2)
+static ap_environment_t* environment_lce(ap_environment_t* env1,
+					 ap_environment_t* env2,
+					 ap_dimchange_t** dimchange1,
+					 ap_dimchange_t** dimchange2)
 {
   size_t size;
   denv_t denv;
@@ -863,8 +1115,41 @@ ap_environment_t* ap_environment_lce(ap_environment_t* env1,
     return ap_environment_copy(env2);
   }
   else {
-    return environment_of_denv(&denv);
+    return environment_finalize(environment_of_denv(&denv));
+  }
+}
+
+ap_environment_t* ap_environment_lce(ap_environment_t* env1,
+				     ap_environment_t* env2,
+				     ap_dimchange_t** dimchange1,
+				     ap_dimchange_t** dimchange2)
+{
+  lce_memo_t* m;
+  ap_environment_t* res;
+
+  if (ap_environment_is_eq(env1,env2)){
+    *dimchange1 = *dimchange2 = NULL;
+    return ap_environment_copy(env1);
+  }
+  if (!hashcons.enabled)
+    return environment_lce(env1,env2,dimchange1,dimchange2);
+
+  m = &lce_memo[memo_index(env1,env2)];
+  if (m->env1==env1 && m->env2==env2){
+    *dimchange1 = dimchange_copy(m->dimchange1);
+    *dimchange2 = dimchange_copy(m->dimchange2);
+    return ap_environment_copy(m->lce);
   }
+  res = environment_lce(env1,env2,dimchange1,dimchange2);
+  if (res){
+    lce_memo_clear(m);
+    m->env1 = ap_environment_copy(env1);
+    m->env2 = ap_environment_copy(env2);
+    m->lce = ap_environment_copy(res);
+    m->dimchange1 = dimchange_copy(*dimchange1);
+    m->dimchange2 = dimchange_copy(*dimchange2);
+  }
+  return res;
 }
 
 /* ========================================================================= */
@@ -998,6 +1283,9 @@ ap_environment_t* ap_environment_lce_array(ap_environment_t** tenv,
       ap_environment_free(env);
       env = NULL;
     }
+    else {
+      env = environment_finalize(env);
+    }
     return env;
   }
 }
@@ -1020,6 +1308,10 @@ ap_environment_t* ap_environment_rename(ap_environment_t* env,
   res->realdim = env->realdim;
   res->count = 1;
   res->var_of_dim = malloc(nbdims*sizeof(ap_var_t));
+  res->dim_of_var = NULL;
+  res->dim_of_var_size = 0;
+  res->next = NULL;
+  res->hash = 0;
 
   /* Build the new environment */
   for (i=0; i<nbdims; i++){
@@ -1052,5 +1344,8 @@ ap_environment_t* ap_environment_rename(ap_environment_t* env,
     ap_dimperm_clear(perm);
     res = NULL;
   }
+  else {
+    res = environment_finalize(res);
+  }
   return res;
 }
@@ -35,6 +35,9 @@ extern "C" {
    - environment_copy increments the counter and return its argument
    - environment_free decrements it and free the environment
      in case of zero or negative number.
+
+   The counter is updated atomically, so that an environment can be shared
+   by threads working on different abstract values.
 */
 
 typedef struct ap_environment_t {
@@ -52,6 +55,20 @@ typedef struct ap_environment_t {
   size_t intdim; /* Number of integer variables */
   size_t realdim;/* Number of real variables */
   size_t count; /* For reference counting */
+  ap_dim_t* dim_of_var;
+  /*
+    Hash index of var_of_dim, used by ap_environment_dim_of_var:
+    open addressing table of size dim_of_var_size (a power of 2), indexed
+    by ap_var_operations->hash, containing dimensions or AP_DIM_MAX for
+    empty slots. NULL (and dim_of_var_size==0) for small environments,
+    which are searched by dichotomy.
+  */
+  size_t dim_of_var_size;
+  struct ap_environment_t* next;
+  unsigned hash;
+  /* Private: if the environment belongs to the hash-consing table, next
+     environment in the same bucket and (non-zero) hash code; otherwise
+     NULL and 0 */
 } ap_environment_t;
 
 typedef struct ap_environment_name_of_dim_t {
@@ -83,6 +100,22 @@ void ap_environment_fdump(FILE* stream, ap_environment_t* env);
       ...
   */
 
+void ap_environment_set_hashcons(bool hashcons);
+  /* Enable or disable the hash-consing of environments (disabled by
+     default).
+
+     When enabled, the environments built by the functions of this module
+     are shared: two equal environments are physically equal, so that
+     ap_environment_is_eq reduces to a pointer comparison. Least common
+     environments and dimchange transformations between pairs of
+     environments are also memoized.
+
+     The hash-consing table and the memoization caches are global and not
+     protected against concurrent accesses, so enable it only if
+     environments are manipulated by a single thread.
+
+     Disabling the hash-consing releases the memoization caches. */
+
 ap_environment_name_of_dim_t* ap_environment_name_of_dim_alloc(ap_environment_t* e);
 void ap_environment_name_of_dim_free(ap_environment_name_of_dim_t*);
 
@@ -245,14 +278,13 @@ ap_var_t ap_environment_var_of_dim(ap_environment_t* env, ap_dim_t dim){
 }
 static inline
 void ap_environment_free(ap_environment_t* env){
-  if (env->count<=1)
+  if (__atomic_load_n(&env->count,__ATOMIC_ACQUIRE)<=1 ||
+      __atomic_sub_fetch(&env->count,1,__ATOMIC_ACQ_REL)==0)
     ap_environment_free2(env);
-  else
-    env->count--;
 }
 static inline
 ap_environment_t* ap_environment_copy(ap_environment_t* env){
-  env->count++;
+  __atomic_add_fetch(&env->count,1,__ATOMIC_RELAXED);
   return env;
 }
 #ifdef __cplusplus
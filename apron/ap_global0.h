@@ -19,6 +19,7 @@
 #include "ap_linexpr0.h"
 #include "ap_lincons0.h"
 #include "ap_generator0.h"
+#include "ap_packed.h"
 #include "ap_texpr0.h"
 #include "ap_tcons0.h"
 #include "ap_manager.h"
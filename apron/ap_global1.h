@@ -19,5 +19,6 @@
 #include "ap_lincons1.h"
 #include "ap_generator1.h"
 #include "ap_abstract1.h"
+#include "ap_checkpoint.h"
 
 #endif
@@ -37,6 +37,11 @@ void ap_interval_free(ap_interval_t* itv)
   ap_scalar_free(itv->sup);
   free(itv);
 }
+size_t ap_interval_memory_size(ap_interval_t* itv)
+{
+  return sizeof(ap_interval_t) +
+    ap_scalar_memory_size(itv->inf) + ap_scalar_memory_size(itv->sup);
+}
 void ap_interval_fprint(FILE* stream, ap_interval_t* a)
 {
   fprintf(stream,"[");
@@ -211,3 +216,12 @@ void ap_interval_array_free(ap_interval_t** array, size_t size)
   }
   free(array);
 }
+size_t ap_interval_array_memory_size(ap_interval_t** array, size_t size)
+{
+  size_t i;
+  size_t res = size*sizeof(ap_interval_t*);
+  for (i=0; i<size; i++){
+    res += ap_interval_memory_size(array[i]);
+  }
+  return res;
+}
@@ -36,6 +36,8 @@ void ap_interval_reinit(ap_interval_t* interval, ap_scalar_discr_t ap_scalar_dis
   /* Change the type of scalars */
 void ap_interval_free(ap_interval_t* interval);
   /* Free an interval */
+size_t ap_interval_memory_size(ap_interval_t* interval);
+  /* Number of bytes of heap memory used by an allocated interval */
 void ap_interval_fprint(FILE* stream, ap_interval_t* a);
 static inline 
 void ap_interval_print(ap_interval_t* a)
@@ -119,6 +121,8 @@ ap_interval_t** ap_interval_array_alloc(size_t size);
   /* Allocating an array of intervals, initialized with [0,0] values */
 void ap_interval_array_free(ap_interval_t** array, size_t size);
   /* Clearing and freeing an array of intervals */
+size_t ap_interval_array_memory_size(ap_interval_t** array, size_t size);
+  /* Number of bytes of heap memory used by an allocated array of intervals */
 
 #ifdef __cplusplus
 }
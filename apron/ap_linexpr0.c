@@ -175,6 +175,25 @@ void ap_linexpr0_free(ap_linexpr0_t* e)
   free(e);
 }
 
+size_t ap_linexpr0_memory_size(ap_linexpr0_t* e)
+{
+  size_t i;
+  size_t res = sizeof(ap_linexpr0_t) + ap_coeff_memory_size(&e->cst);
+  switch(e->discr){
+  case AP_LINEXPR_DENSE:
+    res += e->size*sizeof(ap_coeff_t);
+    for (i=0; i<e->size; i++)
+      res += ap_coeff_memory_size(&e->p.coeff[i]);
+    break;
+  case AP_LINEXPR_SPARSE:
+    res += e->size*sizeof(ap_linterm_t);
+    for (i=0; i<e->size; i++)
+      res += ap_coeff_memory_size(&e->p.linterm[i].coeff);
+    break;
+  }
+  return res;
+}
+
 void ap_linexpr0_print(ap_linexpr0_t* a, char** name_of_dim)
 { ap_linexpr0_fprint(stdout,a,name_of_dim); }
 void ap_linexpr0_fprint(FILE* stream, ap_linexpr0_t* a, char** name_of_dim)
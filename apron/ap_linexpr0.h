@@ -101,6 +101,9 @@ void ap_linexpr0_minimize(ap_linexpr0_t* e);
 void ap_linexpr0_free(ap_linexpr0_t* linexpr);
   /* Free the linear expression */
 
+size_t ap_linexpr0_memory_size(ap_linexpr0_t* linexpr);
+  /* Number of bytes of heap memory used by an allocated linear expression */
+
 ap_linexpr0_t* ap_linexpr0_copy(ap_linexpr0_t* a);
   /* Duplication */
 
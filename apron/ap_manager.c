@@ -12,8 +12,17 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <stdarg.h>
+#include <time.h>
+#include <pthread.h>
 #include "ap_manager.h"
 
+/* Profile of a manager (see VI.) */
+struct ap_profile_t {
+  ap_funprofile_t fun[AP_FUNID_SIZE];
+  char* path; /* file to which the profile is appended at deallocation */
+};
+
 const char* ap_name_of_funid[AP_FUNID_SIZE2] = {
   "unknown",
   "copy",
@@ -66,6 +75,8 @@ const char* ap_name_of_funid[AP_FUNID_SIZE2] = {
   "fold",
   "widening",
   "closure",
+  "memory_size",
+  "deserialize_mapped",
   "unknown",
   "change_environment",
   "rename"
@@ -168,23 +179,39 @@ ap_manager_t* ap_manager_alloc(const char* library, const char* version,
   assert(sizeof(bool)==1);
 
   man = (ap_manager_t*)malloc(sizeof(ap_manager_t));
+  memset(man->funptr,0,sizeof(man->funptr));
   man->library = library;
   man->version = version;
   man->internal = internal;
   man->internal_free = internal_free;
   man->count = 1;
+  man->profile = NULL;
   ap_option_init(&man->option);
   ap_result_init(&man->result);
   man->threadsinitialised = false;
+  {
+    const char* path = getenv("APRON_PROFILE");
+    if (path && *path) ap_manager_profile_enable(man,path);
+  }
   return man;
 }
 void ap_manager_free(ap_manager_t* man)
 {
   assert(man->count>=1);
-  if (man->count>1){
-    man->count--;
-  }
-  else {
+  if (__atomic_load_n(&man->count,__ATOMIC_ACQUIRE)<=1 ||
+      __atomic_sub_fetch(&man->count,1,__ATOMIC_ACQ_REL)==0){
+    if (man->profile){
+      if (man->profile->path){
+	FILE* stream = fopen(man->profile->path,"a");
+	if (stream){
+	  char* str = ap_manager_profile_sprint_json(man);
+	  fprintf(stream,"%s\n",str);
+	  free(str);
+	  fclose(stream);
+	}
+      }
+      ap_manager_profile_disable(man);
+    }
     if (man->internal != NULL){
       man->internal_free(man->internal);
       man->internal = NULL;
@@ -218,6 +245,10 @@ ap_funopt_t ap_manager_get_funopt(ap_manager_t* man, ap_funid_t funid)
 }
 bool ap_manager_get_abort_if_exception(ap_manager_t* man, ap_exc_t exn)
 { return man->option.abort_if_exception[exn]; }
+ap_exc_t ap_manager_get_exception(ap_manager_t* man)
+{ return man->result.exn; }
+ap_exclog_t* ap_manager_get_exclog(ap_manager_t* man)
+{ return man->result.exclog; }
 bool ap_manager_get_flag_exact(ap_manager_t* man)
 { return man->result.flag_exact; }
 bool ap_manager_get_flag_best(ap_manager_t* man)
@@ -323,3 +354,269 @@ bool ap_fpu_init(void)
 }
 
 #endif
+
+/* ********************************************************************** */
+/* VI. Profiling */
+/* ********************************************************************** */
+
+void ap_manager_profile_enable(ap_manager_t* man, const char* path)
+{
+  ap_manager_profile_disable(man);
+  man->profile = (ap_profile_t*)calloc(1,sizeof(ap_profile_t));
+  man->profile->path = path ? strdup(path) : NULL;
+}
+
+void ap_manager_profile_disable(ap_manager_t* man)
+{
+  if (man->profile){
+    free(man->profile->path);
+    free(man->profile);
+    man->profile = NULL;
+  }
+}
+
+const ap_funprofile_t* ap_manager_profile_get(ap_manager_t* man, ap_funid_t funid)
+{
+  if (man->profile==NULL || funid>=AP_FUNID_SIZE)
+    return NULL;
+  return &man->profile->fun[funid];
+}
+
+double ap_manager_profile_clock(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC,&ts);
+  return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
+}
+
+static size_t ap_manager_profile_bucket(size_t dim)
+{
+  size_t k = 0;
+  while (dim>0 && k<AP_PROFILE_NBUCKETS-1){
+    dim >>= 1;
+    k++;
+  }
+  return k;
+}
+
+void ap_manager_profile_record(ap_manager_t* man, ap_funid_t funid,
+			       double time, size_t dimin, size_t dimout)
+{
+  ap_funprofile_t* f;
+
+  if (funid>=AP_FUNID_SIZE) return;
+  f = &man->profile->fun[funid];
+  f->ncalls++;
+  f->time += time;
+  if (time>f->time_max) f->time_max = time;
+  if (man->result.flag_exact) f->nexact++;
+  if (man->result.flag_best) f->nbest++;
+  if (dimin!=(size_t)-1) f->dimin[ap_manager_profile_bucket(dimin)]++;
+  if (dimout!=(size_t)-1) f->dimout[ap_manager_profile_bucket(dimout)]++;
+}
+
+/* Growing string buffer */
+typedef struct ap_manager_profile_buf_t {
+  char* p;
+  size_t size;
+  size_t alloc;
+} ap_manager_profile_buf_t;
+
+static void ap_manager_profile_printf(ap_manager_profile_buf_t* buf, const char* fmt, ...)
+{
+  va_list ap;
+  int n;
+
+  va_start(ap,fmt);
+  n = vsnprintf(buf->p+buf->size,buf->alloc-buf->size,fmt,ap);
+  va_end(ap);
+  if (buf->size+n>=buf->alloc){
+    buf->alloc = 2*(buf->size+n+1);
+    buf->p = (char*)realloc(buf->p,buf->alloc);
+    va_start(ap,fmt);
+    vsnprintf(buf->p+buf->size,buf->alloc-buf->size,fmt,ap);
+    va_end(ap);
+  }
+  buf->size += n;
+}
+
+static void ap_manager_profile_histo(ap_manager_profile_buf_t* buf,
+				     const char* name, unsigned long* tab)
+{
+  int size, k;
+
+  for (size=AP_PROFILE_NBUCKETS; size>0 && tab[size-1]==0; size--);
+  ap_manager_profile_printf(buf,",\"%s\":[",name);
+  for (k=0; k<size; k++){
+    ap_manager_profile_printf(buf,"%s%lu",k ? "," : "",tab[k]);
+  }
+  ap_manager_profile_printf(buf,"]");
+}
+
+char* ap_manager_profile_sprint_json(ap_manager_t* man)
+{
+  ap_manager_profile_buf_t buf;
+  ap_funid_t funid;
+  bool first = true;
+
+  buf.alloc = 1024;
+  buf.size = 0;
+  buf.p = (char*)malloc(buf.alloc);
+  buf.p[0] = 0;
+  ap_manager_profile_printf(&buf,"{\"library\":\"%s\",\"version\":\"%s\",\"functions\":{",
+			    man->library,man->version);
+  if (man->profile){
+    for (funid=0; funid<AP_FUNID_SIZE; funid++){
+      ap_funprofile_t* f = &man->profile->fun[funid];
+      if (f->ncalls==0) continue;
+      ap_manager_profile_printf(&buf,"%s\"%s\":{\"calls\":%lu,\"time\":%.9g,\"time_max\":%.9g,\"exact\":%lu,\"best\":%lu",
+				first ? "" : ",",
+				ap_name_of_funid[funid],
+				f->ncalls,f->time,f->time_max,f->nexact,f->nbest);
+      ap_manager_profile_histo(&buf,"dim_in",f->dimin);
+      ap_manager_profile_histo(&buf,"dim_out",f->dimout);
+      ap_manager_profile_printf(&buf,"}");
+      first = false;
+    }
+  }
+  ap_manager_profile_printf(&buf,"}}");
+  return buf.p;
+}
+
+void ap_manager_profile_fprint_json(FILE* stream, ap_manager_t* man)
+{
+  char* str = ap_manager_profile_sprint_json(man);
+  fputs(str,stream);
+  free(str);
+}
+
+/* ====================================================================== */
+/* Deadlines */
+/* ====================================================================== */
+
+void ap_deadline_init(ap_deadline_t* deadline, ap_funopt_t* funopt)
+{
+  deadline->budget = AP_DEADLINE_PERIOD;
+  deadline->end = funopt->timeout ?
+    ap_manager_profile_clock() + 1e-3*(double)funopt->timeout : 0.0;
+}
+
+bool ap_deadline_check(ap_deadline_t* deadline)
+{
+  deadline->budget = AP_DEADLINE_PERIOD;
+  if (ap_manager_profile_clock()>=deadline->end){
+    deadline->end = -1.0;
+    return true;
+  }
+  return false;
+}
+
+/* ********************************************************************** */
+/* VII. Manager pools */
+/* ********************************************************************** */
+
+typedef struct ap_manager_pool_node_t {
+  ap_manager_t* man;
+  ap_manager_pool_t* pool;
+  bool busy;           /* owned by a thread */
+  struct ap_manager_pool_node_t* next;
+} ap_manager_pool_node_t;
+
+struct ap_manager_pool_t {
+  ap_manager_t* man;   /* prototype */
+  ap_manager_t* (*alloc)(void*);
+  void* arg;
+  pthread_key_t key;   /* node of the calling thread */
+  pthread_mutex_t mutex;
+  ap_manager_pool_node_t* nodes;
+  size_t size;
+};
+
+static void ap_manager_pool_node_release(void* p)
+{
+  ap_manager_pool_node_t* node = (ap_manager_pool_node_t*)p;
+  ap_result_clear(&node->man->result);
+  pthread_mutex_lock(&node->pool->mutex);
+  node->busy = false;
+  pthread_mutex_unlock(&node->pool->mutex);
+}
+
+ap_manager_pool_t* ap_manager_pool_alloc(ap_manager_t* man,
+					 ap_manager_t* (*alloc)(void*),
+					 void* arg)
+{
+  ap_manager_pool_t* pool = (ap_manager_pool_t*)malloc(sizeof(ap_manager_pool_t));
+  pool->man = ap_manager_copy(man);
+  pool->alloc = alloc;
+  pool->arg = arg;
+  pthread_key_create(&pool->key,ap_manager_pool_node_release);
+  pthread_mutex_init(&pool->mutex,NULL);
+  pool->nodes = NULL;
+  pool->size = 0;
+  return pool;
+}
+
+void ap_manager_pool_free(ap_manager_pool_t* pool)
+{
+  ap_manager_pool_node_t* node = pool->nodes;
+  while (node!=NULL){
+    ap_manager_pool_node_t* next = node->next;
+    ap_manager_free(node->man);
+    free(node);
+    node = next;
+  }
+  pthread_key_delete(pool->key);
+  pthread_mutex_destroy(&pool->mutex);
+  ap_manager_free(pool->man);
+  free(pool);
+}
+
+ap_manager_t* ap_manager_pool_get(ap_manager_pool_t* pool)
+{
+  ap_manager_pool_node_t* node;
+
+  node = (ap_manager_pool_node_t*)pthread_getspecific(pool->key);
+  if (node) return node->man;
+
+  pthread_mutex_lock(&pool->mutex);
+  for (node=pool->nodes; node!=NULL && node->busy; node=node->next);
+  if (node==NULL){
+    ap_manager_t* man = pool->alloc(pool->arg);
+    assert(man->library==pool->man->library);
+    man->option = pool->man->option;
+    if (pool->man->profile && man->profile==NULL)
+      ap_manager_profile_enable(man,pool->man->profile->path);
+    node = (ap_manager_pool_node_t*)malloc(sizeof(ap_manager_pool_node_t));
+    node->man = man;
+    node->pool = pool;
+    node->next = pool->nodes;
+    pool->nodes = node;
+    pool->size++;
+  }
+  node->busy = true;
+  pthread_mutex_unlock(&pool->mutex);
+
+  pthread_setspecific(pool->key,node);
+  ap_fpu_init();
+  return node->man;
+}
+
+void ap_manager_pool_release(ap_manager_pool_t* pool)
+{
+  ap_manager_pool_node_t* node;
+
+  node = (ap_manager_pool_node_t*)pthread_getspecific(pool->key);
+  if (node){
+    pthread_setspecific(pool->key,NULL);
+    ap_manager_pool_node_release(node);
+  }
+}
+
+size_t ap_manager_pool_size(ap_manager_pool_t* pool)
+{
+  size_t size;
+  pthread_mutex_lock(&pool->mutex);
+  size = pool->size;
+  pthread_mutex_unlock(&pool->mutex);
+  return size;
+}
@@ -104,6 +104,8 @@ typedef enum ap_funid_t {
   AP_FUNID_FOLD,
   AP_FUNID_WIDENING,
   AP_FUNID_CLOSURE,
+  AP_FUNID_MEMORY_SIZE,
+  AP_FUNID_DESERIALIZE_MAPPED,
   AP_FUNID_SIZE,
   AP_FUNID_CHANGE_ENVIRONMENT,
   AP_FUNID_RENAME_ARRAY,
@@ -161,9 +163,9 @@ typedef struct ap_funopt_t {
      - MIN_INT is most efficient available;
      - otherwise, no accuracy or speed meaning
   */
-  size_t timeout; /* unit !? */
+  size_t timeout; /* in milliseconds, 0 for no limit */
   /* Above the given computation time, the function may abort with the
-     exception flag flag_time_out on.
+     exception AP_EXC_TIMEOUT, and return a correct but coarser result.
   */
   size_t max_object_size; /* in abstract object size unit. */
   /* If during the computation, the size of some object reach this limit, the
@@ -184,8 +186,42 @@ typedef struct ap_option_t {
   ap_scalar_discr_t scalar_discr; /* Preferred type for scalars */
 } ap_option_t;
 
+/* Deadline of a function, armed from its timeout option (public type,
+   used by implementors) */
+typedef struct ap_deadline_t {
+  double end;  /* 0 if there is no timeout, <0 once expired, otherwise in
+		  the time base of ap_manager_profile_clock */
+  long budget; /* work left before the clock is read again */
+} ap_deadline_t;
+
+#define AP_DEADLINE_PERIOD 65536
+
+/* ====================================================================== */
+/* I.3 Profiling */
+/* ====================================================================== */
+
+#define AP_PROFILE_NBUCKETS 16
+
+/* Statistics of a function (public type) */
+typedef struct ap_funprofile_t {
+  unsigned long ncalls;
+  double time;              /* cumulated wall-clock time, in seconds */
+  double time_max;          /* longest call */
+  unsigned long nexact;     /* calls returning with flag_exact */
+  unsigned long nbest;      /* calls returning with flag_best */
+  unsigned long dimin[AP_PROFILE_NBUCKETS];
+  unsigned long dimout[AP_PROFILE_NBUCKETS];
+  /* Histograms of the dimensions (intdim+realdim) of the first abstract
+     argument and of the abstract result, if any:
+     bucket 0 counts dimension 0, bucket 0<k<AP_PROFILE_NBUCKETS-1 counts
+     dimensions in [2^(k-1),2^k[, and the last bucket the larger ones. */
+} ap_funprofile_t;
+
+/* Profile of a manager (opaque type, read with ap_manager_profile_get) */
+typedef struct ap_profile_t ap_profile_t;
+
 /* ====================================================================== */
-/* I.3 Manager */
+/* I.4 Manager */
 /* ====================================================================== */
 
 /* Manager (opaque type) */
@@ -200,7 +236,8 @@ typedef struct ap_manager_t {
   ap_option_t option;            /* Options (in) */
   ap_result_t result;            /* Exceptions and other indications (out) */
   void (*internal_free)(void*);  /* deallocation function for internal */
-  size_t count;                  /* reference counter */
+  size_t count;                  /* reference counter (updated atomically) */
+  ap_profile_t* profile;         /* NULL if profiling is disabled */
 
   void (*internal_halt_threads)(void**); // halt internal threads for octagon
   bool threadsinitialised;
@@ -239,6 +276,76 @@ void ap_manager_set_abort_if_exception(ap_manager_t* man, ap_exc_t exn, bool fla
 bool ap_fpu_init(void);
 /* tries to set the FPU rounding-mode towards +oo, returns true if successful */
 
+/* Profiling */
+
+/* The generic functions of ap_abstract0.h record, for each function of a
+   manager with profiling enabled, the number of calls, their wall-clock
+   time, the dimensions of their arguments and results, and their
+   exactness flags. When profiling is disabled, the cost is one test per
+   call.
+
+   Profiling is enabled at allocation for all managers if the environment
+   variable APRON_PROFILE is set to a path: the profile of each manager is
+   appended to this file in JSON when the manager is freed. */
+
+void ap_manager_profile_enable(ap_manager_t* man, const char* path);
+  /* Enable profiling, and reset the statistics if it was already enabled.
+     If path is not NULL, the profile is appended to this file (one JSON
+     object per line) when the manager is freed. */
+void ap_manager_profile_disable(ap_manager_t* man);
+  /* Disable profiling and free the statistics */
+const ap_funprofile_t* ap_manager_profile_get(ap_manager_t* man, ap_funid_t funid);
+  /* Statistics of the function, or NULL if profiling is disabled */
+char* ap_manager_profile_sprint_json(ap_manager_t* man);
+void ap_manager_profile_fprint_json(FILE* stream, ap_manager_t* man);
+  /* Print the profile as a JSON object
+     {"library":...,"version":...,"functions":{"meet":{...},...}}
+     listing the functions called at least once, with the fields
+     calls, time, time_max, exact, best, dim_in and dim_out (histograms,
+     without trailing zero buckets).
+     The string is allocated with malloc. */
+
+/* Manager pools */
+
+/* The internal field of a manager is a working space, which cannot be used
+   by two threads at the same time, but abstract values do not depend on
+   it: a value created with one manager can be used with any other manager
+   of the same library. A pool hands out one manager per thread, all of
+   them with the options of a prototype manager.
+
+   Two threads should still not operate on the same abstract value at the
+   same time, as some libraries update their arguments in place (for
+   instance to cache a closure). */
+
+typedef struct ap_manager_pool_t ap_manager_pool_t; /* opaque type */
+
+ap_manager_pool_t* ap_manager_pool_alloc(ap_manager_t* man,
+					 ap_manager_t* (*alloc)(void*),
+					 void* arg);
+  /* Create a pool of managers of the library of man.
+     alloc(arg) should return a fresh manager of this library, for instance
+     a wrapper around oct_manager_alloc() or pk_manager_alloc(strict).
+     man is referenced by the pool; its options are copied into each
+     manager of the pool when the latter is allocated, and should not be
+     changed afterwards. Profiling is enabled in the managers of the pool
+     if it is enabled in man, with the same output file. */
+void ap_manager_pool_free(ap_manager_pool_t* pool);
+  /* Free the pool and dereference its managers.
+     No thread should still be using one of them. */
+
+ap_manager_t* ap_manager_pool_get(ap_manager_pool_t* pool);
+  /* Return the manager of the calling thread, which is allocated (or
+     reused from a thread that released its own) on the first call of the
+     thread; this call also sets the FPU rounding mode of the thread
+     (see ap_fpu_init).
+     The manager belongs to the pool: use ap_manager_copy to keep it. */
+void ap_manager_pool_release(ap_manager_pool_t* pool);
+  /* Give back the manager of the calling thread to the pool, so that
+     another thread may reuse it. This is done automatically when the
+     thread exits. */
+size_t ap_manager_pool_size(ap_manager_pool_t* pool);
+  /* Number of managers allocated by the pool */
+
 
 /* ********************************************************************** */
 /* III. Implementor Functions */
@@ -261,6 +368,28 @@ ap_exclog_t* ap_exc_cons(ap_exc_t exn,
 			 ap_exclog_t* tail);
 void ap_exclog_free(ap_exclog_t* head);
 
+double ap_manager_profile_clock(void);
+  /* Wall-clock time in seconds, from an arbitrary origin */
+void ap_manager_profile_record(ap_manager_t* man, ap_funid_t funid,
+			       double time, size_t dimin, size_t dimout);
+  /* Record a call of funid (man->profile should not be NULL), taking its
+     exactness from man->result. dimin (resp. dimout) is (size_t)-1 if the
+     function has no abstract argument (resp. result). */
+
+void ap_deadline_init(ap_deadline_t* deadline, ap_funopt_t* funopt);
+  /* Arm deadline so that it expires funopt->timeout milliseconds from now,
+     or never if the timeout is 0 */
+static inline
+bool ap_deadline_expired(ap_deadline_t* deadline, size_t work);
+  /* Cooperative check, meant for the inner loops of long algorithms, which
+     should then stop and return a correct approximation.
+     work is an estimate of the number of elementary operations done since
+     the last check: the clock is only read every AP_DEADLINE_PERIOD units
+     of work. Once expired, the deadline remains so until it is armed
+     again. */
+bool ap_deadline_check(ap_deadline_t* deadline);
+  /* Read the clock, used by ap_deadline_expired */
+
 /* ********************************************************************** */
 /* IV. Definition of previously declared inline functions */
 /* ********************************************************************** */
@@ -291,7 +420,14 @@ static inline tbool_t tbool_not(tbool_t a)
 }
 static inline
 ap_manager_t* ap_manager_copy(ap_manager_t* man)
-{ man->count++; return man; }
+{ __atomic_add_fetch(&man->count,1,__ATOMIC_RELAXED); return man; }
+static inline
+bool ap_deadline_expired(ap_deadline_t* deadline, size_t work)
+{
+  if (deadline->end<=0.0) return deadline->end<0.0;
+  deadline->budget -= (long)work;
+  return deadline->budget<=0 && ap_deadline_check(deadline);
+}
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,537 @@
+/* ************************************************************************* */
+/* ap_packed.c: packed arrays of constraints and generators */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#include <stdint.h>
+#include <string.h>
+#include "ap_packed.h"
+
+/* ********************************************************************** */
+/* I. Writing */
+/* ********************************************************************** */
+
+/* If p is NULL, only counts the bytes */
+typedef struct writer_t {
+  unsigned char* p;
+  size_t pos;
+  size_t size;
+  bool overflow;
+} writer_t;
+
+static void put(writer_t* w, const void* src, size_t n)
+{
+  if (w->p){
+    if (w->overflow || w->pos+n > w->size){
+      w->overflow = true;
+      return;
+    }
+    memcpy(w->p+w->pos,src,n);
+  }
+  w->pos += n;
+}
+static void put_u8(writer_t* w, uint8_t x)
+{ put(w,&x,sizeof(x)); }
+static void put_i32(writer_t* w, int32_t x)
+{ put(w,&x,sizeof(x)); }
+static void put_u32(writer_t* w, uint32_t x)
+{ put(w,&x,sizeof(x)); }
+static void put_i64(writer_t* w, int64_t x)
+{ put(w,&x,sizeof(x)); }
+static void put_u64(writer_t* w, uint64_t x)
+{ put(w,&x,sizeof(x)); }
+
+static void put_mpz(writer_t* w, mpz_t z)
+{
+  size_t nbytes = mpz_sgn(z)==0 ? 0 : (mpz_sizeinbase(z,2)+7)/8;
+  put_u8(w, mpz_sgn(z)<0);
+  put_u32(w, (uint32_t)nbytes);
+  if (w->p){
+    if (w->overflow || w->pos+nbytes > w->size){
+      w->overflow = true;
+      return;
+    }
+    size_t count;
+    mpz_export(w->p+w->pos,&count,-1,1,0,0,z);
+  }
+  w->pos += nbytes;
+}
+
+static void put_scalar(writer_t* w, ap_scalar_t* scalar)
+{
+  switch(scalar->discr){
+  case AP_SCALAR_DOUBLE:
+    put_u8(w,AP_PACKED_DOUBLE);
+    put(w,&scalar->val.dbl,sizeof(double));
+    break;
+  case AP_SCALAR_MPQ:
+    if (mpz_fits_slong_p(mpq_numref(scalar->val.mpq)) &&
+	mpz_fits_slong_p(mpq_denref(scalar->val.mpq))){
+      put_u8(w,AP_PACKED_MPQ);
+      put_i64(w,mpz_get_si(mpq_numref(scalar->val.mpq)));
+      put_i64(w,mpz_get_si(mpq_denref(scalar->val.mpq)));
+    }
+    else {
+      put_u8(w,AP_PACKED_BIGMPQ);
+      put_mpz(w,mpq_numref(scalar->val.mpq));
+      put_mpz(w,mpq_denref(scalar->val.mpq));
+    }
+    break;
+  case AP_SCALAR_MPFR:
+    if (mpfr_number_p(scalar->val.mpfr)){
+      mpz_t mant;
+      mpfr_exp_t e;
+      mpz_init(mant);
+      e = mpfr_zero_p(scalar->val.mpfr) ? 0 : mpfr_get_z_2exp(mant,scalar->val.mpfr);
+      put_u8(w,AP_PACKED_MPFR);
+      put_u64(w,mpfr_get_prec(scalar->val.mpfr));
+      put_i64(w,e);
+      put_mpz(w,mant);
+      mpz_clear(mant);
+    }
+    else {
+      put_u8(w,AP_PACKED_MPFR_INF);
+      put_u64(w,mpfr_get_prec(scalar->val.mpfr));
+      put_u8(w,(uint8_t)(int8_t)(mpfr_nan_p(scalar->val.mpfr) ? 0 : mpfr_sgn(scalar->val.mpfr)));
+    }
+    break;
+  default:
+    abort();
+  }
+}
+
+static void put_coeff(writer_t* w, ap_coeff_t* coeff)
+{
+  put_u8(w,coeff->discr);
+  switch(coeff->discr){
+  case AP_COEFF_SCALAR:
+    put_scalar(w,coeff->val.scalar);
+    break;
+  case AP_COEFF_INTERVAL:
+    put_scalar(w,coeff->val.interval->inf);
+    put_scalar(w,coeff->val.interval->sup);
+    break;
+  default:
+    abort();
+  }
+}
+
+static void put_linexpr0(writer_t* w, ap_linexpr0_t* e)
+{
+  size_t i,nbterms;
+  ap_dim_t dim;
+  ap_coeff_t* coeff;
+
+  nbterms = 0;
+  ap_linexpr0_ForeachLinterm(e,i,dim,coeff){
+    if (e->discr==AP_LINEXPR_SPARSE || !ap_coeff_zero(coeff)) nbterms++;
+  }
+  put_u32(w,(uint32_t)nbterms);
+  put_coeff(w,&e->cst);
+  ap_linexpr0_ForeachLinterm(e,i,dim,coeff){
+    if (e->discr==AP_LINEXPR_SPARSE || !ap_coeff_zero(coeff)){
+      put_u32(w,dim);
+      put_coeff(w,coeff);
+    }
+  }
+}
+
+static void put_header(writer_t* w, uint32_t magic, size_t size)
+{
+  size_t i;
+  put_u32(w,magic);
+  put_u32(w,AP_PACKED_VERSION);
+  put_u64(w,size);
+  for (i=0; i<size; i++) put_u64(w,0);
+}
+/* Fill the offset of the element i with the current position */
+static void put_offset(writer_t* w, size_t i)
+{
+  uint64_t offset = w->pos;
+  if (w->p && !w->overflow)
+    memcpy(w->p+16+i*sizeof(uint64_t),&offset,sizeof(uint64_t));
+}
+
+static void put_lincons0_array(writer_t* w, ap_lincons0_array_t* array)
+{
+  size_t i;
+  put_header(w,AP_PACKED_LINCONS0,array->size);
+  for (i=0; i<array->size; i++){
+    ap_lincons0_t* cons = &array->p[i];
+    put_offset(w,i);
+    put_i32(w,cons->constyp);
+    put_linexpr0(w,cons->linexpr0);
+    put_u8(w,cons->scalar!=NULL);
+    if (cons->scalar) put_scalar(w,cons->scalar);
+  }
+}
+static void put_generator0_array(writer_t* w, ap_generator0_array_t* array)
+{
+  size_t i;
+  put_header(w,AP_PACKED_GENERATOR0,array->size);
+  for (i=0; i<array->size; i++){
+    put_offset(w,i);
+    put_i32(w,array->p[i].gentyp);
+    put_linexpr0(w,array->p[i].linexpr0);
+  }
+}
+
+/* ====================================================================== */
+/* Interface */
+/* ====================================================================== */
+
+size_t ap_lincons0_array_packed_size(ap_lincons0_array_t* array)
+{
+  writer_t w = { NULL, 0, 0, false };
+  put_lincons0_array(&w,array);
+  return w.pos;
+}
+size_t ap_generator0_array_packed_size(ap_generator0_array_t* array)
+{
+  writer_t w = { NULL, 0, 0, false };
+  put_generator0_array(&w,array);
+  return w.pos;
+}
+
+size_t ap_lincons0_array_pack_into(void* buf, size_t size,
+				   ap_lincons0_array_t* array)
+{
+  writer_t w = { (unsigned char*)buf, 0, size, false };
+  put_lincons0_array(&w,array);
+  return w.overflow ? 0 : w.pos;
+}
+size_t ap_generator0_array_pack_into(void* buf, size_t size,
+				     ap_generator0_array_t* array)
+{
+  writer_t w = { (unsigned char*)buf, 0, size, false };
+  put_generator0_array(&w,array);
+  return w.overflow ? 0 : w.pos;
+}
+
+void* ap_lincons0_array_pack(ap_lincons0_array_t* array, size_t* psize)
+{
+  size_t size = ap_lincons0_array_packed_size(array);
+  void* buf = malloc(size);
+  *psize = ap_lincons0_array_pack_into(buf,size,array);
+  return buf;
+}
+void* ap_generator0_array_pack(ap_generator0_array_t* array, size_t* psize)
+{
+  size_t size = ap_generator0_array_packed_size(array);
+  void* buf = malloc(size);
+  *psize = ap_generator0_array_pack_into(buf,size,array);
+  return buf;
+}
+
+/* ********************************************************************** */
+/* II. Reading */
+/* ********************************************************************** */
+
+typedef struct reader_t {
+  const unsigned char* p;
+  size_t pos;
+  size_t size;
+  bool ok;
+} reader_t;
+
+static void get(reader_t* r, void* dst, size_t n)
+{
+  if (!r->ok || n > r->size - r->pos){
+    r->ok = false;
+    memset(dst,0,n);
+    return;
+  }
+  memcpy(dst,r->p+r->pos,n);
+  r->pos += n;
+}
+static uint8_t get_u8(reader_t* r)
+{ uint8_t x; get(r,&x,sizeof(x)); return x; }
+static int32_t get_i32(reader_t* r)
+{ int32_t x; get(r,&x,sizeof(x)); return x; }
+static uint32_t get_u32(reader_t* r)
+{ uint32_t x; get(r,&x,sizeof(x)); return x; }
+static int64_t get_i64(reader_t* r)
+{ int64_t x; get(r,&x,sizeof(x)); return x; }
+static uint64_t get_u64(reader_t* r)
+{ uint64_t x; get(r,&x,sizeof(x)); return x; }
+
+static void get_mpz(reader_t* r, mpz_t z)
+{
+  uint8_t neg = get_u8(r);
+  uint32_t nbytes = get_u32(r);
+  if (!r->ok || nbytes > r->size - r->pos){
+    r->ok = false;
+    mpz_set_ui(z,0);
+    return;
+  }
+  mpz_import(z,nbytes,-1,1,0,0,r->p+r->pos);
+  if (neg) mpz_neg(z,z);
+  r->pos += nbytes;
+}
+
+/* Check the denominator of a rational, which is positive or, for the
+   infinities +-1/0, zero, and canonicalize it */
+static void check_mpq(reader_t* r, mpq_t q)
+{
+  int sgn = mpz_sgn(mpq_denref(q));
+  if (sgn==0 && mpz_cmpabs_ui(mpq_numref(q),1)==0)
+    return;
+  if (sgn<=0){
+    r->ok = false;
+    mpq_set_si(q,0,1);
+    return;
+  }
+  mpq_canonicalize(q);
+}
+/* Check a precision read from the buffer before allocating it */
+static bool check_prec(reader_t* r, uint64_t prec)
+{
+  if (!r->ok || prec<(uint64_t)MPFR_PREC_MIN ||
+      prec>(uint64_t)AP_PACKED_MPFR_PREC_MAX || prec>(uint64_t)MPFR_PREC_MAX){
+    r->ok = false;
+    return false;
+  }
+  return true;
+}
+
+static void get_scalar(reader_t* r, ap_scalar_t* scalar)
+{
+  uint8_t tag = get_u8(r);
+  switch(tag){
+  case AP_PACKED_DOUBLE:
+    ap_scalar_reinit(scalar,AP_SCALAR_DOUBLE);
+    get(r,&scalar->val.dbl,sizeof(double));
+    break;
+  case AP_PACKED_MPQ:
+    ap_scalar_reinit(scalar,AP_SCALAR_MPQ);
+    mpz_set_si(mpq_numref(scalar->val.mpq),(long)get_i64(r));
+    mpz_set_si(mpq_denref(scalar->val.mpq),(long)get_i64(r));
+    check_mpq(r,scalar->val.mpq);
+    break;
+  case AP_PACKED_BIGMPQ:
+    ap_scalar_reinit(scalar,AP_SCALAR_MPQ);
+    get_mpz(r,mpq_numref(scalar->val.mpq));
+    get_mpz(r,mpq_denref(scalar->val.mpq));
+    check_mpq(r,scalar->val.mpq);
+    break;
+  case AP_PACKED_MPFR:
+    {
+      mpz_t mant;
+      uint64_t prec;
+      int64_t e;
+      ap_scalar_reinit(scalar,AP_SCALAR_MPFR);
+      prec = get_u64(r);
+      e = get_i64(r);
+      mpz_init(mant);
+      get_mpz(r,mant);
+      /* the mantissa of a non-zero value has exactly prec bits, so that
+	 prec is bounded by the size of the buffer */
+      if (check_prec(r,prec) &&
+	  (mpz_sgn(mant)==0 || mpz_sizeinbase(mant,2)==prec)){
+	mpfr_set_prec(scalar->val.mpfr,(mpfr_prec_t)prec);
+	mpfr_set_z(scalar->val.mpfr,mant,GMP_RNDU);
+	mpfr_mul_2si(scalar->val.mpfr,scalar->val.mpfr,(long)e,GMP_RNDU);
+      }
+      else
+	r->ok = false;
+      mpz_clear(mant);
+    }
+    break;
+  case AP_PACKED_MPFR_INF:
+    {
+      uint64_t prec;
+      int8_t sgn;
+      ap_scalar_reinit(scalar,AP_SCALAR_MPFR);
+      prec = get_u64(r);
+      sgn = (int8_t)get_u8(r);
+      if (check_prec(r,prec)){
+	mpfr_set_prec(scalar->val.mpfr,(mpfr_prec_t)prec);
+	if (sgn) mpfr_set_inf(scalar->val.mpfr,sgn);
+	else mpfr_set_nan(scalar->val.mpfr);
+      }
+    }
+    break;
+  default:
+    r->ok = false;
+    break;
+  }
+}
+
+static void get_coeff(reader_t* r, ap_coeff_t* coeff)
+{
+  uint8_t discr = get_u8(r);
+  switch(discr){
+  case AP_COEFF_SCALAR:
+    ap_coeff_reinit(coeff,AP_COEFF_SCALAR,AP_SCALAR_DOUBLE);
+    get_scalar(r,coeff->val.scalar);
+    break;
+  case AP_COEFF_INTERVAL:
+    ap_coeff_reinit(coeff,AP_COEFF_INTERVAL,AP_SCALAR_DOUBLE);
+    get_scalar(r,coeff->val.interval->inf);
+    get_scalar(r,coeff->val.interval->sup);
+    break;
+  default:
+    r->ok = false;
+    break;
+  }
+}
+
+/* Return NULL if not well-formed, the dimensions being strictly
+   increasing as in a valid sparse expression */
+static ap_linexpr0_t* get_linexpr0(reader_t* r)
+{
+  size_t i;
+  ap_linexpr0_t* e;
+  uint32_t nbterms = get_u32(r);
+
+  /* each term takes at least 6 bytes */
+  if (!r->ok || nbterms > (r->size - r->pos)/6){
+    r->ok = false;
+    return NULL;
+  }
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,nbterms);
+  get_coeff(r,&e->cst);
+  for (i=0; i<nbterms && r->ok; i++){
+    e->p.linterm[i].dim = get_u32(r);
+    if (e->p.linterm[i].dim==AP_DIM_MAX ||
+	(i>0 && e->p.linterm[i].dim<=e->p.linterm[i-1].dim))
+      r->ok = false;
+    get_coeff(r,&e->p.linterm[i].coeff);
+  }
+  if (!r->ok){
+    ap_linexpr0_free(e);
+    return NULL;
+  }
+  return e;
+}
+
+static size_t get_header(reader_t* r, uint32_t magic)
+{
+  uint64_t size;
+  if (get_u32(r)!=magic || get_u32(r)!=AP_PACKED_VERSION) return (size_t)-1;
+  size = get_u64(r);
+  if (!r->ok || size > (r->size - r->pos)/sizeof(uint64_t)) return (size_t)-1;
+  return (size_t)size;
+}
+/* Position the reader on the element i */
+static void get_seek(reader_t* r, size_t i)
+{
+  uint64_t offset;
+  r->pos = 16+i*sizeof(uint64_t);
+  offset = get_u64(r);
+  if (offset > r->size) r->ok = false;
+  else r->pos = (size_t)offset;
+}
+
+static bool get_lincons0(reader_t* r, ap_lincons0_t* cons)
+{
+  int32_t constyp = get_i32(r);
+  cons->linexpr0 = NULL;
+  cons->scalar = NULL;
+  if (constyp<AP_CONS_EQ || constyp>AP_CONS_DISEQ) return false;
+  cons->constyp = (ap_constyp_t)constyp;
+  cons->linexpr0 = get_linexpr0(r);
+  /* the modulo of an EQMOD constraint, and only of it */
+  if (get_u8(r)!=(constyp==AP_CONS_EQMOD)) r->ok = false;
+  else if (constyp==AP_CONS_EQMOD){
+    cons->scalar = ap_scalar_alloc();
+    get_scalar(r,cons->scalar);
+  }
+  if (!r->ok){
+    ap_lincons0_clear(cons);
+    return false;
+  }
+  return true;
+}
+static bool get_generator0(reader_t* r, ap_generator0_t* gen)
+{
+  int32_t gentyp = get_i32(r);
+  gen->linexpr0 = NULL;
+  if (gentyp<AP_GEN_LINE || gentyp>AP_GEN_RAYMOD) return false;
+  gen->gentyp = (ap_gentyp_t)gentyp;
+  gen->linexpr0 = get_linexpr0(r);
+  return gen->linexpr0!=NULL;
+}
+
+/* ====================================================================== */
+/* Interface */
+/* ====================================================================== */
+
+size_t ap_lincons0_array_packed_length(const void* buf, size_t size)
+{
+  reader_t r = { (const unsigned char*)buf, 0, size, true };
+  return get_header(&r,AP_PACKED_LINCONS0);
+}
+size_t ap_generator0_array_packed_length(const void* buf, size_t size)
+{
+  reader_t r = { (const unsigned char*)buf, 0, size, true };
+  return get_header(&r,AP_PACKED_GENERATOR0);
+}
+
+bool ap_lincons0_array_unpack(ap_lincons0_array_t* array,
+			      const void* buf, size_t size)
+{
+  size_t i;
+  reader_t r = { (const unsigned char*)buf, 0, size, true };
+  size_t n = get_header(&r,AP_PACKED_LINCONS0);
+  if (n==(size_t)-1){
+    *array = ap_lincons0_array_make(0);
+    return false;
+  }
+  *array = ap_lincons0_array_make(n);
+  for (i=0; i<n; i++){
+    get_seek(&r,i);
+    if (!get_lincons0(&r,&array->p[i])){
+      ap_lincons0_array_clear(array);
+      return false;
+    }
+  }
+  return true;
+}
+bool ap_generator0_array_unpack(ap_generator0_array_t* array,
+				const void* buf, size_t size)
+{
+  size_t i;
+  reader_t r = { (const unsigned char*)buf, 0, size, true };
+  size_t n = get_header(&r,AP_PACKED_GENERATOR0);
+  if (n==(size_t)-1){
+    *array = ap_generator0_array_make(0);
+    return false;
+  }
+  *array = ap_generator0_array_make(n);
+  for (i=0; i<n; i++){
+    get_seek(&r,i);
+    if (!get_generator0(&r,&array->p[i])){
+      ap_generator0_array_clear(array);
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ap_lincons0_unpack_nth(ap_lincons0_t* cons,
+			    const void* buf, size_t size, size_t i)
+{
+  reader_t r = { (const unsigned char*)buf, 0, size, true };
+  size_t n = get_header(&r,AP_PACKED_LINCONS0);
+  cons->linexpr0 = NULL;
+  cons->scalar = NULL;
+  if (n==(size_t)-1 || i>=n) return false;
+  get_seek(&r,i);
+  return get_lincons0(&r,cons);
+}
+bool ap_generator0_unpack_nth(ap_generator0_t* gen,
+			      const void* buf, size_t size, size_t i)
+{
+  reader_t r = { (const unsigned char*)buf, 0, size, true };
+  size_t n = get_header(&r,AP_PACKED_GENERATOR0);
+  gen->linexpr0 = NULL;
+  if (n==(size_t)-1 || i>=n) return false;
+  get_seek(&r,i);
+  return get_generator0(&r,gen);
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************* */
+/* ap_packed.h: packed arrays of constraints and generators */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+/* Arrays of linear constraints and generators can be packed into a flat
+   byte buffer, so that they cross the boundary with a host language
+   (OCaml Bigarray, Java direct ByteBuffer) in one block instead of one
+   object per constraint and per coefficient.
+
+   The buffer is meant for transfer within a process: integers are stored
+   in native byte order and without alignment.
+
+   Layout:
+
+   header   uint32 magic          AP_PACKED_LINCONS0 or AP_PACKED_GENERATOR0
+            uint32 version        AP_PACKED_VERSION
+            uint64 size           number of elements
+            uint64 offset[size]   byte offset of each element in the buffer
+
+   lincons0   int32 constyp, linexpr, uint8 has_scalar, [scalar]
+              (has_scalar is 1 for AP_CONS_EQMOD, 0 otherwise)
+   generator0 int32 gentyp, linexpr
+   linexpr    uint32 nbterms, coeff cst, nbterms*(uint32 dim, coeff)
+              (zero coefficients of dense expressions are omitted,
+               unpacked expressions are sparse, so that the dimensions
+               are strictly increasing)
+   coeff      uint8 discr (ap_coeff_discr_t), scalar [, scalar]
+   scalar     uint8 tag, then
+              AP_PACKED_DOUBLE  double
+              AP_PACKED_MPQ     int64 num, int64 den
+              AP_PACKED_BIGMPQ  mpz num, mpz den
+              AP_PACKED_MPFR    uint64 prec, int64 exp, mpz mant
+                                (value mant*2^exp)
+              AP_PACKED_MPFR_INF uint64 prec, int8 sign
+   mpz        uint8 sign (1 if negative), uint32 nbytes,
+              nbytes bytes of the absolute value, least significant first
+
+   Infinite MPQ scalars (+-1/0) fit in the AP_PACKED_MPQ form.
+
+   Unpacking rejects MPQ denominators that are negative or zero (except for
+   +-1/0) and canonicalizes the rationals. It rejects MPFR precisions above
+   AP_PACKED_MPFR_PREC_MAX, and mantissas of non-zero MPFR values that do
+   not have exactly prec bits.
+*/
+
+#ifndef _AP_PACKED_H_
+#define _AP_PACKED_H_
+
+#include <stddef.h>
+#include "ap_lincons0.h"
+#include "ap_generator0.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AP_PACKED_LINCONS0   0x41504c43 /* "APLC" */
+#define AP_PACKED_GENERATOR0 0x4150474e /* "APGN" */
+#define AP_PACKED_VERSION 1
+#define AP_PACKED_MPFR_PREC_MAX (1<<20) /* bits */
+
+typedef enum ap_packed_tag_t {
+  AP_PACKED_DOUBLE,
+  AP_PACKED_MPQ,
+  AP_PACKED_BIGMPQ,
+  AP_PACKED_MPFR,
+  AP_PACKED_MPFR_INF
+} ap_packed_tag_t;
+
+/* ====================================================================== */
+/* Packing */
+/* ====================================================================== */
+
+size_t ap_lincons0_array_packed_size(ap_lincons0_array_t* array);
+size_t ap_generator0_array_packed_size(ap_generator0_array_t* array);
+  /* Number of bytes of the packed array */
+
+size_t ap_lincons0_array_pack_into(void* buf, size_t size,
+				   ap_lincons0_array_t* array);
+size_t ap_generator0_array_pack_into(void* buf, size_t size,
+				     ap_generator0_array_t* array);
+  /* Pack the array into the buffer buf of size bytes, and return the
+     number of bytes written, or 0 if size is too small */
+
+void* ap_lincons0_array_pack(ap_lincons0_array_t* array, size_t* psize);
+void* ap_generator0_array_pack(ap_generator0_array_t* array, size_t* psize);
+  /* Pack the array into a buffer allocated with malloc, the size of which
+     is stored in *psize */
+
+/* ====================================================================== */
+/* Unpacking */
+/* ====================================================================== */
+
+size_t ap_lincons0_array_packed_length(const void* buf, size_t size);
+size_t ap_generator0_array_packed_length(const void* buf, size_t size);
+  /* Number of elements of a packed array, or (size_t)-1 if buf does not
+     hold a packed array of the right kind */
+
+bool ap_lincons0_array_unpack(ap_lincons0_array_t* array,
+			      const void* buf, size_t size);
+bool ap_generator0_array_unpack(ap_generator0_array_t* array,
+				const void* buf, size_t size);
+  /* Initialize array with the unpacked elements of buf.
+     Return false, leaving array empty, if buf is not well-formed. */
+
+bool ap_lincons0_unpack_nth(ap_lincons0_t* cons,
+			    const void* buf, size_t size, size_t i);
+bool ap_generator0_unpack_nth(ap_generator0_t* gen,
+			      const void* buf, size_t size, size_t i);
+  /* Initialize cons (resp. gen) with the i-th element of buf, without
+     unpacking the other ones. Return false if buf is not well-formed or
+     i is out of range. */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
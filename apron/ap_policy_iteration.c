@@ -0,0 +1,369 @@
+/* ************************************************************************* */
+/* ap_policy_iteration.c: fixpoint computation by policy iteration */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#include <stdlib.h>
+#include "ap_policy_iteration.h"
+
+typedef enum ap_policy_iteration_mode_t {
+  AP_POLICY_ITERATION_IMPROVE, /* improve the policies, then apply them */
+  AP_POLICY_ITERATION_APPLY    /* apply the policies */
+} ap_policy_iteration_mode_t;
+
+struct ap_policy_iteration_t {
+  ap_policy_manager_t* pman;
+  ap_manager_t* man;
+  ap_policy_iteration_mode_t mode;
+  size_t k;       /* current transition */
+  size_t rank;    /* rank of the next policy point of the transition */
+  ap_policy_t*** policies; /* policies[k][rank] */
+  size_t* nbpolicies;      /* number of points of each transition */
+  size_t changed;          /* policies changed by the current pass */
+  ap_policy_iteration_stats_t stats;
+};
+
+void ap_policy_iteration_option_init(ap_policy_iteration_option_t* option)
+{
+  option->widening_delay = 2;
+  option->descending = 2;
+  option->max_iterations = 100;
+}
+
+/* ********************************************************************** */
+/* I. Policy points */
+/* ********************************************************************** */
+
+/* Slot of the policy of the current point, allocated to NULL the first time
+   the point is met. */
+static ap_policy_t** ap_policy_iteration_point(ap_policy_iteration_t* pit)
+{
+  size_t k = pit->k;
+  size_t rank = pit->rank++;
+  if (rank>=pit->nbpolicies[k]){
+    size_t i;
+    pit->policies[k] = realloc(pit->policies[k],(rank+1)*sizeof(ap_policy_t*));
+    for (i=pit->nbpolicies[k]; i<=rank; i++){
+      pit->policies[k][i] = NULL;
+      pit->stats.points++;
+    }
+    pit->nbpolicies[k] = rank+1;
+  }
+  return &pit->policies[k][rank];
+}
+
+/* Replace the policy of the point by policy, if the improvement succeeded */
+static void ap_policy_iteration_update(ap_policy_iteration_t* pit,
+				       ap_policy_t** ppolicy,
+				       ap_policy_t* policy)
+{
+  if (policy==NULL) return;
+  if (*ppolicy!=NULL && ap_policy_equal(pit->pman,*ppolicy,policy)){
+    ap_policy_free(pit->pman,policy);
+  }
+  else {
+    if (*ppolicy!=NULL) ap_policy_free(pit->pman,*ppolicy);
+    *ppolicy = policy;
+    pit->changed++;
+    pit->stats.improvements++;
+  }
+}
+
+ap_abstract0_t* ap_policy_iteration_meet(ap_policy_iteration_t* pit,
+					 bool destructive,
+					 ap_abstract0_t* a1, ap_abstract0_t* a2)
+{
+  ap_policy_t** ppolicy = ap_policy_iteration_point(pit);
+
+  if (pit->mode==AP_POLICY_ITERATION_IMPROVE){
+    ap_policy_iteration_update(pit,ppolicy,
+			       ap_abstract0_policy_meet_improve(pit->pman,*ppolicy,a1,a2));
+  }
+  if (*ppolicy==NULL)
+    return ap_abstract0_meet(pit->man,destructive,a1,a2);
+  else
+    return ap_abstract0_policy_meet_apply(pit->pman,*ppolicy,destructive,a1,a2);
+}
+
+ap_abstract0_t* ap_policy_iteration_meet_lincons_array(ap_policy_iteration_t* pit,
+						       bool destructive,
+						       ap_abstract0_t* a,
+						       ap_lincons0_array_t* array)
+{
+  ap_policy_t** ppolicy = ap_policy_iteration_point(pit);
+
+  if (pit->mode==AP_POLICY_ITERATION_IMPROVE){
+    ap_policy_iteration_update(pit,ppolicy,
+			       ap_abstract0_policy_meet_lincons_array_improve(pit->pman,*ppolicy,a,array));
+  }
+  if (*ppolicy==NULL)
+    return ap_abstract0_meet_lincons_array(pit->man,destructive,a,array);
+  else
+    return ap_abstract0_policy_meet_lincons_array_apply(pit->pman,*ppolicy,destructive,a,array);
+}
+
+ap_abstract0_t* ap_policy_iteration_meet_tcons_array(ap_policy_iteration_t* pit,
+						     bool destructive,
+						     ap_abstract0_t* a,
+						     ap_tcons0_array_t* array)
+{
+  ap_policy_t** ppolicy = ap_policy_iteration_point(pit);
+
+  if (pit->mode==AP_POLICY_ITERATION_IMPROVE){
+    ap_policy_iteration_update(pit,ppolicy,
+			       ap_abstract0_policy_meet_tcons_array_improve(pit->pman,*ppolicy,a,array));
+  }
+  if (*ppolicy==NULL)
+    return ap_abstract0_meet_tcons_array(pit->man,destructive,a,array);
+  else
+    return ap_abstract0_policy_meet_tcons_array_apply(pit->pman,*ppolicy,destructive,a,array);
+}
+
+/* ********************************************************************** */
+/* II. Resolution */
+/* ********************************************************************** */
+
+/* Transitions sorted by destination: the ones of unknown i are
+   order[first[i]..first[i+1]-1] */
+typedef struct ap_policy_iteration_graph_t {
+  size_t* first;
+  size_t* order;
+} ap_policy_iteration_graph_t;
+
+static void ap_policy_iteration_graph_init(ap_policy_iteration_graph_t* graph,
+					   ap_policy_system_t* system)
+{
+  size_t i,k;
+  graph->first = calloc(system->size+1,sizeof(size_t));
+  graph->order = malloc((system->nbtrans ? system->nbtrans : 1)*sizeof(size_t));
+  for (k=0; k<system->nbtrans; k++) graph->first[system->trans[k].dst+1]++;
+  for (i=0; i<system->size; i++) graph->first[i+1] += graph->first[i];
+  for (k=0; k<system->nbtrans; k++){
+    size_t dst = system->trans[k].dst;
+    graph->order[graph->first[dst]++] = k;
+  }
+  for (i=system->size; i>0; i--) graph->first[i] = graph->first[i-1];
+  graph->first[0] = 0;
+}
+
+static void ap_policy_iteration_graph_clear(ap_policy_iteration_graph_t* graph)
+{
+  free(graph->first);
+  free(graph->order);
+}
+
+/* Image of transition k from x[src], NULL if x[src] is bottom */
+static ap_abstract0_t* ap_policy_iteration_step(ap_policy_iteration_t* pit,
+						ap_policy_system_t* system,
+						size_t k, ap_abstract0_t** x)
+{
+  ap_abstract0_t* a = x[system->trans[k].src];
+  if (ap_abstract0_is_bottom(pit->man,a)) return NULL;
+  pit->k = k;
+  pit->rank = 0;
+  pit->stats.steps++;
+  return system->transfer(pit,system->env,k,a);
+}
+
+/* Right-hand side of the equation of unknown i */
+static ap_abstract0_t* ap_policy_iteration_eval(ap_policy_iteration_t* pit,
+						ap_policy_system_t* system,
+						ap_policy_iteration_graph_t* graph,
+						size_t i, ap_abstract0_t** x)
+{
+  ap_abstract0_t* res;
+  size_t j;
+
+  res = system->init && system->init[i] ?
+    ap_abstract0_copy(pit->man,system->init[i]) :
+    ap_abstract0_bottom(pit->man,system->intdim,system->realdim);
+  for (j=graph->first[i]; j<graph->first[i+1]; j++){
+    ap_abstract0_t* img = ap_policy_iteration_step(pit,system,graph->order[j],x);
+    if (img){
+      res = ap_abstract0_join(pit->man,true,res,img);
+      ap_abstract0_free(pit->man,img);
+    }
+  }
+  return res;
+}
+
+/* Fixpoint of the system in the current mode, from bottom: upward
+   iterations with widening, then descending iterations. */
+static ap_abstract0_t** ap_policy_iteration_fixpoint(ap_policy_iteration_t* pit,
+						     ap_policy_system_t* system,
+						     ap_policy_iteration_graph_t* graph,
+						     ap_policy_iteration_option_t* option)
+{
+  ap_abstract0_t** x;
+  size_t* count;
+  size_t i,d;
+  bool change;
+
+  x = malloc((system->size ? system->size : 1)*sizeof(ap_abstract0_t*));
+  count = calloc(system->size ? system->size : 1,sizeof(size_t));
+  for (i=0; i<system->size; i++)
+    x[i] = ap_abstract0_bottom(pit->man,system->intdim,system->realdim);
+
+  do {
+    change = false;
+    for (i=0; i<system->size; i++){
+      ap_abstract0_t* v = ap_policy_iteration_eval(pit,system,graph,i,x);
+      if (!ap_abstract0_is_leq(pit->man,v,x[i])){
+	v = ap_abstract0_join(pit->man,true,v,x[i]);
+	if (count[i]++ >= option->widening_delay){
+	  ap_abstract0_t* w = ap_abstract0_widening(pit->man,x[i],v);
+	  ap_abstract0_free(pit->man,v);
+	  v = w;
+	}
+	ap_abstract0_free(pit->man,x[i]);
+	x[i] = v;
+	change = true;
+      }
+      else {
+	ap_abstract0_free(pit->man,v);
+      }
+    }
+  } while (change);
+
+  /* x is a post-fixpoint, and stays one along the descending iterations */
+  for (d=0; d<option->descending; d++){
+    change = false;
+    for (i=0; i<system->size; i++){
+      ap_abstract0_t* v = ap_policy_iteration_eval(pit,system,graph,i,x);
+      if (!ap_abstract0_is_eq(pit->man,v,x[i])){
+	ap_abstract0_free(pit->man,x[i]);
+	x[i] = v;
+	change = true;
+      }
+      else {
+	ap_abstract0_free(pit->man,v);
+      }
+    }
+    if (!change) break;
+  }
+  free(count);
+  return x;
+}
+
+/* Improves the policies of all the points in one pass from x, and returns
+   the right-hand sides of the equations at x with the improved policies.
+   The number of policies that changed is left in pit->changed. */
+static ap_abstract0_t** ap_policy_iteration_improve(ap_policy_iteration_t* pit,
+						    ap_policy_system_t* system,
+						    ap_policy_iteration_graph_t* graph,
+						    ap_abstract0_t** x)
+{
+  ap_abstract0_t** y;
+  size_t i;
+
+  pit->mode = AP_POLICY_ITERATION_IMPROVE;
+  pit->changed = 0;
+  y = malloc((system->size ? system->size : 1)*sizeof(ap_abstract0_t*));
+  for (i=0; i<system->size; i++)
+    y[i] = ap_policy_iteration_eval(pit,system,graph,i,x);
+  pit->stats.iterations++;
+  return y;
+}
+
+static void ap_policy_iteration_free_values(ap_policy_iteration_t* pit,
+					    ap_policy_system_t* system,
+					    ap_abstract0_t** x)
+{
+  size_t i;
+  for (i=0; i<system->size; i++) ap_abstract0_free(pit->man,x[i]);
+  free(x);
+}
+
+/* x := x meet y, and frees y. Returns true if x decreased. */
+static bool ap_policy_iteration_meet_values(ap_policy_iteration_t* pit,
+					    ap_policy_system_t* system,
+					    ap_abstract0_t** x,
+					    ap_abstract0_t** y)
+{
+  size_t i;
+  bool res = false;
+
+  for (i=0; i<system->size; i++){
+    if (!ap_abstract0_is_leq(pit->man,x[i],y[i])){
+      x[i] = ap_abstract0_meet(pit->man,true,x[i],y[i]);
+      res = true;
+    }
+    ap_abstract0_free(pit->man,y[i]);
+  }
+  free(y);
+  return res;
+}
+
+ap_abstract0_t** ap_policy_iteration_solve(ap_policy_manager_t* pman,
+					   ap_policy_system_t* system,
+					   ap_policy_iteration_option_t* option,
+					   ap_policy_iteration_stats_t* stats)
+{
+  ap_policy_iteration_t pit;
+  ap_policy_iteration_graph_t graph;
+  ap_policy_iteration_option_t defoption;
+  ap_abstract0_t** x;
+  ap_abstract0_t** y;
+  size_t i,k;
+
+  if (option==NULL){
+    ap_policy_iteration_option_init(&defoption);
+    option = &defoption;
+  }
+  pit.pman = pman;
+  pit.man = pman->man;
+  pit.k = pit.rank = 0;
+  pit.changed = 0;
+  pit.policies = calloc(system->nbtrans ? system->nbtrans : 1,sizeof(ap_policy_t**));
+  pit.nbpolicies = calloc(system->nbtrans ? system->nbtrans : 1,sizeof(size_t));
+  pit.stats.iterations = pit.stats.improvements = 0;
+  pit.stats.points = pit.stats.steps = 0;
+  ap_policy_iteration_graph_init(&graph,system);
+
+  /* 1. Initial policies, improved from top: the bounds given by the
+     constraints of the meets are chosen whenever they are finite */
+  x = malloc((system->size ? system->size : 1)*sizeof(ap_abstract0_t*));
+  for (i=0; i<system->size; i++)
+    x[i] = ap_abstract0_top(pit.man,system->intdim,system->realdim);
+  y = ap_policy_iteration_improve(&pit,system,&graph,x);
+  ap_policy_iteration_free_values(&pit,system,x);
+  ap_policy_iteration_free_values(&pit,system,y);
+  pit.stats.iterations = 0;
+
+  /* 2. Fixpoint with the initial policies */
+  pit.mode = AP_POLICY_ITERATION_APPLY;
+  x = ap_policy_iteration_fixpoint(&pit,system,&graph,option);
+
+  /* 3. Policy iteration, until x is a fixpoint of the system with the
+     current policies */
+  while (pit.stats.iterations<option->max_iterations){
+    y = ap_policy_iteration_improve(&pit,system,&graph,x);
+    if (pit.changed>0){
+      /* x is a post-fixpoint of the system with the improved policies,
+	 of which the least fixpoint is computed again */
+      ap_policy_iteration_meet_values(&pit,system,x,y);
+      pit.mode = AP_POLICY_ITERATION_APPLY;
+      y = ap_policy_iteration_fixpoint(&pit,system,&graph,option);
+      ap_policy_iteration_meet_values(&pit,system,x,y);
+    }
+    else if (!ap_policy_iteration_meet_values(&pit,system,x,y))
+      break;
+  }
+
+  for (k=0; k<system->nbtrans; k++){
+    for (i=0; i<pit.nbpolicies[k]; i++){
+      if (pit.policies[k][i]) ap_policy_free(pman,pit.policies[k][i]);
+    }
+    free(pit.policies[k]);
+  }
+  free(pit.policies);
+  free(pit.nbpolicies);
+  ap_policy_iteration_graph_clear(&graph);
+  if (stats) *stats = pit.stats;
+  return x;
+}
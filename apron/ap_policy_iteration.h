@@ -0,0 +1,120 @@
+/* ************************************************************************* */
+/* ap_policy_iteration.h: fixpoint computation by policy iteration */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#ifndef _AP_POLICY_ITERATION_H_
+#define _AP_POLICY_ITERATION_H_
+
+#include "ap_policy.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The driver solves a system of equations
+
+     X_i = init_i \/ \/_{k: trans[k].dst==i} f_k(X_{trans[k].src})
+
+   in which the transfer functions f_k may use meets subject to policies
+   (min-strategies): each meet f_k performs with the functions
+   ap_policy_iteration_meet* below is a policy point, identified by k and by
+   its rank among the calls of f_k.
+
+   1. The initial policies are the ones improved from top: a meet with
+      constraints takes the bounds given by the constraints whenever they
+      are finite, such as the bound of a loop guard.
+
+   2. The least fixpoint X of the system with the policies applied is
+      computed by upward iterations with widening, followed by descending
+      iterations.
+
+   3. Then, until X is a fixpoint of the system with the current policies:
+      all the policies are improved in one pass over the transitions, from
+      X (batched strategy improvement); if some policy changed, 2. is done
+      again, otherwise X is replaced by the right-hand sides evaluated by
+      the pass. X is always met with its previous value.
+
+   Any policy meet is an overapproximation of the exact meet, so that each
+   X is a post-fixpoint of the system, and the sequence of the X is
+   decreasing. As the bounds chosen by the policies do not depend on X, the
+   upward iterations often converge before widening, and the passes of 3.
+   recover the bounds lost by widening otherwise. A policy point that was
+   not met by the initial pass uses the exact meet until it is improved.
+*/
+
+typedef struct ap_policy_iteration_t ap_policy_iteration_t;
+  /* Context of a resolution, given to the transfer functions */
+
+typedef ap_abstract0_t* (*ap_policy_transfer_t)(ap_policy_iteration_t* pit,
+						void* env,
+						size_t k,
+						ap_abstract0_t* a);
+  /* Image of the (non bottom) value a of the source of transition k.
+     a should not be modified nor freed. */
+
+typedef struct ap_policy_transition_t {
+  size_t src;
+  size_t dst;
+} ap_policy_transition_t;
+
+typedef struct ap_policy_system_t {
+  size_t size;                   /* number of unknowns */
+  size_t intdim,realdim;         /* dimensions of the unknowns */
+  ap_abstract0_t** init;         /* initial values, NULL entries for bottom */
+  ap_policy_transition_t* trans; /* transitions */
+  size_t nbtrans;
+  ap_policy_transfer_t transfer; /* transfer function of the transitions */
+  void* env;                     /* given to transfer */
+} ap_policy_system_t;
+
+typedef struct ap_policy_iteration_option_t {
+  size_t widening_delay; /* upward iterations of an unknown before widening */
+  size_t descending;     /* maximal number of descending iterations */
+  size_t max_iterations; /* maximal number of improvement passes */
+} ap_policy_iteration_option_t;
+
+typedef struct ap_policy_iteration_stats_t {
+  size_t iterations;   /* improvement passes after the initial one */
+  size_t improvements; /* policy points whose policy changed */
+  size_t points;       /* policy points */
+  size_t steps;        /* evaluations of transitions */
+} ap_policy_iteration_stats_t;
+
+void ap_policy_iteration_option_init(ap_policy_iteration_option_t* option);
+  /* widening_delay 2, descending 2, max_iterations 100 */
+
+ap_abstract0_t** ap_policy_iteration_solve(ap_policy_manager_t* pman,
+					   ap_policy_system_t* system,
+					   ap_policy_iteration_option_t* option,
+					   ap_policy_iteration_stats_t* stats);
+  /* Returns the array of the system->size values of the unknowns, to be
+     freed with ap_abstract0_free and free. option may be NULL for the
+     default options, stats NULL if the statistics are not wanted. */
+
+/* Meets to be used by the transfer functions, with the same semantics as
+   the ones of ap_abstract0.h. According to the phase of the resolution,
+   they improve the policy of the point and apply it, or only apply it. */
+
+ap_abstract0_t* ap_policy_iteration_meet(ap_policy_iteration_t* pit,
+					 bool destructive,
+					 ap_abstract0_t* a1, ap_abstract0_t* a2);
+ap_abstract0_t* ap_policy_iteration_meet_lincons_array(ap_policy_iteration_t* pit,
+						       bool destructive,
+						       ap_abstract0_t* a,
+						       ap_lincons0_array_t* array);
+ap_abstract0_t* ap_policy_iteration_meet_tcons_array(ap_policy_iteration_t* pit,
+						     bool destructive,
+						     ap_abstract0_t* a,
+						     ap_tcons0_array_t* array);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
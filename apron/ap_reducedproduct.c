@@ -32,12 +32,22 @@ static inline ap_reducedproduct_internal_t* get_internal_init0(ap_manager_t* man
 {
   return (ap_reducedproduct_internal_t*)manager->internal;
 }
+/* Reduce a, unless it is unchanged since its last reduction */
+static inline void reduce_if_needed(ap_manager_t* manager,
+				    ap_reducedproduct_internal_t* intern,
+				    ap_reducedproduct_t* a)
+{
+  if (a->reduced==false){
+    intern->reduce(manager,a);
+    a->reduced = true;
+  }
+}
 static inline ap_reducedproduct_internal_t* get_internal_init1(ap_manager_t* manager,
 							       ap_funid_t funid, ap_reducedproduct_t* a)
 {
   ap_reducedproduct_internal_t* intern = get_internal_init0(manager);
-  if (a->reduced==false && manager->option.funopt[funid].algorithm & 0x1){
-    intern->reduce(manager,a);
+  if (manager->option.funopt[funid].algorithm & 0x1){
+    reduce_if_needed(manager,intern,a);
   }
   return intern;
 }
@@ -47,8 +57,8 @@ static inline ap_reducedproduct_internal_t* get_internal_init2(ap_manager_t* man
 {
   ap_reducedproduct_internal_t* intern = get_internal_init0(manager);
   if (manager->option.funopt[funid].algorithm & 0x1){
-    if (a->reduced==false) intern->reduce(manager,a);
-    if (b && b->reduced==false) intern->reduce(manager,b);
+    reduce_if_needed(manager,intern,a);
+    if (b) reduce_if_needed(manager,intern,b);
   }
   return intern;
 }
@@ -61,7 +71,7 @@ ap_reducedproduct_internal_t* get_internal_init_tab(ap_manager_t* manager,
   ap_reducedproduct_internal_t* intern = get_internal_init0(manager);
   if (manager->option.funopt[funid].algorithm & 0x1){
     for (i=0; i<size; i++){
-      if (tab[i]->reduced==false) intern->reduce(manager,tab[i]);
+      reduce_if_needed(manager,intern,tab[i]);
     }
   }
   return intern;
@@ -105,9 +115,8 @@ void collect_results1(ap_manager_t* manager, ap_funid_t funid, ap_reducedproduct
 {
   collect_results0(manager);
   ap_reducedproduct_internal_t* intern = get_internal_init0(manager);
-  if (a->reduced==false && manager->option.funopt[funid].algorithm & 0x2){
-    intern->reduce(manager,a);
-    a->reduced = true;
+  if (manager->option.funopt[funid].algorithm & 0x2){
+    reduce_if_needed(manager,intern,a);
   }
 }
 
@@ -210,6 +219,28 @@ size_t ap_reducedproduct_size(ap_manager_t* manager, ap_reducedproduct_t* a)
   return res;
 }
 
+/* A pure query: a is not reduced and the result of the last operation is
+   left untouched */
+size_t ap_reducedproduct_memory_size(ap_manager_t* manager, ap_reducedproduct_t* a)
+{
+  ap_reducedproduct_internal_t* intern = get_internal_init0(manager);
+  size_t i;
+  size_t res = sizeof(ap_reducedproduct_t) + intern->size*sizeof(void*);
+
+  for (i=0;i<intern->size;i++){
+    ap_manager_t* man = intern->tmanagers[i];
+    size_t (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_MEMORY_SIZE];
+    if (ptr==NULL){
+      ap_manager_raise_exception(manager,AP_EXC_NOT_IMPLEMENTED,
+				 AP_FUNID_MEMORY_SIZE,
+				 "memory_size not provided by a component library");
+      return res;
+    }
+    res += ptr(man,a->p[i]);
+  }
+  return res;
+}
+
 /* ============================================================ */
 /* I.2 Control of internal representation */
 /* ============================================================ */
@@ -313,7 +344,8 @@ ap_membuf_t ap_reducedproduct_serialize_raw(ap_manager_t* manager, ap_reducedpro
 ap_reducedproduct_t* ap_reducedproduct_deserialize_raw(ap_manager_t* manager, void* p, size_t* size)
 {
   ap_reducedproduct_internal_t* intern = get_internal_init0(manager);
-  size_t i,nb,dummy;
+  size_t i,dummy;
+  size_t avail = size ? *size : (size_t)-1;
   ap_reducedproduct_t* res = ap_reducedproduct_alloc(intern->size);
 
   if (size==NULL) size = &dummy;
@@ -321,8 +353,22 @@ ap_reducedproduct_t* ap_reducedproduct_deserialize_raw(ap_manager_t* manager, vo
   for (i=0;i<intern->size;i++){
     ap_manager_t* man = intern->tmanagers[i];
     void* (*ptr)(ap_manager_t*,...) = man->funptr[AP_FUNID_DESERIALIZE_RAW];
-    size_t nb;
+    /* the components share the bytes left */
+    size_t nb = avail - *size;
     res->p[i] = ptr(man,((char*)p + *size), &nb);
+    if (res->p[i]==NULL){
+      /* the component raised an exception */
+      while (i>0){
+	void (*freeptr)(ap_manager_t*,...);
+	i--;
+	man = intern->tmanagers[i];
+	freeptr = man->funptr[AP_FUNID_FREE];
+	freeptr(man,res->p[i]);
+      }
+      free(res);
+      collect_results0(manager);
+      return NULL;
+    }
     *size += nb;
   }
   collect_results0(manager);
@@ -715,7 +761,8 @@ ap_reducedproduct_t* ap_reducedproduct_meetjoin(ap_funid_t funid,
       }
     }
   }
-  res->reduced = funid==AP_FUNID_JOIN && a1->reduced && a2->reduced;
+  /* the join of reduced values may be tightened by a reduction */
+  res->reduced = false;
  ap_reducedproduct_meetjoin_exit:
   collect_results1(manager,funid,res);
   return res;
@@ -758,16 +805,7 @@ ap_reducedproduct_t* ap_reducedproduct_meetjoin_array(ap_funid_t funid,
       }
     }
   }
-  if (funid==AP_FUNID_JOIN){
-    res->reduced = tab[0]->reduced; i = 1;
-    while (res->reduced && i<size){
-      res->reduced = tab[i]->reduced;
-      i++;
-    }
-  }
-  else {
-    res->reduced = false;
-  }
+  res->reduced = false;
  ap_reducedproduct_meetjoin_array_exit:
   free(a);
   collect_results1(manager,funid,res);
@@ -792,6 +830,7 @@ ap_reducedproduct_t* ap_reducedproduct_meet_lincons_array(ap_manager_t* manager,
     get_internal_init1(manager,AP_FUNID_MEET_LINCONS_ARRAY,a);
   size_t i;
   ap_reducedproduct_t* res;
+  bool reduced = a->reduced && array->size==0;
 
   res = destructive ? a : ap_reducedproduct_alloc(intern->size);
 
@@ -802,10 +841,11 @@ ap_reducedproduct_t* ap_reducedproduct_meet_lincons_array(ap_manager_t* manager,
     bool (*is_bottom)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_BOTTOM];
     if (is_bottom(man,res->p[i])){
       set_bottom(intern,destructive,res,i);
+      reduced = true;
       break;
     }
   }
-  res->reduced = false;
+  res->reduced = reduced;
   collect_results1(manager,AP_FUNID_MEET_LINCONS_ARRAY,res);
   return res;
 }
@@ -817,6 +857,7 @@ ap_reducedproduct_t* ap_reducedproduct_meet_tcons_array(ap_manager_t* manager,
     get_internal_init1(manager,AP_FUNID_MEET_TCONS_ARRAY,a);
   size_t i;
   ap_reducedproduct_t* res;
+  bool reduced = a->reduced && array->size==0;
 
   res = destructive ? a : ap_reducedproduct_alloc(intern->size);
 
@@ -827,10 +868,11 @@ ap_reducedproduct_t* ap_reducedproduct_meet_tcons_array(ap_manager_t* manager,
     bool (*is_bottom)(ap_manager_t*,...) = man->funptr[AP_FUNID_IS_BOTTOM];
     if (is_bottom(man,res->p[i])){
       set_bottom(intern,destructive,res,i);
+      reduced = true;
       break;
     }
   }
-  res->reduced = false;
+  res->reduced = reduced;
   collect_results1(manager,AP_FUNID_MEET_TCONS_ARRAY,res);
   return res;
 }
@@ -1213,14 +1255,22 @@ ap_manager_t* ap_reducedproduct_manager_alloc
   man = ap_manager_alloc(internal->library,internal->version,
 			 internal,
 			 &ap_reducedproduct_internal_free);
-  /* default options */
+  /* default options: the reduction is delayed until an operation needs its
+     arguments reduced. Meets and dimension changes do not, the reduction of
+     their result is left to the next operation. As before, forget also
+     reduces its result, and widening does not reduce its arguments, which
+     could prevent its convergence. */
   for (funid=0; funid<AP_FUNID_SIZE; funid++){
-    man->option.funopt[funid].algorithm = 0x2;
+    man->option.funopt[funid].algorithm = 0x1;
   }
-  man->option.funopt[AP_FUNID_COPY].algorithm = 0x1;
+  man->option.funopt[AP_FUNID_COPY].algorithm = 0x0;
   man->option.funopt[AP_FUNID_FREE].algorithm = 0x0;
   man->option.funopt[AP_FUNID_ASIZE].algorithm = 0x0;
-  man->option.funopt[AP_FUNID_COPY].algorithm = 0x1;
+  man->option.funopt[AP_FUNID_MEMORY_SIZE].algorithm = 0x0;
+  man->option.funopt[AP_FUNID_MEET].algorithm = 0x0;
+  man->option.funopt[AP_FUNID_MEET_ARRAY].algorithm = 0x0;
+  man->option.funopt[AP_FUNID_MEET_LINCONS_ARRAY].algorithm = 0x0;
+  man->option.funopt[AP_FUNID_MEET_TCONS_ARRAY].algorithm = 0x0;
   man->option.funopt[AP_FUNID_MINIMIZE].algorithm = 0x1;
   man->option.funopt[AP_FUNID_IS_BOTTOM].algorithm = 0x1;
   man->option.funopt[AP_FUNID_IS_TOP].algorithm = 0x1;
@@ -1253,6 +1303,7 @@ ap_manager_t* ap_reducedproduct_manager_alloc
   funptr[AP_FUNID_COPY] = &ap_reducedproduct_copy;
   funptr[AP_FUNID_FREE] = &ap_reducedproduct_free;
   funptr[AP_FUNID_ASIZE] = &ap_reducedproduct_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &ap_reducedproduct_memory_size;
   funptr[AP_FUNID_MINIMIZE] = &ap_reducedproduct_minimize;
   funptr[AP_FUNID_CANONICALIZE] = &ap_reducedproduct_canonicalize;
   funptr[AP_FUNID_HASH] = &ap_reducedproduct_hash;
@@ -22,7 +22,8 @@ extern "C" {
 
 /* (internal) abstract value for a product */
 typedef struct ap_reducedproduct_t {
-  bool reduced; /* is the product reduced ? */
+  bool reduced; /* is the product reduced ? false as soon as a component
+		   may have changed since the last reduction */
   void* p[0];   /* array of internal abstract values, 
 		   the size of which is specified in the associated 
 		   ap_reducedproduct_internal_t */
@@ -54,6 +55,17 @@ ap_manager_t* ap_reducedproduct_manager_alloc
  void (*approximate)(ap_manager_t*, ap_reducedproduct_t*, int n) 
    /* approximate function */
 );
+  /* The bits of option.funopt[funid].algorithm of the result select when
+     the operation funid reduces its arguments (0x1, before) and its result
+     (0x2, after). A value is reduced only if it is not already, so that the
+     reduction is done at most once between two modifications.
+
+     By default, operations that are not meets, copies, dimension changes or
+     widenings reduce their arguments, and only forget reduces its result: a
+     sequence of meets is reduced once, when its result is used. Widening
+     does not reduce its arguments, which could prevent its convergence.
+     The result of a join is not reduced, even if its arguments are.
+  */
 
 /* ============================================================ */
 /* V. Extra functions */
@@ -83,6 +95,21 @@ ap_reducedproduct_t* ap_reducedproduct_compose(ap_manager_t* manager, bool destr
      and the result do not share any more information.
   */
 
+/* ============================================================ */
+/* VI. Generic operations */
+/* ============================================================ */
+
+/* Some functions of the virtual table of a product manager, for products
+   that redefine them and fall back on the generic ones. */
+
+bool ap_reducedproduct_is_bottom(ap_manager_t* manager, ap_reducedproduct_t* a);
+bool ap_reducedproduct_is_leq(ap_manager_t* manager,
+			      ap_reducedproduct_t* a, ap_reducedproduct_t* b);
+bool ap_reducedproduct_sat_interval(ap_manager_t* manager, ap_reducedproduct_t* a,
+				    ap_dim_t dim, ap_interval_t* interval);
+ap_interval_t* ap_reducedproduct_bound_dimension(ap_manager_t* manager,
+						 ap_reducedproduct_t* a, ap_dim_t dim);
+
 #ifdef __cplusplus
 }
 #endif
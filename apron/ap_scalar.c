@@ -41,6 +41,25 @@ void ap_scalar_free(ap_scalar_t* scalar)
   free(scalar);
 }
 
+size_t ap_scalar_memory_size(ap_scalar_t* scalar)
+{
+  size_t res = sizeof(ap_scalar_t);
+  switch(scalar->discr){
+  case AP_SCALAR_DOUBLE:
+    break;
+  case AP_SCALAR_MPQ:
+    res += sizeof(mpq_t) +
+      ((size_t)mpq_numref(scalar->val.mpq)->_mp_alloc +
+       (size_t)mpq_denref(scalar->val.mpq)->_mp_alloc)*sizeof(mp_limb_t);
+    break;
+  case AP_SCALAR_MPFR:
+    res += sizeof(mpfr_t) +
+      (mpfr_get_prec(scalar->val.mpfr)+GMP_NUMB_BITS-1)/GMP_NUMB_BITS*sizeof(mp_limb_t);
+    break;
+  }
+  return res;
+}
+
 int ap_scalar_print_prec = 20;
 
 void ap_scalar_fprint(FILE* stream, ap_scalar_t* a)
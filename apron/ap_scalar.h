@@ -57,6 +57,9 @@ ap_scalar_t* ap_scalar_alloc(void);
   /* Allocates a scalar, of default type DOUBLE (the most economical) */
 void ap_scalar_free(ap_scalar_t* scalar);
   /* Free a scalar */
+size_t ap_scalar_memory_size(ap_scalar_t* scalar);
+  /* Number of bytes of heap memory used by an allocated scalar,
+     including its multiprecision limbs */
 void ap_scalar_reinit(ap_scalar_t* scalar, ap_scalar_discr_t d);
   /* Change the type of an already allocated scalar
      (mainly for internal use */
@@ -228,6 +228,23 @@ void ap_texpr0_free(ap_texpr0_t* expr)
   ap_texpr0_clear(expr);
   free(expr);
 }
+size_t ap_texpr0_memory_size(ap_texpr0_t* expr)
+{
+  if (!expr) return 0;
+  switch(expr->discr){
+  case AP_TEXPR_CST:
+    return sizeof(ap_texpr0_t) + ap_coeff_memory_size(&expr->val.cst);
+  case AP_TEXPR_DIM:
+    return sizeof(ap_texpr0_t);
+  case AP_TEXPR_NODE:
+    return sizeof(ap_texpr0_t) + sizeof(ap_texpr0_node_t) +
+      ap_texpr0_memory_size(expr->val.node->exprA) +
+      ap_texpr0_memory_size(expr->val.node->exprB);
+  default:
+    assert(0);
+    return 0;
+  }
+}
 ap_texpr0_t* ap_texpr0_from_linexpr0(ap_linexpr0_t* e)
 {
   ap_texpr0_t* res = ap_texpr0_cst(&e->cst);
@@ -134,6 +134,9 @@ ap_texpr0_t* ap_texpr0_copy(ap_texpr0_t* expr);
 void ap_texpr0_free(ap_texpr0_t* expr);
   /* Recursive (deep) free */
 
+size_t ap_texpr0_memory_size(ap_texpr0_t* expr);
+  /* Number of bytes of heap memory used by an allocated expression tree */
+
 ap_texpr0_t* ap_texpr0_from_linexpr0(ap_linexpr0_t* e);
   /* From linear expression to comb-like expression tree */
 
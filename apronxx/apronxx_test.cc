@@ -1865,6 +1865,64 @@ void test_tcons1_array()
 }
 
 
+#if __cplusplus >= 201103L
+void test_move()
+{
+  cout << endl << "move semantics"
+       << endl << "==============" << endl << endl;
+  polka_manager m;
+  coeff c1[2] = { 1,-1 };
+  coeff c2[2] = { -1,0 };
+
+  // expressions and constraints: moves keep the underlying storage
+  linexpr0 e(2,c1,3,AP_LINEXPR_DENSE);
+  const ap_coeff_t* pe = e.get_ap_linexpr0_t()->p.coeff;
+  linexpr0 e2 = std::move(e);
+  assert(e2.get_ap_linexpr0_t()->p.coeff==pe && e.size()==0);
+  cout << "moved linexpr0:      " << e2 << endl;
+  lincons0_array ca(2);
+  ca[0] = lincons0(AP_CONS_SUPEQ,linexpr0(2,c1,1,AP_LINEXPR_DENSE));
+  ca[1] = lincons0(AP_CONS_SUPEQ,linexpr0(2,c2,10,AP_LINEXPR_DENSE));
+  const ap_lincons0_t* pc = ca.get_ap_lincons0_array_t()->p;
+  vector<lincons0_array> vc;
+  vc.push_back(std::move(ca));
+  assert(vc[0].get_ap_lincons0_array_t()->p==pc && ca.size()==0);
+  ca = vc[0];
+  cout << "moved lincons0_array " << vc[0] << endl;
+  texpr0 t = dim(0)+dim(1)*2;
+  texpr0 t2 = std::move(t);
+  t = t2;
+  cout << "moved texpr0:        " << t2 << endl;
+
+  // abstract elements: moves keep the underlying ap_abstract0_t
+  abstract0 x(m,0,2,top());
+  ap_abstract0_t* px = x.get_ap_abstract0_t();
+  vector<abstract0> v;
+  v.push_back(std::move(x));
+  v.push_back(abstract0(m,0,2,bottom()));
+  assert(v[0].get_ap_abstract0_t()==px);
+  x = v[1];
+  abstract0 y = std::move(v[0]);
+  assert(y.get_ap_abstract0_t()==px);
+
+  // rvalue operands are modified in-place, without copy
+  abstract0 z(m,0,2,top());
+  meet(m,z,std::move(y),ca);
+  assert(z.get_ap_abstract0_t()==px);
+  cout << "rvalue meet:         " << z << endl;
+  assign(m,z,std::move(z),1,e2);
+  assert(z.get_ap_abstract0_t()==px);
+  cout << "rvalue assign:       " << z << endl;
+  join(m,z,std::move(z),abstract0(m,0,2,ca));
+  assert(z.get_ap_abstract0_t()==px);
+  cout << "rvalue join:         " << z << endl;
+  abstract0 w(m,z);
+  meet(m,w,std::move(w),abstract0(m,0,2,bottom()));
+  assert(w.is_bottom(m));
+  cout << "rvalue meet:         " << w << endl;
+}
+#endif
+
 void test_abstract0(manager& m, manager& mm)
 {
   cout << "level 0" << endl << endl;
@@ -2881,6 +2939,9 @@ int main()
   test_texpr1();
   test_tcons1();
   test_tcons1_array();
+#if __cplusplus >= 201103L
+  test_move();
+#endif
   test_box();
   test_polka();
   test_octagon();
@@ -125,6 +125,14 @@ public:
    */
   abstract0(const abstract0& t);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves t into *this, without copying the abstract element.
+   *
+   * t is left empty: it can only be destroyed or assigned to.
+   */
+  abstract0(abstract0&& t) noexcept;
+#endif
+
   //@}
 
 
@@ -162,6 +170,14 @@ public:
    */
   abstract0& operator=(const abstract0& t);
 
+#if __cplusplus >= 201103L
+  /*! \brief Exchanges the abstract elements of *this and t, without copying.
+   *
+   * Also accepts an empty *this (left by a move).
+   */
+  abstract0& operator=(abstract0&& t) noexcept;
+#endif
+
   /*! \brief Assigns the full space to *this.
    *
    * Implicitly uses the manager used to create *this.
@@ -346,6 +362,12 @@ public:
    */
   size_t size(manager& m) const;
 
+  /*! \brief Returns the number of bytes allocated for the abstract element.
+   *
+   * \throw not_implemented if the library does not provide this function.
+   */
+  size_t memory_size(manager& m) const;
+
   //@}
 
 
@@ -473,6 +495,16 @@ public:
    */
   friend abstract0& meet(manager& m, abstract0& dst, const abstract0& x, const abstract0& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the meet of x and y, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& meet(manager& m, abstract0& dst, abstract0&& x, const abstract0& y);
+#endif
+
   /*! \brief Replaces dst with the meet of all abstract elements in x.
    *
    * \return a reference to dst.
@@ -497,6 +529,16 @@ public:
    */
   friend abstract0& meet(manager& m, abstract0& dst, const abstract0& x, const lincons0_array& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the meet of x and some linear constraints, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& meet(manager& m, abstract0& dst, abstract0&& x, const lincons0_array& y);
+#endif
+
   /*! \brief Adds some arbitrary constraints to *this (modified in-place).
    *
    * \return a reference to *this.
@@ -509,6 +551,16 @@ public:
    */
   friend abstract0& meet(manager& m, abstract0& dst, const abstract0& x, const tcons0_array& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the meet of x and some arbitrary constraints, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& meet(manager& m, abstract0& dst, abstract0&& x, const tcons0_array& y);
+#endif
+
 
   /*! \brief Replaces *this with the meet of *this and the abstract element y.
    *
@@ -558,6 +610,16 @@ public:
    */
   friend abstract0& join(manager& m, abstract0& dst, const abstract0& x, const abstract0& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the join of x and y, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& join(manager& m, abstract0& dst, abstract0&& x, const abstract0& y);
+#endif
+
   /*! \brief Replaces dst with the join of all abstract elements in x.
    *
    * \return a reference to dst.
@@ -655,6 +717,16 @@ public:
    */
   friend abstract0& assign(manager& m, abstract0& dst, const abstract0& src, ap_dim_t dim, const linexpr0& l, const abstract0& inter);
 
+#if __cplusplus >= 201103L
+  /*! \brief Assignment of linear expression, reusing src.
+   *
+   * src is modified in-place and moved into dst, without copy; src is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& assign(manager& m, abstract0& dst, abstract0&& src, ap_dim_t dim, const linexpr0& l, const abstract0& inter);
+#endif
+
   /*! \brief Parallel assignment of linear expressions.
    *
    * dst is replaced with the effect of assigning l[i] to dimension dim[i] in src,
@@ -666,6 +738,16 @@ public:
    */
   friend abstract0& assign(manager& m, abstract0& dst, const abstract0& src,  size_t size, const ap_dim_t dim[], const linexpr0 * const l[], const abstract0& inter);
 
+#if __cplusplus >= 201103L
+  /*! \brief Parallel assignment of linear expressions, reusing src.
+   *
+   * src is modified in-place and moved into dst, without copy; src is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& assign(manager& m, abstract0& dst, abstract0&& src, size_t size, const ap_dim_t dim[], const linexpr0 * const l[], const abstract0& inter);
+#endif
+
   /*! \brief Parallel assignment of linear expressions.
    *
    * dst is replaced with the effect of assigning l[i] to dimension dim[i] in src.
@@ -723,6 +805,16 @@ public:
    */
   friend abstract0& assign(manager& m, abstract0& dst, const abstract0& src, ap_dim_t dim, const texpr0& l, const abstract0& inter);
 
+#if __cplusplus >= 201103L
+  /*! \brief Assignment of arbitrary expression, reusing src.
+   *
+   * src is modified in-place and moved into dst, without copy; src is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& assign(manager& m, abstract0& dst, abstract0&& src, ap_dim_t dim, const texpr0& l, const abstract0& inter);
+#endif
+
   /*! \brief Parallel assignment of arbitrary expressions.
    *
    * dst is replaced with the effect of assigning l[i] to dimension dim[i] in src,
@@ -734,6 +826,16 @@ public:
    */
   friend abstract0& assign(manager& m, abstract0& dst, const abstract0& src, size_t size, const ap_dim_t dim[], const texpr0 * const l[], const abstract0& inter);
 
+#if __cplusplus >= 201103L
+  /*! \brief Parallel assignment of arbitrary expressions, reusing src.
+   *
+   * src is modified in-place and moved into dst, without copy; src is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract0& assign(manager& m, abstract0& dst, abstract0&& src, size_t size, const ap_dim_t dim[], const texpr0 * const l[], const abstract0& inter);
+#endif
+
   /*! \brief Parallel assignment of arbitrary expressions.
    *
    * dst is replaced with the effect of assigning l[i] to dimension dim[i] in src.
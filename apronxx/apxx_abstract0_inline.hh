@@ -75,6 +75,14 @@ inline abstract0::abstract0(const abstract0& t)
   manager::raise(a->man, "apron::abstract0::abstract0(abstract0&)",a);
 }
 
+#if __cplusplus >= 201103L
+inline abstract0::abstract0(abstract0&& t) noexcept
+  : a(t.a)
+{
+  t.a = NULL;
+}
+#endif
+
 
 
 /* destructors */
@@ -99,14 +107,23 @@ inline void abstract0::free(manager& m)
 inline abstract0& abstract0::operator=(const abstract0& t)
 {
   if (&t!=this) {
-    ap_abstract0_t* r = ap_abstract0_copy(a->man, t.a);
-    manager::raise(a->man, "apron::abstract0::operator=(const abstract0&)",r);
-    ap_abstract0_free(a->man, a);
+    ap_manager_t* man = a ? a->man : t.a->man;
+    ap_abstract0_t* r = ap_abstract0_copy(man, t.a);
+    manager::raise(man, "apron::abstract0::operator=(const abstract0&)",r);
+    if (a) ap_abstract0_free(man, a);
     a = r;
   }
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& abstract0::operator=(abstract0&& t) noexcept
+{
+  std::swap(a, t.a);
+  return *this;
+}
+#endif
+
 inline abstract0& abstract0::operator=(top t)
 {
   ap_dimension_t d = ap_abstract0_dimension(a->man, a);
@@ -344,6 +361,13 @@ inline size_t abstract0::size(manager& m) const
   return sz;
 }
 
+inline size_t abstract0::memory_size(manager& m) const
+{
+  size_t sz = ap_abstract0_memory_size(m.get_ap_manager_t(), a);
+  m.raise("apron::abstract0::memory_size(manager&)");
+  return sz;
+}
+
 
 
 /* predicates */
@@ -524,6 +548,18 @@ inline abstract0& meet(manager& m, abstract0& dst, const abstract0& x, const abs
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& meet(manager& m, abstract0& dst, abstract0&& x, const abstract0& y)
+{
+  ap_abstract0_t* r = ap_abstract0_meet(m.get_ap_manager_t(), true, x.a, y.a);
+  x.a = NULL;
+  m.raise("apron::meet(manager&, abstract0&, abstract0&&, const abstract0&)",r);
+  if (dst.a) ap_abstract0_free(m.get_ap_manager_t(), dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract0& meet(manager& m, abstract0& dst, const std::vector<const abstract0*>& x)
 {
   ap_abstract0_t* xx[x.size()];
@@ -566,6 +602,18 @@ inline abstract0& join(manager& m, abstract0& dst, const abstract0& x, const abs
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& join(manager& m, abstract0& dst, abstract0&& x, const abstract0& y)
+{
+  ap_abstract0_t* r = ap_abstract0_join(m.get_ap_manager_t(), true, x.a, y.a);
+  x.a = NULL;
+  m.raise("apron::join(manager&, abstract0&, abstract0&&, const abstract0&)",r);
+  if (dst.a) ap_abstract0_free(m.get_ap_manager_t(), dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract0& join(manager& m, abstract0& dst, size_t sz, const abstract0 * const x[])
 {
   ap_abstract0_t* xx[sz];
@@ -611,6 +659,20 @@ inline abstract0& meet(manager& m, abstract0& dst, const abstract0& x, const lin
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& meet(manager& m, abstract0& dst, abstract0&& x, const lincons0_array& y)
+{
+  ap_abstract0_t* r =
+    ap_abstract0_meet_lincons_array(m.get_ap_manager_t(), true, x.a,
+				    const_cast<ap_lincons0_array_t*>(y.get_ap_lincons0_array_t()));
+  x.a = NULL;
+  m.raise("apron::meet(manager&, abstract0&, abstract0&&, const lincons0_array&)",r);
+  if (dst.a) ap_abstract0_free(m.get_ap_manager_t(), dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 
 inline abstract0& abstract0::meet(manager& m, const tcons0_array& y)
 {
@@ -631,6 +693,20 @@ inline abstract0& meet(manager& m, abstract0& dst, const abstract0& x, const tco
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& meet(manager& m, abstract0& dst, abstract0&& x, const tcons0_array& y)
+{
+  ap_abstract0_t* r =
+    ap_abstract0_meet_tcons_array(m.get_ap_manager_t(), true, x.a,
+				  const_cast<ap_tcons0_array_t*>(y.get_ap_tcons0_array_t()));
+  x.a = NULL;
+  m.raise("apron::meet(manager&, abstract0&, abstract0&&, const tcons0_array&)",r);
+  if (dst.a) ap_abstract0_free(m.get_ap_manager_t(), dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 
 
 inline abstract0& abstract0::add_rays(manager& m, const generator0_array& y)
@@ -744,6 +820,28 @@ inline abstract0& assign(manager& m, abstract0& dst, const abstract0& src, size_
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& assign(manager& m, abstract0& dst, abstract0&& src, ap_dim_t dim, const linexpr0& l, const abstract0& inter = abstract0::null)
+{
+  const linexpr0* ll = &l;
+  return assign(m, dst, std::move(src), 1, &dim, &ll, inter);
+}
+
+inline abstract0& assign(manager& m, abstract0& dst, abstract0&& src, size_t size, const ap_dim_t dim[], const linexpr0 * const l[], const abstract0& inter = abstract0::null)
+{
+  ap_abstract0_t* r =
+    ap_abstract0_assign_linexpr_array(m.get_ap_manager_t(), true, src.a,
+				      const_cast<ap_dim_t*>(dim),
+				      reinterpret_cast<ap_linexpr0_t**>(const_cast<linexpr0**>(l)),
+				      size, inter.a);
+  src.a = NULL;
+  m.raise("apron::assign((manager&, abstract0&, abstract0&&, size_t size, const ap_dim_t[], const linexpr0 * const [], const abstract0&)",r);
+  if (dst.a) ap_abstract0_free(m.get_ap_manager_t(), dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract0& assign(manager& m, abstract0& dst, const abstract0& src, const std::vector<ap_dim_t>& dim, const std::vector<const linexpr0*>& l, const abstract0& inter = abstract0::null)
 {
   if (l.size()!=dim.size())
@@ -809,6 +907,28 @@ inline abstract0& assign(manager& m, abstract0& dst, const abstract0& src, size_
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract0& assign(manager& m, abstract0& dst, abstract0&& src, ap_dim_t dim, const texpr0& l, const abstract0& inter = abstract0::null)
+{
+  const texpr0* ll = &l;
+  return assign(m, dst, std::move(src), 1, &dim, &ll, inter);
+}
+
+inline abstract0& assign(manager& m, abstract0& dst, abstract0&& src, size_t size, const ap_dim_t dim[], const texpr0 * const l[], const abstract0& inter = abstract0::null)
+{
+  ap_abstract0_t* r =
+    ap_abstract0_assign_texpr_array(m.get_ap_manager_t(), true, src.a,
+				      const_cast<ap_dim_t*>(dim),
+				      reinterpret_cast<ap_texpr0_t**>(const_cast<texpr0**>(l)),
+				      size, inter.a);
+  src.a = NULL;
+  m.raise("apron::assign((manager&, abstract0&, abstract0&&, size_t size, const ap_dim_t[], const texpr0 * const [], const abstract0&)",r);
+  if (dst.a) ap_abstract0_free(m.get_ap_manager_t(), dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract0& assign(manager& m, abstract0& dst, const abstract0& src, const std::vector<ap_dim_t>& dim, const std::vector<const texpr0*>& l, const abstract0& inter = abstract0::null)
 {
   if (l.size()!=dim.size())
@@ -100,6 +100,14 @@ public:
    */
   abstract1(const abstract1& t);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves t into *this, without copying the abstract element.
+   *
+   * t is left empty: it can only be destroyed or assigned to.
+   */
+  abstract1(abstract1&& t) noexcept;
+#endif
+
   //@}
 
 
@@ -137,6 +145,14 @@ public:
    */
   abstract1& operator=(const abstract1& t);
 
+#if __cplusplus >= 201103L
+  /*! \brief Exchanges the abstract elements of *this and t, without copying.
+   *
+   * Also accepts an empty *this (left by a move).
+   */
+  abstract1& operator=(abstract1&& t) noexcept;
+#endif
+
   /*! \brief Assigns the full space to *this.
    *
    * Implicitly uses the manager used to create *this.
@@ -346,6 +362,13 @@ public:
    */
   size_t size(manager& m) const;
 
+  /*! \brief Returns the number of bytes allocated for the abstract element.
+   * The environment is not counted.
+   *
+   * \throw not_implemented if the library does not provide this function.
+   */
+  size_t memory_size(manager& m) const;
+
   //@}
 
 
@@ -473,6 +496,16 @@ public:
    */
   friend abstract1& meet(manager& m, abstract1& dst, const abstract1& x, const abstract1& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the meet of x and y, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract1& meet(manager& m, abstract1& dst, abstract1&& x, const abstract1& y);
+#endif
+
 
   /*! \brief Replaces *this with the meet of *this and the abstract element y.
    *
@@ -517,6 +550,16 @@ public:
    */
   friend abstract1& meet(manager& m, abstract1& dst, const abstract1& x, const lincons1_array& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the meet of x and some linear constraints, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract1& meet(manager& m, abstract1& dst, abstract1&& x, const lincons1_array& y);
+#endif
+
   /*! \brief Adds some arbitrary constraints to *this (modified in-place).
    *
    * \return a reference to *this.
@@ -529,6 +572,16 @@ public:
    */
   friend abstract1& meet(manager& m, abstract1& dst, const abstract1& x, const tcons1_array& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the meet of x and some arbitrary constraints, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract1& meet(manager& m, abstract1& dst, abstract1&& x, const tcons1_array& y);
+#endif
+
 
   /*! \brief Replaces *this with the meet of *this and the abstract element y.
    *
@@ -578,6 +631,16 @@ public:
    */
   friend abstract1& join(manager& m, abstract1& dst, const abstract1& x, const abstract1& y);
 
+#if __cplusplus >= 201103L
+  /*! \brief Replaces dst with the join of x and y, reusing x.
+   *
+   * x is modified in-place and moved into dst, without copy; x is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract1& join(manager& m, abstract1& dst, abstract1&& x, const abstract1& y);
+#endif
+
   /*! \brief Replaces dst with the join of all abstract elements in x.
    *
    * \return a reference to dst.
@@ -675,6 +738,16 @@ public:
    */
   friend abstract1& assign(manager& m, abstract1& dst, const abstract1& src, const var& v, const linexpr1& l, const abstract1& inter);
 
+#if __cplusplus >= 201103L
+  /*! \brief Assignment of linear expression, reusing src.
+   *
+   * src is modified in-place and moved into dst, without copy; src is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract1& assign(manager& m, abstract1& dst, abstract1&& src, const var& v, const linexpr1& l, const abstract1& inter);
+#endif
+
   /*! \brief Parallel assignment of linear expressions.
    *
    * dst is replaced with the effect of assigning l[i] to variable v[i] in src,
@@ -743,6 +816,16 @@ public:
    */
   friend abstract1& assign(manager& m, abstract1& dst, const abstract1& src, const var& v, const texpr1& l, const abstract1& inter);
 
+#if __cplusplus >= 201103L
+  /*! \brief Assignment of arbitrary expression, reusing src.
+   *
+   * src is modified in-place and moved into dst, without copy; src is left empty.
+   *
+   * \return a reference to dst.
+   */
+  friend abstract1& assign(manager& m, abstract1& dst, abstract1&& src, const var& v, const texpr1& l, const abstract1& inter);
+#endif
+
   /*! \brief Parallel assignment of arbitrary expressions.
    *
    * dst is replaced with the effect of assigning l[i] to variable v[i] in src,
@@ -101,6 +101,15 @@ inline abstract1::abstract1(const abstract1& t)
   manager::raise(a.abstract0->man, "apron::abstract1::abstract1(abstract1&)",a);
 }
 
+#if __cplusplus >= 201103L
+inline abstract1::abstract1(abstract1&& t) noexcept
+  : a(t.a)
+{
+  t.a.abstract0 = NULL;
+  t.a.env = NULL;
+}
+#endif
+
 
 /* destructor */
 /* ========== */
@@ -124,15 +133,23 @@ inline void abstract1::free(manager& m)
 inline abstract1& abstract1::operator=(const abstract1& t)
 {
   if (&t!=this) {
-    ap_abstract1_t r = ap_abstract1_copy(a.abstract0->man,
-					 const_cast<ap_abstract1_t*>(&t.a));
-    manager::raise(a.abstract0->man, "apron::abstract1::operator=(const abstract1&)",r);
-    ap_abstract1_clear(a.abstract0->man, &a);
+    ap_manager_t* man = a.abstract0 ? a.abstract0->man : t.a.abstract0->man;
+    ap_abstract1_t r = ap_abstract1_copy(man, const_cast<ap_abstract1_t*>(&t.a));
+    manager::raise(man, "apron::abstract1::operator=(const abstract1&)",r);
+    if (a.abstract0) ap_abstract1_clear(man, &a);
     a = r;
   }
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& abstract1::operator=(abstract1&& t) noexcept
+{
+  std::swap(a, t.a);
+  return *this;
+}
+#endif
+
 inline abstract1& abstract1::operator=(top t)
 {
   ap_abstract1_t r = ap_abstract1_top(a.abstract0->man, a.env);
@@ -425,6 +442,14 @@ inline size_t abstract1::size(manager& m) const
   return sz;
 }
 
+inline size_t abstract1::memory_size(manager& m) const
+{
+  size_t sz = ap_abstract1_memory_size(m.get_ap_manager_t(),
+				       const_cast<ap_abstract1_t*>(&a));
+  m.raise("apron::abstract1::memory_size(manager&)");
+  return sz;
+}
+
 
 /* predicates */
 /* ========== */
@@ -666,6 +691,22 @@ inline abstract1& meet(manager& m, abstract1& dst, const abstract1& x, const abs
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& meet(manager& m, abstract1& dst, abstract1&& x, const abstract1& y)
+{
+  ap_abstract1_t r =
+    ap_abstract1_meet(m.get_ap_manager_t(), true,
+		      &x.a,
+		      const_cast<ap_abstract1_t*>(&y.a));
+  x.a.abstract0 = NULL;
+  x.a.env = NULL;
+  m.raise("apron::meet(manager&, abstract1&, abstract1&&, const abstract1&)",r);
+  if (dst.a.abstract0) ap_abstract1_clear(m.get_ap_manager_t(), &dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract1& meet(manager& m, abstract1& dst, const std::vector<const abstract1*>& x)
 {
   ap_abstract1_t xx[x.size()];
@@ -713,6 +754,22 @@ inline abstract1& join(manager& m, abstract1& dst, const abstract1& x, const abs
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& join(manager& m, abstract1& dst, abstract1&& x, const abstract1& y)
+{
+  ap_abstract1_t r =
+    ap_abstract1_join(m.get_ap_manager_t(), true,
+		      &x.a,
+		      const_cast<ap_abstract1_t*>(&y.a));
+  x.a.abstract0 = NULL;
+  x.a.env = NULL;
+  m.raise("apron::join(manager&, abstract1&, abstract1&&, const abstract1&)",r);
+  if (dst.a.abstract0) ap_abstract1_clear(m.get_ap_manager_t(), &dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract1& join(manager& m, abstract1& dst, size_t sz, const abstract1 * const x[])
 {
   ap_abstract1_t xx[sz];
@@ -761,6 +818,22 @@ inline abstract1& meet(manager& m, abstract1& dst, const abstract1& x, const lin
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& meet(manager& m, abstract1& dst, abstract1&& x, const lincons1_array& y)
+{
+  ap_abstract1_t r =
+    ap_abstract1_meet_lincons_array(m.get_ap_manager_t(), true,
+				    &x.a,
+				    const_cast<ap_lincons1_array_t*>(y.get_ap_lincons1_array_t()));
+  x.a.abstract0 = NULL;
+  x.a.env = NULL;
+  m.raise("apron::meet(manager&, abstract1&, abstract1&&, const lincons1_array&)",r);
+  if (dst.a.abstract0) ap_abstract1_clear(m.get_ap_manager_t(), &dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 
 inline abstract1& abstract1::meet(manager& m, const tcons1_array& y)
 {
@@ -783,6 +856,22 @@ inline abstract1& meet(manager& m, abstract1& dst, const abstract1& x, const tco
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& meet(manager& m, abstract1& dst, abstract1&& x, const tcons1_array& y)
+{
+  ap_abstract1_t r =
+    ap_abstract1_meet_tcons_array(m.get_ap_manager_t(), true,
+				  &x.a,
+				  const_cast<ap_tcons1_array_t*>(y.get_ap_tcons1_array_t()));
+  x.a.abstract0 = NULL;
+  x.a.env = NULL;
+  m.raise("apron::meet(manager&, abstract1&, abstract1&&, const tcons1_array&)",r);
+  if (dst.a.abstract0) ap_abstract1_clear(m.get_ap_manager_t(), &dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 
 
 inline abstract1& abstract1::add_rays(manager& m, const generator1_array& y)
@@ -930,6 +1019,25 @@ inline abstract1& assign(manager& m, abstract1& dst, const abstract1& src, const
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& assign(manager& m, abstract1& dst, abstract1&& src, const var& v, const linexpr1& l, const abstract1& inter = abstract1::null)
+{
+  ap_abstract1_t r =
+    ap_abstract1_assign_linexpr_array(m.get_ap_manager_t(), true,
+				      &src.a,
+				      reinterpret_cast<ap_var_t*>(const_cast<var*>(&v)),
+				      const_cast<ap_linexpr1_t*>(l.get_ap_linexpr1_t()),
+				      1,
+				      ap_abstract1_t_or_null(inter));
+  src.a.abstract0 = NULL;
+  src.a.env = NULL;
+  m.raise("apron::assign(manager&, abstract1&, abstract1&&, const var&, const linexpr1&, const abstract1&)",r);
+  if (dst.a.abstract0) ap_abstract1_clear(m.get_ap_manager_t(), &dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract1& assign(manager& m, abstract1& dst, const abstract1& src, size_t size, const var v[], const linexpr1 * const l[], const abstract1& inter = abstract1::null)
 {
   ap_linexpr1_t ll[size];
@@ -1026,6 +1134,25 @@ inline abstract1& assign(manager& m, abstract1& dst, const abstract1& src, const
   return dst;
 }
 
+#if __cplusplus >= 201103L
+inline abstract1& assign(manager& m, abstract1& dst, abstract1&& src, const var& v, const texpr1& l, const abstract1& inter = abstract1::null)
+{
+  ap_abstract1_t r =
+    ap_abstract1_assign_texpr_array(m.get_ap_manager_t(), true,
+				    &src.a,
+				    reinterpret_cast<ap_var_t*>(const_cast<var*>(&v)),
+				    const_cast<ap_texpr1_t*>(l.get_ap_texpr1_t()),
+				    1,
+				    ap_abstract1_t_or_null(inter));
+  src.a.abstract0 = NULL;
+  src.a.env = NULL;
+  m.raise("apron::assign(manager&, abstract1&, abstract1&&, const var&, const texpr1&, const abstract1&)",r);
+  if (dst.a.abstract0) ap_abstract1_clear(m.get_ap_manager_t(), &dst.a);
+  dst.a = r;
+  return dst;
+}
+#endif
+
 inline abstract1& assign(manager& m, abstract1& dst, const abstract1& src, size_t size, const var v[], const texpr1 * const l[], const abstract1& inter = abstract1::null)
 {
   ap_texpr1_t ll[size];
@@ -73,6 +73,14 @@ public:
   //! (Deep) copy of a generator.
   generator0(const generator0& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  generator0(generator0&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of a generator, and applies a dimension change to the underlying linear expression.
   generator0(const generator0& x, const dimchange& d);
 
@@ -93,6 +101,11 @@ public:
   //! (Deep) copy.
   generator0& operator= (const generator0& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  generator0& operator=(generator0&& x) noexcept;
+#endif
+
 
   /* dimension operations */
   /* ==================== */
@@ -240,6 +253,14 @@ public:
   //! (Deep) copy.
   generator0_array(const generator0_array& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array.
+   */
+  generator0_array(generator0_array&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of the array and applies add_dimensions to all generators.
   generator0_array(const generator0_array& x, const dimchange& d);
 
@@ -276,6 +297,11 @@ public:
   //! (Deep) copy.
   generator0_array& operator= (const generator0_array& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  generator0_array& operator=(generator0_array&& x) noexcept;
+#endif
+
   /*! \brief Copies the generators from the array into *this.
    *
    * \arg x should contain (at least) size elements.
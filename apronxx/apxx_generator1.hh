@@ -84,6 +84,14 @@ public:
   //! (Deep) copy of a generator.
   generator1(const generator1& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  generator1(generator1&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of x and extends its environment.
    *
    * \throw std::invalid_argument if e is not a super-environment of that of x.
@@ -116,6 +124,11 @@ public:
   //! Makes a (deep) copy.
   generator1& operator= (const generator1& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  generator1& operator=(generator1&& x) noexcept;
+#endif
+
   /*! \brief Sets the underlying linear expression to c (copied).
    *
    * Does not fail as get_linexpr can: if the generator was created without an underlying expression, 
@@ -303,6 +316,14 @@ public:
   //! (Deep) copy.
   generator1_array(const generator1_array& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array on the same environment.
+   */
+  generator1_array(generator1_array&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of x and extends its environment.
    *
    * \throw std::invalid_argument if e is not a super-environment of that of x.
@@ -349,6 +370,11 @@ public:
   //! (Deep) copy.
   generator1_array& operator= (const generator1_array& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  generator1_array& operator=(generator1_array&& x) noexcept;
+#endif
+
   /*! \brief Copies the generators from the array into *this.
    *
    * \warning assumes that all generators have the same environment (unchecked).
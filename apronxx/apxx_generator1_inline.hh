@@ -52,6 +52,15 @@ inline generator1::generator1(const generator1& x)
   l = ap_generator1_copy(const_cast<ap_generator1_t*>(&x.l));
 }
 
+#if __cplusplus >= 201103L
+inline generator1::generator1(generator1&& x) noexcept
+  : l(x.l)
+{
+  x.l.generator0.linexpr0 = NULL;
+  x.l.env = NULL;
+}
+#endif
+
 inline generator1::generator1(const generator1& x, const environment& e)
 {
   if (!x.has_linexpr())
@@ -84,6 +93,14 @@ inline generator1& generator1::operator= (const generator1& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline generator1& generator1::operator=(generator1&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline void generator1::set_linexpr(const linexpr1& c)
 {
   get_generator0().set_linexpr(c.get_linexpr0());
@@ -258,6 +275,16 @@ inline generator1_array::generator1_array(const generator1_array& x)
     a.generator0_array.p[i] = ap_generator0_copy(&x.a.generator0_array.p[i]);
 }
 
+#if __cplusplus >= 201103L
+inline generator1_array::generator1_array(generator1_array&& x) noexcept
+  : a(x.a)
+{
+  x.a.generator0_array.p = NULL;
+  x.a.generator0_array.size = 0;
+  x.a.env = ap_environment_copy(a.env);
+}
+#endif
+
 inline generator1_array::generator1_array(const generator1_array& x, const environment& e)
 {
   bool r = 
@@ -311,6 +338,14 @@ inline generator1_array& generator1_array::operator= (const generator1_array& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline generator1_array& generator1_array::operator=(generator1_array&& x) noexcept
+{
+  std::swap(a, x.a);
+  return *this;
+}
+#endif
+
 inline generator1_array& generator1_array::operator= (const generator1 x[])
 {
   size_t sz = size();
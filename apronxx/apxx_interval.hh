@@ -329,6 +329,14 @@ public:
   //! Makes a copy of an interval array (copying all elements).
   interval_array(const interval_array &x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array.
+   */
+  interval_array(interval_array&& x) noexcept;
+#endif
+
   //! Makes a interval array from an interval vector (copying all elements).
   interval_array(const std::vector<interval>& x);
 
@@ -362,6 +370,11 @@ public:
    */
   interval_array& operator= (const interval_array &x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  interval_array& operator=(interval_array&& x) noexcept;
+#endif
+
   /*! \brief Copies an interval vector into *this.
    *
    * All elements are copied and the array size is updated if necessary.
@@ -371,6 +371,15 @@ inline interval_array::interval_array(const interval_array &x)
     ap_interval_set(c[i], x.c[i]);
 }
 
+#if __cplusplus >= 201103L
+inline interval_array::interval_array(interval_array&& x) noexcept
+  : sz(x.sz), c(x.c)
+{
+  x.sz = 0;
+  x.c = NULL;
+}
+#endif
+
 inline interval_array::interval_array(const std::vector<interval>& x)
   : sz(x.size()), c(ap_interval_array_alloc(x.size()))
 {
@@ -413,6 +422,15 @@ inline interval_array& interval_array::operator= (const interval_array &x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline interval_array& interval_array::operator=(interval_array&& x) noexcept
+{
+  std::swap(sz, x.sz);
+  std::swap(c, x.c);
+  return *this;
+}
+#endif
+
 inline interval_array& interval_array::operator= (const std::vector<interval>& x)
 {
   if (sz != x.size()) {
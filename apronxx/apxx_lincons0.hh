@@ -84,6 +84,14 @@ public:
   //! (Deep) copy of a constraint.
   lincons0(const lincons0& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  lincons0(lincons0&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of a constraint, and applies a dimension change to the underlying linear expression.
   lincons0(const lincons0& x, const dimchange& d);
 
@@ -117,6 +125,11 @@ public:
   //! (Deep) copy.
   lincons0& operator= (const lincons0& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  lincons0& operator=(lincons0&& x) noexcept;
+#endif
+
   //! Assigns an unsatisfiable constraint to *this (-1>=0).
   lincons0& operator= (unsat x);
 
@@ -367,6 +380,14 @@ public:
   //! (Deep) copy.
   lincons0_array(const lincons0_array& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array.
+   */
+  lincons0_array(lincons0_array&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of the array and applies add_dimensions to all constraints.
   lincons0_array(const lincons0_array& x, const dimchange& d);
 
@@ -403,6 +424,11 @@ public:
   //! (Deep) copy.
   lincons0_array& operator= (const lincons0_array& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  lincons0_array& operator=(lincons0_array&& x) noexcept;
+#endif
+
   /*! \brief Copies the constraints from the array into *this.
    *
    * \arg x should contain (at least) size elements.
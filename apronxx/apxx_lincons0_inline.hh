@@ -46,6 +46,15 @@ inline lincons0::lincons0(const lincons0& x)
   l = ap_lincons0_copy(const_cast<ap_lincons0_t*>(&x.l)); 
 }
 
+#if __cplusplus >= 201103L
+inline lincons0::lincons0(lincons0&& x) noexcept
+  : l(x.l)
+{
+  x.l.linexpr0 = NULL;
+  x.l.scalar = NULL;
+}
+#endif
+
 inline lincons0::lincons0(unsat x)
 { 
   l = ap_lincons0_make_unsat();
@@ -87,6 +96,14 @@ inline lincons0& lincons0::operator= (const lincons0& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline lincons0& lincons0::operator=(lincons0&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline lincons0& lincons0::operator= (unsat x)
 { 
   ap_lincons0_clear(&l); 
@@ -280,6 +297,15 @@ inline lincons0_array::lincons0_array(const lincons0_array& x)
     a.p[i] = ap_lincons0_copy(&x.a.p[i]);
 }
 
+#if __cplusplus >= 201103L
+inline lincons0_array::lincons0_array(lincons0_array&& x) noexcept
+  : a(x.a)
+{
+  x.a.p = NULL;
+  x.a.size = 0;
+}
+#endif
+
 inline lincons0_array::lincons0_array(size_t size, const lincons0 x[]) 
   : a(ap_lincons0_array_make(size))
 { 
@@ -329,6 +355,14 @@ inline lincons0_array& lincons0_array::operator= (const lincons0_array& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline lincons0_array& lincons0_array::operator=(lincons0_array&& x) noexcept
+{
+  std::swap(a, x.a);
+  return *this;
+}
+#endif
+
 inline lincons0_array& lincons0_array::operator= (const lincons0 x[])
 {
   size_t size = a.size;
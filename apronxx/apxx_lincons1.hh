@@ -91,6 +91,14 @@ public:
   //! (Deep) copy of a constraint.
   lincons1(const lincons1& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  lincons1(lincons1&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of x and extends its environment.
    *
    * \throw std::invalid_argument if e is not a super-environment of that of x.
@@ -123,6 +131,11 @@ public:
   //! Makes a (deep) copy.
   lincons1& operator= (const lincons1& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  lincons1& operator=(lincons1&& x) noexcept;
+#endif
+
   //! Assigns an unsatisfiable constraint to *this (-1>=0).
   lincons1& operator= (unsat x);
 
@@ -362,6 +375,14 @@ public:
   //! (Deep) copy.
   lincons1_array(const lincons1_array& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array on the same environment.
+   */
+  lincons1_array(lincons1_array&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of x and extends its environment.
    *
    * \throw std::invalid_argument if e is not a super-environment of that of x.
@@ -408,6 +429,11 @@ public:
   //! (Deep) copy.
   lincons1_array& operator= (const lincons1_array& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  lincons1_array& operator=(lincons1_array&& x) noexcept;
+#endif
+
   /*! \brief Copies the constraints from the array into *this.
    *
    * \warning assumes that all constraints have the same environment (unchecked).
@@ -63,6 +63,16 @@ inline lincons1::lincons1(const lincons1& x)
   l = ap_lincons1_copy(const_cast<ap_lincons1_t*>(&x.l));
 }
 
+#if __cplusplus >= 201103L
+inline lincons1::lincons1(lincons1&& x) noexcept
+  : l(x.l)
+{
+  x.l.lincons0.linexpr0 = NULL;
+  x.l.lincons0.scalar = NULL;
+  x.l.env = NULL;
+}
+#endif
+
 inline lincons1::lincons1(const lincons1& x, const environment& e)
 {
   if (!x.has_linexpr())
@@ -95,6 +105,14 @@ inline lincons1& lincons1::operator= (const lincons1& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline lincons1& lincons1::operator=(lincons1&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline lincons1& lincons1::operator= (unsat x)
 {
   ap_lincons1_t ll = ap_lincons1_make_unsat(ap_lincons1_envref(&l));
@@ -321,6 +339,16 @@ inline lincons1_array::lincons1_array(const lincons1_array& x)
     a.lincons0_array.p[i] = ap_lincons0_copy(&x.a.lincons0_array.p[i]);
 }
 
+#if __cplusplus >= 201103L
+inline lincons1_array::lincons1_array(lincons1_array&& x) noexcept
+  : a(x.a)
+{
+  x.a.lincons0_array.p = NULL;
+  x.a.lincons0_array.size = 0;
+  x.a.env = ap_environment_copy(a.env);
+}
+#endif
+
 inline lincons1_array::lincons1_array(const lincons1_array& x, const environment& e)
 {
   bool r = 
@@ -374,6 +402,14 @@ inline lincons1_array& lincons1_array::operator= (const lincons1_array& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline lincons1_array& lincons1_array::operator=(lincons1_array&& x) noexcept
+{
+  std::swap(a, x.a);
+  return *this;
+}
+#endif
+
 inline lincons1_array& lincons1_array::operator= (const lincons1 x[])
 {
   size_t sz = size();
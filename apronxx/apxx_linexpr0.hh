@@ -72,6 +72,14 @@ public:
   //! Makes a (deep) copy.
   linexpr0(const linexpr0& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty expression.
+   */
+  linexpr0(linexpr0&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy, and adds some dimensions (shifting coefficients if needed).
   linexpr0(const linexpr0& x, const dimchange& d);
 
@@ -127,6 +135,11 @@ public:
   //! Makes a (deep) copy.
   linexpr0& operator= (const linexpr0& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  linexpr0& operator=(linexpr0&& x) noexcept;
+#endif
+
   //@}
 
 
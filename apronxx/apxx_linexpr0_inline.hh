@@ -73,6 +73,14 @@ inline linexpr0::linexpr0(const linexpr0& x)
   apxx_linexpr0_copy(&l, &x.l);
 }
 
+#if __cplusplus >= 201103L
+inline linexpr0::linexpr0(linexpr0&& x) noexcept
+{
+  apxx_linexpr0_init(&l, x.l.discr, 0);
+  std::swap(l, x.l);
+}
+#endif
+
 inline linexpr0::linexpr0(const linexpr0& x, const dimchange& d)
 {
   ap_linexpr0_t* p;
@@ -136,6 +144,14 @@ inline linexpr0& linexpr0::operator= (const linexpr0& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline linexpr0& linexpr0::operator=(linexpr0&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 
 /* dimension operations */
 /* ==================== */
@@ -73,6 +73,14 @@ public:
   //! Makes a (deep) copy.
   linexpr1(const linexpr1& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  linexpr1(linexpr1&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of x and extends its environment.
    *
    * \throw std::invalid_argument if e is not a super-environment of that of x.
@@ -105,6 +113,11 @@ public:
   //! Makes a (deep) copy.
   linexpr1& operator= (const linexpr1& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  linexpr1& operator=(linexpr1&& x) noexcept;
+#endif
+
   //@}
 
 
@@ -122,7 +122,7 @@ class abstract1;
  * was created with (that is, a manager for the same library, created using the same
  * parameter values, if any),
  * - two threads should always operate on distinct arguments, and using distinct managers
- * (if they operate concurrently).
+ * (if they operate concurrently); ap_manager_pool_get hands out such managers, one per thread.
  *
  * The manager class is an abstract base class for all managers. It has no effective 
  * constructor.
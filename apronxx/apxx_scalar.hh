@@ -18,6 +18,7 @@
 
 #include <stdlib.h>
 #include <iostream>
+#include <utility>
 
 #include "ap_scalar.h"
 #include "gmpxx.h"
@@ -88,6 +88,14 @@ public:
   //! (Deep) copy of a constraint.
   tcons0(const tcons0& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  tcons0(tcons0&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of a constraint, and applies a dimension change to the underlying expression.
    *
    * \arg \c add whether to add or remove dimensions.
@@ -155,6 +163,11 @@ public:
   //! (Deep) copy.
   tcons0& operator= (const tcons0& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  tcons0& operator=(tcons0&& x) noexcept;
+#endif
+
   //! Assigns an unsatisfiable constraint to *this (-1>=0).
   tcons0& operator= (unsat x);
 
@@ -376,6 +389,14 @@ public:
   //! (Deep) copy.
   tcons0_array(const tcons0_array& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array.
+   */
+  tcons0_array(tcons0_array&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of the array and applies add_dimensions to all constraints.
   tcons0_array(const tcons0_array& x, const dimchange& d, bool add=true);
 
@@ -418,6 +439,11 @@ public:
   //! (Deep) copy.
   tcons0_array& operator= (const tcons0_array& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  tcons0_array& operator=(tcons0_array&& x) noexcept;
+#endif
+
   /*! \brief Copies the constraints from the array into *this.
    *
    * \arg x should contain (at least) size elements.
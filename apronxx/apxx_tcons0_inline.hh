@@ -46,6 +46,15 @@ inline tcons0::tcons0(const tcons0& x)
   l = ap_tcons0_copy(const_cast<ap_tcons0_t*>(&x.l)); 
 }
 
+#if __cplusplus >= 201103L
+inline tcons0::tcons0(tcons0&& x) noexcept
+  : l(x.l)
+{
+  x.l.texpr0 = NULL;
+  x.l.scalar = NULL;
+}
+#endif
+
 inline tcons0::tcons0(unsat x)
 { 
   l = ap_tcons0_make_unsat();
@@ -142,6 +151,14 @@ inline tcons0& tcons0::operator= (const tcons0& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline tcons0& tcons0::operator=(tcons0&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline tcons0& tcons0::operator= (unsat x)
 { 
   ap_tcons0_clear(&l); 
@@ -329,6 +346,15 @@ inline tcons0_array::tcons0_array(const tcons0_array& x)
     a.p[i] = ap_tcons0_copy(&x.a.p[i]);
 }
 
+#if __cplusplus >= 201103L
+inline tcons0_array::tcons0_array(tcons0_array&& x) noexcept
+  : a(x.a)
+{
+  x.a.p = NULL;
+  x.a.size = 0;
+}
+#endif
+
 inline tcons0_array::tcons0_array(size_t size, const tcons0 x[]) 
   : a(ap_tcons0_array_make(size))
 { 
@@ -389,6 +415,14 @@ inline tcons0_array& tcons0_array::operator= (const tcons0_array& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline tcons0_array& tcons0_array::operator=(tcons0_array&& x) noexcept
+{
+  std::swap(a, x.a);
+  return *this;
+}
+#endif
+
 inline tcons0_array& tcons0_array::operator= (const tcons0 x[])
 {
   size_t size = a.size;
@@ -81,6 +81,14 @@ public:
   //! (Deep) copy of a constraint.
   tcons1(const tcons1& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  tcons1(tcons1&& x) noexcept;
+#endif
+
 
   /*! \brief Makes a (deep) copy of x and extends its environment.
    *
@@ -146,6 +154,11 @@ public:
   //! (Deep) copy.
   tcons1& operator= (const tcons1& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  tcons1& operator=(tcons1&& x) noexcept;
+#endif
+
   //! Assigns an unsatisfiable constraint to *this (-1>=0).
   tcons1& operator= (unsat x);
 
@@ -368,6 +381,14 @@ public:
   //! (Deep) copy.
   tcons1_array(const tcons1_array& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as an empty array on the same environment.
+   */
+  tcons1_array(tcons1_array&& x) noexcept;
+#endif
+
   /*! \brief Makes a (deep) copy of the array and extends the environment.
    *
    * \throw std::invalid_argument if e is not a super-environment of that of x.
@@ -413,6 +434,11 @@ public:
   //! (Deep) copy.
   tcons1_array& operator= (const tcons1_array& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  tcons1_array& operator=(tcons1_array&& x) noexcept;
+#endif
+
   /*! \brief Copies the constraints from the array into *this.
    *
    * \warning assumes that all constraints have the same environment (unchecked).
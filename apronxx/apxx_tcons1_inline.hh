@@ -53,6 +53,16 @@ inline tcons1::tcons1(const tcons1& x)
   : l(ap_tcons1_copy(const_cast<ap_tcons1_t*>(&x.l)))
 {}
 
+#if __cplusplus >= 201103L
+inline tcons1::tcons1(tcons1&& x) noexcept
+  : l(x.l)
+{
+  x.l.tcons0.texpr0 = NULL;
+  x.l.tcons0.scalar = NULL;
+  x.l.env = NULL;
+}
+#endif
+
 inline tcons1::tcons1(const tcons1& x, const environment& e)
 {
   if (!x.l.tcons0.texpr0)
@@ -143,6 +153,14 @@ inline tcons1& tcons1::operator= (const tcons1& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline tcons1& tcons1::operator=(tcons1&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline tcons1& tcons1::operator= (unsat x)
 {
   ap_tcons0_clear(&l.tcons0);
@@ -351,6 +369,16 @@ inline tcons1_array::tcons1_array(const tcons1_array& x)
     a.tcons0_array.p[i] = ap_tcons0_copy(&x.a.tcons0_array.p[i]);
 }
 
+#if __cplusplus >= 201103L
+inline tcons1_array::tcons1_array(tcons1_array&& x) noexcept
+  : a(x.a)
+{
+  x.a.tcons0_array.p = NULL;
+  x.a.tcons0_array.size = 0;
+  x.a.env = ap_environment_copy(a.env);
+}
+#endif
+
 inline tcons1_array::tcons1_array(const tcons1_array& x, const environment& e)
 {
   bool r = 
@@ -404,6 +432,14 @@ inline tcons1_array& tcons1_array::operator= (const tcons1_array& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline tcons1_array& tcons1_array::operator=(tcons1_array&& x) noexcept
+{
+  std::swap(a, x.a);
+  return *this;
+}
+#endif
+
 inline tcons1_array& tcons1_array::operator= (const tcons1 x[])
 {
   size_t sz = size();
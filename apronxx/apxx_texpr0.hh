@@ -124,6 +124,14 @@ public:
   //! Makes a (deep) copy of the expression tree.
   texpr0(const texpr0& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left as the expression of dimension 0.
+   */
+  texpr0(texpr0&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of the expression tree.
   texpr0(const const_iterator& x);
 
@@ -169,6 +177,11 @@ public:
   //! Makes a (deep) copy of the expression.
   texpr0& operator=(const texpr0& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  texpr0& operator=(texpr0&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of the expression.
   texpr0& operator=(const const_iterator& x);
 
@@ -62,6 +62,15 @@ inline texpr0::texpr0(const const_iterator& x)
 inline texpr0::texpr0(const texpr0& x)
 { init_from(ap_texpr0_copy(const_cast<ap_texpr0_t*>(&x.l))); }
 
+#if __cplusplus >= 201103L
+inline texpr0::texpr0(texpr0&& x) noexcept
+  : l(x.l)
+{
+  x.l.discr = AP_TEXPR_DIM;
+  x.l.val.dim = 0;
+}
+#endif
+
 
 /* linear expression */
 
@@ -129,6 +138,14 @@ inline texpr0& texpr0::operator= (const texpr0& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline texpr0& texpr0::operator=(texpr0&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline texpr0& texpr0::operator= (const const_iterator& x)
 {
   // copy first, as x.l may alias this!
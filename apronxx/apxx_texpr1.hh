@@ -76,6 +76,14 @@ public:
   //! Makes a (deep) copy of the expression tree.
   texpr1(const texpr1& x);
 
+#if __cplusplus >= 201103L
+  /*! \brief Moves x into *this, without copying.
+   *
+   * x is left empty: it can only be destroyed or assigned to.
+   */
+  texpr1(texpr1&& x) noexcept;
+#endif
+
   /*! \brief Makes a variable name dimension leaf.
    *
    * \throw std::invalid_argument if the environment does not contain the variable.
@@ -145,6 +153,11 @@ public:
   //! Makes a (deep) copy of the expression.
   texpr1& operator=(const texpr1& x);
 
+#if __cplusplus >= 201103L
+  //! Exchanges the contents of *this and x, without copying.
+  texpr1& operator=(texpr1&& x) noexcept;
+#endif
+
   //! Makes a (deep) copy of the expression.
   texpr1& operator=(const const_iterator& x);
 
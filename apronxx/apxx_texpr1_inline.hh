@@ -37,6 +37,15 @@ inline texpr1::texpr1(const texpr1& x)
   init_from(ap_texpr1_copy(const_cast<ap_texpr1_t*>(&x.l)));
 }
 
+#if __cplusplus >= 201103L
+inline texpr1::texpr1(texpr1&& x) noexcept
+  : l(x.l)
+{
+  x.l.texpr0 = NULL;
+  x.l.env = ap_environment_copy(l.env);
+}
+#endif
+
 inline texpr1::texpr1(const builder& x)
 {
   init_from(ap_texpr1_copy(const_cast<ap_texpr1_t*>(x.get_ap_texpr1_t())));
@@ -123,6 +132,14 @@ inline texpr1& texpr1::operator=(const texpr1& x)
   return *this;
 }
 
+#if __cplusplus >= 201103L
+inline texpr1& texpr1::operator=(texpr1&& x) noexcept
+{
+  std::swap(l, x.l);
+  return *this;
+}
+#endif
+
 inline texpr1& texpr1::operator=(const builder& x)
 {
   ap_texpr1_t* c = ap_texpr1_copy(const_cast<ap_texpr1_t*>(x.get_ap_texpr1_t()));
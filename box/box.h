@@ -35,6 +35,9 @@ void box_free(ap_manager_t* man, box_t* a);
 size_t box_size(ap_manager_t* man, box_t* a);
   /* Return the itv size of a box value (see ap_manager_t) */
 
+size_t box_memory_size(ap_manager_t* man, box_t* a);
+  /* Return the number of bytes of heap memory used by the box value */
+
 /* ============================================================ */
 /* I.2 Control of internal representation */
 /* ============================================================ */
@@ -91,9 +94,16 @@ ap_membuf_t box_serialize_raw(ap_manager_t* man, box_t* a);
    of bytes written.  It is the user responsability to free the memory
    afterwards (with free). */
 
-box_t* box_deserialize_raw(ap_manager_t* man, void* ptr);
+box_t* box_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size);
 /* Return the box value read in raw binary format from the input stream
    and store in size the number of bytes read */
+
+struct ap_checkpoint_t;
+box_t* box_deserialize_mapped(ap_manager_t* man, void* ptr, size_t* size,
+			      struct ap_checkpoint_t* ck);
+/* Same as box_deserialize_raw, for a buffer in a mapped checkpoint file.
+   With a native numeric type, the intervals of the result point into the
+   buffer */
 /* ********************************************************************** */
 /* II. Constructor, accessors, tests and property extraction */
 /* ********************************************************************** */
@@ -37,13 +37,25 @@ box_t* box_assign_linexpr_array(ap_manager_t* man,
       exact = itv_eval_ap_linexpr0(intern->itv,
 				   res->p[tdim[0]],texpr[0],a->p);
   }
+  else if (destructive){
+    /* Evaluate the right-hand sides in a scratch buffer, then write
+       them back: no copy of the whole box */
+    itv_t* tmp = box_internal_assign_itv(intern,size);
+    res = a;
+    for (i=0;i<size;i++){
+      exact = itv_eval_ap_linexpr0(intern->itv,
+				   tmp[i],texpr[i],a->p) && exact;
+    }
+    for (i=0;i<size;i++){
+      itv_swap(res->p[tdim[i]],tmp[i]);
+    }
+  }
   else {
     res = box_copy(man,a);
     for (i=0;i<size;i++){
       exact = itv_eval_ap_linexpr0(intern->itv,
 				   res->p[tdim[i]],texpr[i],a->p) && exact;
     }
-    if (destructive) box_free(man,a);
   }
   if (dest)
     res = box_meet(man,true,res,dest);
@@ -110,12 +122,21 @@ box_t* box_assign_texpr_array(ap_manager_t* man,
     res = destructive ? a : box_copy(man,a);
     itv_eval_ap_texpr0(intern->itv,res->p[tdim[0]],texpr[0],a->p);
   }
+  else if (destructive){
+    itv_t* tmp = box_internal_assign_itv(intern,size);
+    res = a;
+    for (i=0;i<size;i++){
+      itv_eval_ap_texpr0(intern->itv,tmp[i],texpr[i],a->p);
+    }
+    for (i=0;i<size;i++){
+      itv_swap(res->p[tdim[i]],tmp[i]);
+    }
+  }
   else {
     res = box_copy(man,a);
     for (i=0;i<size;i++){
       itv_eval_ap_texpr0(intern->itv,res->p[tdim[i]],texpr[i],a->p);
     }
-    if (destructive) box_free(man,a);
   }
   if (dest)
     res = box_meet(man,true,res,dest);
@@ -22,6 +22,8 @@ void box_internal_init(box_internal_t* intern)
   itv_init(intern->meet_lincons_internal_itv2);
   itv_init(intern->meet_lincons_internal_itv3);
   bound_init(intern->meet_lincons_internal_bound);
+  intern->assign_itv = NULL;
+  intern->assign_itv_size = 0;
 }
 void box_internal_clear(box_internal_t* intern)
 {
@@ -37,6 +39,22 @@ void box_internal_clear(box_internal_t* intern)
   itv_clear(intern->meet_lincons_internal_itv2);
   itv_clear(intern->meet_lincons_internal_itv3);
   bound_clear(intern->meet_lincons_internal_bound);
+  if (intern->assign_itv){
+    itv_array_free(intern->assign_itv,intern->assign_itv_size);
+    intern->assign_itv = NULL;
+    intern->assign_itv_size = 0;
+  }
+}
+
+itv_t* box_internal_assign_itv(box_internal_t* intern, size_t size)
+{
+  if (intern->assign_itv_size<size){
+    if (intern->assign_itv)
+      itv_array_free(intern->assign_itv,intern->assign_itv_size);
+    intern->assign_itv = itv_array_alloc(size);
+    intern->assign_itv_size = size;
+  }
+  return intern->assign_itv;
 }
 
 box_internal_t* box_internal_alloc(void)
@@ -70,6 +88,7 @@ ap_manager_t* box_manager_alloc(void)
   funptr[AP_FUNID_COPY] = &box_copy;
   funptr[AP_FUNID_FREE] = &box_free;
   funptr[AP_FUNID_ASIZE] = &box_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &box_memory_size;
   funptr[AP_FUNID_MINIMIZE] = &box_minimize;
   funptr[AP_FUNID_CANONICALIZE] = &box_canonicalize;
   funptr[AP_FUNID_HASH] = &box_hash;
@@ -79,6 +98,7 @@ ap_manager_t* box_manager_alloc(void)
   funptr[AP_FUNID_FDUMP] = &box_fdump;
   funptr[AP_FUNID_SERIALIZE_RAW] = &box_serialize_raw;
   funptr[AP_FUNID_DESERIALIZE_RAW] = &box_deserialize_raw;
+  funptr[AP_FUNID_DESERIALIZE_MAPPED] = &box_deserialize_mapped;
   funptr[AP_FUNID_BOTTOM] = &box_bottom;
   funptr[AP_FUNID_TOP] = &box_top;
   funptr[AP_FUNID_OF_BOX] = &box_of_box;
@@ -10,6 +10,7 @@
 
 #include "box_config.h"
 #include "itv.h"
+#include "ap_checkpoint.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,6 +20,8 @@ struct box_t {
   itv_t* p;
   size_t intdim;
   size_t realdim;
+  ap_checkpoint_t* map; /* if not NULL, p lies in this mapped file,
+			   see box_deserialize_mapped */
 };
 
 ap_manager_t* box_manager_alloc(void);
@@ -35,6 +38,8 @@ typedef struct box_internal_t {
   itv_t meet_lincons_internal_itv2;
   itv_t meet_lincons_internal_itv3;
   bound_t meet_lincons_internal_bound;
+  itv_t* assign_itv; /* scratch buffer for destructive parallel assignments */
+  size_t assign_itv_size;
 } box_internal_t;
 
 void box_internal_init(box_internal_t* intern);
@@ -43,6 +48,9 @@ void box_internal_clear(box_internal_t* intern);
 box_internal_t* box_internal_alloc(void);
 void box_internal_free(box_internal_t* intern);
 
+itv_t* box_internal_assign_itv(box_internal_t* intern, size_t size);
+  /* Return the scratch buffer of intern, resized to at least size intervals */
+
 /* Initializes some fields of pk from manager */
 static inline box_internal_t* box_init_from_manager(ap_manager_t* man, ap_funid_t funid)
 {
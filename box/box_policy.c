@@ -353,7 +353,7 @@ void box_policy_meet_internal_improve(
     return;
   }
   nbdims = a1->intdim + a1->realdim;
-  if (policy->nbdims != nbdims) abort();
+  if (policy && policy->nbdims != nbdims) abort();
   for (i=0; i<nbdims; i++) {
     rpolicy->p[i] =
       itv_policy_meet_improve(
@@ -416,7 +416,7 @@ box_policy_t* box_policy_meet_array_improve(ap_policy_manager_t* pman,
   box_policy_t* rboxpolicy;
   box_t* res;
 
-  assert(size>0 && boxpolicy->size==size-1);
+  assert(size>0 && (boxpolicy ? boxpolicy->size==size-1 : true));
 
   if (size==1){
     return box_policy_alloc(pman,0,tab[0]->intdim+tab[0]->realdim);
@@ -427,7 +427,7 @@ box_policy_t* box_policy_meet_array_improve(ap_policy_manager_t* pman,
     res = box_copy(pman->man,tab[0]);
     rboxpolicy = box_policy_alloc(pman,size-1,tab[0]->intdim+tab[0]->realdim);
     for (i=1;i<size;i++){
-      box_policy_meet_internal_improve(pman->man,&rboxpolicy->p[i-1],&boxpolicy->p[i-1],res,tab[i]);
+      box_policy_meet_internal_improve(pman->man,&rboxpolicy->p[i-1],boxpolicy ? &boxpolicy->p[i-1] : NULL,res,tab[i]);
       res = box_policy_meet_internal_apply(pman->man,&rboxpolicy->p[i-1],true,res,tab[i]);
     }
     box_free(pman->man,res);
@@ -559,7 +559,7 @@ void box_policy_meet_lincons_internal(box_internal_t* intern,
 	  }
 	  if (rboxpolicy){
 	    cmp = bound_cmp(a->p[dim]->inf, intern->meet_lincons_internal_bound);
-	    rpolicy_dim->inf = (cmp==0 && boxpolicy) ? policy_dim->inf : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
+	    rpolicy_dim->inf = (cmp==0 && boxpolicy) ? boxpolicy->p[dim].inf : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
 	  }
 	  /* We update the interval */
 	  if (policy_dim->inf == BOX_POLICY_2){
@@ -584,7 +584,7 @@ void box_policy_meet_lincons_internal(box_internal_t* intern,
 	  }
 	  if (rboxpolicy){
 	    cmp = bound_cmp(a->p[dim]->sup, intern->meet_lincons_internal_bound);
-	    rpolicy_dim->sup = (cmp==0 && boxpolicy) ? policy_dim->sup : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
+	    rpolicy_dim->sup = (cmp==0 && boxpolicy) ? boxpolicy->p[dim].sup : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
 	  }
 	  /* We update the interval */
 	  if (policy_dim->sup == BOX_POLICY_2){
@@ -650,7 +650,7 @@ void box_policy_meet_lincons_internal(box_internal_t* intern,
 	  }
 	  if (rboxpolicy){
 	    cmp = bound_cmp(a->p[dim]->inf, intern->meet_lincons_internal_bound);
-	    rpolicy_dim->inf = (cmp==0 && boxpolicy) ? policy_dim->inf : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
+	    rpolicy_dim->inf = (cmp==0 && boxpolicy) ? boxpolicy->p[dim].inf : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
 	  }
 	  /* We update the interval */
 	  if (policy_dim->inf == BOX_POLICY_2){
@@ -692,7 +692,7 @@ void box_policy_meet_lincons_internal(box_internal_t* intern,
 	  }
 	  if (rboxpolicy){
 	    cmp = bound_cmp(a->p[dim]->sup, intern->meet_lincons_internal_bound);
-	    rpolicy_dim->sup = (cmp==0 && boxpolicy) ? policy_dim->sup : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
+	    rpolicy_dim->sup = (cmp==0 && boxpolicy) ? boxpolicy->p[dim].sup : (cmp<0 ? BOX_POLICY_1 : BOX_POLICY_2);
 	  }
 	  /* We update the interval */
 	  if (policy_dim->sup == BOX_POLICY_2){
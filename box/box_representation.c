@@ -17,6 +17,7 @@ box_t* box_alloc(size_t intdim, size_t realdim)
   itv->p = NULL;
   itv->intdim = intdim;
   itv->realdim = realdim;
+  itv->map = NULL;
   return itv;
 }
 
@@ -32,12 +33,31 @@ void box_init(box_t* a)
 
 void box_set_bottom(box_t* a)
 {
-  if (a->p){
+  if (a->map){
+    ap_checkpoint_free(a->map);
+    a->map = NULL;
+    a->p = NULL;
+  }
+  else if (a->p){
     itv_array_free(a->p,a->intdim+a->realdim+1);
     a->p = NULL;
   }
 }
 
+/* Copy the intervals of a to the heap if they lie in a mapped file, before
+   resizing them */
+void box_unmap(box_t* a)
+{
+  if (a->map){
+    size_t size = (a->intdim+a->realdim+1)*sizeof(itv_t);
+    itv_t* p = malloc(size);
+    memcpy(p,a->p,size); /* native numbers only, see box_deserialize_mapped */
+    a->p = p;
+    ap_checkpoint_free(a->map);
+    a->map = NULL;
+  }
+}
+
 void box_set_top(box_t* a)
 {
   size_t i;
@@ -98,10 +118,7 @@ box_t* box_copy(ap_manager_t* man, box_t* a)
 /* Free all the memory used by the abstract value */
 void box_free(ap_manager_t* man, box_t* a)
 {
-  if (a->p){
-    itv_array_free(a->p,a->intdim+a->realdim+1);
-    a->p = NULL;
-  }
+  box_set_bottom(a);
   free(a);
 }
 
@@ -111,6 +128,16 @@ size_t box_size(ap_manager_t* man, box_t* a)
   return 2*(a->intdim+a->realdim);
 }
 
+size_t box_memory_size(ap_manager_t* man, box_t* a)
+{
+  size_t nbdims = a->intdim+a->realdim;
+  size_t res = sizeof(box_t);
+  if (a->p && !a->map){
+    res += (nbdims+1)*sizeof(itv_t) + itv_heap_size_array(a->p,nbdims+1);
+  }
+  return res;
+}
+
 /* ********************************************************************** */
 /* 2. Control of internal representation */
 /* ********************************************************************** */
@@ -304,6 +331,17 @@ void box_fprintdiff(FILE* stream,
 /* 4. Serialization */
 /* ********************************************************************** */
 
+/* raw format:
+   0: uchar:  num_serialize_id
+   1: uchar:  state (0=bottom, 1=intervals)
+   2: uint32: intdim
+   6: uint32: realdim
+  10:   -   : padding, so that intervals are aligned in checkpoint files
+  16:   -   : intdim+realdim+1 intervals, as pairs of bound_t (inf,sup)
+*/
+
+#define BOX_SERIALIZE_HEADER 16
+
 /* Allocate a memory buffer (with malloc), output the abstract value in raw
    binary format to it and return a pointer on the memory buffer and the size
    of bytes written.  It is the user responsability to free the memory
@@ -311,17 +349,134 @@ void box_fprintdiff(FILE* stream,
 ap_membuf_t box_serialize_raw(ap_manager_t* man, box_t* a)
 {
   ap_membuf_t buf;
-  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_SERIALIZE_RAW,"");
-  buf.ptr = NULL;
-  buf.size = 0;
+  size_t i,n;
+  size_t nbdims = a->intdim+a->realdim;
+
+  man->result.flag_best = true;
+  man->result.flag_exact = true;
+  n = BOX_SERIALIZE_HEADER;
+  if (a->p){
+    for (i=0; i<nbdims+1; i++){
+      n += bound_serialized_size(a->p[i]->inf) + bound_serialized_size(a->p[i]->sup);
+    }
+  }
+  buf.ptr = malloc(n);
+  memset(buf.ptr,0,BOX_SERIALIZE_HEADER);
+  ((unsigned char*)buf.ptr)[0] = num_serialize_id();
+  ((unsigned char*)buf.ptr)[1] = a->p ? 1 : 0;
+  num_dump_word32((char*)buf.ptr+2,a->intdim);
+  num_dump_word32((char*)buf.ptr+6,a->realdim);
+  n = BOX_SERIALIZE_HEADER;
+  if (a->p){
+    for (i=0; i<nbdims+1; i++){
+      n += bound_serialize((char*)buf.ptr+n,a->p[i]->inf);
+      n += bound_serialize((char*)buf.ptr+n,a->p[i]->sup);
+    }
+  }
+  buf.size = n;
   return buf;
 }
 
+static void box_deserialize_error(ap_manager_t* man, const char* msg)
+{
+  ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,msg);
+}
+
+/* Read the header from the avail bytes available at ptr, return false if
+   it is not valid */
+static bool box_deserialize_header(ap_manager_t* man, void* ptr, size_t avail,
+				   unsigned char* state,
+				   size_t* intdim, size_t* realdim)
+{
+  if (avail<BOX_SERIALIZE_HEADER){
+    box_deserialize_error(man,"box_deserialize_raw: truncated header");
+    return false;
+  }
+  *state = ((unsigned char*)ptr)[1];
+  *intdim = num_undump_word32((char*)ptr+2);
+  *realdim = num_undump_word32((char*)ptr+6);
+  if (((unsigned char*)ptr)[0]!=num_serialize_id() || *state>1){
+    box_deserialize_error(man,"box_deserialize_raw: invalid header or numeric type");
+    return false;
+  }
+  return true;
+}
+
 /* Return the abstract value read in raw binary format from the input stream
-   and store in size the number of bytes read */
-box_t* box_deserialize_raw(ap_manager_t* man, void* ptr)
+   and store in size the number of bytes read. If size is not NULL, *size is
+   the number of bytes available at ptr, the intervals are checked against
+   it before allocating and reading them. */
+box_t* box_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size)
+{
+  unsigned char state;
+  size_t avail = size ? *size : (size_t)-1;
+  size_t intdim,realdim,i,k,n;
+  box_t* a;
+
+  man->result.flag_best = true;
+  man->result.flag_exact = true;
+  if (!box_deserialize_header(man,ptr,avail,&state,&intdim,&realdim))
+    return NULL;
+  n = BOX_SERIALIZE_HEADER;
+  if (state){
+    /* 2*(intdim+realdim+1) bounds of at least one byte each, then each of
+       them in turn */
+    if (intdim+realdim >= (avail-n)/2){
+      box_deserialize_error(man,"box_deserialize_raw: dimensions larger than the buffer");
+      return NULL;
+    }
+    for (i=0; i<2*(intdim+realdim+1); i++){
+      k = bound_deserialized_size((char*)ptr+n,avail-n);
+      if (!k){
+	box_deserialize_error(man,"box_deserialize_raw: truncated bounds");
+	return NULL;
+      }
+      n += k;
+    }
+    n = BOX_SERIALIZE_HEADER;
+  }
+  a = box_alloc(intdim,realdim);
+  if (state){
+    box_init(a);
+    for (i=0; i<intdim+realdim+1; i++){
+      n += bound_deserialize(a->p[i]->inf,(char*)ptr+n);
+      n += bound_deserialize(a->p[i]->sup,(char*)ptr+n);
+    }
+  }
+  if (size) *size = n;
+  return a;
+}
+
+/* Same as box_deserialize_raw, but with native numbers, the intervals of
+   the result point into the buffer, which lies in the mapping of ck */
+box_t* box_deserialize_mapped(ap_manager_t* man, void* ptr, size_t* size,
+			      ap_checkpoint_t* ck)
 {
-  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_DESERIALIZE_RAW,"");
-  return NULL;
+#if defined(BOUND_SERIALIZE_NATIVE)
+  unsigned char state;
+  size_t avail = size ? *size : (size_t)-1;
+  size_t intdim,realdim;
+  char* p = (char*)ptr+BOX_SERIALIZE_HEADER;
+  box_t* a;
+
+  if (sizeof(itv_t)==2*sizeof(bound_t) &&
+      (size_t)p % __alignof__(itv_t)==0 &&
+      avail>=BOX_SERIALIZE_HEADER && ((unsigned char*)ptr)[1]==1){
+    man->result.flag_best = true;
+    man->result.flag_exact = true;
+    if (!box_deserialize_header(man,ptr,avail,&state,&intdim,&realdim))
+      return NULL;
+    if (intdim+realdim >= (avail-BOX_SERIALIZE_HEADER)/sizeof(itv_t)){
+      box_deserialize_error(man,"box_deserialize_raw: dimensions larger than the buffer");
+      return NULL;
+    }
+    a = box_alloc(intdim,realdim);
+    a->p = (itv_t*)p;
+    a->map = ap_checkpoint_copy(ck);
+    if (size) *size = BOX_SERIALIZE_HEADER + (intdim+realdim+1)*sizeof(itv_t);
+    return a;
+  }
+#endif
+  return box_deserialize_raw(man,ptr,size);
 }
 
@@ -17,11 +17,13 @@ void box_init(box_t* a);
 void box_set_bottom(box_t* a);
 void box_set_top(box_t* a);
 void box_set(box_t* a, box_t* b);
+void box_unmap(box_t* a);
 
 /* 1. Memory */
 box_t* box_copy(ap_manager_t* man, box_t* a);
 void box_free(ap_manager_t* man, box_t* a);
 size_t box_size(ap_manager_t* man, box_t* a);
+size_t box_memory_size(ap_manager_t* man, box_t* a);
 
 /* 2. Control of internal representation */
 void box_minimize(ap_manager_t* man, box_t* a);
@@ -38,7 +40,9 @@ void box_printdiff(FILE* stream,
 
 /* 4. Serialization */
 ap_membuf_t box_serialize_raw(ap_manager_t* man, box_t* a);
-box_t* box_deserialize_raw(ap_manager_t* man, void* ptr);
+box_t* box_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size);
+box_t* box_deserialize_mapped(ap_manager_t* man, void* ptr, size_t* size,
+			      struct ap_checkpoint_t* ck);
 
 #ifdef __cplusplus
 }
@@ -3,6 +3,7 @@
 /* ********************************************************************** */
 
 #include "box_internal.h"
+#include "box_representation.h"
 #include "box_resize.h"
 
 box_t* box_add_dimensions(ap_manager_t* man,
@@ -21,6 +22,7 @@ box_t* box_add_dimensions(ap_manager_t* man,
   if (a->p==NULL){
     goto box_add_dimensions_exit;
   }
+  box_unmap(res);
   size = res->intdim+res->realdim;
   dimsup = dimchange->intdim+dimchange->realdim;
   res->p = realloc(res->p,(size+dimsup+1)*sizeof(itv_t));
@@ -64,6 +66,7 @@ box_t* box_remove_dimensions(ap_manager_t* man,
   if (a->p==NULL){
     goto box_remove_dimensions_exit;
   }
+  box_unmap(res);
   size = res->intdim+res->realdim;
   dimsup = dimchange->intdim+dimchange->realdim;
   k=0;
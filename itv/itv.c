@@ -403,7 +403,7 @@ void ITVFUN(itv_mul)(itv_internal_t* intern, itv_t a, itv_t b, itv_t c)
     /* b is positive, */
     itv_mulp(intern,a,c,b);
   }
-  else if (bound_sgn(c->sup)<=0){
+  else if (bound_sgn(b->sup)<=0){
     /* b is negative */
     itv_muln(intern,a,c,b);
   }
@@ -518,15 +518,10 @@ void itv_divn(itv_internal_t* intern,
   }
   else {
     /* 0 is in the middle of b: one cross-divide b by c->sup */
-    if (a!=b) {
-      bound_div(a->inf,b->sup,c->sup);
-      bound_div(a->sup,b->inf,c->sup);
-    }
-    else {
-      bound_div(intern->mul_bound,b->sup,c->sup);
-      bound_div(a->sup,b->inf,c->sup);
-      bound_set(a->inf,intern->mul_bound);
-    }
+    bound_neg(intern->mul_bound,c->sup);
+    bound_div(a->inf,b->inf,intern->mul_bound);
+    bound_div(a->sup,b->sup,intern->mul_bound);
+    bound_swap(a->inf,a->sup);
   }
 }
 
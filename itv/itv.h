@@ -87,6 +87,10 @@ static inline void itv_clear(itv_t a);
 static inline void itv_clear_array(itv_t* a, size_t size);
 static inline itv_t* itv_array_alloc(size_t size);
 static inline void itv_array_free(itv_t* a, size_t size);
+static inline size_t itv_heap_size(itv_t a);
+static inline size_t itv_heap_size_array(itv_t* a, size_t size);
+  /* Number of bytes allocated outside of the interval(s) (multiprecision
+     limbs), not counting the itv_t themselves */
 
 /* Assignement */
 static inline void itv_set(itv_t a, itv_t b);
@@ -361,6 +365,17 @@ static inline void itv_array_free(itv_t* a, size_t size)
   free(a);
 }
 
+static inline size_t itv_heap_size(itv_t a)
+{ return bound_heap_size(a->inf) + bound_heap_size(a->sup); }
+
+static inline size_t itv_heap_size_array(itv_t* a, size_t size)
+{
+  size_t i,n=0;
+  for (i=0;i<size;i++)
+    n += itv_heap_size(a[i]);
+  return n;
+}
+
 static inline void itv_set(itv_t a, itv_t b)
 {
   bound_set(a->inf,b->inf);
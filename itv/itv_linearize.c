@@ -780,8 +780,13 @@ static void itv_round(itv_t res, itv_t arg,
   case AP_RTYPE_QUAD:     /* 'round to quad' could be improved */
   case AP_RTYPE_EXTENDED: /* 'round to extended' could be improved */
   case AP_RTYPE_DOUBLE:
+#if defined(NUMFLT_DOUBLE)
+    /* bounds are already doubles, computed with outward rounding */
+    if (&res!=&arg) itv_set(res,arg);
+#else
     /* directed rounding cases (+oo, -oo, 0) could be improved */
     itv_to_double(res,arg);
+#endif
     break;
 
   default:
@@ -0,0 +1,157 @@
+/* Soundness testing of itv arithmetic against exact rational arithmetic.
+   Compile with
+
+   gcc test3.c itv.c -std=c99 -I../num -I../apron  -L../apron -lapron_debug -lmpfr -lgmp -lm -DNUM_DOUBLE
+
+   (replacing NUM_DOUBLE with your choice of NUM_)
+
+   Random intervals are combined with itv_add, itv_sub, itv_mul and
+   itv_div; the exact results on the bounds of the arguments, computed with
+   GMP rationals, must be included in the resulting interval.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "ap_manager.h"
+#include "num.h"
+#include "bound.h"
+#include "itv.h"
+
+itv_internal_t* intern;
+ap_scalar_t* scalar;
+int nb_errors = 0;
+
+/* Store in mpq the value of the (finite) bound b */
+void mpq_set_bound(mpq_t mpq, bound_t b)
+{
+  ap_scalar_set_bound(scalar,b);
+  ap_mpq_set_scalar(mpq,scalar,GMP_RNDU);
+}
+
+/* Compare bound b with mpq, as bound_cmp */
+int bound_cmp_mpq(bound_t b, mpq_t mpq)
+{
+  mpq_t q;
+  int res;
+  if (bound_infty(b)) return bound_sgn(b);
+  mpq_init(q);
+  mpq_set_bound(q,b);
+  res = mpq_cmp(q,mpq);
+  mpq_clear(q);
+  return res;
+}
+
+/* Random bound with a few significant bits, possibly infinite */
+void random_bound(bound_t b)
+{
+  num_t n;
+  num_init(n);
+  if (lrand48()%10==0)
+    bound_set_infty(b,lrand48()%2 ? 1 : -1);
+  else {
+    num_set_int2(n,lrand48()%2000-1000,lrand48()%16+1);
+    bound_set_num(b,n);
+  }
+  num_clear(n);
+}
+
+void random_itv(itv_t a)
+{
+  for (;;){
+    random_bound(a->inf);
+    random_bound(a->sup);
+    if (bound_cmp(a->inf,a->sup)>0) bound_swap(a->inf,a->sup);
+    if (bound_infty(a->inf) && bound_sgn(a->inf)>0) continue;
+    if (bound_infty(a->sup) && bound_sgn(a->sup)<0) continue;
+    break;
+  }
+  bound_neg(a->inf,a->inf);
+}
+
+/* Check that the exact value of op(x,y), for x a bound of b and y a bound
+   of c, belongs to a */
+void check(char* str, int op, itv_t a, itv_t b, itv_t c)
+{
+  bound_t x[2],y[2];
+  mpq_t qx,qy,qr;
+  int i,j;
+
+  bound_init(x[0]); bound_init(x[1]);
+  bound_init(y[0]); bound_init(y[1]);
+  mpq_init(qx); mpq_init(qy); mpq_init(qr);
+  bound_neg(x[0],b->inf); bound_set(x[1],b->sup);
+  bound_neg(y[0],c->inf); bound_set(y[1],c->sup);
+  for (i=0;i<2;i++){
+    if (bound_infty(x[i])) continue;
+    for (j=0;j<2;j++){
+      if (bound_infty(y[j])) continue;
+      mpq_set_bound(qx,x[i]);
+      mpq_set_bound(qy,y[j]);
+      switch (op){
+      case 0: mpq_add(qr,qx,qy); break;
+      case 1: mpq_sub(qr,qx,qy); break;
+      case 2: mpq_mul(qr,qx,qy); break;
+      case 3:
+	if (mpq_sgn(qy)==0) continue;
+	mpq_div(qr,qx,qy);
+	break;
+      default: abort();
+      }
+      mpq_neg(qr,qr);
+      if (bound_cmp_mpq(a->inf,qr)<0){
+	mpq_neg(qr,qr);
+	goto error;
+      }
+      mpq_neg(qr,qr);
+      if (bound_cmp_mpq(a->sup,qr)<0) goto error;
+    }
+  }
+  goto end;
+ error:
+  nb_errors++;
+  printf("%s unsound: b=",str); itv_print(b);
+  printf(" c="); itv_print(c);
+  printf(" result="); itv_print(a);
+  printf(" misses "); mpq_out_str(stdout,10,qr); printf("\n");
+ end:
+  bound_clear(x[0]); bound_clear(x[1]);
+  bound_clear(y[0]); bound_clear(y[1]);
+  mpq_clear(qx); mpq_clear(qy); mpq_clear(qr);
+}
+
+int main(int argc, char**argv)
+{
+  itv_t a,b,c;
+  long int seed;
+  int i,n = 100000;
+
+  ap_fpu_init();
+  mpfr_set_default_prec(4046);
+  seed = argc>1 ? atol(argv[1]) : 0;
+  srand48(seed);
+
+  intern = itv_internal_alloc();
+  scalar = ap_scalar_alloc();
+  itv_init(a); itv_init(b); itv_init(c);
+
+  for (i=0;i<n;i++){
+    random_itv(b);
+    random_itv(c);
+    itv_add(a,b,c);
+    check("itv_add",0,a,b,c);
+    itv_sub(a,b,c);
+    check("itv_sub",1,a,b,c);
+    itv_mul(intern,a,b,c);
+    check("itv_mul",2,a,b,c);
+    itv_div(intern,a,b,c);
+    check("itv_div",3,a,b,c);
+  }
+  printf("seed = %ld, %i tests, %i error(s)\n",seed,n,nb_errors);
+
+  itv_clear(a); itv_clear(b); itv_clear(c);
+  ap_scalar_free(scalar);
+  itv_internal_free(intern);
+  return nb_errors ? 1 : 0;
+}
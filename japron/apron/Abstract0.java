@@ -8,6 +8,8 @@
 
 package apron;
 
+import java.nio.ByteBuffer;
+
 /**
  * Class of level 0 numerical abstract values.
  *
@@ -137,6 +139,12 @@ public class Abstract0
     public native int getSize(Manager man)
         throws ApronException;
 
+    /**
+     * Returns the number of bytes allocated for the abstract element.
+     */
+    public native long getMemorySize(Manager man)
+        throws ApronException;
+
     /**
      * Returns a hash of the element value.
      */
@@ -257,6 +265,20 @@ public class Abstract0
     public native Generator0[] toGenerator(Manager man)
         throws ApronException;
 
+    /**
+     * Same as {@link #toLincons}, but returns the constraints packed in a
+     * direct ByteBuffer (see {@link apron.Lincons0#pack}).
+     */
+    public native ByteBuffer toLinconsPacked(Manager man)
+        throws ApronException;
+
+    /**
+     * Same as {@link #toGenerator}, but returns the generators packed in a
+     * direct ByteBuffer (see {@link apron.Generator0#pack}).
+     */
+    public native ByteBuffer toGeneratorPacked(Manager man)
+        throws ApronException;
+
 
 
     // Tests
@@ -470,6 +492,20 @@ public class Abstract0
     public native void meet(Manager man, Tcons0[] ar)
         throws ApronException;
 
+    /**
+     * Same as {@link #meetCopy(Manager, Lincons0[])}, with the constraints
+     * packed in the direct ByteBuffer b (see {@link apron.Lincons0#pack}).
+     */
+    public native Abstract0 meetPackedCopy(Manager man, ByteBuffer b)
+        throws ApronException;
+
+    /**
+     * Same as {@link #meet(Manager, Lincons0[])}, with the constraints
+     * packed in the direct ByteBuffer b (see {@link apron.Lincons0#pack}).
+     */
+    public native void meetPacked(Manager man, ByteBuffer b)
+        throws ApronException;
+
 
 
     /**
@@ -529,6 +565,20 @@ public class Abstract0
     public native void addRay(Manager man, Generator0[] ar)
         throws ApronException;
 
+    /**
+     * Same as {@link #addRayCopy(Manager, Generator0[])}, with the rays
+     * packed in the direct ByteBuffer b (see {@link apron.Generator0#pack}).
+     */
+    public native Abstract0 addRayPackedCopy(Manager man, ByteBuffer b)
+        throws ApronException;
+
+    /**
+     * Same as {@link #addRay(Manager, Generator0[])}, with the rays
+     * packed in the direct ByteBuffer b (see {@link apron.Generator0#pack}).
+     */
+    public native void addRayPacked(Manager man, ByteBuffer b)
+        throws ApronException;
+
     /**
      * Returns a new abstract element that contains (an over-approximation of)
      * this with one ray added.
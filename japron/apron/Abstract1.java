@@ -240,6 +240,17 @@ public class Abstract1
         return abs.getSize(man);
     }
 
+    /**
+     * Returns the number of bytes allocated for the abstract element.
+     *
+     * <p> The environment is not counted.
+     */
+    public long getMemorySize(Manager man)
+        throws ApronException
+    {
+        return abs.getMemorySize(man);
+    }
+
     /**
      * Returns a hash of the element value.
      */
@@ -9,6 +9,7 @@
 package apron;
 
 import java.io.*;
+import java.nio.*;
 
 /**
  * Class of geometrical features of level 0 linear abstract elements.
@@ -39,6 +40,10 @@ public class Generator0
      */
     public int kind;
 
+    private static native void class_init();
+
+    static { System.loadLibrary("japron"); class_init(); }
+
        
     // Constructors
     ///////////////
@@ -207,4 +212,37 @@ public class Generator0
     {
         kind = k;
     }
+
+
+    // Packed arrays
+    ////////////////
+
+    /**
+     * Returns a direct ByteBuffer holding the array of generators ar in 
+     * packed form.
+     *
+     * <p> The buffer is in native byte order and meant to be passed to
+     * {@link #unpack}, {@link #packedGet}, or the packed methods of 
+     * {@link apron.Abstract0} within the same process, without creating
+     * one Java object per generator and coefficient.
+     */
+    public static native ByteBuffer pack(Generator0[] ar);
+
+    /**
+     * Returns the array of generators packed in the direct ByteBuffer b.
+     *
+     * <p> Throws IllegalArgumentException if b does not hold a packed
+     * array of generators.
+     */
+    public static native Generator0[] unpack(ByteBuffer b);
+
+    /** Returns the number of generators packed in the direct ByteBuffer b. */
+    public static native int packedLength(ByteBuffer b);
+
+    /**
+     * Returns the i-th generator packed in the direct ByteBuffer b, 
+     * without unpacking the other ones.
+     */
+    public static native Generator0 packedGet(ByteBuffer b, int i);
+
 }
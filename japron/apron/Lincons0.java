@@ -9,6 +9,7 @@
 package apron;
 
 import java.io.*;
+import java.nio.*;
 
 /**
  * Class of level 0 linear constraints.
@@ -39,6 +40,10 @@ public class Lincons0
      */
     public Scalar scalar;
 
+    private static native void class_init();
+
+    static { System.loadLibrary("japron"); class_init(); }
+
     
     // Constructors
     ///////////////
@@ -382,5 +387,37 @@ public class Lincons0
         return (x instanceof Lincons0) && (isEqual((Lincons0)x));
     }
 
+
+    // Packed arrays
+    ////////////////
+
+    /**
+     * Returns a direct ByteBuffer holding the array of constraints ar in 
+     * packed form.
+     *
+     * <p> The buffer is in native byte order and meant to be passed to
+     * {@link #unpack}, {@link #packedGet}, or the packed methods of 
+     * {@link apron.Abstract0} within the same process, without creating
+     * one Java object per constraint and coefficient.
+     */
+    public static native ByteBuffer pack(Lincons0[] ar);
+
+    /**
+     * Returns the array of constraints packed in the direct ByteBuffer b.
+     *
+     * <p> Throws IllegalArgumentException if b does not hold a packed
+     * array of constraints.
+     */
+    public static native Lincons0[] unpack(ByteBuffer b);
+
+    /** Returns the number of constraints packed in the direct ByteBuffer b. */
+    public static native int packedLength(ByteBuffer b);
+
+    /**
+     * Returns the i-th constraint packed in the direct ByteBuffer b, 
+     * without unpacking the other ones.
+     */
+    public static native Lincons0 packedGet(ByteBuffer b, int i);
+
 }
 
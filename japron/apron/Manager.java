@@ -101,6 +101,8 @@ public class Manager
     static public final int FUNID_FOLD = 48;
     static public final int FUNID_WIDENING = 49;
     static public final int FUNID_CLOSURE = 50;
+    static public final int FUNID_MEMORY_SIZE = 51;
+    static public final int FUNID_DESERIALIZE_MAPPED = 52;
 
     // Scalar kinds
     ///////////////
@@ -175,7 +177,9 @@ public class Manager
     /** 
      * Sets a timeout for the given operation ({@link #FUNID_COPY}, etc.).
      * 
-     * <p> Note: timeouts are currently unimplemented.
+     * <p> The unit is the millisecond, 0 indicates no limit.
+     * <p> The check is cooperative, and only done in the long algorithms
+     * of some libraries (see {@link apron.TimeoutException}).
      */
     public native void setTimeout(int funid, int time);
 
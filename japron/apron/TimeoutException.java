@@ -15,7 +15,9 @@ package apron;
  * <p> The timeout is set by {@link apron.Manager#setTimeout}, on a
  * per-function, per-manager basis. There is no timeout by default.
  *
- * <p> Note: timeouts are not currently implemented.
+ * <p> Timeouts are checked in the long algorithms of some libraries:
+ * conversions of polyhedra, closures of octagons and joins of Taylor1+
+ * forms.
  */
 public class TimeoutException
     extends ApronException
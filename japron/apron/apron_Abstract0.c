@@ -118,6 +118,22 @@ JNIEXPORT jint JNICALL Java_apron_Abstract0_getSize
   return r;
 }
 
+/*
+ * Class:     apron_Abstract0
+ * Method:    getMemorySize
+ * Signature: (Lapron/Manager;)J
+ */
+JNIEXPORT jlong JNICALL Java_apron_Abstract0_getMemorySize
+  (JNIEnv *env, jobject a, jobject m)
+{
+  check_nonnull(a,0);
+  check_nonnull(m,0);
+  ap_manager_t* man = as_manager(m);
+  size_t r = ap_abstract0_memory_size(man, as_abstract0(a));
+  check_exc( { } );
+  return r;
+}
+
 
 /*
  * Class:     apron_Abstract0
@@ -299,6 +315,43 @@ JNIEXPORT jobjectArray JNICALL Java_apron_Abstract0_toGenerator
   return rr;
 }
 
+/*
+ * Class:     apron_Abstract0
+ * Method:    toLinconsPacked
+ * Signature: (Lapron/Manager;)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Abstract0_toLinconsPacked
+  (JNIEnv *env, jobject a, jobject m)
+{
+  check_nonnull(a,NULL);
+  check_nonnull(m,NULL);
+  ap_manager_t* man = as_manager(m);
+  ap_lincons0_array_t t = ap_abstract0_to_lincons_array(man, as_abstract0(a));
+  check_exc( { ap_lincons0_array_clear(&t); return NULL; } );
+  jobject rr = japron_lincons0_array_get_packed(env, &t);
+  ap_lincons0_array_clear(&t);
+  return rr;
+}
+
+/*
+ * Class:     apron_Abstract0
+ * Method:    toGeneratorPacked
+ * Signature: (Lapron/Manager;)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Abstract0_toGeneratorPacked
+  (JNIEnv *env, jobject a, jobject m)
+{
+  check_nonnull(a,NULL);
+  check_nonnull(m,NULL);
+  ap_manager_t* man = as_manager(m);
+  ap_generator0_array_t t =
+    ap_abstract0_to_generator_array(man, as_abstract0(a));
+  check_exc( { ap_generator0_array_clear(&t); return NULL; } );
+  jobject rr = japron_generator0_array_get_packed(env, &t);
+  ap_generator0_array_clear(&t);
+  return rr;
+}
+
 /*
  * Class:     apron_Abstract0
  * Method:    isBottom
@@ -681,6 +734,48 @@ JNIEXPORT void JNICALL Java_apron_Abstract0_meet__Lapron_Manager_2_3Lapron_Tcons
   check_exc( { } );
 }
 
+/*
+ * Class:     apron_Abstract0
+ * Method:    meetPackedCopy
+ * Signature: (Lapron/Manager;Ljava/nio/ByteBuffer;)Lapron/Abstract0;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Abstract0_meetPackedCopy
+  (JNIEnv *env, jobject a, jobject m, jobject b)
+{
+  check_nonnull(a,NULL);
+  check_nonnull(m,NULL);
+  check_nonnull(b,NULL);
+  ap_manager_t* man = as_manager(m);
+  ap_lincons0_array_t t;
+  if (!japron_lincons0_array_init_set_packed(env, &t, b)) return NULL;
+  ap_abstract0_t* r = 
+    ap_abstract0_meet_lincons_array(man, false, as_abstract0(a), &t);
+  ap_lincons0_array_clear(&t);
+  check_exc( { if (r) ap_abstract0_free(man, r); return NULL; } );
+  return japron_abstract0_get(env, man, r);
+}
+
+/*
+ * Class:     apron_Abstract0
+ * Method:    meetPacked
+ * Signature: (Lapron/Manager;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_apron_Abstract0_meetPacked
+  (JNIEnv *env, jobject a, jobject m, jobject b)
+{
+  check_nonnull(a,);
+  check_nonnull(m,);
+  check_nonnull(b,);
+  ap_manager_t* man = as_manager(m);
+  ap_lincons0_array_t t;
+  if (!japron_lincons0_array_init_set_packed(env, &t, b)) return;
+  ap_abstract0_t* r = 
+    ap_abstract0_meet_lincons_array(man, true, as_abstract0(a), &t);
+  ap_lincons0_array_clear(&t);
+  set_abstract0(a, r);
+  check_exc( { } );
+}
+
 /*
  * Class:     apron_Abstract0
  * Method:    addRayCopy
@@ -723,6 +818,48 @@ JNIEXPORT void JNICALL Java_apron_Abstract0_addRay
   check_exc( { } );
 }
 
+/*
+ * Class:     apron_Abstract0
+ * Method:    addRayPackedCopy
+ * Signature: (Lapron/Manager;Ljava/nio/ByteBuffer;)Lapron/Abstract0;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Abstract0_addRayPackedCopy
+  (JNIEnv *env, jobject a, jobject m, jobject b)
+{
+  check_nonnull(a,NULL);
+  check_nonnull(m,NULL);
+  check_nonnull(b,NULL);
+  ap_manager_t* man = as_manager(m);
+  ap_generator0_array_t t;
+  if (!japron_generator0_array_init_set_packed(env, &t, b)) return NULL;
+  ap_abstract0_t* r = 
+    ap_abstract0_add_ray_array(man, false, as_abstract0(a), &t);
+  ap_generator0_array_clear(&t);
+  check_exc( { if (r) ap_abstract0_free(man, r); return NULL; } );
+  return japron_abstract0_get(env, man, r);
+}
+
+/*
+ * Class:     apron_Abstract0
+ * Method:    addRayPacked
+ * Signature: (Lapron/Manager;Ljava/nio/ByteBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_apron_Abstract0_addRayPacked
+  (JNIEnv *env, jobject a, jobject m, jobject b)
+{
+  check_nonnull(a,);
+  check_nonnull(m,);
+  check_nonnull(b,);
+  ap_manager_t* man = as_manager(m);
+  ap_generator0_array_t t;
+  if (!japron_generator0_array_init_set_packed(env, &t, b)) return;
+  ap_abstract0_t* r = 
+    ap_abstract0_add_ray_array(man, true, as_abstract0(a), &t);
+  ap_generator0_array_clear(&t);
+  set_abstract0(a, r);
+  check_exc( { } );
+}
+
 /*
  * Class:     apron_Abstract0
  * Method:    assign
@@ -0,0 +1,100 @@
+/*
+ * apron_Generator0.c
+ *
+ * glue for Generator0.java
+ *
+ * APRON Library / Java Apron binding
+ *
+ * Copyright (C) Antoine Mine' 2010
+ */
+
+#include "japron.h"
+#include "apron_Generator0.h"
+
+//////////////////////////////////////
+
+/*
+ * Class:     apron_Generator0
+ * Method:    class_init
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_apron_Generator0_class_1init
+  (JNIEnv *env, jclass cls)
+{
+  japron_cache(env);
+}
+
+/*
+ * Class:     apron_Generator0
+ * Method:    pack
+ * Signature: ([Lapron/Generator0;)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Generator0_pack
+  (JNIEnv *env, jclass cls, jobjectArray ar)
+{
+  check_nonnull(ar,NULL);
+  ap_generator0_array_t t;
+  if (!japron_generator0_array_init_set(env, &t, ar)) return NULL;
+  jobject b = japron_generator0_array_get_packed(env, &t);
+  japron_generator0_array_clear(&t);
+  return b;
+}
+
+/*
+ * Class:     apron_Generator0
+ * Method:    unpack
+ * Signature: (Ljava/nio/ByteBuffer;)[Lapron/Generator0;
+ */
+JNIEXPORT jobjectArray JNICALL Java_apron_Generator0_unpack
+  (JNIEnv *env, jclass cls, jobject b)
+{
+  check_nonnull(b,NULL);
+  ap_generator0_array_t t;
+  if (!japron_generator0_array_init_set_packed(env, &t, b)) return NULL;
+  jobjectArray rr = japron_generator0_array_get(env, &t);
+  ap_generator0_array_clear(&t);
+  return rr;
+}
+
+/*
+ * Class:     apron_Generator0
+ * Method:    packedLength
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_apron_Generator0_packedLength
+  (JNIEnv *env, jclass cls, jobject b)
+{
+  check_nonnull(b,0);
+  size_t size;
+  void* p = japron_bytebuffer_set(env, b, &size);
+  if (!p) return 0;
+  size_t n = ap_generator0_array_packed_length(p, size);
+  if (n==(size_t)-1 || n>INT_MAX) {
+    illegal_argument("invalid packed generator array");
+    return 0;
+  }
+  return n;
+}
+
+/*
+ * Class:     apron_Generator0
+ * Method:    packedGet
+ * Signature: (Ljava/nio/ByteBuffer;I)Lapron/Generator0;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Generator0_packedGet
+  (JNIEnv *env, jclass cls, jobject b, jint i)
+{
+  check_nonnull(b,NULL);
+  check_positive(i,NULL);
+  size_t size;
+  void* p = japron_bytebuffer_set(env, b, &size);
+  if (!p) return NULL;
+  ap_generator0_t g;
+  if (!ap_generator0_unpack_nth(&g, p, size, i)) {
+    illegal_argument("invalid packed generator array or index");
+    return NULL;
+  }
+  jobject c = japron_generator0_get(env, &g);
+  ap_generator0_clear(&g);
+  return c;
+}
@@ -24,3 +24,89 @@ JNIEXPORT jboolean JNICALL Java_apron_Lincons0_isUnsat
   return r;
 }
 
+
+/*
+ * Class:     apron_Lincons0
+ * Method:    class_init
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_apron_Lincons0_class_1init
+  (JNIEnv *env, jclass cls)
+{
+  japron_cache(env);
+}
+
+/*
+ * Class:     apron_Lincons0
+ * Method:    pack
+ * Signature: ([Lapron/Lincons0;)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Lincons0_pack
+  (JNIEnv *env, jclass cls, jobjectArray ar)
+{
+  check_nonnull(ar,NULL);
+  ap_lincons0_array_t t;
+  if (!japron_lincons0_array_init_set(env, &t, ar)) return NULL;
+  jobject b = japron_lincons0_array_get_packed(env, &t);
+  japron_lincons0_array_clear(&t);
+  return b;
+}
+
+/*
+ * Class:     apron_Lincons0
+ * Method:    unpack
+ * Signature: (Ljava/nio/ByteBuffer;)[Lapron/Lincons0;
+ */
+JNIEXPORT jobjectArray JNICALL Java_apron_Lincons0_unpack
+  (JNIEnv *env, jclass cls, jobject b)
+{
+  check_nonnull(b,NULL);
+  ap_lincons0_array_t t;
+  if (!japron_lincons0_array_init_set_packed(env, &t, b)) return NULL;
+  jobjectArray rr = japron_lincons0_array_get(env, &t);
+  ap_lincons0_array_clear(&t);
+  return rr;
+}
+
+/*
+ * Class:     apron_Lincons0
+ * Method:    packedLength
+ * Signature: (Ljava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_apron_Lincons0_packedLength
+  (JNIEnv *env, jclass cls, jobject b)
+{
+  check_nonnull(b,0);
+  size_t size;
+  void* p = japron_bytebuffer_set(env, b, &size);
+  if (!p) return 0;
+  size_t n = ap_lincons0_array_packed_length(p, size);
+  if (n==(size_t)-1 || n>INT_MAX) {
+    illegal_argument("invalid packed constraint array");
+    return 0;
+  }
+  return n;
+}
+
+/*
+ * Class:     apron_Lincons0
+ * Method:    packedGet
+ * Signature: (Ljava/nio/ByteBuffer;I)Lapron/Lincons0;
+ */
+JNIEXPORT jobject JNICALL Java_apron_Lincons0_packedGet
+  (JNIEnv *env, jclass cls, jobject b, jint i)
+{
+  check_nonnull(b,NULL);
+  check_positive(i,NULL);
+  size_t size;
+  void* p = japron_bytebuffer_set(env, b, &size);
+  if (!p) return NULL;
+  ap_lincons0_t l;
+  if (!ap_lincons0_unpack_nth(&l, p, size, i)) {
+    illegal_argument("invalid packed constraint array or index");
+    return NULL;
+  }
+  jobject c = japron_lincons0_get(env, &l);
+  ap_lincons0_clear(&l);
+  return c;
+}
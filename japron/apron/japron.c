@@ -36,6 +36,8 @@ jclass japron_manager;
 jclass japron_abstract0;
 jclass japron_environment;
 jclass japron_dimension;
+jclass japron_bytebuffer;
+jclass japron_byteorder;
 
 jfieldID japron_mpqscalar_val;
 jfieldID japron_mpfrscalar_val;
@@ -80,6 +82,9 @@ jmethodID japron_environment_init;
 jmethodID japron_linexpr0_init;
 jmethodID japron_manager_init;
 jmethodID japron_texpr0intern_init;
+jmethodID japron_bytebuffer_allocatedirect;
+jmethodID japron_bytebuffer_order;
+jmethodID japron_byteorder_nativeorder;
 
 static int japron_cached = 0;
 
@@ -109,6 +114,8 @@ void japron_cache(JNIEnv *env)
   cache_class(japron_abstract0,    "apron/Abstract0");
   cache_class(japron_environment,  "apron/Environment");
   cache_class(japron_dimension,    "apron/Dimension");
+  cache_class(japron_bytebuffer,   "java/nio/ByteBuffer");
+  cache_class(japron_byteorder,    "java/nio/ByteOrder");
   cache_field(japron_mpqscalar_val,     japron_mpqscalar,    "val",     "Lgmp/Mpq;");
   cache_field(japron_mpfrscalar_val,    japron_mpfrscalar,   "val",     "Lgmp/Mpfr;");
   cache_field(japron_doublescalar_val,  japron_doublescalar, "val",     "D");
@@ -151,6 +158,18 @@ void japron_cache(JNIEnv *env)
   cache_init(japron_linexpr0);
   cache_init(japron_manager);
   cache_init(japron_texpr0intern);
+  japron_bytebuffer_allocatedirect =
+    (*env)->GetStaticMethodID(env, japron_bytebuffer, "allocateDirect",
+                              "(I)Ljava/nio/ByteBuffer;");
+  if (!japron_bytebuffer_allocatedirect) return;
+  japron_bytebuffer_order =
+    (*env)->GetMethodID(env, japron_bytebuffer, "order",
+                        "(Ljava/nio/ByteOrder;)Ljava/nio/ByteBuffer;");
+  if (!japron_bytebuffer_order) return;
+  japron_byteorder_nativeorder =
+    (*env)->GetStaticMethodID(env, japron_byteorder, "nativeOrder",
+                              "()Ljava/nio/ByteOrder;");
+  if (!japron_byteorder_nativeorder) return;
   japron_cached = 1;
 }
 
@@ -482,6 +501,22 @@ int japron_generator0_array_init_set(JNIEnv *env, ap_generator0_array_t* t, jobj
   return 1;
 }
 
+/* ap_generator0_t -> Generator0 */
+jobject japron_generator0_get(JNIEnv *env, ap_generator0_t* t)
+{
+  check_nonnull(t,NULL);
+  jobject c = (*env)->AllocObject(env, japron_generator0);
+  if (!c) return NULL;
+  (*env)->SetIntField(env, c, japron_generator0_kind, t->gentyp);
+  jobject e = (*env)->NewObject(env, japron_linexpr0, japron_linexpr0_init);
+  if (!e) return NULL;
+  ap_linexpr0_free(as_linexpr0(e));
+  set_linexpr0(e, t->linexpr0);
+  t->linexpr0 = NULL;
+  (*env)->SetObjectField(env, c, japron_generator0_coord, e);
+  return c;
+}
+
 /* ap_generator0_array_t -> Generator0[] */
 jobjectArray japron_generator0_array_get(JNIEnv *env, ap_generator0_array_t* t)
 {
@@ -490,20 +525,112 @@ jobjectArray japron_generator0_array_get(JNIEnv *env, ap_generator0_array_t* t)
   if (!o) return NULL;
   size_t i;
   for (i=0; i<t->size; i++) {
-    jobject c = (*env)->AllocObject(env, japron_generator0);
+    jobject c = japron_generator0_get(env, &t->p[i]);
     if (!c) return NULL;
-    (*env)->SetIntField(env, c, japron_generator0_kind, t->p[i].gentyp);
-    jobject e = (*env)->NewObject(env, japron_linexpr0, japron_linexpr0_init);
-    ap_linexpr0_free(as_linexpr0(e));
-    set_linexpr0(e, t->p[i].linexpr0);
-    t->p[i].linexpr0 = NULL;
-    (*env)->SetObjectField(env, c, japron_generator0_coord, e);
     (*env)->SetObjectArrayElement(env, o, i, c);
   }
   return o;
 }
 
 
+/* Packed arrays */
+/* ------------- */
+
+/* The packed arrays of ap_packed.h are exchanged as direct ByteBuffer
+   in native byte order. */
+
+/* new direct ByteBuffer of size bytes, its address is stored in *pbuf */
+static jobject japron_bytebuffer_alloc(JNIEnv *env, size_t size, void** pbuf)
+{
+  if (size>INT_MAX) {
+    illegal_argument("packed array is too large for a ByteBuffer");
+    return NULL;
+  }
+  jobject b = (*env)->CallStaticObjectMethod(env, japron_bytebuffer,
+                                             japron_bytebuffer_allocatedirect,
+                                             (jint)size);
+  if (!b) return NULL;
+  jobject o = (*env)->CallStaticObjectMethod(env, japron_byteorder,
+                                             japron_byteorder_nativeorder);
+  if (!o) return NULL;
+  b = (*env)->CallObjectMethod(env, b, japron_bytebuffer_order, o);
+  if (!b) return NULL;
+  *pbuf = (*env)->GetDirectBufferAddress(env, b);
+  if (!*pbuf) return NULL;
+  return b;
+}
+
+/* address and capacity of a direct ByteBuffer */
+void* japron_bytebuffer_set(JNIEnv *env, jobject b, size_t* psize)
+{
+  check_nonnull(b,NULL);
+  void* p = (*env)->GetDirectBufferAddress(env, b);
+  jlong size = (*env)->GetDirectBufferCapacity(env, b);
+  if (!p || size<0) {
+    illegal_argument("ByteBuffer is not direct");
+    return NULL;
+  }
+  *psize = size;
+  return p;
+}
+
+/* ap_lincons0_array_t -> packed ByteBuffer */
+jobject japron_lincons0_array_get_packed(JNIEnv *env, ap_lincons0_array_t* t)
+{
+  check_nonnull(t,NULL);
+  void* p;
+  size_t size = ap_lincons0_array_packed_size(t);
+  jobject b = japron_bytebuffer_alloc(env, size, &p);
+  if (!b) return NULL;
+  ap_lincons0_array_pack_into(p, size, t);
+  return b;
+}
+
+/* packed ByteBuffer -> ap_lincons0_array_t, to be freed with
+   ap_lincons0_array_clear */
+int japron_lincons0_array_init_set_packed(JNIEnv *env, ap_lincons0_array_t* t, jobject b)
+{
+  size_t size;
+  t->size = 0;
+  t->p = NULL;
+  void* p = japron_bytebuffer_set(env, b, &size);
+  if (!p) return 0;
+  if (!ap_lincons0_array_unpack(t, p, size)) {
+    illegal_argument("invalid packed constraint array");
+    return 0;
+  }
+  return 1;
+}
+
+/* ap_generator0_array_t -> packed ByteBuffer */
+jobject japron_generator0_array_get_packed(JNIEnv *env, ap_generator0_array_t* t)
+{
+  check_nonnull(t,NULL);
+  void* p;
+  size_t size = ap_generator0_array_packed_size(t);
+  jobject b = japron_bytebuffer_alloc(env, size, &p);
+  if (!b) return NULL;
+  ap_generator0_array_pack_into(p, size, t);
+  return b;
+}
+
+/* packed ByteBuffer -> ap_generator0_array_t, to be freed with
+   ap_generator0_array_clear */
+int japron_generator0_array_init_set_packed(JNIEnv *env, ap_generator0_array_t* t, jobject b)
+{
+  size_t size;
+  t->size = 0;
+  t->p = NULL;
+  void* p = japron_bytebuffer_set(env, b, &size);
+  if (!p) return 0;
+  if (!ap_generator0_array_unpack(t, p, size)) {
+    illegal_argument("invalid packed generator array");
+    return 0;
+  }
+  return 1;
+}
+
+
 /* Tcons0 */
 /* ------ */
 
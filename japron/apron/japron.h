@@ -36,6 +36,8 @@ extern jclass japron_manager;
 extern jclass japron_abstract0;
 extern jclass japron_environment;
 extern jclass japron_dimension;
+extern jclass japron_bytebuffer;
+extern jclass japron_byteorder;
 
 extern jfieldID japron_mpqscalar_val;
 extern jfieldID japron_mpfrscalar_val;
@@ -86,6 +88,9 @@ extern jmethodID japron_environment_init;
 extern jmethodID japron_linexpr0_init;
 extern jmethodID japron_manager_init;
 extern jmethodID japron_texpr0intern_init;
+extern jmethodID japron_bytebuffer_allocatedirect;
+extern jmethodID japron_bytebuffer_order;
+extern jmethodID japron_byteorder_nativeorder;
 
 /* fills cache, once */
 void japron_cache(JNIEnv *env);
@@ -171,10 +176,18 @@ void         japron_lincons0_array_clear   (ap_lincons0_array_t* t);
 int          japron_lincons0_array_init_set(JNIEnv *env, ap_lincons0_array_t* t, jobjectArray o);
 jobjectArray japron_lincons0_array_get     (JNIEnv *env, ap_lincons0_array_t* t);
 
+jobject japron_generator0_get(JNIEnv *env, ap_generator0_t* t);
+
 void         japron_generator0_array_clear   (ap_generator0_array_t* t);
 int          japron_generator0_array_init_set(JNIEnv *env, ap_generator0_array_t* t, jobjectArray o);
 jobjectArray japron_generator0_array_get     (JNIEnv *env, ap_generator0_array_t* t);
 
+void*   japron_bytebuffer_set(JNIEnv *env, jobject b, size_t* psize);
+jobject japron_lincons0_array_get_packed       (JNIEnv *env, ap_lincons0_array_t* t);
+int     japron_lincons0_array_init_set_packed  (JNIEnv *env, ap_lincons0_array_t* t, jobject b);
+jobject japron_generator0_array_get_packed     (JNIEnv *env, ap_generator0_array_t* t);
+int     japron_generator0_array_init_set_packed(JNIEnv *env, ap_generator0_array_t* t, jobject b);
+
 void    japron_tcons0_clear   (ap_tcons0_t* t);
 int     japron_tcons0_init_set(JNIEnv *env, ap_tcons0_t* t, jobject c);
 jobject japron_tcons0_get     (JNIEnv *env, ap_tcons0_t* t);
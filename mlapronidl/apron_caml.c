@@ -327,7 +327,7 @@ static
 unsigned long camlidl_apron_abstract0_deserialize(void * dst)
 {
   if (deserialize_man) {
-    size_t size = deserialize_uint_8(), realsize;
+    size_t size = deserialize_uint_8(), realsize = size;
     void* data;
     data = malloc(size);
     assert(data);
@@ -21,6 +21,7 @@
 #include "ap_abstract0.h"
 #include "ap_expr1.h"
 #include "ap_abstract1.h"
+#include "ap_packed.h"
 
 #include <caml/mlvalues.h>
 #include <caml/memory.h>
@@ -30,11 +31,23 @@
 #include <caml/custom.h>
 #include <caml/bigarray.h>
 #include <caml/intext.h>
+#include <caml/version.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Allocation of custom blocks wrapping C pointers. When available,
+   caml_alloc_custom_mem tells the GC the number of bytes held outside the
+   OCaml heap, which speeds up its collection. */
+#if OCAML_VERSION >= 40800
+#define camlidl_apron_alloc_custom(ops,size,mem,used,max) \
+  caml_alloc_custom_mem((ops),(size),(mem))
+#else
+#define camlidl_apron_alloc_custom(ops,size,mem,used,max) \
+  alloc_custom((ops),(size),(used),(max))
+#endif
+
 struct ap_interval_array_t {
   struct ap_interval_t** p;
   size_t size;
@@ -71,6 +84,12 @@ typedef struct ap_environment_t* ap_environment_ptr;
 
 typedef ap_abstract0_t* ap_abstract0_ptr;
 
+/* Packed arrays of constraints or generators (see ap_packed.h) */
+typedef struct ap_packed_t {
+  void* p;
+  size_t size;
+} ap_packed_t;
+
 typedef struct ap_abstract1_ptr {
   ap_abstract0_ptr ap_abstract0_ptr;
   ap_environment_t* env;
@@ -116,7 +135,8 @@ static inline
 value camlidl_apron_linexpr0_ptr_c2ml(ap_linexpr0_ptr* p)
 {
   value v;
-  v = alloc_custom(&camlidl_apron_custom_linexpr0_ptr, sizeof(ap_linexpr0_ptr), 0,1);
+  v = camlidl_apron_alloc_custom(&camlidl_apron_custom_linexpr0_ptr, sizeof(ap_linexpr0_ptr),
+				 ap_linexpr0_memory_size(*p), 0,1);
   *((ap_linexpr0_ptr *) Data_custom_val(v)) = *p;
   return v;
 }
@@ -127,6 +147,28 @@ value camlidl_apron_linexpr0_ptr_c2ml(ap_linexpr0_ptr* p)
 void camlidl_apron_lincons0_ml2c(value v, ap_lincons0_t* cons, struct camlidl_ctx_struct* _ctx);
 value camlidl_apron_lincons0_c2ml(ap_lincons0_t* cons);
 
+/* ********************************************************************** */
+/* packed arrays */
+/* ********************************************************************** */
+
+/* Packed arrays are Bigarrays of bytes. The C to ML conversion takes
+   ownership of the buffer, which should have been allocated with malloc:
+   it is not copied, and freed by the GC. */
+
+static inline
+void camlidl_apron_packed_ml2c(value v, ap_packed_t* packed)
+{
+  packed->p = Caml_ba_data_val(v);
+  packed->size = Caml_ba_array_val(v)->dim[0];
+}
+
+static inline
+value camlidl_apron_packed_c2ml(ap_packed_t* packed)
+{
+  return caml_ba_alloc_dims(CAML_BA_UINT8 | CAML_BA_C_LAYOUT | CAML_BA_MANAGED,
+			    1, packed->p, (intnat)packed->size);
+}
+
 /* ********************************************************************** */
 /* texpr0 */
 /* ********************************************************************** */
@@ -146,7 +188,8 @@ static inline
 value camlidl_apron_texpr0_ptr_c2ml(ap_texpr0_ptr* p)
 {
   value v;
-  v = alloc_custom(&camlidl_apron_custom_texpr0_ptr, sizeof(ap_texpr0_ptr), 0,1);
+  v = camlidl_apron_alloc_custom(&camlidl_apron_custom_texpr0_ptr, sizeof(ap_texpr0_ptr),
+				 ap_texpr0_memory_size(*p), 0,1);
   *((ap_texpr0_ptr *) Data_custom_val(v)) = *p;
   return v;
 }
@@ -230,13 +273,58 @@ value camlidl_apron_abstract0_ptr_c2ml(ap_abstract0_ptr* p)
 {
   value v;
   assert((*p)->man!=NULL);
-  v = alloc_custom(&camlidl_apron_custom_abstract0_ptr, sizeof(ap_abstract0_ptr),
-		   ap_abstract0_size((*p)->man,(*p)),
-		   camlidl_apron_heap);
+  v = camlidl_apron_alloc_custom(&camlidl_apron_custom_abstract0_ptr, sizeof(ap_abstract0_ptr),
+				 (*p)->man->funptr[AP_FUNID_MEMORY_SIZE] ?
+				 ap_abstract0_memory_size((*p)->man,(*p)) :
+				 sizeof(ap_abstract0_t),
+				 ap_abstract0_size((*p)->man,(*p)),
+				 camlidl_apron_heap);
   *((ap_abstract0_ptr *) Data_custom_val(v)) = *p;
   return v;
 }
 
+/* ********************************************************************** */
+/* Releasing the runtime system */
+/* ********************************************************************** */
+
+/* Potentially long operations on abstract values release the OCaml runtime
+   system around the call to the library, so that other threads (or domains)
+   can run meanwhile, typically analyses with their own managers.
+
+   The OCaml arguments are registered as local roots during the call, so that
+   the custom blocks owning the C objects handed to the library (managers,
+   abstract values, expressions, environments, variables) are not finalized
+   by another thread. These C objects are not moved by the GC.
+
+   MPQ and MPFR scalars are the exception: once converted, they point inside
+   custom blocks of the OCaml heap, that the GC may move. Calls with
+   intervals keep the runtime, and calls with constraints release it only if
+   no constraint carries such a scalar (only modulo constraints carry one). */
+
+static inline
+bool camlidl_apron_scalar_in_heap(ap_scalar_t* scalar)
+{
+  return scalar!=NULL && scalar->discr!=AP_SCALAR_DOUBLE;
+}
+static inline
+bool camlidl_apron_lincons0_array_in_heap(ap_lincons0_array_t* array)
+{
+  size_t i;
+  for (i=0; i<array->size; i++){
+    if (camlidl_apron_scalar_in_heap(array->p[i].scalar)) return true;
+  }
+  return false;
+}
+static inline
+bool camlidl_apron_tcons0_array_in_heap(ap_tcons0_array_t* array)
+{
+  size_t i;
+  for (i=0; i<array->size; i++){
+    if (camlidl_apron_scalar_in_heap(array->p[i].scalar)) return true;
+  }
+  return false;
+}
+
 /* ********************************************************************** */
 /* Variable */
 /* ********************************************************************** */
@@ -272,18 +360,18 @@ int ap_var_hash(ap_var_t pp)
 static inline
 ap_var_t ap_var_copy(ap_var_t pp){
   apron_var_ptr p = (apron_var_ptr)pp;
-  p->count++;
+  __atomic_add_fetch(&p->count,1,__ATOMIC_RELAXED);
   return (ap_var_t)p;
 }
 static inline
 void ap_var_free(ap_var_t pp){
   apron_var_ptr p = (apron_var_ptr)pp;
-  if (p->count<=1){
+  /* atomic, as environments may be shared between threads */
+  if (__atomic_load_n(&p->count,__ATOMIC_ACQUIRE)<=1 ||
+      __atomic_sub_fetch(&p->count,1,__ATOMIC_ACQ_REL)==0){
     free(p->name);
     free(p);
   }
-  else
-    p->count--;
 }
 static inline
 char* ap_var_to_string(ap_var_t pp)
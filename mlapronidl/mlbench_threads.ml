@@ -0,0 +1,103 @@
+(* mlbench_threads.ml
+ *
+ * Parallel speedup of abstract operations with one manager per thread
+ *
+ * APRON Library / OCaml interface
+ *
+ * This file is part of the APRON Library, released under LGPL license
+ * with an exception allowing the redistribution of statically linked
+ * executables.
+ *)
+
+(* compile with:
+
+ocamlfind ocamlopt -thread -package threads.posix,unix,gmp \
+   -I ${INSTALL_DIR}/lib apron.cmxa polkaMPQ.cmxa boxMPQ.cmxa \
+   mlbench_threads.ml -o mlbench_threads \
+   -cclib -lpolkaMPQ -cclib -lboxMPQ -cclib -lapron
+
+and run with:
+
+./mlbench_threads [nthreads] [njobs] [nbdims]
+
+Each job builds random polyhedra and boxes and iterates meets with
+constraints, joins, widenings and conversions to constraints. The jobs are
+run first sequentially, then spread over nthreads threads, each with its
+own managers. As the bindings release the runtime system during these
+operations, the second run should be close to nthreads times faster on a
+machine with enough cores.
+
+Octagons are not benchmarked: with DBMCACHE, their managers share a
+global cache of matrices that concurrent managers must not use.
+*)
+
+open Apron
+
+let nthreads = if Array.length Sys.argv > 1 then int_of_string Sys.argv.(1) else 4
+let njobs = if Array.length Sys.argv > 2 then int_of_string Sys.argv.(2) else 16
+let nbdims = if Array.length Sys.argv > 3 then int_of_string Sys.argv.(3) else 8
+let niter = 20
+
+let env =
+  Environment.make
+    (Array.init nbdims (fun i -> Var.of_string (Printf.sprintf "x%d" i)))
+    [||]
+
+(* Random constraint a*xi + b*xj + c >= 0 *)
+let random_lincons st =
+  let i = Random.State.int st nbdims
+  and j = Random.State.int st nbdims
+  and coeff st = Random.State.int st 7 - 3 in
+  let e = Linexpr1.make env in
+  Linexpr1.set_list e
+    [ (Coeff.s_of_int (coeff st), Var.of_string (Printf.sprintf "x%d" i));
+      (Coeff.s_of_int (coeff st), Var.of_string (Printf.sprintf "x%d" j)) ]
+    (Some (Coeff.s_of_int (Random.State.int st 20)));
+  Lincons1.make e Lincons1.SUPEQ
+
+let random_array st n =
+  let tab = Lincons1.array_make env n in
+  for k = 0 to n - 1 do Lincons1.array_set tab k (random_lincons st) done;
+  tab
+
+let job man seed =
+  let st = Random.State.make [| seed |] in
+  let acc = ref (Abstract1.bottom man env) in
+  for _ = 1 to niter do
+    let a = Abstract1.of_lincons_array man env (random_array st nbdims) in
+    let b = Abstract1.meet_lincons_array man a (random_array st 2) in
+    let j = Abstract1.join man !acc b in
+    acc := Abstract1.widening man !acc j;
+    ignore (Abstract1.to_lincons_array man !acc);
+    ignore (Abstract1.is_leq man b !acc)
+  done;
+  Abstract1.closure man !acc
+
+let run_jobs seeds =
+  let pk = Polka.manager_alloc_strict () and box = Box.manager_alloc () in
+  List.iter
+    (fun seed ->
+       ignore (job pk seed);
+       ignore (job box seed))
+    seeds
+
+let time f =
+  let t = Unix.gettimeofday () in
+  f ();
+  Unix.gettimeofday () -. t
+
+let () =
+  let seeds = List.init njobs (fun i -> i) in
+  let seq = time (fun () -> run_jobs seeds) in
+  let par =
+    time (fun () ->
+        let threads =
+          List.init nthreads (fun t ->
+              Thread.create run_jobs
+                (List.filter (fun s -> s mod nthreads = t) seeds))
+        in
+        List.iter Thread.join threads)
+  in
+  Printf.printf "jobs: %d, dims: %d, threads: %d\n" njobs nbdims nthreads;
+  Printf.printf "sequential: %.3fs\nparallel:   %.3fs\nspeedup:    %.2f\n"
+    seq par (seq /. par)
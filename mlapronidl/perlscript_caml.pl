@@ -23,10 +23,13 @@ while (<>) {
     s/^and ap_lincons0_array_t = ap_lincons0_t array//g;
     s/ap_lincons0_t/t/g;
     s/ap_lincons0_array_t/t array/g;
+    s/external ap_lincons0_/external /g;
+    s/ap_packed_t/packed/g;
     s/gentyp/typ/g;
     s/^and ap_generator0_array_t = ap_generator0_t array//g;
     s/ap_generator0_t/t/g;
     s/ap_generator0_array_t/t array/g;
+    s/external ap_generator0_/external /g;
     s/ap_texpr0_ptr/t/g;
     s/ap_texpr_unop_t/unop/g;
     s/ap_texpr_binop_t/binop/g;
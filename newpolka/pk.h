@@ -127,6 +127,11 @@ size_t pk_size(ap_manager_t* man, pk_t* a);
   /* Return the abstract size of a polyhedron, which is the number of
      coefficients of its current representation, possibly redundant. */
 
+size_t pk_memory_size(ap_manager_t* man, pk_t* a);
+  /* Return the number of bytes allocated for the polyhedron, including
+     its constraint and generator matrices, their saturation matrices and
+     the limbs of the coefficients. */
+
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
@@ -161,7 +161,8 @@ The result is given by ray, sat and pnbline. The
 status coefficient of rows of ray are set properly at the end of
 the function.
 
-Throw exception.
+Throw exception: out of space if the option max_object_size is
+exceeded, timeout if the deadline pk->deadline expires.
 */
 
 size_t cherni_conversion(pk_internal_t* pk,
@@ -188,6 +189,10 @@ size_t cherni_conversion(pk_internal_t* pk,
   k = bitindex_init(start);
   while (k.index < con->nbrows){
     /* Iteration sur les contraintes */
+    if (ap_deadline_expired(&pk->deadline,nbrows*nbcols)){
+      pk->exn = AP_EXC_TIMEOUT;
+      goto cherni_conversion_exit0;
+    }
     is_inequality = numint_sgn(con->p[k.index][0]);
 
     /* Scalar product and index: */
@@ -296,6 +301,10 @@ size_t cherni_conversion(pk_internal_t* pk,
 	  /* Compute the new cones by combining adjacent constraints: */
 	  bound = nbrows;
 	  for (i=equal_bound; i<sup_bound; i++){
+	    if (ap_deadline_expired(&pk->deadline,(bound-sup_bound)*bound)){
+	      pk->exn = AP_EXC_TIMEOUT;
+	      goto cherni_conversion_exit0;
+	    }
 	    for(j=sup_bound; j<bound; j++){
 	      /* For each pair R+,R-, */
 	      /* compute the set of constraints saturated by both of them,
@@ -25,6 +25,8 @@ void pk_internal_init(pk_internal_t* pk, size_t maxdims)
   size_t i;
 
   pk->exn = AP_EXC_NONE;
+  pk->deadline.end = 0.0; /* no timeout until pk_init_from_manager */
+  pk->deadline.budget = AP_DEADLINE_PERIOD;
 
   pk->maxdims = maxdims;
   pk->maxcols = maxdims+3;
@@ -215,6 +217,7 @@ ap_manager_t* pk_manager_alloc(bool strict)
   funptr[AP_FUNID_COPY] = &pk_copy;
   funptr[AP_FUNID_FREE] = &pk_free;
   funptr[AP_FUNID_ASIZE] = &pk_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &pk_memory_size;
   funptr[AP_FUNID_MINIMIZE] = &pk_minimize;
   funptr[AP_FUNID_CANONICALIZE] = &pk_canonicalize;
   funptr[AP_FUNID_HASH] = &pk_hash;
@@ -38,6 +38,7 @@ struct pk_internal_t {
 
   ap_funid_t funid;
   ap_funopt_t* funopt;
+  ap_deadline_t deadline; /* from funopt->timeout, see cherni_conversion */
 
   size_t max_coeff_size; /* Used for overflow exception in vector_combine */
   size_t approximate_max_coeff_size;
@@ -94,6 +95,7 @@ static inline pk_internal_t* pk_init_from_manager(ap_manager_t* man, ap_funid_t
   pk_internal_t* pk = (pk_internal_t*)man->internal;
   pk->funid = funid;
   pk->funopt = &man->option.funopt[funid];
+  ap_deadline_init(&pk->deadline,pk->funopt);
   man->result.flag_exact = man->result.flag_best = false;
   return pk;
 }
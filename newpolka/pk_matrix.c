@@ -109,6 +109,23 @@ void matrix_free(matrix_t* mat)
   free(mat);
 }
 
+/* Number of bytes allocated for the matrix, including the limbs of the
+   coefficients. */
+size_t matrix_memory_size(matrix_t* mat)
+{
+  size_t i,j;
+  size_t res;
+
+  res = sizeof(matrix_t) + mat->_maxrows*sizeof(numint_t*) +
+    mat->_maxrows*mat->nbcolumns*sizeof(numint_t);
+  for (i=0;i<mat->_maxrows;i++){
+    for (j=0;j<mat->nbcolumns;j++){
+      res += numint_heap_size(mat->p[i][j]);
+    }
+  }
+  return res;
+}
+
 /* Set all elements to zero. */
 void matrix_clear(matrix_t* mat)
 {
@@ -57,6 +57,7 @@ void      matrix_resize_rows(matrix_t* mat, size_t nbrows);
 void      matrix_resize_rows_lazy(matrix_t* mat, size_t nbrows);
 void      matrix_minimize(matrix_t* mat);
 void      matrix_free(matrix_t* mat);
+size_t    matrix_memory_size(matrix_t* mat);
 void      matrix_clear(matrix_t* mat);
 void      matrix_print(matrix_t* mat);
 void      matrix_fprint(FILE* stream, matrix_t* mat);
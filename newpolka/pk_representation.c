@@ -140,6 +140,17 @@ size_t pk_size(ap_manager_t* man, pk_t* po)
   return (s1+s2)*(po->intdim + po->realdim);
 }
 
+size_t pk_memory_size(ap_manager_t* man, pk_t* po)
+{
+  size_t res = sizeof(pk_t);
+
+  if (po->C) res += matrix_memory_size(po->C);
+  if (po->F) res += matrix_memory_size(po->F);
+  if (po->satC) res += satmat_memory_size(po->satC);
+  if (po->satF) res += satmat_memory_size(po->satF);
+  return res;
+}
+
 /* ********************************************************************** */
 /* II. Control of internal representation */
 /* ********************************************************************** */
@@ -250,12 +261,10 @@ void poly_chernikova2(ap_manager_t* man,
 
 /* Same as poly_chernikova2, but in addition normalize matrices by Gauss
    elimination and sorting */
-static int counter = 0;
 void poly_chernikova3(ap_manager_t* man,
 		      pk_t* po,
 		      char* msg)
 {
-  counter++;
   pk_internal_t* pk = (pk_internal_t*)man->internal;
   poly_chernikova2(man,po,msg);
   if (pk->exn)
@@ -529,20 +538,82 @@ void pk_fdump(FILE* stream, ap_manager_t* man, pk_t* po)
 /* IV. Serialization */
 /* ********************************************************************** */
 
+/* raw format:
+   0: uchar:  numint_serialize_id
+   1: uchar:  content (0=empty, 1=constraints, 2=generators)
+   2: uint32: intdim
+   6: uint32: realdim
+  10: uint32: nbrows
+  14: uint32: nbcolumns
+  18:   -   : coefficients of the matrix, row by row
+
+  Only one representation is saved, the constraints if available; the
+  other one and the saturation matrices are recomputed when needed.
+*/
+
+#define PK_SERIALIZE_HEADER 18
+
 ap_membuf_t pk_serialize_raw(ap_manager_t* man, pk_t* a)
 {
   ap_membuf_t membuf;
+  matrix_t* mat;
+  size_t i,j,n;
+
   pk_init_from_manager(man,AP_FUNID_SERIALIZE_RAW);
-  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_SERIALIZE_RAW,NULL);
-  membuf.ptr = NULL;
-  membuf.size = 0;
+  mat = a->C ? a->C : a->F;
+  n = PK_SERIALIZE_HEADER;
+  if (mat){
+    for (i=0; i<mat->nbrows; i++)
+      for (j=0; j<mat->nbcolumns; j++)
+	n += numint_serialized_size(mat->p[i][j]);
+  }
+  membuf.ptr = malloc(n);
+  ((unsigned char*)membuf.ptr)[0] = numint_serialize_id();
+  ((unsigned char*)membuf.ptr)[1] = mat==NULL ? 0 : (mat==a->C ? 1 : 2);
+  num_dump_word32((char*)membuf.ptr+2,a->intdim);
+  num_dump_word32((char*)membuf.ptr+6,a->realdim);
+  num_dump_word32((char*)membuf.ptr+10,mat ? mat->nbrows : 0);
+  num_dump_word32((char*)membuf.ptr+14,mat ? mat->nbcolumns : 0);
+  n = PK_SERIALIZE_HEADER;
+  if (mat){
+    for (i=0; i<mat->nbrows; i++)
+      for (j=0; j<mat->nbcolumns; j++)
+	n += numint_serialize((char*)membuf.ptr+n,mat->p[i][j]);
+  }
+  membuf.size = n;
   return membuf;
 }
 pk_t* pk_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size)
 {
-  pk_init_from_manager(man,AP_FUNID_DESERIALIZE_RAW);
-  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_DESERIALIZE_RAW,NULL);
-  return NULL;
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_DESERIALIZE_RAW);
+  unsigned char id = ((unsigned char*)ptr)[0];
+  unsigned char content = ((unsigned char*)ptr)[1];
+  size_t intdim = num_undump_word32((char*)ptr+2);
+  size_t realdim = num_undump_word32((char*)ptr+6);
+  size_t nbrows = num_undump_word32((char*)ptr+10);
+  size_t nbcols = num_undump_word32((char*)ptr+14);
+  size_t i,j,n;
+  matrix_t* mat;
+  pk_t* po;
+
+  if (id!=numint_serialize_id() || content>2 ||
+      (content && nbcols!=pk->dec+intdim+realdim)){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_DESERIALIZE_RAW,
+			       "invalid header, numeric type or strictness");
+    return NULL;
+  }
+  po = poly_alloc(intdim,realdim);
+  n = PK_SERIALIZE_HEADER;
+  if (content){
+    mat = matrix_alloc(nbrows,nbcols,false);
+    for (i=0; i<nbrows; i++)
+      for (j=0; j<nbcols; j++)
+	n += numint_deserialize(mat->p[i][j],(char*)ptr+n);
+    if (content==1) po->C = mat;
+    else po->F = mat;
+  }
+  if (size) *size = n;
+  return po;
 }
 
 /* ********************************************************************** */
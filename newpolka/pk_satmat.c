@@ -58,6 +58,13 @@ void satmat_free(satmat_t* sat)
   free(sat);
 }
 
+/* Number of bytes allocated for the saturation matrix. */
+size_t satmat_memory_size(satmat_t* sat)
+{
+  return sizeof(satmat_t) + sat->_maxrows*sizeof(bitstring_t*) +
+    sat->_maxrows*sat->nbcolumns*sizeof(bitstring_t);
+}
+
 /* Reallocation function, to scale up or to downsize a matrix */
 void satmat_resize_rows(satmat_t* sat, size_t nbrows)
 {
@@ -39,6 +39,7 @@ void satmat_resize_rows(satmat_t* sat, size_t nbrows);
 void satmat_resize_cols(satmat_t* sat, size_t nbcols);
 satmat_t* satmat_copy_resize_cols(satmat_t* sat, size_t nbcols);
 void satmat_free(satmat_t* sat);
+size_t satmat_memory_size(satmat_t* sat);
 void satmat_clear(satmat_t* sat);
 satmat_t* satmat_copy(satmat_t* sat);
 void satmat_print(satmat_t* sat);
@@ -612,6 +612,7 @@ ap_manager_t* pkeq_manager_alloc(void)
   // funptr[AP_FUNID_COPY] = &poly_copy;
   // funptr[AP_FUNID_FREE] = &poly_free;
   funptr[AP_FUNID_ASIZE] = &pkeq_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &pk_memory_size;
   // funptr[AP_FUNID_MINIMIZE] = &poly_minimize;
   // funptr[AP_FUNID_CANONICALIZE] = &poly_canonicalize;
   // funptr[AP_FUNID_HASH] = &poly_hash;
@@ -0,0 +1,2074 @@
+/* ********************************************************************** */
+/* pkgrid.c: grids (linear congruences) on top of NewPolka matrices */
+/* ********************************************************************** */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#include "pk_config.h"
+#include "pk_vector.h"
+#include "pk_matrix.h"
+#include "pk.h"
+#include "pk_internal.h"
+#include "pk_user.h"
+
+#include "pkgrid.h"
+
+#include "ap_generic.h"
+
+/* ********************************************************************** */
+/* 0. Representation */
+/* ********************************************************************** */
+
+/* A row [den, y_0, y_1, ..., y_n] of a matrix is an element of a module of
+   Q^(n+1), the coordinate y_0 being the homogenizing (constant) one:
+
+   - if den==0, it is an element of the vector space part: the module
+     contains the whole line Q.y;
+
+   - if den>0, it is the element y/den of the lattice part: the module
+     contains Z.(y/den).
+
+   The generators of a grid G are a module M such that G is the set of x with
+   (1,x) in M: a vertex p is the row (d, d, d.p), a line is a vector space
+   element with y_0=0, and a parameter (modular line) is a lattice element
+   with y_0=0.
+
+   The congruences are the dual module M* = { f | f.y in Z for y in the
+   lattice part, f.y=0 for y in the vector space part }: a vector space
+   element f is the equality f.(1,x)=0, and a lattice element f/den is the
+   congruence f.(1,x)=0 mod den. The congruences always contain the trivial
+   one 1=0 mod 1, so that M*=(M**)* is exactly the module generated by the
+   points of G, and the grid is empty iff its dual module contains no
+   element with y_0=1.
+
+   A module is in canonical form if its vector space part is in reduced
+   echelon form (primitive rows with a positive pivot), and its lattice part
+   is reduced modulo the vector space part, with a common and minimal
+   denominator and numerators in Hermite normal form. Two modules are then
+   equal iff their canonical matrices are equal. The pivots of the
+   congruences are chosen on the variables first, so that they read as
+   x = ... mod m, and the ones of the generators on the constant coefficient
+   first, so that the point is the first lattice row.
+
+   C==NULL && G==NULL iff the grid is empty. Otherwise, at least one of the
+   two is present, and the present ones are canonical. */
+
+struct pkgrid_t {
+  matrix_t* C;    /* congruences, or NULL */
+  matrix_t* G;    /* generators, or NULL */
+  size_t intdim;
+  size_t realdim;
+};
+
+/* Columns of the rows */
+static const size_t grid_den = 0;
+static const size_t grid_cst = 1;
+static const size_t grid_dec = 2;
+
+static pkgrid_t* grid_alloc(size_t intdim, size_t realdim)
+{
+  pkgrid_t* a = (pkgrid_t*)malloc(sizeof(pkgrid_t));
+  a->C = a->G = NULL;
+  a->intdim = intdim;
+  a->realdim = realdim;
+  return a;
+}
+
+static void grid_set_bottom(pkgrid_t* a)
+{
+  if (a->C) matrix_free(a->C);
+  if (a->G) matrix_free(a->G);
+  a->C = a->G = NULL;
+}
+
+static inline bool grid_is_bottom(pkgrid_t* a)
+{
+  return a->C==NULL && a->G==NULL;
+}
+
+/* ********************************************************************** */
+/* 1. Rows and modules */
+/* ********************************************************************** */
+
+/* Add a null row at the end of the matrix and return it */
+static numint_t* grid_matrix_add_row(matrix_t* mat)
+{
+  size_t j,nbrows;
+  numint_t* q;
+
+  nbrows = mat->nbrows;
+  if (nbrows+1 > mat->_maxrows)
+    matrix_resize_rows(mat,2*mat->_maxrows+1);
+  mat->nbrows = nbrows+1;
+  mat->_sorted = false;
+  q = mat->p[nbrows];
+  for (j=0; j<mat->nbcolumns; j++)
+    numint_set_int(q[j],0);
+  return q;
+}
+
+static bool grid_row_is_null(numint_t* q, size_t size)
+{
+  size_t j;
+  for (j=grid_cst; j<size; j++){
+    if (numint_sgn(q[j])) return false;
+  }
+  return true;
+}
+
+/* Is the row independent of the variables ? */
+static bool grid_row_is_constant(numint_t* q, size_t size)
+{
+  size_t j;
+  for (j=grid_dec; j<size; j++){
+    if (numint_sgn(q[j])) return false;
+  }
+  return true;
+}
+
+/* Divide q[start..size-1] by their gcd */
+static void grid_vector_normalize(numint_t* q, size_t start, size_t size,
+				  numint_t gcd)
+{
+  size_t j;
+
+  numint_set_int(gcd,0);
+  for (j=start; j<size; j++){
+    if (numint_sgn(q[j])){
+      numint_gcd(gcd,gcd,q[j]);
+      if (numint_cmp_int(gcd,1)==0) return;
+    }
+  }
+  if (numint_cmp_int(gcd,1)>0){
+    for (j=start; j<size; j++)
+      numint_divexact(q[j],q[j],gcd);
+  }
+}
+
+/* Normalize a row, including its denominator if it is in the lattice part */
+static inline void grid_row_normalize(numint_t* q, size_t size, numint_t gcd)
+{
+  grid_vector_normalize(q, numint_sgn(q[grid_den]) ? grid_den : grid_cst,
+			size, gcd);
+}
+
+static void grid_row_neg(numint_t* q, size_t size)
+{
+  size_t j;
+  for (j=grid_cst; j<size; j++)
+    numint_neg(q[j],q[j]);
+}
+
+/* q := q - k.r on the numerators */
+static void grid_row_submul(numint_t* q, numint_t* r, numint_t k, size_t size,
+			    numint_t tmp)
+{
+  size_t j;
+  for (j=grid_cst; j<size; j++){
+    if (numint_sgn(r[j])){
+      numint_mul(tmp,k,r[j]);
+      numint_sub(q[j],q[j],tmp);
+    }
+  }
+}
+
+/* Eliminates the column c of q with the vector space element r, which
+   has a positive pivot r[c]. The element denoted by q is unchanged if q is
+   in the lattice part (its denominator is multiplied by r[c]), and scaled if
+   q is in the vector space part. */
+static void grid_row_eliminate(numint_t* q, numint_t* r, size_t c, size_t size,
+			       numint_t tmp, numint_t tmp2)
+{
+  size_t j;
+
+  assert(numint_sgn(r[c])>0);
+  numint_set(tmp2,q[c]);
+  for (j=grid_cst; j<size; j++){
+    numint_mul(q[j],q[j],r[c]);
+    if (numint_sgn(r[j])){
+      numint_mul(tmp,tmp2,r[j]);
+      numint_sub(q[j],q[j],tmp);
+    }
+  }
+  numint_mul(q[grid_den],q[grid_den],r[c]);
+}
+
+/* Scalar product of the numerators */
+static void grid_row_product(numint_t prod, numint_t* q, numint_t* r,
+			     size_t size, numint_t tmp)
+{
+  size_t j;
+  numint_set_int(prod,0);
+  for (j=grid_cst; j<size; j++){
+    if (numint_sgn(q[j]) && numint_sgn(r[j])){
+      numint_mul(tmp,q[j],r[j]);
+      numint_add(prod,prod,tmp);
+    }
+  }
+}
+
+/* Does b divide a ? */
+static bool grid_divides(numint_t a, numint_t b, numint_t tmp)
+{
+  numint_fdiv_q(tmp,a,b);
+  numint_mul(tmp,tmp,b);
+  return numint_equal(tmp,a);
+}
+
+/* Column of rank k in the order of the pivots: the constant coefficient
+   comes first, or last if cstlast */
+static inline size_t grid_column(size_t k, size_t nbcols, bool cstlast)
+{
+  return
+    cstlast ?
+    (grid_dec+k<nbcols ? grid_dec+k : grid_cst) :
+    grid_cst+k;
+}
+
+/* Put the module in canonical form (see above), with the pivots chosen in
+   the order of grid_column */
+static void grid_module_canonicalize(matrix_t* mat, bool cstlast)
+{
+  size_t nbcols = mat->nbcolumns;
+  size_t i,j,k,c,kc,nbeq,nbrows;
+  size_t* pivot;
+  numint_t tmp,tmp2,q,den;
+  bool done;
+
+  numint_init(tmp); numint_init(tmp2); numint_init(q); numint_init(den);
+
+  /* 1. Vector space rows first, then lattice rows, null rows removed */
+  nbeq = 0;
+  for (i=0; i<mat->nbrows; i++){
+    if (numint_sgn(mat->p[i][grid_den])==0 &&
+	!grid_row_is_null(mat->p[i],nbcols)){
+      matrix_exch_rows(mat,i,nbeq);
+      nbeq++;
+    }
+  }
+  nbrows = nbeq;
+  for (i=nbeq; i<mat->nbrows; i++){
+    if (numint_sgn(mat->p[i][grid_den]) &&
+	!grid_row_is_null(mat->p[i],nbcols)){
+      if (numint_sgn(mat->p[i][grid_den])<0){
+	numint_neg(mat->p[i][grid_den],mat->p[i][grid_den]);
+	grid_row_neg(mat->p[i],nbcols);
+      }
+      matrix_exch_rows(mat,i,nbrows);
+      nbrows++;
+    }
+  }
+
+  /* 2. Reduced echelon form of the vector space part */
+  pivot = (size_t*)malloc((nbeq+1)*sizeof(size_t));
+  k = 0;
+  for (kc=0; kc<nbcols-grid_cst && k<nbeq; kc++){
+    c = grid_column(kc,nbcols,cstlast);
+    for (i=k; i<nbeq && numint_sgn(mat->p[i][c])==0; i++);
+    if (i==nbeq) continue;
+    matrix_exch_rows(mat,k,i);
+    grid_vector_normalize(mat->p[k],grid_cst,nbcols,tmp);
+    if (numint_sgn(mat->p[k][c])<0)
+      grid_row_neg(mat->p[k],nbcols);
+    for (i=0; i<nbeq; i++){
+      if (i!=k && numint_sgn(mat->p[i][c])){
+	grid_row_eliminate(mat->p[i],mat->p[k],c,nbcols,tmp,tmp2);
+	grid_vector_normalize(mat->p[i],grid_cst,nbcols,tmp);
+      }
+    }
+    pivot[k] = c;
+    k++;
+  }
+  /* rows k..nbeq-1 are now null */
+  for (i=nbeq; i<nbrows; i++)
+    matrix_exch_rows(mat,i,k+i-nbeq);
+  nbrows -= nbeq-k;
+  nbeq = k;
+
+  /* 3. Lattice rows reduced modulo the vector space part, and put on a
+     common denominator */
+  numint_set_int(den,1);
+  for (i=nbeq; i<nbrows; i++){
+    for (k=0; k<nbeq; k++){
+      if (numint_sgn(mat->p[i][pivot[k]]))
+	grid_row_eliminate(mat->p[i],mat->p[k],pivot[k],nbcols,tmp,tmp2);
+    }
+    grid_vector_normalize(mat->p[i],grid_den,nbcols,tmp);
+    numint_lcm(den,den,mat->p[i][grid_den]);
+  }
+  for (i=nbeq; i<nbrows; i++){
+    if (numint_cmp(mat->p[i][grid_den],den)){
+      numint_divexact(q,den,mat->p[i][grid_den]);
+      for (j=grid_cst; j<nbcols; j++)
+	numint_mul(mat->p[i][j],mat->p[i][j],q);
+      numint_set(mat->p[i][grid_den],den);
+    }
+  }
+  free(pivot);
+
+  /* 4. Hermite normal form of the numerators of the lattice part */
+  k = nbeq;
+  for (kc=0; kc<nbcols-grid_cst && k<nbrows; kc++){
+    c = grid_column(kc,nbcols,cstlast);
+    do {
+      /* row with the smallest non-zero absolute value in the column */
+      j = nbrows;
+      for (i=k; i<nbrows; i++){
+	if (numint_sgn(mat->p[i][c])){
+	  if (j==nbrows)
+	    j = i;
+	  else {
+	    numint_abs(tmp,mat->p[i][c]);
+	    numint_abs(tmp2,mat->p[j][c]);
+	    if (numint_cmp(tmp,tmp2)<0) j = i;
+	  }
+	}
+      }
+      if (j==nbrows) break;
+      matrix_exch_rows(mat,k,j);
+      done = true;
+      for (i=k+1; i<nbrows; i++){
+	if (numint_sgn(mat->p[i][c])){
+	  numint_fdiv_q(q,mat->p[i][c],mat->p[k][c]);
+	  grid_row_submul(mat->p[i],mat->p[k],q,nbcols,tmp);
+	  if (numint_sgn(mat->p[i][c])) done = false;
+	}
+      }
+    } while (!done);
+    if (j==nbrows) continue;
+    if (numint_sgn(mat->p[k][c])<0)
+      grid_row_neg(mat->p[k],nbcols);
+    for (i=nbeq; i<k; i++){
+      numint_fdiv_q(q,mat->p[i][c],mat->p[k][c]);
+      if (numint_sgn(q))
+	grid_row_submul(mat->p[i],mat->p[k],q,nbcols,tmp);
+    }
+    k++;
+  }
+  nbrows = k;
+
+  /* 5. Minimal common denominator */
+  if (nbrows>nbeq){
+    numint_set(q,den);
+    for (i=nbeq; i<nbrows && numint_cmp_int(q,1)>0; i++){
+      for (j=grid_cst; j<nbcols; j++){
+	if (numint_sgn(mat->p[i][j])) numint_gcd(q,q,mat->p[i][j]);
+      }
+    }
+    if (numint_cmp_int(q,1)>0){
+      for (i=nbeq; i<nbrows; i++){
+	for (j=grid_den; j<nbcols; j++)
+	  numint_divexact(mat->p[i][j],mat->p[i][j],q);
+      }
+    }
+  }
+  mat->nbrows = nbrows;
+  mat->_sorted = false;
+
+  numint_clear(tmp); numint_clear(tmp2); numint_clear(q); numint_clear(den);
+}
+
+/* Dual of a canonical module. The rows of the module, completed with unit
+   vectors, form an invertible matrix Q; with P=(Q^T)^-1, the dual module is
+   generated by den.P_i for the lattice rows i of the module (den being their
+   denominator) and by the vector space P_i for the unit rows i.
+   The module is canonical for the order cstlast, its dual is made canonical
+   for the other order. */
+static matrix_t* grid_module_dual(matrix_t* mat, bool cstlast)
+{
+  size_t nbcols = mat->nbcolumns;
+  size_t m = nbcols-1;
+  size_t i,j,k,c,r,nbrows;
+  matrix_t* W;
+  matrix_t* res;
+  bool* ispivot;
+  numint_t tmp,tmp2,a,b,den;
+
+  numint_init(tmp); numint_init(tmp2); numint_init(a); numint_init(b);
+  numint_init_set_int(den,1);
+
+  /* W = [Q^T | I] */
+  W = matrix_alloc(m,2*m,false);
+  ispivot = (bool*)malloc(m*sizeof(bool));
+  for (j=0; j<m; j++) ispivot[j] = false;
+  for (r=0; r<mat->nbrows; r++){
+    numint_t* q = mat->p[r];
+    for (j=0; j<m; j++){
+      numint_set(W->p[j][r],q[grid_cst+j]);
+    }
+    c = grid_cst;
+    for (k=0; k<m; k++){
+      c = grid_column(k,nbcols,cstlast);
+      if (numint_sgn(q[c])) break;
+    }
+    assert(k<m);
+    ispivot[c-grid_cst] = true;
+    if (numint_sgn(q[grid_den])) numint_set(den,q[grid_den]);
+  }
+  nbrows = mat->nbrows;
+  for (j=0; j<m; j++){
+    if (!ispivot[j]){
+      numint_set_int(W->p[j][nbrows],1);
+      nbrows++;
+    }
+  }
+  assert(nbrows==m);
+  free(ispivot);
+  for (j=0; j<m; j++)
+    numint_set_int(W->p[j][m+j],1);
+
+  /* Fraction-free Gauss-Jordan elimination */
+  for (j=0; j<m; j++){
+    for (i=j; i<m && numint_sgn(W->p[i][j])==0; i++);
+    assert(i<m);
+    matrix_exch_rows(W,i,j);
+    for (i=0; i<m; i++){
+      if (i!=j && numint_sgn(W->p[i][j])){
+	numint_set(a,W->p[j][j]);
+	numint_set(b,W->p[i][j]);
+	for (k=0; k<2*m; k++){
+	  numint_mul(W->p[i][k],W->p[i][k],a);
+	  if (numint_sgn(W->p[j][k])){
+	    numint_mul(tmp,b,W->p[j][k]);
+	    numint_sub(W->p[i][k],W->p[i][k],tmp);
+	  }
+	}
+	grid_vector_normalize(W->p[i],0,2*m,tmp);
+      }
+    }
+  }
+  /* Row r of P is W[r][m..2m-1]/W[r][r] */
+  res = matrix_alloc(m,nbcols,false);
+  res->nbrows = 0;
+  for (r=0; r<m; r++){
+    numint_t* q;
+    if (r<mat->nbrows && numint_sgn(mat->p[r][grid_den])==0)
+      continue;
+    q = grid_matrix_add_row(res);
+    if (r<mat->nbrows){
+      /* lattice element den.P_r */
+      numint_abs(q[grid_den],W->p[r][r]);
+      for (j=0; j<m; j++)
+	numint_mul(q[grid_cst+j],W->p[r][m+j],den);
+      if (numint_sgn(W->p[r][r])<0) grid_row_neg(q,nbcols);
+    }
+    else {
+      /* vector space element */
+      for (j=0; j<m; j++)
+	numint_set(q[grid_cst+j],W->p[r][m+j]);
+    }
+    grid_row_normalize(q,nbcols,tmp);
+  }
+  matrix_free(W);
+  grid_module_canonicalize(res,!cstlast);
+
+  numint_clear(tmp); numint_clear(tmp2); numint_clear(a); numint_clear(b);
+  numint_clear(den);
+  return res;
+}
+
+/* Canonicalize congruences, after adding the trivial congruence 1=0 mod 1 */
+static void grid_C_canonicalize(matrix_t* C)
+{
+  numint_t* q = grid_matrix_add_row(C);
+  numint_set_int(q[grid_den],1);
+  numint_set_int(q[grid_cst],1);
+  grid_module_canonicalize(C,true);
+}
+
+/* Does the canonical dual of congruences contain a point ? */
+static bool grid_G_has_point(matrix_t* G)
+{
+  size_t i;
+  for (i=0; i<G->nbrows; i++){
+    if (numint_sgn(G->p[i][grid_den])){
+      return numint_equal(G->p[i][grid_den],G->p[i][grid_cst]);
+    }
+  }
+  return false;
+}
+
+/* Compute the generators, and detect emptiness */
+static void grid_obtain_G(pkgrid_t* a)
+{
+  if (a->G==NULL && a->C!=NULL){
+    a->G = grid_module_dual(a->C,true);
+    if (!grid_G_has_point(a->G))
+      grid_set_bottom(a);
+  }
+}
+/* Compute the congruences */
+static void grid_obtain_C(pkgrid_t* a)
+{
+  if (a->C==NULL && a->G!=NULL){
+    a->C = grid_module_dual(a->G,false);
+  }
+}
+
+static void grid_set_C(pkgrid_t* a, matrix_t* C)
+{
+  if (a->C) matrix_free(a->C);
+  if (a->G) matrix_free(a->G);
+  a->C = C;
+  a->G = NULL;
+}
+static void grid_set_G(pkgrid_t* a, matrix_t* G)
+{
+  if (a->C) matrix_free(a->C);
+  if (a->G) matrix_free(a->G);
+  a->C = NULL;
+  a->G = G;
+}
+
+static matrix_t* grid_C_top(size_t dim)
+{
+  matrix_t* C = matrix_alloc(0,grid_dec+dim,false);
+  grid_C_canonicalize(C);
+  return C;
+}
+
+/* Fills q with the scalar linear expression expr, so that the expression is
+   q[1..]/q[0]. Returns false if the expression is not scalar. */
+static bool grid_row_set_itv_linexpr(pk_internal_t* pk, numint_t* q,
+				     itv_linexpr_t* expr, size_t dim)
+{
+  if (!itv_linexpr_is_scalar(expr))
+    return false;
+  vector_set_itv_linexpr(pk,q,expr,dim,1);
+  return true;
+}
+static bool grid_row_set_linexpr(pk_internal_t* pk, numint_t* q,
+				 ap_linexpr0_t* expr, size_t dim)
+{
+  itv_linexpr_set_ap_linexpr0(pk->itv,&pk->poly_itv_linexpr,expr);
+  return grid_row_set_itv_linexpr(pk,q,&pk->poly_itv_linexpr,dim);
+}
+
+/* Value of the expression q[1..]/q[0] if it is constant on the (non empty)
+   grid */
+static bool grid_eval_row(matrix_t* G, numint_t* q,
+			  numint_t num, numint_t den, numint_t tmp)
+{
+  size_t i;
+  bool res = true;
+  numint_t prod;
+
+  numint_init(prod);
+  numint_set_int(num,0);
+  numint_set_int(den,1);
+  for (i=0; i<G->nbrows; i++){
+    numint_t* g = G->p[i];
+    if (numint_sgn(g[grid_den]) && numint_sgn(g[grid_cst])){
+      /* the point */
+      grid_row_product(num,q,g,G->nbcolumns,tmp);
+      numint_set(den,g[grid_den]);
+    }
+    else {
+      /* a line or a parameter */
+      grid_row_product(prod,q,g,G->nbcolumns,tmp);
+      if (numint_sgn(prod)){
+	res = false;
+	break;
+      }
+    }
+  }
+  numint_mul(den,den,q[grid_den]);
+  numint_clear(prod);
+  return res;
+}
+
+/* Does the (non empty) grid satisfy the congruence or equality q ? */
+static bool grid_sat_row(matrix_t* G, numint_t* q,
+			 numint_t prod, numint_t den, numint_t tmp)
+{
+  size_t i;
+  for (i=0; i<G->nbrows; i++){
+    numint_t* g = G->p[i];
+    grid_row_product(prod,q,g,G->nbcolumns,tmp);
+    if (numint_sgn(prod)){
+      if (numint_sgn(q[grid_den])==0 || numint_sgn(g[grid_den])==0)
+	return false;
+      numint_mul(den,q[grid_den],g[grid_den]);
+      if (!grid_divides(prod,den,tmp))
+	return false;
+    }
+  }
+  return true;
+}
+
+/* ********************************************************************** */
+/* I. General management */
+/* ********************************************************************** */
+
+/* ============================================================ */
+/* I.1 Memory */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_copy(ap_manager_t* man, pkgrid_t* a)
+{
+  pkgrid_t* res;
+  pk_init_from_manager(man,AP_FUNID_COPY);
+  res = grid_alloc(a->intdim,a->realdim);
+  res->C = a->C ? matrix_copy(a->C) : NULL;
+  res->G = a->G ? matrix_copy(a->G) : NULL;
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+void pkgrid_free(ap_manager_t* man, pkgrid_t* a)
+{
+  grid_set_bottom(a);
+  free(a);
+}
+
+/* Return the abstract size of a grid, which is the number of rows times the
+   dimension */
+size_t pkgrid_size(ap_manager_t* man, pkgrid_t* a)
+{
+  size_t s = (a->C ? a->C->nbrows : 0) + (a->G ? a->G->nbrows : 0);
+  return s*(a->intdim + a->realdim);
+}
+
+size_t pkgrid_memory_size(ap_manager_t* man, pkgrid_t* a)
+{
+  size_t res = sizeof(pkgrid_t);
+  if (a->C) res += matrix_memory_size(a->C);
+  if (a->G) res += matrix_memory_size(a->G);
+  return res;
+}
+
+/* ============================================================ */
+/* I.2 Control of internal representation */
+/* ============================================================ */
+
+void pkgrid_minimize(ap_manager_t* man, pkgrid_t* a)
+{
+  pk_init_from_manager(man,AP_FUNID_MINIMIZE);
+  grid_obtain_G(a);
+  if (a->C && a->G){
+    matrix_free(a->G);
+    a->G = NULL;
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+}
+
+void pkgrid_canonicalize(ap_manager_t* man, pkgrid_t* a)
+{
+  pk_init_from_manager(man,AP_FUNID_CANONICALIZE);
+  grid_obtain_G(a);
+  grid_obtain_C(a);
+  man->result.flag_exact = man->result.flag_best = true;
+}
+
+int pkgrid_hash(ap_manager_t* man, pkgrid_t* a)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_HASH);
+  int res;
+  size_t i;
+
+  grid_obtain_G(a);
+  grid_obtain_C(a);
+  res = 5*a->intdim + 7*a->realdim;
+  if (a->C){
+    res += a->C->nbrows*11;
+    for (i=0; i<a->C->nbrows; i += (a->C->nbrows+3)/4){
+      res = res*3 + vector_hash(pk,a->C->p[i],a->C->nbcolumns);
+    }
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+void pkgrid_approximate(ap_manager_t* man, pkgrid_t* a, int algorithm)
+{
+  pk_init_from_manager(man,AP_FUNID_APPROXIMATE);
+  man->result.flag_exact = man->result.flag_best = true;
+}
+
+/* ============================================================ */
+/* I.3 Printing */
+/* ============================================================ */
+
+void pkgrid_fprint(FILE* stream, ap_manager_t* man, pkgrid_t* a,
+		   char** name_of_dim)
+{
+  pk_init_from_manager(man,AP_FUNID_FPRINT);
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    fprintf(stream,"empty grid of dim (%lu,%lu)\n",
+	    (unsigned long)a->intdim,(unsigned long)a->realdim);
+  }
+  else {
+    ap_lincons0_array_t cons;
+    fprintf(stream,"grid of dim (%lu,%lu)\n",
+	    (unsigned long)a->intdim,(unsigned long)a->realdim);
+    cons = pkgrid_to_lincons_array(man,a);
+    ap_lincons0_array_fprint(stream,&cons,name_of_dim);
+    ap_lincons0_array_clear(&cons);
+  }
+}
+
+void pkgrid_fprintdiff(FILE* stream, ap_manager_t* man,
+		       pkgrid_t* a1, pkgrid_t* a2,
+		       char** name_of_dim)
+{
+  pk_init_from_manager(man,AP_FUNID_FPRINTDIFF);
+  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_FPRINTDIFF,NULL);
+}
+
+void pkgrid_fdump(FILE* stream, ap_manager_t* man, pkgrid_t* a)
+{
+  pk_init_from_manager(man,AP_FUNID_FDUMP);
+  if (grid_is_bottom(a))
+    fprintf(stream,"empty grid of dim (%lu,%lu)\n",
+	    (unsigned long)a->intdim,(unsigned long)a->realdim);
+  else {
+    fprintf(stream,"grid of dim (%lu,%lu)\n",
+	    (unsigned long)a->intdim,(unsigned long)a->realdim);
+    if (a->C){
+      fprintf(stream,"Congruences: ");
+      matrix_fprint(stream, a->C);
+    }
+    if (a->G){
+      fprintf(stream,"Generators: ");
+      matrix_fprint(stream, a->G);
+    }
+  }
+}
+
+/* ============================================================ */
+/* I.4 Serialization */
+/* ============================================================ */
+
+ap_membuf_t pkgrid_serialize_raw(ap_manager_t* man, pkgrid_t* a)
+{
+  ap_membuf_t membuf;
+  pk_init_from_manager(man,AP_FUNID_SERIALIZE_RAW);
+  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_SERIALIZE_RAW,NULL);
+  membuf.ptr = NULL;
+  membuf.size = 0;
+  return membuf;
+}
+pkgrid_t* pkgrid_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size)
+{
+  pk_init_from_manager(man,AP_FUNID_DESERIALIZE_RAW);
+  ap_manager_raise_exception(man,AP_EXC_NOT_IMPLEMENTED,AP_FUNID_DESERIALIZE_RAW,NULL);
+  return NULL;
+}
+
+/* ********************************************************************** */
+/* II. Constructor, accessors, tests and property extraction */
+/* ********************************************************************** */
+
+/* ============================================================ */
+/* II.1 Basic constructors */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_bottom(ap_manager_t* man, size_t intdim, size_t realdim)
+{
+  pk_init_from_manager(man,AP_FUNID_BOTTOM);
+  man->result.flag_exact = man->result.flag_best = true;
+  return grid_alloc(intdim,realdim);
+}
+
+pkgrid_t* pkgrid_top(ap_manager_t* man, size_t intdim, size_t realdim)
+{
+  pkgrid_t* a;
+  pk_init_from_manager(man,AP_FUNID_TOP);
+  a = grid_alloc(intdim,realdim);
+  a->C = grid_C_top(intdim+realdim);
+  man->result.flag_exact = man->result.flag_best = true;
+  return a;
+}
+
+/* Only the singleton intervals are kept */
+pkgrid_t* pkgrid_of_box(ap_manager_t* man,
+			size_t intdim, size_t realdim,
+			ap_interval_t** tinterval)
+{
+  size_t i,dim;
+  pkgrid_t* a;
+  matrix_t* C;
+  mpq_t mpq;
+  bool exact;
+
+  pk_init_from_manager(man,AP_FUNID_OF_BOX);
+  a = grid_alloc(intdim,realdim);
+  dim = intdim+realdim;
+  for (i=0; i<dim; i++){
+    if (ap_interval_is_bottom(tinterval[i])){
+      man->result.flag_exact = man->result.flag_best = true;
+      return a;
+    }
+  }
+  C = matrix_alloc(0,grid_dec+dim,false);
+  mpq_init(mpq);
+  exact = true;
+  for (i=0; i<dim; i++){
+    ap_interval_t* itv = tinterval[i];
+    if (!ap_scalar_infty(itv->inf) && ap_scalar_equal(itv->inf,itv->sup)){
+      numint_t* q = grid_matrix_add_row(C);
+      ap_mpq_set_scalar(mpq,itv->inf,0);
+      if (!numint_set_mpz(q[grid_cst],mpq_numref(mpq)) ||
+	  !numint_set_mpz(q[grid_dec+i],mpq_denref(mpq))){
+	C->nbrows--;
+	exact = false;
+	continue;
+      }
+      numint_neg(q[grid_cst],q[grid_cst]);
+    }
+    else if (!ap_interval_is_top(itv))
+      exact = false;
+  }
+  mpq_clear(mpq);
+  grid_C_canonicalize(C);
+  a->C = C;
+  man->result.flag_exact = man->result.flag_best = exact;
+  return a;
+}
+
+pkgrid_t* pkgrid_of_lincons_array(ap_manager_t* man,
+				  size_t intdim, size_t realdim,
+				  ap_lincons0_array_t* array)
+{
+  pkgrid_t* a;
+  a = grid_alloc(intdim,realdim);
+  a->C = grid_C_top(intdim+realdim);
+  a = pkgrid_meet_lincons_array(man,true,a,array);
+  man->result.flag_best = man->result.flag_exact;
+  return a;
+}
+
+/* ============================================================ */
+/* II.2 Accessors */
+/* ============================================================ */
+
+ap_dimension_t pkgrid_dimension(ap_manager_t* man, pkgrid_t* a)
+{
+  ap_dimension_t res;
+  res.intdim = a->intdim;
+  res.realdim = a->realdim;
+  return res;
+}
+
+/* ============================================================ */
+/* II.3 Tests */
+/* ============================================================ */
+
+bool pkgrid_is_bottom(ap_manager_t* man, pkgrid_t* a)
+{
+  pk_init_from_manager(man,AP_FUNID_IS_BOTTOM);
+  grid_obtain_G(a);
+  man->result.flag_exact = man->result.flag_best = true;
+  return grid_is_bottom(a);
+}
+
+bool pkgrid_is_top(ap_manager_t* man, pkgrid_t* a)
+{
+  size_t i;
+  pk_init_from_manager(man,AP_FUNID_IS_TOP);
+  grid_obtain_G(a);
+  man->result.flag_exact = man->result.flag_best = true;
+  if (grid_is_bottom(a)) return false;
+  grid_obtain_C(a);
+  for (i=0; i<a->C->nbrows; i++){
+    if (!grid_row_is_constant(a->C->p[i],a->C->nbcolumns))
+      return false;
+  }
+  return true;
+}
+
+/* Does G satisfy all the rows of C ? */
+static bool grid_G_sat_C(matrix_t* G, matrix_t* C)
+{
+  size_t i;
+  bool res = true;
+  numint_t prod,den,tmp;
+
+  numint_init(prod); numint_init(den); numint_init(tmp);
+  for (i=0; i<C->nbrows && res; i++){
+    res = grid_sat_row(G,C->p[i],prod,den,tmp);
+  }
+  numint_clear(prod); numint_clear(den); numint_clear(tmp);
+  return res;
+}
+
+bool pkgrid_is_leq(ap_manager_t* man, pkgrid_t* a1, pkgrid_t* a2)
+{
+  pk_init_from_manager(man,AP_FUNID_IS_LEQ);
+  man->result.flag_exact = man->result.flag_best = true;
+  grid_obtain_G(a1);
+  if (grid_is_bottom(a1)) return true;
+  if (grid_is_bottom(a2)) return false;
+  grid_obtain_C(a2);
+  return grid_G_sat_C(a1->G,a2->C);
+}
+
+bool pkgrid_is_eq(ap_manager_t* man, pkgrid_t* a1, pkgrid_t* a2)
+{
+  pk_init_from_manager(man,AP_FUNID_IS_EQ);
+  man->result.flag_exact = man->result.flag_best = true;
+  grid_obtain_G(a1);
+  grid_obtain_G(a2);
+  if (grid_is_bottom(a1) || grid_is_bottom(a2))
+    return grid_is_bottom(a1) && grid_is_bottom(a2);
+  grid_obtain_C(a1);
+  grid_obtain_C(a2);
+  return matrix_equal(a1->C,a2->C);
+}
+
+bool pkgrid_sat_lincons(ap_manager_t* man, pkgrid_t* a, ap_lincons0_t* lincons)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_SAT_LINCONS);
+  size_t dim = a->intdim+a->realdim;
+  itv_lincons_t* cons = &pk->poly_itv_lincons;
+  numint_t* q;
+  numint_t num,den,tmp;
+  bool res;
+  int sgn;
+
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    man->result.flag_exact = man->result.flag_best = true;
+    return true;
+  }
+  itv_lincons_set_ap_lincons0(pk->itv,cons,lincons);
+  q = vector_alloc(grid_dec+dim);
+  if (!grid_row_set_itv_linexpr(pk,q,&cons->linexpr,dim)){
+    /* not a linear constraint */
+    vector_free(q,grid_dec+dim);
+    return false;
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  numint_init(num); numint_init(den); numint_init(tmp);
+  if (cons->constyp==AP_CONS_EQMOD && num_sgn(cons->num)){
+    /* element expr/modulo */
+    numint_mul(q[grid_den],q[grid_den],numrat_numref(cons->num));
+    numint_abs(q[grid_den],q[grid_den]);
+    for (size_t j=grid_cst; j<grid_dec+dim; j++)
+      numint_mul(q[j],q[j],numrat_denref(cons->num));
+    res = grid_sat_row(a->G,q,num,den,tmp);
+  }
+  else if (!grid_eval_row(a->G,q,num,den,tmp))
+    res = false;
+  else {
+    sgn = numint_sgn(num);
+    switch (cons->constyp){
+    case AP_CONS_EQ:
+    case AP_CONS_EQMOD:
+      res = (sgn==0);
+      break;
+    case AP_CONS_SUPEQ:
+      res = (sgn>=0);
+      break;
+    case AP_CONS_SUP:
+      res = (sgn>0);
+      break;
+    case AP_CONS_DISEQ:
+      res = (sgn!=0);
+      break;
+    default:
+      abort();
+    }
+  }
+  numint_clear(num); numint_clear(den); numint_clear(tmp);
+  vector_free(q,grid_dec+dim);
+  return res;
+}
+
+bool pkgrid_sat_tcons(ap_manager_t* man, pkgrid_t* a, ap_tcons0_t* cons)
+{
+  return ap_generic_sat_tcons(man,a,cons,AP_SCALAR_MPQ,false);
+}
+
+bool pkgrid_sat_interval(ap_manager_t* man, pkgrid_t* a,
+			 ap_dim_t dim, ap_interval_t* interval)
+{
+  ap_interval_t* itv;
+  bool res;
+
+  itv = pkgrid_bound_dimension(man,a,dim);
+  res = ap_interval_is_leq(itv,interval);
+  ap_interval_free(itv);
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+bool pkgrid_is_dimension_unconstrained(ap_manager_t* man, pkgrid_t* a,
+				       ap_dim_t dim)
+{
+  size_t i;
+  pk_init_from_manager(man,AP_FUNID_IS_DIMENSION_UNCONSTRAINED);
+  man->result.flag_exact = man->result.flag_best = true;
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)) return false;
+  grid_obtain_C(a);
+  for (i=0; i<a->C->nbrows; i++){
+    if (numint_sgn(a->C->p[i][grid_dec+dim])) return false;
+  }
+  return true;
+}
+
+/* ============================================================ */
+/* II.4 Extraction of properties */
+/* ============================================================ */
+
+/* Interval of the expression q[1..]/q[0] */
+static ap_interval_t* grid_bound_row(pkgrid_t* a, numint_t* q)
+{
+  ap_interval_t* interval;
+  numint_t num,den,tmp;
+
+  interval = ap_interval_alloc();
+  ap_interval_reinit(interval,AP_SCALAR_MPQ);
+  if (grid_is_bottom(a)){
+    ap_interval_set_bottom(interval);
+    return interval;
+  }
+  numint_init(num); numint_init(den); numint_init(tmp);
+  if (grid_eval_row(a->G,q,num,den,tmp)){
+    mpz_set_numint(mpq_numref(interval->inf->val.mpq),num);
+    mpz_set_numint(mpq_denref(interval->inf->val.mpq),den);
+    mpq_canonicalize(interval->inf->val.mpq);
+    ap_scalar_set(interval->sup,interval->inf);
+  }
+  else {
+    ap_interval_set_top(interval);
+  }
+  numint_clear(num); numint_clear(den); numint_clear(tmp);
+  return interval;
+}
+
+ap_interval_t* pkgrid_bound_linexpr(ap_manager_t* man,
+				    pkgrid_t* a, ap_linexpr0_t* expr)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_BOUND_LINEXPR);
+  size_t dim = a->intdim+a->realdim;
+  ap_interval_t* interval;
+  numint_t* q;
+
+  grid_obtain_G(a);
+  q = vector_alloc(grid_dec+dim);
+  if (grid_is_bottom(a) || grid_row_set_linexpr(pk,q,expr,dim)){
+    interval = grid_bound_row(a,q);
+    man->result.flag_exact = man->result.flag_best = true;
+  }
+  else {
+    interval = ap_interval_alloc();
+    ap_interval_reinit(interval,AP_SCALAR_MPQ);
+    ap_interval_set_top(interval);
+  }
+  vector_free(q,grid_dec+dim);
+  return interval;
+}
+
+ap_interval_t* pkgrid_bound_texpr(ap_manager_t* man,
+				  pkgrid_t* a, ap_texpr0_t* expr)
+{
+  return ap_generic_bound_texpr(man,a,expr,AP_SCALAR_MPQ,false);
+}
+
+ap_interval_t* pkgrid_bound_dimension(ap_manager_t* man,
+				      pkgrid_t* a, ap_dim_t dim)
+{
+  size_t nbcols = grid_dec+a->intdim+a->realdim;
+  ap_interval_t* interval;
+  numint_t* q;
+
+  pk_init_from_manager(man,AP_FUNID_BOUND_DIMENSION);
+  grid_obtain_G(a);
+  q = vector_alloc(nbcols);
+  numint_set_int(q[grid_den],1);
+  numint_set_int(q[grid_dec+dim],1);
+  interval = grid_bound_row(a,q);
+  vector_free(q,nbcols);
+  man->result.flag_exact = man->result.flag_best = true;
+  return interval;
+}
+
+ap_lincons0_array_t pkgrid_to_lincons_array(ap_manager_t* man, pkgrid_t* a)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_TO_LINCONS_ARRAY);
+  ap_lincons0_array_t array;
+  size_t i,k,nbcols;
+  numint_t* q;
+  numint_t gcd;
+
+  man->result.flag_exact = man->result.flag_best = true;
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    array = ap_lincons0_array_make(1);
+    array.p[0] = ap_lincons0_make_unsat();
+    return array;
+  }
+  grid_obtain_C(a);
+  nbcols = a->C->nbcolumns;
+  k = 0;
+  for (i=0; i<a->C->nbrows; i++){
+    if (!grid_row_is_constant(a->C->p[i],nbcols)) k++;
+  }
+  array = ap_lincons0_array_make(k);
+  q = vector_alloc(nbcols);
+  numint_init(gcd);
+  k = 0;
+  for (i=0; i<a->C->nbrows; i++){
+    if (grid_row_is_constant(a->C->p[i],nbcols)) continue;
+    /* each congruence with its own smallest modulo */
+    vector_copy(q,a->C->p[i],nbcols);
+    grid_row_normalize(q,nbcols,gcd);
+    array.p[k] = lincons0_of_vector(pk,q,nbcols);
+    if (numint_sgn(q[grid_den])){
+      /* q[1..].(1,x) = 0 mod q[0] */
+      array.p[k].constyp = AP_CONS_EQMOD;
+      array.p[k].scalar = ap_scalar_alloc();
+      ap_scalar_reinit(array.p[k].scalar,AP_SCALAR_MPQ);
+      mpq_set_numint(array.p[k].scalar->val.mpq,q[grid_den]);
+    }
+    k++;
+  }
+  numint_clear(gcd);
+  vector_free(q,nbcols);
+  return array;
+}
+
+ap_tcons0_array_t pkgrid_to_tcons_array(ap_manager_t* man, pkgrid_t* a)
+{
+  return ap_generic_to_tcons_array(man,a);
+}
+
+ap_interval_t** pkgrid_to_box(ap_manager_t* man, pkgrid_t* a)
+{
+  size_t i,dim;
+  ap_interval_t** box;
+
+  dim = a->intdim+a->realdim;
+  box = (ap_interval_t**)malloc(dim*sizeof(ap_interval_t*));
+  for (i=0; i<dim; i++){
+    box[i] = pkgrid_bound_dimension(man,a,(ap_dim_t)i);
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return box;
+}
+
+ap_generator0_array_t pkgrid_to_generator_array(ap_manager_t* man, pkgrid_t* a)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_TO_GENERATOR_ARRAY);
+  ap_generator0_array_t array;
+  size_t i,j,nbcols;
+  mpz_t den;
+
+  man->result.flag_exact = man->result.flag_best = true;
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    array = ap_generator0_array_make(0);
+    return array;
+  }
+  nbcols = a->G->nbcolumns;
+  array = ap_generator0_array_make(a->G->nbrows);
+  mpz_init(den);
+  for (i=0; i<a->G->nbrows; i++){
+    numint_t* q = a->G->p[i];
+    array.p[i] = generator0_of_vector(pk,q,nbcols);
+    if (numint_sgn(q[grid_den]) && numint_sgn(q[grid_cst])==0){
+      /* parameter q[2..]/q[0] */
+      ap_linexpr0_t* e = array.p[i].linexpr0;
+      array.p[i].gentyp = AP_GEN_LINEMOD;
+      mpz_set_numint(den,q[grid_den]);
+      for (j=0; j<e->size; j++){
+	mpq_ptr mpq = e->p.coeff[j].val.scalar->val.mpq;
+	mpz_mul(mpq_denref(mpq),mpq_denref(mpq),den);
+	mpq_canonicalize(mpq);
+      }
+    }
+  }
+  mpz_clear(den);
+  return array;
+}
+
+/* ********************************************************************** */
+/* III. Operations */
+/* ********************************************************************** */
+
+/* ============================================================ */
+/* III.1 Meet and Join */
+/* ============================================================ */
+
+static pkgrid_t* grid_result(bool destructive, pkgrid_t* a)
+{
+  return destructive ? a : grid_alloc(a->intdim,a->realdim);
+}
+
+pkgrid_t* pkgrid_meet(ap_manager_t* man, bool destructive, pkgrid_t* a1, pkgrid_t* a2)
+{
+  pkgrid_t* res;
+  matrix_t* C;
+
+  pk_init_from_manager(man,AP_FUNID_MEET);
+  res = grid_result(destructive,a1);
+  if (grid_is_bottom(a1) || grid_is_bottom(a2)){
+    grid_set_bottom(res);
+  }
+  else {
+    grid_obtain_C(a1);
+    grid_obtain_C(a2);
+    C = matrix_append(a1->C,a2->C);
+    grid_module_canonicalize(C,true);
+    grid_set_C(res,C);
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+pkgrid_t* pkgrid_meet_array(ap_manager_t* man, pkgrid_t** tab, size_t size)
+{
+  pkgrid_t* res;
+  size_t i;
+
+  if (size==0){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_MEET_ARRAY,
+			       "empty array");
+    return grid_alloc(0,0);
+  }
+  res = pkgrid_copy(man,tab[0]);
+  for (i=1; i<size && !grid_is_bottom(res); i++){
+    res = pkgrid_meet(man,true,res,tab[i]);
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+pkgrid_t* pkgrid_join(ap_manager_t* man, bool destructive, pkgrid_t* a1, pkgrid_t* a2)
+{
+  pkgrid_t* res;
+  matrix_t* G;
+
+  pk_init_from_manager(man,AP_FUNID_JOIN);
+  grid_obtain_G(a1);
+  grid_obtain_G(a2);
+  res = grid_result(destructive,a1);
+  if (grid_is_bottom(a2)){
+    if (!destructive){
+      res->C = a1->C ? matrix_copy(a1->C) : NULL;
+      res->G = a1->G ? matrix_copy(a1->G) : NULL;
+    }
+  }
+  else if (grid_is_bottom(a1)){
+    res->C = a2->C ? matrix_copy(a2->C) : NULL;
+    res->G = matrix_copy(a2->G);
+  }
+  else {
+    G = matrix_append(a1->G,a2->G);
+    grid_module_canonicalize(G,false);
+    grid_set_G(res,G);
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+pkgrid_t* pkgrid_join_array(ap_manager_t* man, pkgrid_t** tab, size_t size)
+{
+  pkgrid_t* res;
+  size_t i;
+
+  if (size==0){
+    ap_manager_raise_exception(man,AP_EXC_INVALID_ARGUMENT,AP_FUNID_JOIN_ARRAY,
+			       "empty array");
+    return grid_alloc(0,0);
+  }
+  res = pkgrid_copy(man,tab[0]);
+  for (i=1; i<size; i++){
+    res = pkgrid_join(man,true,res,tab[i]);
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+/* Equalities and congruences are added to the congruences, the other
+   constraints are ignored unless they do not involve variables. */
+pkgrid_t* pkgrid_meet_lincons_array(ap_manager_t* man,
+				    bool destructive, pkgrid_t* a,
+				    ap_lincons0_array_t* array)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_MEET_LINCONS_ARRAY);
+  size_t dim = a->intdim+a->realdim;
+  size_t nbcols = grid_dec+dim;
+  itv_lincons_t* cons = &pk->poly_itv_lincons;
+  pkgrid_t* res;
+  matrix_t* C;
+  size_t i,j;
+  bool exact,sat;
+  numint_t tmp;
+
+  res = grid_result(destructive,a);
+  if (grid_is_bottom(a)){
+    man->result.flag_exact = man->result.flag_best = true;
+    return res;
+  }
+  grid_obtain_C(a);
+  C = matrix_copy(a->C);
+  exact = true;
+  sat = true;
+  numint_init(tmp);
+  for (i=0; i<array->size && sat; i++){
+    numint_t* q = grid_matrix_add_row(C);
+    itv_lincons_set_ap_lincons0(pk->itv,cons,&array->p[i]);
+    if (!grid_row_set_itv_linexpr(pk,q,&cons->linexpr,dim)){
+      C->nbrows--;
+      exact = false;
+      continue;
+    }
+    if (cons->constyp==AP_CONS_EQMOD && num_sgn(cons->num)){
+      /* element expr/modulo */
+      numint_mul(q[grid_den],q[grid_den],numrat_numref(cons->num));
+      numint_abs(q[grid_den],q[grid_den]);
+      for (j=grid_cst; j<nbcols; j++)
+	numint_mul(q[j],q[j],numrat_denref(cons->num));
+    }
+    else if (cons->constyp==AP_CONS_EQ || cons->constyp==AP_CONS_EQMOD){
+      numint_set_int(q[grid_den],0);
+    }
+    if (grid_row_is_constant(q,nbcols)){
+      /* the constraint is evaluated */
+      switch (cons->constyp){
+      case AP_CONS_EQ:
+	sat = numint_sgn(q[grid_cst])==0;
+	break;
+      case AP_CONS_EQMOD:
+	sat = numint_sgn(q[grid_den]) ?
+	  grid_divides(q[grid_cst],q[grid_den],tmp) :
+	  numint_sgn(q[grid_cst])==0;
+	break;
+      case AP_CONS_SUPEQ:
+	sat = numint_sgn(q[grid_cst])>=0;
+	break;
+      case AP_CONS_SUP:
+	sat = numint_sgn(q[grid_cst])>0;
+	break;
+      case AP_CONS_DISEQ:
+	sat = numint_sgn(q[grid_cst])!=0;
+	break;
+      default:
+	abort();
+      }
+      C->nbrows--;
+    }
+    else if (cons->constyp!=AP_CONS_EQ && cons->constyp!=AP_CONS_EQMOD){
+      C->nbrows--;
+      exact = false;
+    }
+  }
+  numint_clear(tmp);
+  if (sat){
+    grid_module_canonicalize(C,true);
+    grid_set_C(res,C);
+  }
+  else {
+    matrix_free(C);
+    grid_set_bottom(res);
+    exact = true;
+  }
+  man->result.flag_exact = man->result.flag_best = exact;
+  return res;
+}
+
+static
+void* pkgrid_meet_lincons_array2(ap_manager_t* man,
+				 bool destructive, void* a,
+				 ap_lincons0_array_t* array)
+{
+  return (void*)(pkgrid_meet_lincons_array(man,destructive,(pkgrid_t*)a,array));
+}
+
+pkgrid_t* pkgrid_meet_tcons_array(ap_manager_t* man,
+				  bool destructive, pkgrid_t* a,
+				  ap_tcons0_array_t* array)
+{
+  return ap_generic_meet_intlinearize_tcons_array(man,destructive,a,array,
+						  AP_SCALAR_MPQ, AP_LINEXPR_LINEAR,
+						  &pkgrid_meet_lincons_array2);
+}
+
+/* Lines and modular lines are added, rays are approximated by lines */
+pkgrid_t* pkgrid_add_ray_array(ap_manager_t* man,
+			       bool destructive, pkgrid_t* a,
+			       ap_generator0_array_t* array)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_ADD_RAY_ARRAY);
+  size_t dim = a->intdim+a->realdim;
+  pkgrid_t* res;
+  matrix_t* G;
+  size_t i;
+  bool exact;
+
+  res = grid_result(destructive,a);
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    grid_set_bottom(res);
+    man->result.flag_exact = man->result.flag_best = true;
+    return res;
+  }
+  G = matrix_copy(a->G);
+  exact = true;
+  for (i=0; i<array->size; i++){
+    ap_generator0_t* gen = &array->p[i];
+    numint_t* q;
+    if (gen->gentyp==AP_GEN_VERTEX){
+      exact = false;
+      continue;
+    }
+    q = grid_matrix_add_row(G);
+    if (!grid_row_set_linexpr(pk,q,gen->linexpr0,dim)){
+      G->nbrows--;
+      exact = false;
+      continue;
+    }
+    numint_set_int(q[grid_cst],0);
+    if (gen->gentyp==AP_GEN_LINE || gen->gentyp==AP_GEN_RAY)
+      numint_set_int(q[grid_den],0);
+    if (gen->gentyp==AP_GEN_RAY || gen->gentyp==AP_GEN_RAYMOD)
+      exact = false;
+  }
+  grid_module_canonicalize(G,false);
+  grid_set_G(res,G);
+  man->result.flag_exact = man->result.flag_best = exact;
+  return res;
+}
+
+/* ============================================================ */
+/* III.2 Assignement and Substitutions */
+/* ============================================================ */
+
+/* Converts the expressions into rows, NULL for non scalar ones; the lcm of
+   the denominators is put in lcm. */
+static numint_t** grid_rows_of_linexpr_array(pk_internal_t* pk,
+					     ap_linexpr0_t** texpr, size_t size,
+					     size_t dim, numint_t lcm)
+{
+  numint_t** tq;
+  size_t i;
+
+  tq = (numint_t**)malloc(size*sizeof(numint_t*));
+  numint_set_int(lcm,1);
+  for (i=0; i<size; i++){
+    tq[i] = vector_alloc(grid_dec+dim);
+    if (grid_row_set_linexpr(pk,tq[i],texpr[i],dim)){
+      numint_lcm(lcm,lcm,tq[i][grid_den]);
+    }
+    else {
+      vector_free(tq[i],grid_dec+dim);
+      tq[i] = NULL;
+    }
+  }
+  return tq;
+}
+static void grid_rows_free(numint_t** tq, size_t size, size_t dim)
+{
+  size_t i;
+  for (i=0; i<size; i++){
+    if (tq[i]) vector_free(tq[i],grid_dec+dim);
+  }
+  free(tq);
+}
+
+/* The image of the generators by the affine transformation */
+pkgrid_t* pkgrid_assign_linexpr_array(ap_manager_t* man,
+				      bool destructive, pkgrid_t* a,
+				      ap_dim_t* tdim,
+				      ap_linexpr0_t** texpr,
+				      size_t size,
+				      pkgrid_t* dest)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_ASSIGN_LINEXPR_ARRAY);
+  size_t dim = a->intdim+a->realdim;
+  size_t nbcols = grid_dec+dim;
+  pkgrid_t* res;
+  matrix_t* G;
+  numint_t** tq;
+  size_t i,j,k;
+  bool exact;
+  numint_t lcm,mul,tmp;
+
+  res = grid_result(destructive,a);
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    grid_set_bottom(res);
+    man->result.flag_exact = man->result.flag_best = true;
+    return res;
+  }
+  numint_init(lcm); numint_init(mul); numint_init(tmp);
+  tq = grid_rows_of_linexpr_array(pk,texpr,size,dim,lcm);
+  G = matrix_alloc(a->G->nbrows,nbcols,false);
+  for (i=0; i<a->G->nbrows; i++){
+    numint_t* g = a->G->p[i];
+    numint_t* q = G->p[i];
+    numint_mul(q[grid_den],g[grid_den],lcm);
+    for (j=grid_cst; j<nbcols; j++)
+      numint_mul(q[j],g[j],lcm);
+    for (k=0; k<size; k++){
+      numint_t* e = tq[k];
+      numint_t* pq = &q[grid_dec+tdim[k]];
+      if (e){
+	/* lcm.e(g) */
+	grid_row_product(*pq,e,g,nbcols,tmp);
+	numint_divexact(mul,lcm,e[grid_den]);
+	numint_mul(*pq,*pq,mul);
+      }
+      else
+	numint_set_int(*pq,0);
+    }
+    grid_row_normalize(q,nbcols,tmp);
+  }
+  exact = true;
+  for (k=0; k<size; k++){
+    if (tq[k]==NULL){
+      numint_t* q = grid_matrix_add_row(G);
+      numint_set_int(q[grid_dec+tdim[k]],1);
+      exact = false;
+    }
+  }
+  grid_rows_free(tq,size,dim);
+  numint_clear(lcm); numint_clear(mul); numint_clear(tmp);
+  grid_module_canonicalize(G,false);
+  grid_set_G(res,G);
+  if (dest){
+    res = pkgrid_meet(man,true,res,dest);
+  }
+  man->result.flag_exact = man->result.flag_best = exact;
+  return res;
+}
+
+/* The preimage of the congruences by the affine transformation */
+pkgrid_t* pkgrid_substitute_linexpr_array(ap_manager_t* man,
+					  bool destructive, pkgrid_t* a,
+					  ap_dim_t* tdim,
+					  ap_linexpr0_t** texpr,
+					  size_t size,
+					  pkgrid_t* dest)
+{
+  pk_internal_t* pk = pk_init_from_manager(man,AP_FUNID_SUBSTITUTE_LINEXPR_ARRAY);
+  size_t dim = a->intdim+a->realdim;
+  size_t nbcols = grid_dec+dim;
+  pkgrid_t* res;
+  matrix_t* C;
+  numint_t** tq;
+  size_t i,j,k;
+  bool exact;
+  numint_t lcm,mul,tmp;
+
+  res = grid_result(destructive,a);
+  if (grid_is_bottom(a)){
+    man->result.flag_exact = man->result.flag_best = true;
+    return res;
+  }
+  grid_obtain_C(a);
+  numint_init(lcm); numint_init(mul); numint_init(tmp);
+  tq = grid_rows_of_linexpr_array(pk,texpr,size,dim,lcm);
+  C = matrix_alloc(0,nbcols,false);
+  exact = true;
+  for (i=0; i<a->C->nbrows; i++){
+    numint_t* c = a->C->p[i];
+    numint_t* q;
+    for (k=0; k<size; k++){
+      if (tq[k]==NULL && numint_sgn(c[grid_dec+tdim[k]])) break;
+    }
+    if (k<size){
+      /* the congruence is lost */
+      exact = false;
+      continue;
+    }
+    q = grid_matrix_add_row(C);
+    numint_mul(q[grid_den],c[grid_den],lcm);
+    for (j=grid_cst; j<nbcols; j++)
+      numint_mul(q[j],c[j],lcm);
+    for (k=0; k<size; k++)
+      numint_set_int(q[grid_dec+tdim[k]],0);
+    for (k=0; k<size; k++){
+      numint_t* e = tq[k];
+      if (e && numint_sgn(c[grid_dec+tdim[k]])){
+	numint_divexact(mul,lcm,e[grid_den]);
+	numint_mul(mul,mul,c[grid_dec+tdim[k]]);
+	for (j=grid_cst; j<nbcols; j++){
+	  if (numint_sgn(e[j])){
+	    numint_mul(tmp,mul,e[j]);
+	    numint_add(q[j],q[j],tmp);
+	  }
+	}
+      }
+    }
+    grid_row_normalize(q,nbcols,tmp);
+  }
+  grid_rows_free(tq,size,dim);
+  numint_clear(lcm); numint_clear(mul); numint_clear(tmp);
+  grid_C_canonicalize(C);
+  grid_set_C(res,C);
+  if (dest){
+    res = pkgrid_meet(man,true,res,dest);
+  }
+  man->result.flag_exact = man->result.flag_best = exact;
+  return res;
+}
+
+pkgrid_t* pkgrid_assign_texpr_array(ap_manager_t* man,
+				    bool destructive, pkgrid_t* a,
+				    ap_dim_t* tdim,
+				    ap_texpr0_t** texpr,
+				    size_t size,
+				    pkgrid_t* dest)
+{
+  return ap_generic_asssub_texpr_array(true,
+				       man,destructive,a,tdim,texpr,size,dest);
+}
+pkgrid_t* pkgrid_substitute_texpr_array(ap_manager_t* man,
+					bool destructive, pkgrid_t* a,
+					ap_dim_t* tdim,
+					ap_texpr0_t** texpr,
+					size_t size,
+					pkgrid_t* dest)
+{
+  return ap_generic_asssub_texpr_array(false,
+				       man,destructive,a,tdim,texpr,size,dest);
+}
+
+/* ============================================================ */
+/* III.3 Projections */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_forget_array(ap_manager_t* man,
+			      bool destructive, pkgrid_t* a,
+			      ap_dim_t* tdim, size_t size,
+			      bool project)
+{
+  pkgrid_t* res;
+  matrix_t* G;
+  size_t i,k;
+
+  pk_init_from_manager(man,AP_FUNID_FORGET_ARRAY);
+  res = grid_result(destructive,a);
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    grid_set_bottom(res);
+  }
+  else {
+    G = matrix_copy(a->G);
+    if (project){
+      for (i=0; i<G->nbrows; i++){
+	for (k=0; k<size; k++)
+	  numint_set_int(G->p[i][grid_dec+tdim[k]],0);
+      }
+    }
+    else {
+      for (k=0; k<size; k++){
+	numint_t* q = grid_matrix_add_row(G);
+	numint_set_int(q[grid_dec+tdim[k]],1);
+      }
+    }
+    grid_module_canonicalize(G,false);
+    grid_set_G(res,G);
+  }
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+/* ============================================================ */
+/* III.4 Change and permutation of dimensions */
+/* ============================================================ */
+
+/* Copy of mat with nbcols columns, the column j of a row being put in the
+   column map[j-grid_dec]+grid_dec, or removed if map[j-grid_dec] is
+   AP_DIM_MAX */
+static matrix_t* grid_matrix_map(matrix_t* mat, size_t nbcols, ap_dim_t* map)
+{
+  matrix_t* res;
+  size_t i,j;
+
+  res = matrix_alloc(mat->nbrows,nbcols,false);
+  for (i=0; i<mat->nbrows; i++){
+    numint_set(res->p[i][grid_den],mat->p[i][grid_den]);
+    numint_set(res->p[i][grid_cst],mat->p[i][grid_cst]);
+    for (j=grid_dec; j<mat->nbcolumns; j++){
+      if (map[j-grid_dec]!=AP_DIM_MAX)
+	numint_set(res->p[i][grid_dec+map[j-grid_dec]],mat->p[i][j]);
+    }
+  }
+  return res;
+}
+
+pkgrid_t* pkgrid_add_dimensions(ap_manager_t* man,
+				bool destructive, pkgrid_t* a,
+				ap_dimchange_t* dimchange,
+				bool project)
+{
+  pkgrid_t* res;
+  size_t dim,nbdims,i,k;
+  ap_dim_t* map;
+  matrix_t* C = NULL;
+  matrix_t* G = NULL;
+
+  pk_init_from_manager(man,AP_FUNID_ADD_DIMENSIONS);
+  res = grid_result(destructive,a);
+  dim = a->intdim+a->realdim;
+  nbdims = dimchange->intdim+dimchange->realdim;
+  if (!grid_is_bottom(a)){
+    map = (ap_dim_t*)malloc((dim+1)*sizeof(ap_dim_t));
+    k = 0;
+    for (i=0; i<dim; i++){
+      while (k<nbdims && dimchange->dim[k]<=i) k++;
+      map[i] = i+k;
+    }
+    if (a->C){
+      C = grid_matrix_map(a->C,grid_dec+dim+nbdims,map);
+      if (project){
+	for (k=0; k<nbdims; k++){
+	  numint_t* q = grid_matrix_add_row(C);
+	  numint_set_int(q[grid_dec+dimchange->dim[k]+k],1);
+	}
+	grid_module_canonicalize(C,true);
+      }
+    }
+    if (a->G){
+      G = grid_matrix_map(a->G,grid_dec+dim+nbdims,map);
+      if (!project){
+	for (k=0; k<nbdims; k++){
+	  numint_t* q = grid_matrix_add_row(G);
+	  numint_set_int(q[grid_dec+dimchange->dim[k]+k],1);
+	}
+	grid_module_canonicalize(G,false);
+      }
+    }
+    free(map);
+    grid_set_bottom(res);
+    res->C = C;
+    res->G = G;
+  }
+  res->intdim = a->intdim+dimchange->intdim;
+  res->realdim = a->realdim+dimchange->realdim;
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+pkgrid_t* pkgrid_remove_dimensions(ap_manager_t* man,
+				   bool destructive, pkgrid_t* a,
+				   ap_dimchange_t* dimchange)
+{
+  pkgrid_t* res;
+  size_t dim,nbdims,i,k;
+  ap_dim_t* map;
+  matrix_t* G;
+
+  pk_init_from_manager(man,AP_FUNID_REMOVE_DIMENSIONS);
+  res = grid_result(destructive,a);
+  dim = a->intdim+a->realdim;
+  nbdims = dimchange->intdim+dimchange->realdim;
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    grid_set_bottom(res);
+  }
+  else {
+    map = (ap_dim_t*)malloc(dim*sizeof(ap_dim_t));
+    k = 0;
+    for (i=0; i<dim; i++){
+      if (k<nbdims && dimchange->dim[k]==i){
+	map[i] = AP_DIM_MAX;
+	k++;
+      }
+      else
+	map[i] = i-k;
+    }
+    G = grid_matrix_map(a->G,grid_dec+dim-nbdims,map);
+    free(map);
+    grid_module_canonicalize(G,false);
+    grid_set_G(res,G);
+  }
+  res->intdim = a->intdim-dimchange->intdim;
+  res->realdim = a->realdim-dimchange->realdim;
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+pkgrid_t* pkgrid_permute_dimensions(ap_manager_t* man,
+				    bool destructive,
+				    pkgrid_t* a,
+				    ap_dimperm_t* permutation)
+{
+  pkgrid_t* res;
+  matrix_t* C = NULL;
+  matrix_t* G = NULL;
+
+  pk_init_from_manager(man,AP_FUNID_PERMUTE_DIMENSIONS);
+  res = grid_result(destructive,a);
+  if (a->C){
+    C = grid_matrix_map(a->C,a->C->nbcolumns,permutation->dim);
+    grid_module_canonicalize(C,true);
+  }
+  if (a->G){
+    G = grid_matrix_map(a->G,a->G->nbcolumns,permutation->dim);
+    grid_module_canonicalize(G,false);
+  }
+  grid_set_bottom(res);
+  res->C = C;
+  res->G = G;
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+/* ============================================================ */
+/* III.5 Expansion and folding of dimensions */
+/* ============================================================ */
+
+/* The congruences involving dim are duplicated for each new dimension */
+pkgrid_t* pkgrid_expand(ap_manager_t* man,
+			bool destructive, pkgrid_t* a,
+			ap_dim_t dim,
+			size_t n)
+{
+  pkgrid_t* res;
+  size_t i,k,nbdims,nbrows;
+  size_t intdim,realdim;
+  ap_dim_t pos;
+  ap_dim_t* map;
+  matrix_t* C;
+
+  pk_init_from_manager(man,AP_FUNID_EXPAND);
+  res = grid_result(destructive,a);
+  intdim = a->intdim;
+  realdim = a->realdim;
+  nbdims = intdim+realdim;
+  /* new dimensions are inserted at pos */
+  if (dim<intdim){
+    pos = intdim;
+    intdim += n;
+  }
+  else {
+    pos = nbdims;
+    realdim += n;
+  }
+  if (!grid_is_bottom(a)){
+    grid_obtain_C(a);
+    map = (ap_dim_t*)malloc(nbdims*sizeof(ap_dim_t));
+    for (i=0; i<nbdims; i++)
+      map[i] = i<pos ? i : i+n;
+    C = grid_matrix_map(a->C,grid_dec+nbdims+n,map);
+    free(map);
+    nbrows = C->nbrows;
+    for (i=0; i<nbrows; i++){
+      ap_dim_t ndim = dim<pos ? dim : dim+n;
+      if (numint_sgn(C->p[i][grid_dec+ndim])==0) continue;
+      for (k=0; k<n; k++){
+	numint_t* q = grid_matrix_add_row(C);
+	vector_copy(q,C->p[i],C->nbcolumns);
+	numint_set_int(q[grid_dec+ndim],0);
+	numint_set(q[grid_dec+pos+k],C->p[i][grid_dec+ndim]);
+      }
+    }
+    grid_module_canonicalize(C,true);
+    grid_set_C(res,C);
+  }
+  res->intdim = intdim;
+  res->realdim = realdim;
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+/* Join of the grids in which tdim[0] takes the values of each tdim[i] */
+pkgrid_t* pkgrid_fold(ap_manager_t* man,
+		      bool destructive, pkgrid_t* a,
+		      ap_dim_t* tdim,
+		      size_t size)
+{
+  pkgrid_t* res;
+  size_t i,k,dim,nbcols;
+  ap_dim_t* map;
+  matrix_t* G;
+  matrix_t* G2;
+
+  pk_init_from_manager(man,AP_FUNID_FOLD);
+  res = grid_result(destructive,a);
+  dim = a->intdim+a->realdim;
+  nbcols = grid_dec+dim;
+  grid_obtain_G(a);
+  if (grid_is_bottom(a)){
+    grid_set_bottom(res);
+  }
+  else {
+    G = matrix_alloc(0,nbcols,false);
+    for (i=0; i<a->G->nbrows; i++){
+      for (k=0; k<size; k++){
+	numint_t* q = grid_matrix_add_row(G);
+	vector_copy(q,a->G->p[i],nbcols);
+	numint_set(q[grid_dec+tdim[0]],a->G->p[i][grid_dec+tdim[k]]);
+      }
+    }
+    map = (ap_dim_t*)malloc(dim*sizeof(ap_dim_t));
+    k = 1;
+    for (i=0; i<dim; i++){
+      if (k<size && tdim[k]==i){
+	map[i] = AP_DIM_MAX;
+	k++;
+      }
+      else
+	map[i] = i-(k-1);
+    }
+    G2 = grid_matrix_map(G,nbcols-(size-1),map);
+    free(map);
+    matrix_free(G);
+    grid_module_canonicalize(G2,false);
+    grid_set_G(res,G2);
+  }
+  if (tdim[0]<a->intdim)
+    res->intdim = a->intdim-(size-1);
+  else
+    res->realdim = a->realdim-(size-1);
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+/* ============================================================ */
+/* III.6 Widening */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_widening(ap_manager_t* man,
+			  pkgrid_t* a1, pkgrid_t* a2)
+{
+  pkgrid_t* res;
+  matrix_t* C;
+  size_t i;
+  numint_t prod,den,tmp;
+
+  pk_init_from_manager(man,AP_FUNID_WIDENING);
+  grid_obtain_G(a1);
+  grid_obtain_G(a2);
+  if (grid_is_bottom(a1))
+    return pkgrid_copy(man,a2);
+  if (grid_is_bottom(a2))
+    return pkgrid_copy(man,a1);
+  grid_obtain_C(a1);
+  res = grid_alloc(a1->intdim,a1->realdim);
+  C = matrix_alloc(0,a1->C->nbcolumns,false);
+  numint_init(prod); numint_init(den); numint_init(tmp);
+  for (i=0; i<a1->C->nbrows; i++){
+    if (grid_sat_row(a2->G,a1->C->p[i],prod,den,tmp)){
+      numint_t* q = grid_matrix_add_row(C);
+      vector_copy(q,a1->C->p[i],C->nbcolumns);
+    }
+  }
+  numint_clear(prod); numint_clear(den); numint_clear(tmp);
+  grid_C_canonicalize(C);
+  res->C = C;
+  man->result.flag_exact = man->result.flag_best = false;
+  return res;
+}
+
+/* ============================================================ */
+/* III.7 Closure operation */
+/* ============================================================ */
+
+/* Grids are topologically closed */
+pkgrid_t* pkgrid_closure(ap_manager_t* man, bool destructive, pkgrid_t* a)
+{
+  pkgrid_t* res = destructive ? a : pkgrid_copy(man,a);
+  man->result.flag_exact = man->result.flag_best = true;
+  return res;
+}
+
+/* ********************************************************************** */
+/* IV. Manager */
+/* ********************************************************************** */
+
+pkgrid_t* pkgrid_of_abstract0(ap_abstract0_t* abstract)
+{
+  return (pkgrid_t*)abstract->value;
+}
+
+ap_abstract0_t* pkgrid_to_abstract0(ap_manager_t* man, pkgrid_t* grid)
+{
+  ap_abstract0_t* res = malloc(sizeof(ap_abstract0_t));
+  assert(man->library && strcmp(man->library,"polka, grid mode")==0);
+  res->value = grid;
+  res->man = ap_manager_copy(man);
+  return res;
+}
+
+pk_internal_t* pkgrid_manager_get_internal(ap_manager_t* man)
+{
+  return pk_manager_get_internal(man);
+}
+
+ap_manager_t* pkgrid_manager_alloc(void)
+{
+  pk_internal_t* pk;
+  ap_manager_t* man;
+  void** funptr;
+
+  pk = pk_internal_alloc(false);
+  assert(pk->dec==grid_dec);
+  man = ap_manager_alloc("polka, grid mode",
+#if defined(NUMINT_LONGINT)
+			 "3.0 with NUMINT_LONGINT",
+#elif defined(NUMINT_LONGLONGINT)
+			 "3.0 with NUMINT_LONGLONGINT",
+#elif defined(NUMINT_MPZ)
+			 "3.0 with NUMINT_MPZ",
+#else
+#error "here"
+#endif
+			 pk, (void (*)(void*))pk_internal_free);
+  funptr = man->funptr;
+
+  funptr[AP_FUNID_COPY] = &pkgrid_copy;
+  funptr[AP_FUNID_FREE] = &pkgrid_free;
+  funptr[AP_FUNID_ASIZE] = &pkgrid_size;
+  funptr[AP_FUNID_MEMORY_SIZE] = &pkgrid_memory_size;
+  funptr[AP_FUNID_MINIMIZE] = &pkgrid_minimize;
+  funptr[AP_FUNID_CANONICALIZE] = &pkgrid_canonicalize;
+  funptr[AP_FUNID_HASH] = &pkgrid_hash;
+  funptr[AP_FUNID_APPROXIMATE] = &pkgrid_approximate;
+  funptr[AP_FUNID_FPRINT] = &pkgrid_fprint;
+  funptr[AP_FUNID_FPRINTDIFF] = &pkgrid_fprintdiff;
+  funptr[AP_FUNID_FDUMP] = &pkgrid_fdump;
+  funptr[AP_FUNID_SERIALIZE_RAW] = &pkgrid_serialize_raw;
+  funptr[AP_FUNID_DESERIALIZE_RAW] = &pkgrid_deserialize_raw;
+  funptr[AP_FUNID_BOTTOM] = &pkgrid_bottom;
+  funptr[AP_FUNID_TOP] = &pkgrid_top;
+  funptr[AP_FUNID_OF_BOX] = &pkgrid_of_box;
+  funptr[AP_FUNID_DIMENSION] = &pkgrid_dimension;
+  funptr[AP_FUNID_IS_BOTTOM] = &pkgrid_is_bottom;
+  funptr[AP_FUNID_IS_TOP] = &pkgrid_is_top;
+  funptr[AP_FUNID_IS_LEQ] = &pkgrid_is_leq;
+  funptr[AP_FUNID_IS_EQ] = &pkgrid_is_eq;
+  funptr[AP_FUNID_IS_DIMENSION_UNCONSTRAINED] = &pkgrid_is_dimension_unconstrained;
+  funptr[AP_FUNID_SAT_INTERVAL] = &pkgrid_sat_interval;
+  funptr[AP_FUNID_SAT_LINCONS] = &pkgrid_sat_lincons;
+  funptr[AP_FUNID_SAT_TCONS] = &pkgrid_sat_tcons;
+  funptr[AP_FUNID_BOUND_DIMENSION] = &pkgrid_bound_dimension;
+  funptr[AP_FUNID_BOUND_LINEXPR] = &pkgrid_bound_linexpr;
+  funptr[AP_FUNID_BOUND_TEXPR] = &pkgrid_bound_texpr;
+  funptr[AP_FUNID_TO_BOX] = &pkgrid_to_box;
+  funptr[AP_FUNID_TO_LINCONS_ARRAY] = &pkgrid_to_lincons_array;
+  funptr[AP_FUNID_TO_TCONS_ARRAY] = &pkgrid_to_tcons_array;
+  funptr[AP_FUNID_TO_GENERATOR_ARRAY] = &pkgrid_to_generator_array;
+  funptr[AP_FUNID_MEET] = &pkgrid_meet;
+  funptr[AP_FUNID_MEET_ARRAY] = &pkgrid_meet_array;
+  funptr[AP_FUNID_MEET_LINCONS_ARRAY] = &pkgrid_meet_lincons_array;
+  funptr[AP_FUNID_MEET_TCONS_ARRAY] = &pkgrid_meet_tcons_array;
+  funptr[AP_FUNID_JOIN] = &pkgrid_join;
+  funptr[AP_FUNID_JOIN_ARRAY] = &pkgrid_join_array;
+  funptr[AP_FUNID_ADD_RAY_ARRAY] = &pkgrid_add_ray_array;
+  funptr[AP_FUNID_ASSIGN_LINEXPR_ARRAY] = &pkgrid_assign_linexpr_array;
+  funptr[AP_FUNID_SUBSTITUTE_LINEXPR_ARRAY] = &pkgrid_substitute_linexpr_array;
+  funptr[AP_FUNID_ASSIGN_TEXPR_ARRAY] = &pkgrid_assign_texpr_array;
+  funptr[AP_FUNID_SUBSTITUTE_TEXPR_ARRAY] = &pkgrid_substitute_texpr_array;
+  funptr[AP_FUNID_ADD_DIMENSIONS] = &pkgrid_add_dimensions;
+  funptr[AP_FUNID_REMOVE_DIMENSIONS] = &pkgrid_remove_dimensions;
+  funptr[AP_FUNID_PERMUTE_DIMENSIONS] = &pkgrid_permute_dimensions;
+  funptr[AP_FUNID_FORGET_ARRAY] = &pkgrid_forget_array;
+  funptr[AP_FUNID_EXPAND] = &pkgrid_expand;
+  funptr[AP_FUNID_FOLD] = &pkgrid_fold;
+  funptr[AP_FUNID_WIDENING] = &pkgrid_widening;
+  funptr[AP_FUNID_CLOSURE] = &pkgrid_closure;
+
+  return man;
+}
@@ -0,0 +1,399 @@
+/* ********************************************************************** */
+/* pkgrid.h: Interface of the polka grid (linear congruences) library  */
+/* ********************************************************************** */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#ifndef __PKGRID_H__
+#define __PKGRID_H__
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "ap_global0.h"
+#include "pk.h"
+
+typedef struct pkgrid_t pkgrid_t;
+
+/*
+
+  A grid is a set of points
+
+    { p + sum_i k_i.v_i + sum_j l_j.w_j | k_i integers, l_j rationals }
+
+  or, dually, the set of solutions of a conjunction of linear equalities
+  (e=0) and linear congruences (e=0 mod m).
+
+  Both representations are kept as matrices of NewPolka integer vectors, in
+  Hermite normal form for the lattice part and in reduced echelon form for
+  the vector space part, so that the representations are canonical. The
+  conversion between them is computed by a matrix inversion.
+
+  Constraints which are not equalities or congruences are ignored by the
+  meets (the result is then not exact), but the ones without variables are
+  evaluated. Integer dimensions are not assumed to take integer values.
+
+  Important remark: the newpolka library is normally intended to be accessed
+  through the APRON interface, i.e., through abstract0_XX and abstract1_XX
+  functions. If it is accessed directly with pkgrid_XXX functions, many
+  checks on arguments will not be performed.
+
+*/
+
+
+/* ============================================================ */
+/* A. Constructor for APRON manager (to be freed with ap_manager_free). */
+/* ============================================================ */
+
+ap_manager_t* pkgrid_manager_alloc(void);
+pk_internal_t* pkgrid_manager_get_internal(ap_manager_t*);
+
+/* ============================================================ */
+/* D. Conversions */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_of_abstract0(ap_abstract0_t* abstract);
+  /* Extract from an abstract value the underlying grid.  There
+     is no copy, so only one of the two objects should be freed. */
+
+ap_abstract0_t* pkgrid_to_abstract0(ap_manager_t* man, pkgrid_t* grid);
+  /* Create an abstract value from the manager and the underlying
+     grid. There is no copy, and only the result should be freed
+  */
+
+/* ********************************************************************** */
+/* I. General management */
+/* ********************************************************************** */
+
+/* ============================================================ */
+/* I.1 Memory */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_copy(ap_manager_t* man, pkgrid_t* a);
+  /* Return a copy of an abstract value, on
+     which destructive update does not affect the initial value. */
+
+void pkgrid_free(ap_manager_t* man, pkgrid_t* a);
+  /* Free all the memory used by the abstract value */
+
+size_t pkgrid_size(ap_manager_t* man, pkgrid_t* a);
+  /* Return the abstract size of an abstract value (see ap_manager_t) */
+
+size_t pkgrid_memory_size(ap_manager_t* man, pkgrid_t* a);
+  /* Return the number of bytes allocated for a grid */
+
+
+/* ============================================================ */
+/* I.2 Control of internal representation */
+/* ============================================================ */
+
+void pkgrid_minimize(ap_manager_t* man, pkgrid_t* a);
+  /* Minimize the size of the representation of a.
+     This may result in a later recomputation of internal information.
+  */
+
+void pkgrid_canonicalize(ap_manager_t* man, pkgrid_t* a);
+  /* Put the abstract value in canonical form: both representations are
+     computed. */
+
+int pkgrid_hash(ap_manager_t* man, pkgrid_t* a);
+  /* Return an hash code */
+
+void pkgrid_approximate(ap_manager_t* man, pkgrid_t* a, int algorithm);
+  /* Perform some transformation on the abstract value, guided by the
+     field algorithm.
+
+     The transformation may lose information. */
+
+/* ============================================================ */
+/* I.3 Printing */
+/* ============================================================ */
+
+void pkgrid_fprint(FILE* stream,
+		   ap_manager_t* man,
+		   pkgrid_t* a,
+		   char** name_of_dim);
+  /* Print the abstract value in a pretty way, using function
+     name_of_dim to name dimensions */
+
+void pkgrid_fprintdiff(FILE* stream,
+		       ap_manager_t* man,
+		       pkgrid_t* a1, pkgrid_t* a2,
+		       char** name_of_dim);
+  /* Print the difference between a1 (old value) and a2 (new value),
+     using function name_of_dim to name dimensions.
+     The meaning of difference is library dependent. */
+
+void pkgrid_fdump(FILE* stream, ap_manager_t* man, pkgrid_t* a);
+  /* Dump the internal representation of an abstract value,
+     for debugging purposes */
+
+
+/* ============================================================ */
+/* I.4 Serialization */
+/* ============================================================ */
+
+ap_membuf_t pkgrid_serialize_raw(ap_manager_t* man, pkgrid_t* a);
+/* Allocate a memory buffer (with malloc), output the abstract value in raw
+   binary format to it and return a pointer on the memory buffer and the size
+   of bytes written.  It is the user responsability to free the memory
+   afterwards (with free). */
+
+pkgrid_t* pkgrid_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size);
+/* Return the abstract value read in raw binary format from the input stream
+   and store in size the number of bytes read */
+
+/* ********************************************************************** */
+/* II. Constructor, accessors, tests and property extraction */
+/* ********************************************************************** */
+
+/* ============================================================ */
+/* II.1 Basic constructors */
+/* ============================================================ */
+
+/* We assume that dimensions [0..intdim-1] correspond to integer variables, and
+   dimensions [intdim..intdim+realdim-1] to real variables */
+
+pkgrid_t* pkgrid_bottom(ap_manager_t* man, size_t intdim, size_t realdim);
+  /* Create a bottom (empty) value */
+
+pkgrid_t* pkgrid_top(ap_manager_t* man, size_t intdim, size_t realdim);
+  /* Create a top (universe) value */
+
+
+pkgrid_t* pkgrid_of_box(ap_manager_t* man,
+			size_t intdim, size_t realdim,
+			ap_interval_t** tinterval);
+  /* Abstract an hypercube defined by the array of intervals
+     of size intdim+realdim */
+
+pkgrid_t* pkgrid_of_lincons_array(ap_manager_t* man,
+				  size_t intdim, size_t realdim,
+				  ap_lincons0_array_t* array);
+  /* Abstract a grid defined by the array of linear constraints
+     of size size */
+
+
+/* ============================================================ */
+/* II.2 Accessors */
+/* ============================================================ */
+
+ap_dimension_t pkgrid_dimension(ap_manager_t* man, pkgrid_t* a);
+/* Return the total number of dimensions of the abstract values */
+
+/* ============================================================ */
+/* II.3 Tests */
+/* ============================================================ */
+
+bool pkgrid_is_bottom(ap_manager_t* man, pkgrid_t* a);
+bool pkgrid_is_top(ap_manager_t* man, pkgrid_t* a);
+
+bool pkgrid_is_leq(ap_manager_t* man, pkgrid_t* a1, pkgrid_t* a2);
+  /* inclusion check */
+
+bool pkgrid_is_eq(ap_manager_t* man, pkgrid_t* a1, pkgrid_t* a2);
+  /* equality check */
+
+bool pkgrid_sat_lincons(ap_manager_t* man, pkgrid_t* a, ap_lincons0_t* lincons);
+  /* does the abstract value satisfy the linear constraint ? */
+
+bool pkgrid_sat_tcons(ap_manager_t* man, pkgrid_t* a, ap_tcons0_t* cons);
+  /* does the abstract value satisfy the tree expression constraint ? */
+
+bool pkgrid_sat_interval(ap_manager_t* man, pkgrid_t* a,
+			 ap_dim_t dim, ap_interval_t* interval);
+  /* is the dimension included in the interval in the abstract value ? */
+
+bool pkgrid_is_dimension_unconstrained(ap_manager_t* man, pkgrid_t* a,
+				       ap_dim_t dim);
+  /* is the dimension unconstrained ? */
+
+/* ============================================================ */
+/* II.4 Extraction of properties */
+/* ============================================================ */
+
+ap_interval_t* pkgrid_bound_linexpr(ap_manager_t* man,
+				    pkgrid_t* a, ap_linexpr0_t* expr);
+  /* Returns the interval taken by a linear expression
+     over the abstract value */
+
+ap_interval_t* pkgrid_bound_texpr(ap_manager_t* man,
+				  pkgrid_t* a, ap_texpr0_t* expr);
+  /* Returns the interval taken by a tree expression
+     over the abstract value */
+
+ap_interval_t* pkgrid_bound_dimension(ap_manager_t* man,
+				      pkgrid_t* a, ap_dim_t dim);
+  /* Returns the interval taken by the dimension
+     over the abstract value */
+
+ap_lincons0_array_t pkgrid_to_lincons_array(ap_manager_t* man, pkgrid_t* a);
+  /* Converts an abstract value to a conjunction of linear equalities and
+     congruences. */
+
+ap_tcons0_array_t pkgrid_to_tcons_array(ap_manager_t* man, pkgrid_t* a);
+  /* Converts an abstract value to a
+     conjunction of tree expressions constraints. */
+
+ap_interval_t** pkgrid_to_box(ap_manager_t* man, pkgrid_t* a);
+  /* Converts an abstract value to an interval/hypercube.
+     The size of the resulting array is pkgrid_dimension(man,a).  This
+     function can be reimplemented by using pkgrid_bound_linexpr */
+
+ap_generator0_array_t pkgrid_to_generator_array(ap_manager_t* man, pkgrid_t* a);
+  /* Converts an abstract value to a system of generators: a vertex, lines
+     and modular lines (parameters). */
+
+
+/* ********************************************************************** */
+/* III. Operations */
+/* ********************************************************************** */
+
+/* ============================================================ */
+/* III.1 Meet and Join */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_meet(ap_manager_t* man, bool destructive, pkgrid_t* a1, pkgrid_t* a2);
+pkgrid_t* pkgrid_join(ap_manager_t* man, bool destructive, pkgrid_t* a1, pkgrid_t* a2);
+  /* Meet and Join of 2 abstract values */
+
+pkgrid_t* pkgrid_meet_array(ap_manager_t* man, pkgrid_t** tab, size_t size);
+pkgrid_t* pkgrid_join_array(ap_manager_t* man, pkgrid_t** tab, size_t size);
+  /* Meet and Join of an array of abstract values.
+     Raises an [[exc_invalid_argument]] exception if [[size==0]]
+     (no way to define the dimensionality of the result in such a case */
+
+pkgrid_t* pkgrid_meet_lincons_array(ap_manager_t* man,
+				    bool destructive, pkgrid_t* a,
+				    ap_lincons0_array_t* array);
+  /* Meet of an abstract value with a set of constraints
+     (generalize pkgrid_of_lincons_array) */
+
+pkgrid_t* pkgrid_meet_tcons_array(ap_manager_t* man,
+				  bool destructive, pkgrid_t* a,
+				  ap_tcons0_array_t* array);
+  /* Meet of an abstract value with a set of tree expressions constraints,
+     linearized first */
+
+pkgrid_t* pkgrid_add_ray_array(ap_manager_t* man,
+			       bool destructive, pkgrid_t* a,
+			       ap_generator0_array_t* array);
+  /* Generalized time elapse operator. Rays are approximated by lines. */
+
+/* ============================================================ */
+/* III.2 Assignement and Substitutions */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_assign_linexpr_array(ap_manager_t* man,
+				      bool destructive, pkgrid_t* a,
+				      ap_dim_t* tdim,
+				      ap_linexpr0_t** texpr,
+				      size_t size,
+				      pkgrid_t* dest);
+pkgrid_t* pkgrid_substitute_linexpr_array(ap_manager_t* man,
+					  bool destructive, pkgrid_t* a,
+					  ap_dim_t* tdim,
+					  ap_linexpr0_t** texpr,
+					  size_t size,
+					  pkgrid_t* dest);
+  /* Parallel Assignement and Substitution of several dimensions by
+     linear expressons. Expressions with interval coefficients are
+     approximated by forgetting the assigned dimensions. */
+
+pkgrid_t* pkgrid_assign_texpr_array(ap_manager_t* man,
+				    bool destructive, pkgrid_t* a,
+				    ap_dim_t* tdim,
+				    ap_texpr0_t** texpr,
+				    size_t size,
+				    pkgrid_t* dest);
+pkgrid_t* pkgrid_substitute_texpr_array(ap_manager_t* man,
+					bool destructive, pkgrid_t* a,
+					ap_dim_t* tdim,
+					ap_texpr0_t** texpr,
+					size_t size,
+					pkgrid_t* dest);
+  /* Parallel Assignement and Substitution of several dimensions by
+     tree expressions. */
+
+/* ============================================================ */
+/* III.3 Projections */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_forget_array(ap_manager_t* man,
+			      bool destructive, pkgrid_t* a,
+			      ap_dim_t* tdim, size_t size,
+			      bool project);
+
+/* ============================================================ */
+/* III.4 Change and permutation of dimensions */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_add_dimensions(ap_manager_t* man,
+				bool destructive, pkgrid_t* a,
+				ap_dimchange_t* dimchange,
+				bool project);
+
+pkgrid_t* pkgrid_remove_dimensions(ap_manager_t* man,
+				   bool destructive, pkgrid_t* a,
+				   ap_dimchange_t* dimchange);
+pkgrid_t* pkgrid_permute_dimensions(ap_manager_t* man,
+				    bool destructive,
+				    pkgrid_t* a,
+				    ap_dimperm_t* permutation);
+
+/* ============================================================ */
+/* III.5 Expansion and folding of dimensions */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_expand(ap_manager_t* man,
+			bool destructive, pkgrid_t* a,
+			ap_dim_t dim,
+			size_t n);
+  /* Expand the dimension dim into itself + n additional dimensions.
+     It results in (n+1) unrelated dimensions having same
+     relations with other dimensions. The (n+1) dimensions are put as follows:
+
+     - original dimension dim
+
+     - if the dimension is integer, the n additional dimensions are put at the
+       end of integer dimensions; if it is real, at the end of the real
+       dimensions.
+  */
+
+pkgrid_t* pkgrid_fold(ap_manager_t* man,
+		      bool destructive, pkgrid_t* a,
+		      ap_dim_t* tdim,
+		      size_t size);
+  /* Fold the dimensions in the array tdim of size n>=1 and put the result
+     in the first dimension in the array. The other dimensions of the array
+     are then removed. */
+
+/* ============================================================ */
+/* III.6 Widening */
+/* ============================================================ */
+
+pkgrid_t* pkgrid_widening(ap_manager_t* man,
+			  pkgrid_t* a1, pkgrid_t* a2);
+  /* Keeps the congruences of a1 satisfied by a2. As a basis of the
+     congruences of a1 is kept, the rank of the result decreases until
+     stabilization. */
+
+/* ============================================================ */
+/* III.7 Closure operation */
+/* ============================================================ */
+
+/* Returns the topological closure of a possibly opened abstract value */
+
+pkgrid_t* pkgrid_closure(ap_manager_t* man, bool destructive, pkgrid_t* a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
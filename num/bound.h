@@ -152,11 +152,23 @@ static inline bool ap_scalar_set_bound(ap_scalar_t* a, bound_t b);
 static inline size_t bound_serialize(void* dst, bound_t src);
 static inline size_t bound_deserialize(bound_t dst, const void* src);
 static inline size_t bound_serialized_size(bound_t a);
+static inline size_t bound_deserialized_size(const void* src, size_t size);
+  /* Number of bytes of the bound serialized at src, or 0 if it does not fit
+     in the size bytes available */
 
 static inline size_t bound_serialize_array(void* dst, bound_t* src, size_t size);
 static inline size_t bound_deserialize_array(bound_t* dst, const void* src, size_t size);
 static inline size_t bound_serialized_size_array(bound_t* src, size_t size);
 
+/* ====================================================================== */
+/* Memory */
+/* ====================================================================== */
+
+static inline size_t bound_heap_size(bound_t a);
+static inline size_t bound_heap_size_array(bound_t* a, size_t size);
+  /* Number of bytes allocated outside of the bound(s) (multiprecision
+     limbs), not counting the bound_t themselves */
+
 #ifdef __cplusplus
 }
 #endif
@@ -599,6 +599,12 @@ static inline bool ap_scalar_set_bound(ap_scalar_t* a, bound_t b)
 /* Serialization */
 /* ====================================================================== */
 
+/* Defined when bound_serialize writes the memory representation of bound_t,
+   so that serialized arrays can be used in place (see ap_checkpoint.h) */
+#if defined(BOUND_NUM) && defined(NUM_NATIVE) && !defined(WORDS_BIGENDIAN)
+#define BOUND_SERIALIZE_NATIVE
+#endif
+
 static inline size_t bound_serialize(void* dst, bound_t src)
 {
 #if defined(BOUND_NUM)
@@ -628,6 +634,18 @@ static inline size_t bound_serialized_size(bound_t a)
 #endif
 }
 
+static inline size_t bound_deserialized_size(const void* src, size_t size)
+{
+#if defined(BOUND_NUM)
+  return num_deserialized_size(src,size);
+#else
+  size_t n;
+  if (size<1) return 0;
+  n = num_deserialized_size((const char*)src+1,size-1);
+  return n ? n+1 : 0;
+#endif
+}
+
 static inline size_t bound_serialize_array(void* dst, bound_t* src, size_t size)
 {
   size_t i,n=0;
@@ -652,6 +670,17 @@ static inline size_t bound_serialized_size_array(bound_t* src, size_t size)
   return n;
 }
 
+static inline size_t bound_heap_size(bound_t a)
+{ return num_heap_size(bound_numref(a)); }
+
+static inline size_t bound_heap_size_array(bound_t* a, size_t size)
+{
+  size_t i,n=0;
+  for (i=0;i<size;i++)
+    n += bound_heap_size(a[i]);
+  return n;
+}
+
 static inline bool bound_integer(bound_t a)
 { return !bound_infty(a) && num_integer(bound_numref(a)); }
 
@@ -223,6 +223,14 @@ static inline unsigned char num_serialize_id(void);
 static inline size_t num_serialize(void* dst, num_t src);
 static inline size_t num_deserialize(num_t dst, const void* src);
 static inline size_t num_serialized_size(num_t a);
+static inline size_t num_deserialized_size(const void* src, size_t size);
+  /* Number of bytes of the number serialized at src, or 0 if it does not
+     fit in the size bytes available (to be called on untrusted data before
+     num_deserialize) */
+
+static inline size_t num_heap_size(num_t a);
+  /* Number of bytes allocated outside of a (multiprecision limbs),
+     0 for native numbers */
 
 static inline size_t num_serialize_array(void* dst, num_t* src, size_t size)
 {
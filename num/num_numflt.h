@@ -245,6 +245,11 @@ static inline size_t num_deserialize(num_t dst, const void* src)
 
 static inline size_t num_serialized_size(num_t a)
 { (void)a; return numflt_serialized_size(a); }
+static inline size_t num_deserialized_size(const void* src, size_t size)
+{ return numflt_deserialized_size(src,size); }
+
+static inline size_t num_heap_size(num_t a)
+{ return numflt_heap_size(a); }
 
 #ifdef __cplusplus
 }
@@ -242,6 +242,11 @@ static inline size_t num_deserialize(num_t dst, const void* src)
 
 static inline size_t num_serialized_size(num_t a)
 { return numint_serialized_size(a); }
+static inline size_t num_deserialized_size(const void* src, size_t size)
+{ return numint_deserialized_size(src,size); }
+
+static inline size_t num_heap_size(num_t a)
+{ return numint_heap_size(a); }
 
 #ifdef __cplusplus
 }
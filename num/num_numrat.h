@@ -238,6 +238,11 @@ static inline size_t num_deserialize(num_t dst, const void* src)
 
 static inline size_t num_serialized_size(num_t a)
 { return numrat_serialized_size(a); }
+static inline size_t num_deserialized_size(const void* src, size_t size)
+{ return numrat_deserialized_size(src,size); }
+
+static inline size_t num_heap_size(num_t a)
+{ return numrat_heap_size(a); }
 
 #ifdef __cplusplus
 }
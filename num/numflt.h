@@ -165,6 +165,12 @@ static inline unsigned char numflt_serialize_id(void)
 static inline size_t numflt_serialize(void* dst, numflt_t src);
 static inline size_t numflt_deserialize(numflt_t dst, const void* src);
 static inline size_t numflt_serialized_size(numflt_t a);
+static inline size_t numflt_deserialized_size(const void* src, size_t size);
+  /* Number of bytes of the number serialized at src, or 0 if it does not
+     fit in the size bytes available */
+
+static inline size_t numflt_heap_size(numflt_t a);
+  /* Number of bytes allocated outside of a (multiprecision limbs) */
 
 
 /* */
@@ -342,6 +342,25 @@ static inline size_t numflt_deserialize(numflt_t dst, const void* src)
 static inline size_t numflt_serialized_size(numflt_t a)
 { return mpfr_get_prec(a)/8+9+sizeof(mp_limb_t); }
 
+static inline size_t numflt_deserialized_size(const void* src, size_t size)
+{
+  size_t count;
+  if (size<1) return 0;
+  switch (*((const char*)src)) {
+  case 0: case 1: case 2:
+    return 1;
+  case 3: case 4:
+    if (size<9) return 0;
+    count = num_undump_word32((const char*)src+1);
+    return count<=size-9 ? count+9 : 0;
+  default:
+    return 0;
+  }
+}
+
+static inline size_t numflt_heap_size(numflt_t a)
+{ return (mpfr_get_prec(a)+GMP_NUMB_BITS-1)/GMP_NUMB_BITS*sizeof(mp_limb_t); }
+
 
 /* */
 static inline bool ap_scalar_set_numflt(ap_scalar_t* a, numflt_t b)
@@ -446,6 +446,12 @@ static inline size_t numflt_deserialize(numflt_t dst, const void* src)
 static inline size_t numflt_serialized_size(numflt_t a)
 { (void)a; return sizeof(numflt_t); }
 
+static inline size_t numflt_deserialized_size(const void* src, size_t size)
+{ (void)src; return size>=sizeof(numflt_t) ? sizeof(numflt_t) : 0; }
+
+static inline size_t numflt_heap_size(numflt_t a)
+{ (void)a; return 0; }
+
 
 /* */
 static inline bool ap_scalar_set_numflt(ap_scalar_t* a, numflt_t b)
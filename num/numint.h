@@ -164,6 +164,12 @@ static inline unsigned char numint_serialize_id(void);
 static inline size_t numint_serialize(void* dst, numint_t src);
 static inline size_t numint_deserialize(numint_t dst, const void* src);
 static inline size_t numint_serialized_size(numint_t a);
+static inline size_t numint_deserialized_size(const void* src, size_t size);
+  /* Number of bytes of the number serialized at src, or 0 if it does not
+     fit in the size bytes available */
+
+static inline size_t numint_heap_size(numint_t a);
+  /* Number of bytes allocated outside of a (multiprecision limbs) */
 
 
 /* */
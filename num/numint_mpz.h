@@ -347,6 +347,17 @@ static inline size_t numint_deserialize(numint_t dst, const void* src)
 static inline size_t numint_serialized_size(numint_t a)
 { return mpz_sizeinbase(a,2)/8+5+sizeof(mp_limb_t); }
 
+static inline size_t numint_deserialized_size(const void* src, size_t size)
+{
+  size_t count;
+  if (size<5) return 0;
+  count = num_undump_word32((const char*)src+1);
+  return count<=size-5 ? count+5 : 0;
+}
+
+static inline size_t numint_heap_size(numint_t a)
+{ return (size_t)a->_mp_alloc*sizeof(mp_limb_t); }
+
 #ifdef __cplusplus
 }
 #endif
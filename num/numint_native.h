@@ -492,6 +492,12 @@ static inline size_t numint_deserialize(numint_t dst, const void* src)
 static inline size_t numint_serialized_size(numint_t a)
 { (void)a; return sizeof(numint_t); }
 
+static inline size_t numint_deserialized_size(const void* src, size_t size)
+{ (void)src; return size>=sizeof(numint_t) ? sizeof(numint_t) : 0; }
+
+static inline size_t numint_heap_size(numint_t a)
+{ (void)a; return 0; }
+
 #ifdef __cplusplus
 }
 #endif
@@ -163,6 +163,12 @@ static inline unsigned char numrat_serialize_id(void);
 static inline size_t numrat_serialize(void* dst, numrat_t src);
 static inline size_t numrat_deserialize(numrat_t dst, const void* src);
 static inline size_t numrat_serialized_size(numrat_t a);
+static inline size_t numrat_deserialized_size(const void* src, size_t size);
+  /* Number of bytes of the number serialized at src, or 0 if it does not
+     fit in the size bytes available */
+
+static inline size_t numrat_heap_size(numrat_t a);
+  /* Number of bytes allocated outside of a (multiprecision limbs) */
 
 
 /* */
@@ -405,6 +405,23 @@ static inline size_t numrat_serialized_size(numrat_t a)
     9+2*sizeof(mp_limb_t);
 }
 
+static inline size_t numrat_deserialized_size(const void* src, size_t size)
+{
+  size_t count1, count2;
+  if (size<9) return 0;
+  count1 = num_undump_word32((const char*)src+1);
+  count2 = num_undump_word32((const char*)src+5);
+  if (count1>size-9 || count2>size-9-count1) return 0;
+  return count1+count2+9;
+}
+
+static inline size_t numrat_heap_size(numrat_t a)
+{
+  return
+    ((size_t)mpq_numref(a)->_mp_alloc+(size_t)mpq_denref(a)->_mp_alloc)*
+    sizeof(mp_limb_t);
+}
+
 #ifdef __cplusplus
 }
 #endif
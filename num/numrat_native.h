@@ -528,6 +528,16 @@ static inline size_t numrat_serialized_size(numrat_t a)
          numint_serialized_size(numrat_denref(a));
 }
 
+static inline size_t numrat_deserialized_size(const void* src, size_t size)
+{
+  size_t x = numint_deserialized_size(src,size);
+  size_t y = x ? numint_deserialized_size((const char*)src+x,size-x) : 0;
+  return y ? x+y : 0;
+}
+
+static inline size_t numrat_heap_size(numrat_t a)
+{ (void)a; return 0; }
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,7 +2,12 @@
 #include "oct_internal.h"
 #include "seqalgorithms.h"
 
-bool incrclosure_seq(dbm* m, size_t dim, size_t a, size_t b, bound_t d) {
+/* number of matrix elements updated between two checks of the deadline */
+#define INCR_CHUNK 4096
+
+/* If the deadline of pr expires, the remaining rows are not updated: the
+   matrix is then correct but not closed, and pr->timeout is set. */
+bool incrclosure_seq(oct_internal_t* pr, dbm* m, size_t dim, size_t a, size_t b, bound_t d) {
   size_t i,j;
   size_t bara = a^1;
   size_t barb = b^1;
@@ -38,9 +43,18 @@ bool incrclosure_seq(dbm* m, size_t dim, size_t a, size_t b, bound_t d) {
   bound_add(temp1, twod, *getdbm(m,matpos2(bara,a)));
   bound_add(temp2, twod, *getdbm(m,matpos2(b,barb)));
 
-  size_t sz_mat = matsize(dim);
   if(STRONGINCR==1) strong_helper(m,dim,a,b,d,temp1,temp2);
-  single_seq_helper(m, m, 0, sz_mat, a, b, d, temp1, temp2);
+  /* by chunks of whole rows */
+  for (i=0; i<2*dim; i=j) {
+    size_t start = matpos(i,0);
+    for (j=i+1; j<2*dim && matpos(j,0)-start<INCR_CHUNK; j++);
+    if (oct_timeout(pr,matpos(j,0)-start)) {
+      /* keep at least the new constraint */
+      setdbmbmin(m,matpos2(a,b),d);
+      break;
+    }
+    single_seq_helper(m, m, start, matpos(j,0), a, b, d, temp1, temp2);
+  }
   bound_clear(temp1);
   bound_clear(temp2);
   bound_clear(twod);
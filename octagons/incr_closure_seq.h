@@ -1,4 +1,4 @@
-bool incrclosure_seq(dbm* m, size_t dim, size_t a, size_t b, bound_t d);
+bool incrclosure_seq(oct_internal_t* pr, dbm* m, size_t dim, size_t a, size_t b, bound_t d);
 
 /* bool unary_inequality_incrclosure(bound_t* m, size_t dim, size_t a, bound_t d); */
 
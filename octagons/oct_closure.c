@@ -62,11 +62,13 @@ bool hmat_s_step(dbm* m, size_t dim)
 
    Returns true if the resulting matrix is empty, false otherwise
    (does not free the matrix)
+   If the deadline of pr expires, stops early with pr->timeout set: the
+   matrix is then correct, but not closed.
 
    Cubic time. Constant space.
  */
 
-bool hmat_close(dbm* m, size_t dim)
+bool hmat_close(oct_internal_t* pr, dbm* m, size_t dim)
 {
   size_t i,j,k;
   bound_t *c,ik,ik2,ij;
@@ -76,6 +78,7 @@ bool hmat_close(dbm* m, size_t dim)
   /* Floyd-Warshall */
   for (k=0;k<2*dim;k++) {
     size_t k2 = k^1;
+    if (oct_timeout(pr,matsize(dim))) break;
     for (i=0;i<2*dim;i++) {
       size_t i2 = i|1;
       size_t br = k<i2 ? k : i2;
@@ -114,17 +117,17 @@ bool hmat_close(dbm* m, size_t dim)
 */
 
 bool hmat_close_binary_incremental_equality(oct_internal_t* pr, dbm* m, size_t dim, size_t b, size_t bara, bound_t d, bound_t dprime) {
-  if (incrclosure_seq(m, dim, b, bara, d)) {
+  if (incrclosure_seq(pr, m, dim, b, bara, d)) {
     return true;
   }
   else {
-    bool res = incrclosure_seq(m,dim,b^1, bara^1, dprime);
+    bool res = incrclosure_seq(pr,m,dim,b^1, bara^1, dprime);
     return res;
   }
 }
 
 bool hmat_close_binary_incremental_inequality(oct_internal_t* pr, dbm* m, size_t dim, size_t b, size_t bara, bound_t d) {
-  return incrclosure_seq(m, dim, b, bara, d);
+  return incrclosure_seq(pr, m, dim, b, bara, d);
 }
 
 /* Mine original incremental closure */
@@ -62,6 +62,10 @@ void oct_free(ap_manager_t* man, oct_t* a);
 size_t oct_size(ap_manager_t* man, oct_t* a);
   /* Return the abstract size of an abstract value (see ap_manager_t) */
 
+size_t oct_memory_size(ap_manager_t* man, oct_t* a);
+  /* Return the number of bytes of heap memory used by the abstract value,
+     including the cached closed half-matrix */
+
 
 struct _oct_internal_t;
 typedef struct _oct_internal_t oct_internal_t;
@@ -125,12 +129,24 @@ ap_membuf_t oct_serialize_raw(ap_manager_t* man, oct_t* a);
 /* Allocate a memory buffer (with malloc), output the abstract value in raw
    binary format to it and return a pointer on the memory buffer and the size
    of bytes written.  It is the user responsability to free the memory
-   afterwards (with free). */
+   afterwards (with free).
+
+   Only one matrix is saved, the closed one if available.  By default, the
+   matrix is saved as a dictionary of its distinct bounds and codes of
+   elements, with runs of +oo collapsed.  With algorithm>0, it is saved as a
+   flat array of bounds, which oct_deserialize_mapped can use in place. */
 
 oct_t* oct_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size);
 /* Return the abstract value read in raw binary format from the input stream
    and store in size the number of bytes read */
 
+struct ap_checkpoint_t;
+oct_t* oct_deserialize_mapped(ap_manager_t* man, void* ptr, size_t* size,
+			      struct ap_checkpoint_t* ck);
+/* Same as oct_deserialize_raw, for a buffer in a mapped checkpoint file.
+   Without DBMCACHE and with a native numeric type, the matrix of the result
+   points into the buffer if it was saved flat (see oct_serialize_raw) */
+
 
 /* ********************************************************************** */
 /* II. Constructor, accessors, tests and property extraction */
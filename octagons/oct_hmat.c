@@ -16,6 +16,7 @@
    Please read the COPYING file packaged in the distribution.
 */
 
+#include <pthread.h>
 #include "oct.h"
 #include "oct_internal.h"
 
@@ -68,6 +69,12 @@ bound_t values[CACHESIZE];
 
 signed short dbmnext = 0;
 
+/* The cache is shared by all managers: it is initialized once, and
+   insertions are serialized, so that managers can be used by concurrent
+   threads. Cached values are never modified once inserted. */
+static pthread_once_t dbm_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t dbm_lock = PTHREAD_MUTEX_INITIALIZER;
+
 void setinfty(dbm* d, size_t index);
 void setzero(dbm* d, size_t index);
 
@@ -99,7 +106,7 @@ bool check_values_invariant(void) {
   return true;
 }
 
-void initcache(void) {
+static void initcache_once(void) {
   assert(dbmnext == 0);
   bound_t zero, one, infty;
   bound_init(zero);
@@ -121,6 +128,10 @@ void initcache(void) {
   dbmnext = 3;
 }
 
+void initcache(void) {
+  pthread_once(&dbm_once, initcache_once);
+}
+
 
 #if defined(DBMCACHE)
 inline dbm* hmat_alloc(oct_internal_t* pr, size_t dim)
@@ -170,13 +181,18 @@ inline dbm* hmat_alloc(oct_internal_t* pr, size_t dim)
   checked_malloc(r,bound_t,sz,return NULL;);
   bound_init_array(r,matsize(dim));
   d->m = r;
+  d->map = NULL;
   return d;
 }
 
 inline void hmat_free(oct_internal_t* pr, dbm* d, size_t dim)
 {
-  bound_clear_array(d->m,matsize(dim));
-  free(d->m);
+  if (d->map)
+    ap_checkpoint_free(d->map);
+  else {
+    bound_clear_array(d->m,matsize(dim));
+    free(d->m);
+  }
   free(d);
 }
 
@@ -201,6 +217,20 @@ inline dbm* hmat_alloc_top(oct_internal_t* pr, size_t dim)
 
 #endif
 
+/* heap bytes of the half-matrix, including the limbs of its bounds
+   (shared cached values are not counted) */
+size_t hmat_memory_size(oct_internal_t* pr, dbm* d, size_t dim)
+{
+  size_t sz = matsize(dim);
+  if (!sz) sz = 1;
+#if defined(DBMCACHE)
+  return sizeof(dbm) + sz*sizeof(unsigned short);
+#else
+  if (d->map) return sizeof(dbm);
+  return sizeof(dbm) + sz*sizeof(bound_t) + bound_heap_size_array(d->m,matsize(dim));
+#endif
+}
+
 void hmat_fdump(FILE* stream, oct_internal_t* pr, dbm* d, size_t dim)
 {
   size_t i,j;
@@ -232,8 +262,11 @@ inline dbm* hmat_copy(oct_internal_t* pr, dbm* m, size_t dim)
 
 signed short dbm_insert(bound_t new)
 {
-  signed short lower = 0;
-  signed short upper = dbmnext - 1;
+  signed short lower, upper, index;
+
+  pthread_mutex_lock(&dbm_lock);
+  lower = 0;
+  upper = dbmnext - 1;
   assert(dbmnext > 0);
   
   while (lower <= upper )
@@ -242,10 +275,15 @@ signed short dbm_insert(bound_t new)
       int cmp = bound_cmp(new, pairs[mid].value); // 1 if new>pairs[mid].value
       if (cmp < 0) upper = mid-1;
       else if (cmp > 0) lower = mid+1;
-      else return pairs[mid].index;
+      else {
+	index = pairs[mid].index;
+	pthread_mutex_unlock(&dbm_lock);
+	return index;
+      }
     }
   
   if (dbmnext >= CACHESIZE) {
+    pthread_mutex_unlock(&dbm_lock);
     return lower + 1;
   } else {
     for (unsigned short i = dbmnext; i > lower; i--)
@@ -258,8 +296,10 @@ signed short dbm_insert(bound_t new)
     
     bound_set(pairs[lower].value, new);
     pairs[lower].index = dbmnext;
+    index = dbmnext;
     dbmnext++;
-    return pairs[lower].index;
+    pthread_mutex_unlock(&dbm_lock);
+    return index;
   }
 }
 
@@ -394,6 +434,121 @@ inline void dbm_bound_set_array2(dbm* dst, bound_t* src, size_t size) {
   }
 }
 
+/* Element-wise operations on whole matrices.
+
+   The half-matrix is scanned linearly.  With DBMCACHE, equal elements are
+   recognized by their index, and the min or max of two cached values is one
+   of them, so that nothing is inserted into the cache.  With native integer
+   and floating-point bounds, where +oo is a number, the loops are plain
+   min/max/compare streams that the compiler vectorizes; inclusion reduces
+   the comparisons of each block of DBM_BLOCK elements before testing them.
+*/
+
+#define DBM_BLOCK 64
+
+#if !defined(DBMCACHE) && defined(BOUND_NUM) && defined(NUM_MAX)
+#define DBM_SCALAR
+#if defined(NUM_NUMINT)
+typedef numint_native dbm_scalar;
+#else
+typedef numflt_native dbm_scalar;
+#endif
+#endif
+
+/* dst = min(a,b), dst may be a or b */
+void dbm_min_array(dbm* dst, dbm* a, dbm* b, size_t size)
+{
+  size_t k;
+#if defined(DBMCACHE)
+  for (k=0;k<size;k++) {
+    unsigned short x = a->m[k], y = b->m[k];
+    dst->m[k] = (x==y || bound_cmp(values[x],values[y])<=0) ? x : y;
+  }
+#elif defined(DBM_SCALAR)
+  dbm_scalar* d = (dbm_scalar*)dst->m;
+  const dbm_scalar* x = (const dbm_scalar*)a->m;
+  const dbm_scalar* y = (const dbm_scalar*)b->m;
+  for (k=0;k<size;k++)
+    d[k] = x[k]<y[k] ? x[k] : y[k];
+#else
+  for (k=0;k<size;k++)
+    bound_min(dst->m[k],a->m[k],b->m[k]);
+#endif
+}
+
+/* dst = max(a,b), dst may be a or b */
+void dbm_max_array(dbm* dst, dbm* a, dbm* b, size_t size)
+{
+  size_t k;
+#if defined(DBMCACHE)
+  for (k=0;k<size;k++) {
+    unsigned short x = a->m[k], y = b->m[k];
+    dst->m[k] = (x==y || bound_cmp(values[x],values[y])>=0) ? x : y;
+  }
+#elif defined(DBM_SCALAR)
+  dbm_scalar* d = (dbm_scalar*)dst->m;
+  const dbm_scalar* x = (const dbm_scalar*)a->m;
+  const dbm_scalar* y = (const dbm_scalar*)b->m;
+  for (k=0;k<size;k++)
+    d[k] = x[k]>y[k] ? x[k] : y[k];
+#else
+  for (k=0;k<size;k++)
+    bound_max(dst->m[k],a->m[k],b->m[k]);
+#endif
+}
+
+/* a <= b element-wise */
+bool dbm_is_leq_array(dbm* a, dbm* b, size_t size)
+{
+  size_t k;
+#if defined(DBMCACHE)
+  for (k=0;k<size;k++) {
+    unsigned short x = a->m[k], y = b->m[k];
+    if (x!=y && bound_cmp(values[x],values[y])>0) return false;
+  }
+#elif defined(DBM_SCALAR)
+  const dbm_scalar* x = (const dbm_scalar*)a->m;
+  const dbm_scalar* y = (const dbm_scalar*)b->m;
+  for (k=0;k<size;k+=DBM_BLOCK) {
+    size_t i, n = size-k<DBM_BLOCK ? size-k : DBM_BLOCK;
+    int gt = 0;
+    for (i=0;i<n;i++)
+      gt |= x[k+i]>y[k+i];
+    if (gt) return false;
+  }
+#else
+  for (k=0;k<size;k++)
+    if (bound_cmp(a->m[k],b->m[k])>0) return false;
+#endif
+  return true;
+}
+
+/* a == b element-wise */
+bool dbm_is_eq_array(dbm* a, dbm* b, size_t size)
+{
+  size_t k;
+#if defined(DBMCACHE)
+  for (k=0;k<size;k++) {
+    unsigned short x = a->m[k], y = b->m[k];
+    if (x!=y && bound_cmp(values[x],values[y])) return false;
+  }
+#elif defined(DBM_SCALAR)
+  const dbm_scalar* x = (const dbm_scalar*)a->m;
+  const dbm_scalar* y = (const dbm_scalar*)b->m;
+  for (k=0;k<size;k+=DBM_BLOCK) {
+    size_t i, n = size-k<DBM_BLOCK ? size-k : DBM_BLOCK;
+    int ne = 0;
+    for (i=0;i<n;i++)
+      ne |= x[k+i]!=y[k+i];
+    if (ne) return false;
+  }
+#else
+  for (k=0;k<size;k++)
+    if (bound_cmp(a->m[k],b->m[k])) return false;
+#endif
+  return true;
+}
+
 inline size_t dbm_serialized_size_array(dbm* src, size_t size) {
   size_t i, n=0;
   for(i=0; i<size; i++) {
@@ -409,9 +564,274 @@ inline size_t dbm_serialize_array(void* dst, dbm* src, size_t size) {
   return n;
 }
 
+inline size_t dbm_deserialized_size_array(const void* src, size_t avail, size_t size) {
+  size_t i,k,n=0;
+  for (i=0;i<size;i++) {
+    k = bound_deserialized_size((const char*)src+n,avail-n);
+    if (!k) return 0;
+    n += k;
+  }
+  return n;
+}
+
+#if defined(DBMCACHE)
+/* getdbm points into the shared table of values, which must not be
+   written: bounds are read into a temporary and inserted */
+inline size_t dbm_deserialize_array(dbm* dst, const void *src, size_t size) {
+  size_t i,n=0;
+  bound_t b;
+  bound_init(b);
+  for (i=0;i<size;i++) {
+    n += bound_deserialize(b,(const char*)src+n);
+    setdbm(dst,i,b);
+  }
+  bound_clear(b);
+  return n;
+}
+#else
 inline size_t dbm_deserialize_array(dbm* dst, const void *src, size_t size) {
   size_t i,n=0;
   for (i=0;i<size;i++)
     n += bound_deserialize(*getdbm(dst,i),(const char*)src+n);
   return n;
 }
+#endif
+
+
+/* ============================================================ */
+/* Compact serialization */
+/* ============================================================ */
+
+/* Format of dbm_serialize_compact:
+     uint32: n, number of distinct bounds other than +oo
+     n serialized bounds, the dictionary
+     codes of the elements in order, of 1, 2 or 4 bytes (the smallest width
+     holding n): c<n stands for the c-th bound of the dictionary, and c=n
+     for a run of +oo, whose length follows as an uint32.
+   Matrices have few distinct bounds, and mostly +oo before closure.
+*/
+
+#define DBM_PINFTY 0xffffffffu
+
+static inline size_t dbm_code_width(size_t n)
+{
+  return n<0x100 ? 1 : n<0x10000 ? 2 : 4;
+}
+
+static inline void dbm_dump_code(char* dst, size_t w, unsigned c)
+{
+  switch (w) {
+  case 1: *(unsigned char*)dst = c; break;
+  case 2: *(unsigned char*)dst = c>>8; *((unsigned char*)dst+1) = c & 0xff; break;
+  default: num_dump_word32(dst,c);
+  }
+}
+
+static inline unsigned dbm_undump_code(const char* src, size_t w)
+{
+  switch (w) {
+  case 1: return *(const unsigned char*)src;
+  case 2: return ((unsigned)*(const unsigned char*)src<<8) + *((const unsigned char*)src+1);
+  default: return num_undump_word32(src);
+  }
+}
+
+static inline bool dbm_is_pinfty(dbm* d, size_t k)
+{
+  return bound_infty(*getdbm(d,k)) && bound_sgn(*getdbm(d,k))>0;
+}
+
+/* hash consistent with equality of elements */
+#if defined(DBMCACHE)
+static inline unsigned dbm_hash(dbm* d, size_t k)
+{
+  return (unsigned)d->m[k]*2654435761u;
+}
+static inline bool dbm_equal(dbm* d, size_t k1, size_t k2)
+{
+  return d->m[k1]==d->m[k2];
+}
+#else
+static inline unsigned dbm_hash(dbm* d, size_t k)
+{
+  double x;
+  unsigned long long u;
+  if (bound_infty(*getdbm(d,k))) return 0;
+  double_set_num(&x,bound_numref(*getdbm(d,k)));
+  x += 0.0; /* -0 and 0 */
+  memcpy(&u,&x,sizeof(u));
+  u ^= u>>29; u *= 0xbf58476d1ce4e5b9ull; u ^= u>>32;
+  return (unsigned)u;
+}
+static inline bool dbm_equal(dbm* d, size_t k1, size_t k2)
+{
+  return bound_cmp(*getdbm(d,k1),*getdbm(d,k2))==0;
+}
+#endif
+
+/* Allocate a buffer of header bytes followed by the compact encoding of the
+   size elements of src. The header is left uninitialized. */
+ap_membuf_t dbm_serialize_compact(oct_internal_t* pr, dbm* src, size_t size,
+				  size_t header)
+{
+  ap_membuf_t buf;
+  unsigned *code, *first, *slot;
+  size_t i, k, n, w, cap, len;
+  char* p;
+
+  buf.ptr = NULL; buf.size = 0;
+  for (cap=16; cap<2*size; cap*=2);
+  checked_malloc(code,unsigned,2*size+cap,return buf;);
+  first = code+size;
+  slot = first+size;
+  for (i=0;i<cap;i++) slot[i] = DBM_PINFTY;
+
+  /* dictionary: first[c] is the first element equal to the c-th bound */
+  n = 0;
+  len = 4;
+  for (k=0;k<size;k++) {
+    if (dbm_is_pinfty(src,k)) {
+      code[k] = DBM_PINFTY;
+      continue;
+    }
+    for (i=dbm_hash(src,k)&(cap-1);
+	 slot[i]!=DBM_PINFTY && !dbm_equal(src,k,first[slot[i]]);
+	 i=(i+1)&(cap-1));
+    if (slot[i]==DBM_PINFTY) {
+      slot[i] = n;
+      first[n++] = k;
+      len += bound_serialized_size(*getdbm(src,k));
+    }
+    code[k] = slot[i];
+  }
+  w = dbm_code_width(n);
+  for (k=0;k<size;k++) {
+    len += w;
+    if (code[k]==DBM_PINFTY) {
+      len += 4;
+      while (k+1<size && code[k+1]==DBM_PINFTY) k++;
+    }
+  }
+
+  /* len overapproximates the size of the encoding */
+  checked_malloc(p,char,header+len,free(code);return buf;);
+  buf.ptr = p;
+  p += header;
+  num_dump_word32(p,n);
+  p += 4;
+  for (i=0;i<n;i++)
+    p += bound_serialize(p,*getdbm(src,first[i]));
+  for (k=0;k<size;k++) {
+    if (code[k]==DBM_PINFTY) {
+      size_t r = k;
+      while (k+1<size && code[k+1]==DBM_PINFTY) k++;
+      dbm_dump_code(p,w,n);
+      num_dump_word32(p+w,k+1-r);
+      p += w+4;
+    }
+    else {
+      dbm_dump_code(p,w,code[k]);
+      p += w;
+    }
+  }
+  buf.size = p-(char*)buf.ptr;
+  assert(buf.size<=header+len);
+  free(code);
+  return buf;
+}
+
+/* Read the compact encoding of size elements into dst.
+   Return the number of bytes read, or 0 if src is malformed or memory is
+   lacking. */
+/* Walks the dictionary, the codes and the runs of +oo without storing
+   them, which must cover exactly size elements within avail bytes */
+size_t dbm_deserialized_size_compact(const void* src, size_t avail, size_t size)
+{
+  const char* p = (const char*)src;
+  size_t i, k, n, w, x, pos;
+
+  if (avail<4) return 0;
+  n = num_undump_word32(p);
+  pos = 4;
+  if (n>size) return 0;
+  w = dbm_code_width(n);
+  for (i=0;i<n;i++) {
+    x = bound_deserialized_size(p+pos,avail-pos);
+    if (!x) return 0;
+    pos += x;
+  }
+  for (k=0;k<size;) {
+    unsigned c;
+    if (w>avail-pos) return 0;
+    c = dbm_undump_code(p+pos,w);
+    pos += w;
+    if (c<n) k++;
+    else if (c==n) {
+      size_t r;
+      if (4>avail-pos) return 0;
+      r = num_undump_word32(p+pos);
+      pos += 4;
+      if (r==0 || r>size-k) return 0;
+      k += r;
+    }
+    else return 0;
+  }
+  return pos;
+}
+
+size_t dbm_deserialize_compact(oct_internal_t* pr, dbm* dst, const void* src,
+			       size_t size)
+{
+  const char* p = (const char*)src;
+  size_t i, k, n, w;
+#if defined(DBMCACHE)
+  unsigned short* dict;
+  bound_t b;
+#else
+  bound_t* dict;
+#endif
+
+  n = num_undump_word32(p);
+  p += 4;
+  if (n>size) return 0;
+  w = dbm_code_width(n);
+  /* dictionary, as cache indices with DBMCACHE */
+#if defined(DBMCACHE)
+  checked_malloc(dict,unsigned short,n+1,return 0;);
+  bound_init(b);
+  for (i=0;i<n;i++) {
+    p += bound_deserialize(b,p);
+    dict[i] = dbm_insert(b);
+  }
+  bound_clear(b);
+#else
+  checked_malloc(dict,bound_t,n+1,return 0;);
+  bound_init_array(dict,n);
+  for (i=0;i<n;i++)
+    p += bound_deserialize(dict[i],p);
+#endif
+
+  for (k=0;k<size;) {
+    unsigned c = dbm_undump_code(p,w);
+    p += w;
+    if (c<n) {
+#if defined(DBMCACHE)
+      dst->m[k++] = dict[c];
+#else
+      bound_set(dst->m[k++],dict[c]);
+#endif
+    }
+    else if (c==n) {
+      size_t r = num_undump_word32(p);
+      p += 4;
+      if (r==0 || r>size-k) break;
+      for (;r>0;r--) setdbminfty(dst,k++);
+    }
+    else break;
+  }
+#if !defined(DBMCACHE)
+  bound_clear_array(dict,n);
+#endif
+  free(dict);
+  return k==size ? (size_t)(p-(const char*)src) : 0;
+}
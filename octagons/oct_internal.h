@@ -21,6 +21,7 @@
 #define __OCT_INTERNAL_H
 
 #include "oct_fun.h"
+#include "ap_checkpoint.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,6 +34,8 @@ typedef struct _dbm {
 #else
 typedef struct _dbm {
   bound_t* m;
+  ap_checkpoint_t* map; /* if not NULL, m lies in this mapped file,
+			   see oct_deserialize_mapped */
 } dbm;
 #endif
 
@@ -55,6 +58,9 @@ struct _oct_internal_t {
   /* local parameters for current function */
   ap_funopt_t* funopt;
 
+  /* deadline of the current function, from funopt->timeout */
+  ap_deadline_t deadline;
+
   /* growing temporary buffer */
   bound_t* tmp;
   void* tmp2;
@@ -65,6 +71,11 @@ struct _oct_internal_t {
   */
   bool conv;
 
+  /* raised when a closure algorithm was interrupted by the deadline,
+     leaving a correct but non-closed matrix
+  */
+  bool timeout;
+
   // Data for threads
   //void *args[64];
 
@@ -83,6 +94,8 @@ oct_init_from_manager(ap_manager_t* man, ap_funid_t id, size_t size)
   pr->funopt = man->option.funopt+id;
   man->result.flag_exact = man->result.flag_best = true;
   pr->conv = false;
+  pr->timeout = false;
+  ap_deadline_init(&pr->deadline,pr->funopt);
   if (pr->tmp_size<size) {
     bound_clear_array(pr->tmp,pr->tmp_size);
     pr->tmp = (bound_t*)realloc(pr->tmp,sizeof(bound_t)*size);
@@ -130,6 +143,20 @@ oct_init_from_manager(ap_manager_t* man, ap_funid_t id, size_t size)
       action }								\
   } while(0)
 
+  /* cooperative check of the deadline in closure algorithms, work being
+     the number of matrix elements updated since the last check;
+     raises the timeout exception the first time it returns true */
+static inline bool oct_timeout(oct_internal_t* pr, size_t work)
+{
+  if (!ap_deadline_expired(&pr->deadline,work)) return false;
+  if (!pr->timeout) {
+    pr->timeout = true;
+    ap_manager_raise_exception(pr->man,AP_EXC_TIMEOUT,pr->funid,
+			       "closure interrupted");
+  }
+  return true;
+}
+
   /* malloc with safe-guard */
 #define checked_malloc(ptr,t,nb,action)					\
   do {									\
@@ -161,6 +188,7 @@ oct_init_from_manager(ap_manager_t* man, ap_funid_t id, size_t size)
   dbm* hmat_alloc_zero  (oct_internal_t* pr, size_t dim);
   dbm* hmat_alloc_top   (oct_internal_t* pr, size_t dim);
   dbm* hmat_copy        (oct_internal_t* pr, dbm* m, size_t dim);
+  size_t hmat_memory_size(oct_internal_t* pr, dbm* m, size_t dim);
   void hmat_fdump       (FILE* stream, oct_internal_t* pr,
 			 dbm* m, size_t dim);
 
@@ -182,9 +210,21 @@ oct_init_from_manager(ap_manager_t* man, ap_funid_t id, size_t size)
   void dbm_set_array_from_point (dbm* dst, dbm* src, size_t point, size_t point2, size_t size);
   void dbm_bound_set_array(bound_t* dst, dbm* src, size_t size);
   void dbm_bound_set_array2(dbm* dst, bound_t* src, size_t size);
+  void dbm_min_array(dbm* dst, dbm* a, dbm* b, size_t size);
+  void dbm_max_array(dbm* dst, dbm* a, dbm* b, size_t size);
+  bool dbm_is_leq_array(dbm* a, dbm* b, size_t size);
+  bool dbm_is_eq_array(dbm* a, dbm* b, size_t size);
   size_t dbm_serialized_size_array(dbm* src, size_t size);
   size_t dbm_serialize_array(void* dst, dbm* src, size_t size);
   size_t dbm_deserialize_array(dbm* dst, const void *src, size_t size);
+  size_t dbm_deserialized_size_array(const void* src, size_t avail, size_t size);
+  /* bytes of the serialized matrix of size elements at src, or 0 if it does
+     not fit in avail bytes; to be checked before deserializing */
+  ap_membuf_t dbm_serialize_compact(oct_internal_t* pr, dbm* src, size_t size,
+				    size_t header);
+  size_t dbm_deserialize_compact(oct_internal_t* pr, dbm* dst, const void* src,
+				 size_t size);
+  size_t dbm_deserialized_size_compact(const void* src, size_t avail, size_t size);
 
 
 //* ============================================================ */
@@ -232,7 +272,7 @@ static inline size_t matpos2(size_t i, size_t j)
 /* see oct_closure.c */
 
 bool hmat_s_step(dbm* m, size_t dim);
-bool hmat_close(dbm* m, size_t dim);
+bool hmat_close(oct_internal_t* pr, dbm* m, size_t dim);
 bool hmat_close_incremental(dbm* m, size_t dim, size_t v);
 bool hmat_check_closed(dbm* m, size_t dim);
 /* bool hmat_close_unary_incremental_nonequality(dbm* m, size_t dim, size_t a, bound_t d); */
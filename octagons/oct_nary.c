@@ -34,10 +34,8 @@ oct_t* oct_meet(ap_manager_t* man, bool destructive, oct_t* a1, oct_t* a2)
   else {
     dbm* m1 = a1->closed ? a1->closed : a1->m;
     dbm* m2 = a2->closed ? a2->closed : a2->m;
-    size_t i;
     m = destructive ? m1 : hmat_alloc(pr,a1->dim);
-    for (i=0;i<matsize(a1->dim);i++)
-      setdbmmin(m,i,*getdbm(m1,i),*getdbm(m2,i));
+    dbm_min_array(m,m1,m2,matsize(a1->dim));
     /* optimal, but not closed */
     return oct_set_mat(pr,a1,m,NULL,destructive);
   }
@@ -68,10 +66,8 @@ oct_t* oct_join(ap_manager_t* man, bool destructive, oct_t* a1, oct_t* a2)
    dbm* m1 = a1->closed ? a1->closed : a1->m;
    dbm* m2 = a2->closed ? a2->closed : a2->m;
    dbm* m = destructive ? m1 : hmat_alloc(pr,a1->dim);
-   size_t i;
    man->result.flag_exact = false;
-   for (i=0;i<matsize(a1->dim);i++)
-     setdbmmax(m,i,*getdbm(m1,i),*getdbm(m2,i));
+   dbm_max_array(m,m1,m2,matsize(a1->dim));
 
    if (a1->closed && a2->closed) {
      /* result is closed and optimal on Q */
@@ -90,7 +86,7 @@ oct_t* oct_meet_array(ap_manager_t* man, oct_t** tab, size_t size)
 {
   oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_MEET_ARRAY,0);
   oct_t* r;
-  size_t i,k;
+  size_t k;
   arg_assert(size>0,return NULL;);
   r = oct_alloc_internal(pr,tab[0]->dim,tab[0]->intdim);
   /* check whether there is an empty element */
@@ -102,8 +98,7 @@ oct_t* oct_meet_array(ap_manager_t* man, oct_t** tab, size_t size)
     dbm* x = tab[k]->closed ? tab[k]->closed : tab[k]->m;
     arg_assert(tab[k]->dim==r->dim && tab[k]->intdim==r->intdim,
 	       oct_free_internal(pr,r);return NULL;);
-    for (i=0;i<matsize(r->dim);i++)
-      setdbmbmin(r->m,i,*getdbm(x,i));
+    dbm_min_array(r->m,r->m,x,matsize(r->dim));
   }
   return r;
 }
@@ -115,7 +110,7 @@ oct_t* oct_join_array(ap_manager_t* man, oct_t** tab, size_t size)
   bool closed = true;
   oct_t* r;
   dbm* m = NULL;
-  size_t i,k;
+  size_t k;
   arg_assert(size>0,return NULL;);
   r = oct_alloc_internal(pr,tab[0]->dim,tab[0]->intdim);
   for (k=0;k<size;k++) {
@@ -130,8 +125,7 @@ oct_t* oct_join_array(ap_manager_t* man, oct_t** tab, size_t size)
     else {
       /* not first non-empty */
       dbm* x = tab[k]->closed ? tab[k]->closed : tab[k]->m;
-      for (i=0;i<matsize(r->dim);i++)
-	setdbmbmax(m,i,*getdbm(x,i));
+      dbm_max_array(m,m,x,matsize(r->dim));
     }
     if (!tab[k]->closed) closed = false;
   }
@@ -0,0 +1,410 @@
+/*
+ * oct_policy.c
+ *
+ * Policies (min-strategies) for the meets of octagons.
+ *
+ * APRON Library / Octagonal Domain
+ *
+ */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <string.h>
+
+#include "oct.h"
+#include "oct_internal.h"
+#include "oct_policy.h"
+
+/* ============================================================ */
+/* Policy manager */
+/* ============================================================ */
+
+ap_policy_manager_t* oct_policy_manager_alloc(ap_manager_t* man)
+{
+  ap_policy_manager_t* pman;
+  void** funptr;
+
+  if (strcmp(man->library,"oct")!=0){
+    char str[160];
+    snprintf(str,159,"\
+oct_policy_manager_alloc: the standard manager given in argument is not an oct manager, but a %s manager",
+	     man->library);
+    ap_manager_raise_exception(man,
+			       AP_EXC_INVALID_ARGUMENT,
+			       AP_FUNID_UNKNOWN,
+			       str);
+    return NULL;
+  }
+  pman = ap_policy_manager_alloc(man,NULL,NULL);
+  funptr = pman->funptr;
+  funptr[AP_FUNPOLICYID_UNKNOWN] = NULL;
+  funptr[AP_FUNPOLICYID_COPY] = oct_policy_copy;
+  funptr[AP_FUNPOLICYID_FREE] = oct_policy_free;
+  funptr[AP_FUNPOLICYID_FPRINT] = oct_policy_fprint;
+  funptr[AP_FUNPOLICYID_SPRINT] = oct_policy_sprint;
+  funptr[AP_FUNPOLICYID_DIMENSION] = oct_policy_dimension;
+  funptr[AP_FUNPOLICYID_EQUAL] = oct_policy_equal;
+  funptr[AP_FUNPOLICYID_HASH] = oct_policy_hash;
+  funptr[AP_FUNPOLICYID_MEET_APPLY] = oct_policy_meet_apply;
+  funptr[AP_FUNPOLICYID_MEET_ARRAY_APPLY] = oct_policy_meet_array_apply;
+  funptr[AP_FUNPOLICYID_MEET_LINCONS_ARRAY_APPLY] = oct_policy_meet_lincons_array_apply;
+  funptr[AP_FUNPOLICYID_MEET_TCONS_ARRAY_APPLY] = oct_policy_meet_tcons_array_apply;
+  funptr[AP_FUNPOLICYID_MEET_IMPROVE] = oct_policy_meet_improve;
+  funptr[AP_FUNPOLICYID_MEET_ARRAY_IMPROVE] = oct_policy_meet_array_improve;
+  funptr[AP_FUNPOLICYID_MEET_LINCONS_ARRAY_IMPROVE] = oct_policy_meet_lincons_array_improve;
+  funptr[AP_FUNPOLICYID_MEET_TCONS_ARRAY_IMPROVE] = oct_policy_meet_tcons_array_improve;
+  return pman;
+}
+
+/* ============================================================ */
+/* Policies */
+/* ============================================================ */
+
+static oct_policy_t* oct_policy_alloc(size_t size, size_t nbdims)
+{
+  size_t i;
+  oct_policy_t* policy = (oct_policy_t*)malloc(sizeof(oct_policy_t));
+  policy->p = (oct_policy_one_t*)malloc((size ? size : 1)*sizeof(oct_policy_one_t));
+  policy->size = size;
+  policy->nbdims = nbdims;
+  for (i=0;i<size;i++){
+    policy->p[i].nbdims = nbdims;
+    policy->p[i].p = (oct_policy_choice_t*)malloc(matsize(nbdims));
+  }
+  return policy;
+}
+
+void oct_policy_free(ap_policy_manager_t* pman, oct_policy_t* policy)
+{
+  if (policy){
+    size_t i;
+    for (i=0;i<policy->size;i++) free(policy->p[i].p);
+    free(policy->p);
+    free(policy);
+  }
+}
+
+oct_policy_t* oct_policy_copy(ap_policy_manager_t* pman, oct_policy_t* policy)
+{
+  if (policy==NULL){
+    return NULL;
+  } else {
+    size_t i;
+    oct_policy_t* r = oct_policy_alloc(policy->size,policy->nbdims);
+    for (i=0;i<policy->size;i++)
+      memcpy(r->p[i].p,policy->p[i].p,matsize(policy->nbdims));
+    return r;
+  }
+}
+
+size_t oct_policy_dimension(ap_policy_manager_t* pman, oct_policy_t* policy)
+{
+  return policy ? policy->nbdims : 0;
+}
+
+char* oct_policy_sprint(ap_policy_manager_t* pman, oct_policy_t* policy)
+{
+  if (policy){
+    size_t i,k,n = matsize(policy->nbdims);
+    char* s = (char*)malloc(policy->size*(n+1)+1);
+    char* p = s;
+    for (i=0;i<policy->size;i++){
+      for (k=0;k<n;k++)
+	*(p++) = policy->p[i].p[k]==OCT_POLICY_1 ? 'l' : 'r';
+      *(p++) = '\n';
+    }
+    *p = 0;
+    return s;
+  } else {
+    return strdup("NULL");
+  }
+}
+
+void oct_policy_fprint(FILE* stream, ap_policy_manager_t* pman, oct_policy_t* policy)
+{
+  char* s = oct_policy_sprint(pman,policy);
+  fputs(s,stream);
+  free(s);
+}
+
+bool oct_policy_equal(ap_policy_manager_t* pman, oct_policy_t* policy1, oct_policy_t* policy2)
+{
+  size_t i;
+
+  if (policy1==policy2) return true;
+  if (policy1==NULL || policy2==NULL) return false;
+  if (policy1->nbdims!=policy2->nbdims || policy1->size!=policy2->size)
+    return false;
+  for (i=0;i<policy1->size;i++){
+    if (memcmp(policy1->p[i].p,policy2->p[i].p,matsize(policy1->nbdims)))
+      return false;
+  }
+  return true;
+}
+
+long oct_policy_hash(ap_policy_manager_t* pman, oct_policy_t* policy)
+{
+  if (policy){
+    size_t i,k,n = matsize(policy->nbdims);
+    long res = policy->size;
+    for (i=0;i<policy->size;i++)
+      for (k=0;k<n;k++)
+	res = 5*res + policy->p[i].p[k];
+    return res;
+  } else {
+    return 0;
+  }
+}
+
+/* ============================================================ */
+/* Meet */
+/* ============================================================ */
+
+/* closed matrix of a, NULL if a is empty */
+static inline dbm* oct_policy_closed(oct_internal_t* pr, oct_t* a)
+{
+  oct_cache_closure(pr,a);
+  return a->closed ? a->closed : a->m;
+}
+
+static oct_t* oct_policy_meet_internal_apply(oct_internal_t* pr,
+					     oct_policy_one_t* policy,
+					     bool destructive,
+					     oct_t* a1, oct_t* a2)
+{
+  dbm* m1 = oct_policy_closed(pr,a1);
+  dbm* m2 = oct_policy_closed(pr,a2);
+  dbm* m;
+  size_t k;
+
+  pr->man->result.flag_exact = pr->man->result.flag_best = false;
+  if (!m1 || !m2)
+    return oct_set_mat(pr,a1,NULL,NULL,destructive);
+  if (policy->nbdims!=a1->dim) abort();
+  m = hmat_alloc(pr,a1->dim);
+  for (k=0;k<matsize(a1->dim);k++)
+    setdbm(m,k,*getdbm(policy->p[k]==OCT_POLICY_1 ? m1 : m2,k));
+  return oct_set_mat(pr,a1,m,NULL,destructive);
+}
+
+static void oct_policy_meet_internal_improve(oct_internal_t* pr,
+					     oct_policy_one_t* rpolicy,
+					     oct_policy_one_t* policy,
+					     oct_t* a1, oct_t* a2)
+{
+  dbm* m1 = oct_policy_closed(pr,a1);
+  dbm* m2 = oct_policy_closed(pr,a2);
+  size_t k;
+
+  if (!m1 || !m2){
+    /* the meet is empty whatever the choices */
+    memset(rpolicy->p,OCT_POLICY_1,matsize(a1->dim));
+    return;
+  }
+  if (policy && policy->nbdims!=a1->dim) abort();
+  for (k=0;k<matsize(a1->dim);k++){
+    int cmp = bound_cmp(*getdbm(m1,k),*getdbm(m2,k));
+    rpolicy->p[k] =
+      (cmp==0 && policy) ? policy->p[k] :
+      (cmp<=0 ? OCT_POLICY_1 : OCT_POLICY_2);
+  }
+}
+
+oct_t* oct_policy_meet_apply(ap_policy_manager_t* pman,
+			     oct_policy_t* policy,
+			     bool destructive, oct_t* a1, oct_t* a2)
+{
+  oct_internal_t* pr = oct_init_from_manager(pman->man,AP_FUNID_MEET,0);
+  assert(policy->size==1);
+  return oct_policy_meet_internal_apply(pr,&policy->p[0],destructive,a1,a2);
+}
+
+oct_policy_t* oct_policy_meet_improve(ap_policy_manager_t* pman,
+				      oct_policy_t* policy,
+				      oct_t* a1, oct_t* a2)
+{
+  oct_internal_t* pr = oct_init_from_manager(pman->man,AP_FUNID_MEET,0);
+  oct_policy_t* r = oct_policy_alloc(1,a1->dim);
+  assert(policy ? policy->size==1 : true);
+  oct_policy_meet_internal_improve(pr,&r->p[0],policy ? &policy->p[0] : NULL,a1,a2);
+  return r;
+}
+
+oct_t* oct_policy_meet_array_apply(ap_policy_manager_t* pman,
+				   oct_policy_t* policy,
+				   oct_t** tab, size_t size)
+{
+  oct_internal_t* pr = oct_init_from_manager(pman->man,AP_FUNID_MEET_ARRAY,0);
+  oct_t* r;
+  size_t i;
+
+  assert(size>0 && policy->size==size-1);
+  r = oct_copy_internal(pr,tab[0]);
+  for (i=1;i<size;i++)
+    r = oct_policy_meet_internal_apply(pr,&policy->p[i-1],true,r,tab[i]);
+  return r;
+}
+
+oct_policy_t* oct_policy_meet_array_improve(ap_policy_manager_t* pman,
+					    oct_policy_t* policy,
+					    oct_t** tab, size_t size)
+{
+  oct_internal_t* pr = oct_init_from_manager(pman->man,AP_FUNID_MEET_ARRAY,0);
+  oct_policy_t* rpolicy;
+  oct_t* r;
+  size_t i;
+
+  assert(size>0 && (policy ? policy->size==size-1 : true));
+  rpolicy = oct_policy_alloc(size-1,tab[0]->dim);
+  r = oct_copy_internal(pr,tab[0]);
+  for (i=1;i<size;i++){
+    oct_policy_meet_internal_improve(pr,&rpolicy->p[i-1],
+				     policy ? &policy->p[i-1] : NULL,
+				     r,tab[i]);
+    r = oct_policy_meet_internal_apply(pr,&rpolicy->p[i-1],true,r,tab[i]);
+  }
+  oct_free_internal(pr,r);
+  return rpolicy;
+}
+
+/* ============================================================ */
+/* Meet with constraints */
+/* ============================================================ */
+
+/* The octagonal constraints (at most two variables with unit coefficients)
+   are the second argument of the meet, as a closed octagon independent of
+   the first argument: a policy chooses for each entry either the entry of
+   the first argument or the bound given by the constraints, like the box
+   policies do for the bounds of the variables. The other constraints are
+   added exactly after the policy is applied. */
+
+static bool oct_policy_lincons_is_octagonal(ap_lincons0_t* cons)
+{
+  size_t i,nb = 0;
+  ap_dim_t dim;
+  ap_coeff_t* coeff;
+
+  if (cons->constyp!=AP_CONS_EQ && cons->constyp!=AP_CONS_SUPEQ &&
+      cons->constyp!=AP_CONS_SUP)
+    return false;
+  if (cons->linexpr0->cst.discr!=AP_COEFF_SCALAR) return false;
+  ap_linexpr0_ForeachLinterm(cons->linexpr0,i,dim,coeff){
+    if (ap_coeff_zero(coeff)) continue;
+    if (coeff->discr!=AP_COEFF_SCALAR ||
+	!(ap_scalar_equal_int(coeff->val.scalar,1) ||
+	  ap_scalar_equal_int(coeff->val.scalar,-1)) ||
+	++nb>2)
+      return false;
+  }
+  return true;
+}
+
+/* Octagon of the octagonal constraints of array, the other ones being
+   copied in *others */
+static oct_t* oct_policy_lincons_split(ap_manager_t* man, oct_t* a,
+				       ap_lincons0_array_t* array,
+				       ap_lincons0_array_t* others)
+{
+  ap_lincons0_array_t octs;
+  size_t i,nbocts = 0,nbothers = 0;
+  oct_t* c;
+
+  for (i=0;i<array->size;i++)
+    if (oct_policy_lincons_is_octagonal(&array->p[i])) nbocts++;
+  octs = ap_lincons0_array_make(nbocts);
+  *others = ap_lincons0_array_make(array->size-nbocts);
+  nbocts = 0;
+  for (i=0;i<array->size;i++){
+    if (oct_policy_lincons_is_octagonal(&array->p[i]))
+      octs.p[nbocts++] = ap_lincons0_copy(&array->p[i]);
+    else
+      others->p[nbothers++] = ap_lincons0_copy(&array->p[i]);
+  }
+  c = oct_top(man,a->intdim,a->dim-a->intdim);
+  c = oct_meet_lincons_array(man,true,c,&octs);
+  ap_lincons0_array_clear(&octs);
+  return c;
+}
+
+oct_t* oct_policy_meet_lincons_array_apply(ap_policy_manager_t* pman,
+					   oct_policy_t* policy,
+					   bool destructive, oct_t* a,
+					   ap_lincons0_array_t* array)
+{
+  ap_manager_t* man = pman->man;
+  oct_internal_t* pr = (oct_internal_t*)man->internal;
+  ap_lincons0_array_t others;
+  oct_t* c;
+
+  assert(policy->size==1);
+  c = oct_policy_lincons_split(man,a,array,&others);
+  oct_init_from_manager(man,AP_FUNID_MEET_LINCONS_ARRAY,0);
+  a = oct_policy_meet_internal_apply(pr,&policy->p[0],destructive,a,c);
+  oct_free_internal(pr,c);
+  if (others.size>0){
+    a = oct_meet_lincons_array(man,true,a,&others);
+    man->result.flag_exact = man->result.flag_best = false;
+  }
+  ap_lincons0_array_clear(&others);
+  return a;
+}
+
+oct_policy_t* oct_policy_meet_lincons_array_improve(ap_policy_manager_t* pman,
+						    oct_policy_t* policy,
+						    oct_t* a, ap_lincons0_array_t* array)
+{
+  ap_manager_t* man = pman->man;
+  oct_internal_t* pr = (oct_internal_t*)man->internal;
+  ap_lincons0_array_t others;
+  oct_policy_t* r;
+  oct_t* c;
+
+  assert(policy ? policy->size==1 : true);
+  c = oct_policy_lincons_split(man,a,array,&others);
+  oct_init_from_manager(man,AP_FUNID_MEET_LINCONS_ARRAY,0);
+  r = oct_policy_alloc(1,a->dim);
+  oct_policy_meet_internal_improve(pr,&r->p[0],policy ? &policy->p[0] : NULL,a,c);
+  oct_free_internal(pr,c);
+  ap_lincons0_array_clear(&others);
+  return r;
+}
+
+/* The tree constraints are linearized on the first argument */
+
+static ap_lincons0_array_t oct_policy_linearize(ap_manager_t* man, oct_t* a,
+						ap_tcons0_array_t* array)
+{
+  ap_abstract0_t a0;
+  bool exact;
+
+  a0.value = a;
+  a0.man = man;
+  return ap_intlinearize_tcons0_array(man,&a0,array,&exact,NUM_AP_SCALAR,
+				      AP_LINEXPR_INTLINEAR,true,true,2,false);
+}
+
+oct_t* oct_policy_meet_tcons_array_apply(ap_policy_manager_t* pman,
+					 oct_policy_t* policy,
+					 bool destructive, oct_t* a,
+					 ap_tcons0_array_t* array)
+{
+  ap_lincons0_array_t array2 = oct_policy_linearize(pman->man,a,array);
+  a = oct_policy_meet_lincons_array_apply(pman,policy,destructive,a,&array2);
+  ap_lincons0_array_clear(&array2);
+  return a;
+}
+
+oct_policy_t* oct_policy_meet_tcons_array_improve(ap_policy_manager_t* pman,
+						  oct_policy_t* policy,
+						  oct_t* a, ap_tcons0_array_t* array)
+{
+  ap_lincons0_array_t array2 = oct_policy_linearize(pman->man,a,array);
+  oct_policy_t* r = oct_policy_meet_lincons_array_improve(pman,policy,a,&array2);
+  ap_lincons0_array_clear(&array2);
+  return r;
+}
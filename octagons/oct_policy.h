@@ -0,0 +1,98 @@
+/*
+ * oct_policy.h
+ *
+ * Policies (min-strategies) for the meets of octagons.
+ *
+ * APRON Library / Octagonal Domain
+ *
+ * This file is part of the APRON Library, released under LGPL license
+ * with an exception allowing the redistribution of statically linked
+ * executables.
+ *
+ * Please read the COPYING file packaged in the distribution.
+ */
+
+#ifndef __OCT_POLICY_H
+#define __OCT_POLICY_H
+
+#include <stdio.h>
+#include "ap_global0.h"
+#include "ap_policy.h"
+#include "oct_fun.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A meet of two octagons takes, for each entry of the closed half-matrix,
+   the minimum of the two entries. A policy chooses instead one of the two
+   entries, so that applying it gives an overapproximation of the meet.
+
+   For a meet with constraints, the second argument is the closed octagon
+   of the octagonal constraints; the other constraints are added exactly
+   once the policy is applied. Tree constraints are first linearized on the
+   first argument. */
+
+typedef char oct_policy_choice_t;
+#define OCT_POLICY_1 0
+#define OCT_POLICY_2 1
+  /* 1: the entry of the first argument is chosen,
+     2: the entry of the second argument is chosen */
+
+typedef struct oct_policy_one_t {
+  oct_policy_choice_t* p; /* Usage: p[0<=k<matsize(nbdims)] */
+  size_t nbdims;
+} oct_policy_one_t;
+
+typedef struct oct_policy_t {
+  oct_policy_one_t* p; /* one per binary meet */
+  size_t size;
+  size_t nbdims;
+} oct_policy_t;
+
+ap_policy_manager_t* oct_policy_manager_alloc(ap_manager_t* man);
+  /* man should be an octagon manager */
+
+void oct_policy_free(ap_policy_manager_t* pman, oct_policy_t* policy);
+oct_policy_t* oct_policy_copy(ap_policy_manager_t* pman, oct_policy_t* policy);
+void oct_policy_fprint(FILE* stream, ap_policy_manager_t* pman, oct_policy_t* policy);
+char* oct_policy_sprint(ap_policy_manager_t* pman, oct_policy_t* policy);
+size_t oct_policy_dimension(ap_policy_manager_t* pman, oct_policy_t* policy);
+bool oct_policy_equal(ap_policy_manager_t* pman, oct_policy_t* policy1, oct_policy_t* policy2);
+long oct_policy_hash(ap_policy_manager_t* pman, oct_policy_t* policy);
+
+oct_t* oct_policy_meet_apply(ap_policy_manager_t* pman,
+			     oct_policy_t* policy,
+			     bool destructive, oct_t* a1, oct_t* a2);
+oct_t* oct_policy_meet_array_apply(ap_policy_manager_t* pman,
+				   oct_policy_t* policy,
+				   oct_t** tab, size_t size);
+oct_t* oct_policy_meet_lincons_array_apply(ap_policy_manager_t* pman,
+					   oct_policy_t* policy,
+					   bool destructive, oct_t* a,
+					   ap_lincons0_array_t* array);
+oct_t* oct_policy_meet_tcons_array_apply(ap_policy_manager_t* pman,
+					 oct_policy_t* policy,
+					 bool destructive, oct_t* a,
+					 ap_tcons0_array_t* array);
+
+oct_policy_t* oct_policy_meet_improve(ap_policy_manager_t* pman,
+				      oct_policy_t* policy,
+				      oct_t* a1, oct_t* a2);
+oct_policy_t* oct_policy_meet_array_improve(ap_policy_manager_t* pman,
+					    oct_policy_t* policy,
+					    oct_t** tab, size_t size);
+oct_policy_t* oct_policy_meet_lincons_array_improve(ap_policy_manager_t* pman,
+						    oct_policy_t* policy,
+						    oct_t* a, ap_lincons0_array_t* array);
+oct_policy_t* oct_policy_meet_tcons_array_improve(ap_policy_manager_t* pman,
+						  oct_policy_t* policy,
+						  oct_t* a, ap_tcons0_array_t* array);
+  /* The improved policy chooses the smallest entry, and keeps the choice
+     of policy (which may be NULL) on ties. */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OCT_POLICY_H */
@@ -77,19 +77,16 @@ bool oct_is_leq(ap_manager_t* man, oct_t* a1, oct_t* a2)
     else { flag_algo; return false; }
   }
   else {
-    size_t i,j;
     dbm *x = a1->closed ? a1->closed : a1->m;
     dbm *y = a2->closed ? a2->closed : a2->m;
-    for (i=0;i<2*a1->dim;i++)
-      for (j=0;j<=(i|1);j++)
-	if (bound_cmp(*getdbm(x, matpos2(i,j)),*getdbm(y,matpos2(i,j)))>0) {
-	  if (a1->closed) {
-	    /* not included on Q */
-	    if (num_incomplete || a1->intdim) { flag_incomplete; }
-	    return false;
-	  }
-	  else { flag_algo; return false; }
-	}
+    if (!dbm_is_leq_array(x,y,matsize(a1->dim))) {
+      if (a1->closed) {
+	/* not included on Q */
+	if (num_incomplete || a1->intdim) { flag_incomplete; }
+	return false;
+      }
+      else { flag_algo; return false; }
+    }
     /* definitively included */
     return true;
   }
@@ -125,20 +122,17 @@ bool oct_is_eq(ap_manager_t* man, oct_t* a1, oct_t* a2)
     else { flag_algo; return false; }
   }
   else {
-    size_t i,j;
     dbm *x = a1->closed ? a1->closed : a1->m;
     dbm *y = a2->closed ? a2->closed : a2->m;
-    for (i=0;i<2*a1->dim;i++)
-      for (j=0;j<=(i|1);j++)
-	if (bound_cmp(*getdbm(x, matpos2(i,j)),*getdbm(y,matpos2(i,j)))) {
-	  if (a1->closed) {
-	    /* not equal on Q */
-	    if (num_incomplete || a1->intdim)
-	      { flag_incomplete; }
-	    return false;
-	  }
-	  else { flag_algo; return false; }
-	}
+    if (!dbm_is_eq_array(x,y,matsize(a1->dim))) {
+      if (a1->closed) {
+	/* not equal on Q */
+	if (num_incomplete || a1->intdim)
+	  { flag_incomplete; }
+	return false;
+      }
+      else { flag_algo; return false; }
+    }
     /* definitively equal */
     return true;
   }
@@ -134,70 +134,135 @@ void oct_fdump(FILE* stream, ap_manager_t* man, oct_t* a)
 /* raw format:
    0: uchar:  num_serialize_id
    1: uchar:  state (0=empty, 1=not closed, 2=closed)
-   2: uint32: intdim
-   6: uint32: realdim
-  10:   -   : half matrix, as flat array of bound_t
+   2: uint32: dim
+   6: uint32: intdim
+  10: uchar:  format of the matrix (0=flat, 1=compact)
+  11:   -   : padding, so that the matrix is aligned in checkpoint files
+  16:   -   : half matrix, either as flat array of bound_t, or in the
+              compact format of dbm_serialize_compact
  */
 
+#define OCT_SERIALIZE_HEADER 16
+#define OCT_SERIALIZE_MAXDIM ((size_t)1<<26)
+
 ap_membuf_t oct_serialize_raw(ap_manager_t* man, oct_t* a)
 {
   oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_SERIALIZE_RAW,0);
   ap_membuf_t buf;
-  size_t n = 10;
-  if (a->m) 
-    //n += bound_serialized_size_array(a->m,matsize(a->dim));
-    n += dbm_serialized_size_array(a->m,matsize(a->dim));
-  else if (a->closed) 
-    n += dbm_serialized_size_array(a->closed,matsize(a->dim));
-  checked_malloc(buf.ptr,char,n,buf.size=0;return buf;);
-  ((unsigned char*)buf.ptr)[0] = num_serialize_id();
-  num_dump_word32((char*)buf.ptr+2,a->dim);
-  num_dump_word32((char*)buf.ptr+6,a->intdim);
-  n = 10;
-  if (a->m) {
-    ((char*)buf.ptr)[1] = 1;
-    buf.size = 10 + dbm_serialize_array
-      ((char*)buf.ptr+10,a->m,matsize(a->dim));
-    
+  /* the closed matrix, if any, is the one to keep */
+  dbm* d = a->closed ? a->closed : a->m;
+  char format = d && pr->funopt->algorithm<=0;
+  if (!d) {
+    checked_malloc(buf.ptr,char,OCT_SERIALIZE_HEADER,buf.size=0;return buf;);
+    buf.size = OCT_SERIALIZE_HEADER;
   }
-  else if (a->closed) {
-    ((char*)buf.ptr)[1] = 2;
-    buf.size = 10 + dbm_serialize_array
-      ((char*)buf.ptr+10,a->closed,matsize(a->dim));
+  else if (format) {
+    buf = dbm_serialize_compact(pr,d,matsize(a->dim),OCT_SERIALIZE_HEADER);
+    if (!buf.ptr) return buf;
   }
   else {
-    ((char*)buf.ptr)[1] = 0;
-    buf.size = 10;
+    size_t n = OCT_SERIALIZE_HEADER + dbm_serialized_size_array(d,matsize(a->dim));
+    checked_malloc(buf.ptr,char,n,buf.size=0;return buf;);
+    buf.size = OCT_SERIALIZE_HEADER + dbm_serialize_array
+      ((char*)buf.ptr+OCT_SERIALIZE_HEADER,d,matsize(a->dim));
   }
+  memset(buf.ptr,0,OCT_SERIALIZE_HEADER);
+  ((unsigned char*)buf.ptr)[0] = num_serialize_id();
+  ((char*)buf.ptr)[1] = !d ? 0 : a->closed ? 2 : 1;
+  num_dump_word32((char*)buf.ptr+2,a->dim);
+  num_dump_word32((char*)buf.ptr+6,a->intdim);
+  ((char*)buf.ptr)[10] = format;
   return buf;
 }
 
+/* Check the header of the raw format against the avail bytes available */
+static bool oct_deserialize_header(oct_internal_t* pr, void* ptr, size_t avail)
+{
+  arg_assert(avail>=OCT_SERIALIZE_HEADER,return false;);
+  {
+    unsigned char state = ((unsigned char*)ptr)[1];
+    size_t dim = num_undump_word32((char*)ptr+2);
+    size_t intdim = num_undump_word32((char*)ptr+6);
+    unsigned char format = ((unsigned char*)ptr)[10];
+    arg_assert(((unsigned char*)ptr)[0]==num_serialize_id(),return false;);
+    arg_assert(state<3 && format<2 && intdim<=dim,return false;);
+    /* keeps matsize(dim)*sizeof(bound_t) representable */
+    arg_assert(state==0 || dim<=OCT_SERIALIZE_MAXDIM,return false;);
+  }
+  return true;
+}
+
+/* If size is not NULL, *size is the number of bytes available at ptr; the
+   header and the matrix are checked against it before allocating */
 oct_t* oct_deserialize_raw(ap_manager_t* man, void* ptr, size_t* size)
 {
   oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_DESERIALIZE_RAW,0);
-  unsigned char id = ((unsigned char*)ptr)[0];
-  char state = ((char*)ptr)[1];
-  size_t dim = num_undump_word32((char*)ptr+2);
-  size_t intdim = num_undump_word32((char*)ptr+6);
-  size_t dummy;
-  oct_t* r = oct_alloc_internal(pr,dim,intdim);
-  arg_assert(id==num_serialize_id(),oct_free_internal(pr,r);return NULL;);
-  arg_assert(state<3,oct_free_internal(pr,r);return NULL;);
+  size_t avail = size ? *size : (size_t)-1;
+  char state, format;
+  size_t dim, intdim, dummy, n;
+  dbm* d;
+  oct_t* r;
+  if (!oct_deserialize_header(pr,ptr,avail)) return NULL;
+  state = ((char*)ptr)[1];
+  dim = num_undump_word32((char*)ptr+2);
+  intdim = num_undump_word32((char*)ptr+6);
+  format = ((char*)ptr)[10];
   if (!size) size = &dummy;
-  switch (state) {
-  case 0:
-    *size = 10;
-    break;
-  case 1:
-    r->m = hmat_alloc(pr,dim);
-    *size = 10 + dbm_deserialize_array(r->m,(char*)ptr+10,matsize(dim));
-    break;
-  case 2:
-    r->closed = hmat_alloc(pr,dim);
-    *size = 10 + dbm_deserialize_array(r->closed,(char*)ptr+10,matsize(dim));
-    break;
-  default: assert(0);
+  if (state==0) {
+    *size = OCT_SERIALIZE_HEADER;
+    return oct_alloc_internal(pr,dim,intdim);
   }
+  avail -= OCT_SERIALIZE_HEADER;
+  if (format)
+    n = dbm_deserialized_size_compact((char*)ptr+OCT_SERIALIZE_HEADER,avail,matsize(dim));
+  else
+    n = dbm_deserialized_size_array((char*)ptr+OCT_SERIALIZE_HEADER,avail,matsize(dim));
+  arg_assert(n>0 || matsize(dim)==0,return NULL;);
+  d = hmat_alloc(pr,dim);
+  if (!d) return NULL;
+  r = oct_alloc_internal(pr,dim,intdim);
+  if (state==1) r->m = d;
+  else r->closed = d;
+  if (format)
+    n = dbm_deserialize_compact(pr,d,(char*)ptr+OCT_SERIALIZE_HEADER,matsize(dim));
+  else
+    n = dbm_deserialize_array(d,(char*)ptr+OCT_SERIALIZE_HEADER,matsize(dim));
+  arg_assert(n>0 || matsize(dim)==0,oct_free_internal(pr,r);return NULL;);
+  *size = OCT_SERIALIZE_HEADER + n;
   return r;
 }
 
+oct_t* oct_deserialize_mapped(ap_manager_t* man, void* ptr, size_t* size,
+			      ap_checkpoint_t* ck)
+{
+#if defined(BOUND_SERIALIZE_NATIVE) && !defined(DBMCACHE)
+  /* the matrix is used in place: writes copy the pages of the private
+     mapping, and hmat_free releases ck instead of freeing it */
+  oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_DESERIALIZE_MAPPED,0);
+  size_t avail = size ? *size : (size_t)-1;
+  char state;
+  bound_t* m = (bound_t*)((char*)ptr+OCT_SERIALIZE_HEADER);
+  if (!oct_deserialize_header(pr,ptr,avail)) return NULL;
+  state = ((char*)ptr)[1];
+  if ((state==1 || state==2) &&
+      ((char*)ptr)[10]==0 &&
+      (size_t)m % __alignof__(bound_t)==0) {
+    size_t dim = num_undump_word32((char*)ptr+2);
+    size_t intdim = num_undump_word32((char*)ptr+6);
+    oct_t* r;
+    arg_assert(matsize(dim)<=(avail-OCT_SERIALIZE_HEADER)/sizeof(bound_t),
+	       return NULL;);
+    r = oct_alloc_internal(pr,dim,intdim);
+    dbm* d;
+    checked_malloc(d,dbm,1,oct_free_internal(pr,r);return NULL;);
+    d->m = m;
+    d->map = ap_checkpoint_copy(ck);
+    if (state==1) r->m = d;
+    else r->closed = d;
+    if (size) *size = OCT_SERIALIZE_HEADER + matsize(dim)*sizeof(bound_t);
+    return r;
+  }
+#endif
+  return oct_deserialize_raw(man,ptr,size);
+}
+
@@ -78,6 +78,17 @@ size_t oct_size(ap_manager_t* man, oct_t* a)
   return matsize(a->dim);
 }
 
+/* does not call oct_init_from_manager, so that the flags of the last
+   operation are kept */
+size_t oct_memory_size(ap_manager_t* man, oct_t* a)
+{
+  oct_internal_t* pr = (oct_internal_t*)man->internal;
+  size_t res = sizeof(oct_t);
+  if (a->m) res += hmat_memory_size(pr,a->m,a->dim);
+  if (a->closed && a->closed!=a->m) res += hmat_memory_size(pr,a->closed,a->dim);
+  return res;
+}
+
 /* If destructive, returns a with fields m and closed updated
    (former fields of a, if not reused in m or closed, are destroyed).
    If not destructive, returns a new octagon with same dimensions as a
@@ -131,23 +142,25 @@ oct_t* oct_top(ap_manager_t* man, size_t intdim, size_t realdim)
 oct_t* oct_of_box(ap_manager_t* man, size_t intdim, size_t realdim,
 		  ap_interval_t ** t)
 {
-  oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_OF_BOX,0);
+  oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_OF_BOX,2);
   oct_t* r = oct_alloc_internal(pr,intdim+realdim,intdim);
   size_t i,j,n2;
   if (!t) return r; /* empty */
   for (i=0;i<r->dim;i++)
     if (ap_scalar_cmp(t[i]->inf,t[i]->sup)>0) return r; /* empty */
   r->closed = hmat_alloc_top(pr,r->dim);
-  for (i=0;i<r->dim;i++)
-    if (bounds_of_interval(pr,
-			   *getdbm(r->closed,matpos(2*i,2*i+1)),
-			   *getdbm(r->closed,matpos(2*i+1,2*i)),
-			   t[i],true)) {
+  for (i=0;i<r->dim;i++) {
+    /* the bounds are converted in pr->tmp, as with DBMCACHE getdbm points
+       to a value shared by all the equal elements */
+    if (bounds_of_interval(pr,pr->tmp[0],pr->tmp[1],t[i],true)) {
       /* one interval is empty -> the result is empty */
       hmat_free(pr,r->closed,r->dim);
       r->closed = NULL;
       return r;
     }
+    setdbm(r->closed,matpos(2*i,2*i+1),pr->tmp[0]);
+    setdbm(r->closed,matpos(2*i+1,2*i),pr->tmp[1]);
+  }
   /* a S step is sufficient to ensure clsoure */
   if (hmat_s_step(r->closed,r->dim)){
     /* definitively empty */
@@ -207,7 +220,6 @@ ap_abstract0_oct_of_generator_array(ap_manager_t* man,
 
 ap_dimension_t oct_dimension(ap_manager_t* man, oct_t* a)
 {
-  oct_internal_t* pr = oct_init_from_manager(man,AP_FUNID_DIMENSION,0);
   ap_dimension_t r;
   r.intdim = a->intdim;
   r.realdim = a->dim-a->intdim;
@@ -229,12 +241,17 @@ void oct_cache_closure(oct_internal_t* pr, oct_t* a)
 {
   if (a->closed || !a->m) return;
   a->closed = hmat_copy(pr,a->m,a->dim);
-  if (hmat_close(a->closed,a->dim)) {
+  if (hmat_close(pr,a->closed,a->dim)) {
     /* empty! */
     hmat_free(pr,a->m,a->dim);
     hmat_free(pr,a->closed,a->dim);
     a->m = a->closed = NULL;
   }
+  else if (pr->timeout) {
+    /* interrupted: go on with a->m, as when closure is disabled */
+    hmat_free(pr,a->closed,a->dim);
+    a->closed = NULL;
+  }
 }
 
 /* Unlike oct_cache_closure, this frees the a->m representation, forcing
@@ -252,10 +269,15 @@ void oct_close(oct_internal_t* pr, oct_t* a)
   }
   a->closed = a->m;
   a->m = NULL;
-  if (hmat_close(a->closed,a->dim)) {
+  if (hmat_close(pr,a->closed,a->dim)) {
     hmat_free(pr,a->closed,a->dim);
     a->closed = NULL;
   }
+  else if (pr->timeout) {
+    /* interrupted: the matrix is not closed */
+    a->m = a->closed;
+    a->closed = NULL;
+  }
 }
 
 
@@ -348,6 +370,9 @@ ap_manager_t* oct_manager_alloc(void)
   bound_init_array(pr->tmp,pr->tmp_size);
   pr->tmp2 = malloc(sizeof(long)*pr->tmp_size);
   assert(pr->tmp2);
+  pr->timeout = false;
+  pr->deadline.end = 0.0; /* no timeout until oct_init_from_manager */
+  pr->deadline.budget = AP_DEADLINE_PERIOD;
 
   man = ap_manager_alloc("oct","1.0 with " NUM_NAME, pr,
 			 (void (*)(void*))oct_internal_free);
@@ -357,6 +382,7 @@ ap_manager_t* oct_manager_alloc(void)
   man->funptr[AP_FUNID_COPY] = &oct_copy;
   man->funptr[AP_FUNID_FREE] = &oct_free;
   man->funptr[AP_FUNID_ASIZE] = &oct_size;
+  man->funptr[AP_FUNID_MEMORY_SIZE] = &oct_memory_size;
   man->funptr[AP_FUNID_MINIMIZE] = &oct_minimize;
   man->funptr[AP_FUNID_CANONICALIZE] = &oct_canonicalize;
   man->funptr[AP_FUNID_HASH] = &oct_hash;
@@ -366,6 +392,7 @@ ap_manager_t* oct_manager_alloc(void)
   man->funptr[AP_FUNID_FDUMP] = &oct_fdump;
   man->funptr[AP_FUNID_SERIALIZE_RAW] = &oct_serialize_raw;
   man->funptr[AP_FUNID_DESERIALIZE_RAW] = &oct_deserialize_raw;
+  man->funptr[AP_FUNID_DESERIALIZE_MAPPED] = &oct_deserialize_mapped;
   man->funptr[AP_FUNID_BOTTOM] = &oct_bottom;
   man->funptr[AP_FUNID_TOP] = &oct_top;
   man->funptr[AP_FUNID_OF_BOX] = &oct_of_box;
@@ -98,7 +98,7 @@ char check(oct_t* o)
     if (!o->m) return 'c'; /* ok */
     /* now check that closure(o->m) = o->closed */
     cl = hmat_copy(pr,o->m,o->dim);
-    hmat_close(cl,o->dim);
+    hmat_close(pr,cl,o->dim);
     for (i=0;i<matsize(o->dim);i++)
       if (bound_cmp(*getdbm(cl,i),*getdbm(o->closed,i))) {
 	hmat_free(pr,cl,o->dim);
@@ -706,6 +706,7 @@ void test_serialize(void)
     ap_membuf_t b;
     o  = random_oct(10,.1);
     b  = oct_serialize_raw(mo,o); FLAG(mo);
+    sz = b.size;
     o2 = oct_deserialize_raw(mo,b.ptr,&sz); FLAG(mo);
     RESULT(check(o)); check(o2);
     if (oct_is_nleq(mo,o,o2)) {
@@ -435,6 +435,9 @@ bool hmat_add_lincons(oct_internal_t* pr, dbm* b, size_t intdim, size_t dim,
   /* if (*respect_closure && closure_pending) */
   /*   if (hmat_close_incremental(b,dim,var_pending)) return true; */
 
+  /* an interrupted incremental closure does not respect closure */
+  if (pr->timeout) *respect_closure = false;
+
   return false;
 }
 
@@ -786,6 +789,9 @@ static void hmat_assign(oct_internal_t* pr, uexpr u, dbm* m, size_t dim,
 
     bound_clear(tmpa); bound_clear(tmpb); bound_clear(Cb); bound_clear(cb);
   }
+
+  /* an interrupted incremental closure does not respect closure */
+  if (pr->timeout) *respect_closure = false;
 }
 
 
@@ -1082,7 +1088,7 @@ oct_t* oct_assign_linexpr_array(ap_manager_t* man,
 
   /* now close & remove temporary variables */
   if (pr->funopt->algorithm>=0) {
-    if (hmat_close(mm,a->dim+size)) {
+    if (hmat_close(pr,mm,a->dim+size)) {
       /* empty */
       hmat_free(pr,mm,a->dim+size);
       return oct_set_mat(pr,a,NULL,NULL,destructive);
@@ -1195,7 +1201,7 @@ oct_t* oct_substitute_linexpr_array(ap_manager_t* man,
 
   /* now close */
   if (pr->funopt->algorithm>=0) {
-    if (hmat_close(mm,a->dim+size)) {
+    if (hmat_close(pr,mm,a->dim+size)) {
       /* empty */
       hmat_free(pr,mm,a->dim+size);
       return oct_set_mat(pr,a,NULL,NULL,destructive);
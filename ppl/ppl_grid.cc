@@ -213,6 +213,16 @@ size_t ap_ppl_grid_size(ap_manager_t* man, PPL_Grid* a)
   CATCH_WITH_VAL(AP_FUNID_ASIZE,0);
 }
 
+extern "C"
+size_t ap_ppl_grid_memory_size(ap_manager_t* man, PPL_Grid* a)
+{
+  man->result.flag_exact = man->result.flag_best = true;
+  try {
+    return sizeof(PPL_Grid) + a->p->total_memory_in_bytes();
+  }
+  CATCH_WITH_VAL(AP_FUNID_MEMORY_SIZE,0);
+}
+
 /* ============================================================ */
 /* I.2 Control of internal representation */
 /* ============================================================ */
@@ -1274,6 +1284,7 @@ extern "C" ap_manager_t* ap_ppl_grid_manager_alloc(void)
   man->funptr[AP_FUNID_COPY] = (void*)ap_ppl_grid_copy;
   man->funptr[AP_FUNID_FREE] = (void*)ap_ppl_grid_free;
   man->funptr[AP_FUNID_ASIZE] = (void*)ap_ppl_grid_size;
+  man->funptr[AP_FUNID_MEMORY_SIZE] = (void*)ap_ppl_grid_memory_size;
   man->funptr[AP_FUNID_MINIMIZE] = (void*)ap_ppl_grid_minimize;
   man->funptr[AP_FUNID_CANONICALIZE] = (void*)ap_ppl_grid_canonicalize;
   man->funptr[AP_FUNID_HASH] = (void*)ap_ppl_grid_hash;
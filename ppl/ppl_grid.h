@@ -46,6 +46,9 @@ size_t ap_ppl_grid_size(ap_manager_t* man, struct ppl_grid* a);
   /* Return the abstract size of a polyhedron, which is the number of
      coefficients of its current representation, possibly redundant. */
 
+size_t ap_ppl_grid_memory_size(ap_manager_t* man, struct ppl_grid* a);
+  /* Return the number of bytes allocated for the grid */
+
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
@@ -65,6 +65,9 @@ size_t ap_ppl_grid_size(ap_manager_t* man, PPL_Grid* a);
   /* Return the abstract size of an abstract value, which is the number of
      coefficients of its current representation, possibly redundant. */
 
+size_t ap_ppl_grid_memory_size(ap_manager_t* man, PPL_Grid* a);
+  /* Return the number of bytes allocated for the grid */
+
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
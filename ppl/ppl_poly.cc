@@ -204,6 +204,16 @@ size_t ap_ppl_poly_size(ap_manager_t* man, PPL_Poly* a)
   CATCH_WITH_VAL(AP_FUNID_ASIZE,0);
 }
 
+extern "C"
+size_t ap_ppl_poly_memory_size(ap_manager_t* man, PPL_Poly* a)
+{
+  man->result.flag_exact = man->result.flag_best = true;
+  try {
+    return sizeof(PPL_Poly) + a->p->total_memory_in_bytes();
+  }
+  CATCH_WITH_VAL(AP_FUNID_MEMORY_SIZE,0);
+}
+
 /* ============================================================ */
 /* I.2 Control of internal representation */
 /* ============================================================ */
@@ -1225,6 +1235,7 @@ extern "C" ap_manager_t* ap_ppl_poly_manager_alloc(bool strict)
   man->funptr[AP_FUNID_COPY] = (void*)ap_ppl_poly_copy;
   man->funptr[AP_FUNID_FREE] = (void*)ap_ppl_poly_free;
   man->funptr[AP_FUNID_ASIZE] = (void*)ap_ppl_poly_size;
+  man->funptr[AP_FUNID_MEMORY_SIZE] = (void*)ap_ppl_poly_memory_size;
   man->funptr[AP_FUNID_MINIMIZE] = (void*)ap_ppl_poly_minimize;
   man->funptr[AP_FUNID_CANONICALIZE] = (void*)ap_ppl_poly_canonicalize;
   man->funptr[AP_FUNID_HASH] = (void*)ap_ppl_poly_hash;
@@ -69,6 +69,9 @@ size_t ap_ppl_poly_size(ap_manager_t* man, PPL_Poly* a);
   /* Return the abstract size of a polyhedron, which is the number of
      coefficients of its current representation, possibly redundant. */
 
+size_t ap_ppl_poly_memory_size(ap_manager_t* man, PPL_Poly* a);
+  /* Return the number of bytes allocated for the polyhedron */
+
 
 /* ============================================================ */
 /* I.2 Control of internal representation */
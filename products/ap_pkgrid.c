@@ -1,5 +1,5 @@
 /* ************************************************************************* */
-/* ap_pkgrid.c: reduced product of NewPolka polyhedra and PPL grids */
+/* ap_pkgrid.c: reduced product of NewPolka polyhedra and grids */
 /* ************************************************************************* */
 
 /* This file is part of the APRON Library, released under GPL license.  Please
@@ -10,7 +10,7 @@
 #include <string.h>
 #include "ap_global0.h"
 #include "ap_reducedproduct.h"
-#include "ap_reducedproduct.h"
+#include "ap_pkgrid.h"
 
 #include "pk.h"
 #include "pk_internal.h"
@@ -18,7 +18,9 @@
 #include "pk_satmat.h"
 #include "pk_representation.h"
 #include "pk_user.h"
-#include "ppl_grid.h"
+
+/* The grid is accessed through the functions of its manager, so that both
+   the PPL grids and the grids of NewPolka can be used. */
 
 void ap_pkgrid_reduce(ap_manager_t* manager,
 		      ap_reducedproduct_t* a)
@@ -29,36 +31,55 @@ void ap_pkgrid_reduce(ap_manager_t* manager,
   ap_manager_t* manpoly = intern->tmanagers[0];
   ap_manager_t* mangrid = intern->tmanagers[1];
   pk_t* poly = (pk_t*)a->p[0];
-  struct ppl_grid* grid = a->p[1];
+  void* grid = a->p[1];
   ap_lincons0_array_t array,array2;
   ap_interval_t* interval;
   mpq_t quotient;
   int cmp;
   ap_dimension_t dimension;
 
+  void (*grid_free)(ap_manager_t*,...) = mangrid->funptr[AP_FUNID_FREE];
+  void* (*grid_bottom)(ap_manager_t*,...) = mangrid->funptr[AP_FUNID_BOTTOM];
+  bool (*grid_sat_lincons)(ap_manager_t*,...) =
+    mangrid->funptr[AP_FUNID_SAT_LINCONS];
+  void* (*grid_meet_lincons_array)(ap_manager_t*,...) =
+    mangrid->funptr[AP_FUNID_MEET_LINCONS_ARRAY];
+  bool (*grid_is_bottom)(ap_manager_t*,...) = mangrid->funptr[AP_FUNID_IS_BOTTOM];
+  void (*grid_canonicalize)(ap_manager_t*,...) =
+    mangrid->funptr[AP_FUNID_CANONICALIZE];
+  ap_lincons0_array_t (*grid_to_lincons_array)(ap_manager_t*,...) =
+    mangrid->funptr[AP_FUNID_TO_LINCONS_ARRAY];
+
   mpq_init(quotient);
   dimension = pk_dimension(manpoly,poly);
 
   /* 1. Reduction from poly to grid:
-     one add equalities of poly to grid */
+     one add to grid the equalities of poly it does not already satisfy */
   pk_canonicalize(manpoly,poly);
   if (pk_is_bottom(manpoly,poly)){
   ap_pkgrid_reduce_exit1:
-    ap_ppl_grid_free(mangrid,grid);
-    grid = ap_ppl_grid_bottom(mangrid,
-			      dimension.intdim,dimension.realdim);
+    grid_free(mangrid,grid);
+    grid = grid_bottom(mangrid,
+		       dimension.intdim,dimension.realdim);
     goto ap_pkgrid_reduce_exit;
   }
   assert(poly->C->_sorted);
   if (poly->nbeq>0){
     array = ap_lincons0_array_make(poly->nbeq);
+    index = 0;
     for (i=0; i<poly->nbeq; i++){
-      array.p[i] = lincons0_of_vector((pk_internal_t*)(manpoly->internal),
-				      poly->C->p[i],poly->C->nbcolumns);
+      array.p[index] = lincons0_of_vector((pk_internal_t*)(manpoly->internal),
+					  poly->C->p[i],poly->C->nbcolumns);
+      if (grid_sat_lincons(mangrid,grid,&array.p[index]))
+	ap_lincons0_clear(&array.p[index]);
+      else
+	index++;
     }
-    grid = ap_ppl_grid_meet_lincons_array(mangrid,true,grid,&array);
+    array.size = index;
+    if (index>0)
+      grid = grid_meet_lincons_array(mangrid,true,grid,&array);
     ap_lincons0_array_clear(&array);
-    if (ap_ppl_grid_is_bottom(mangrid,grid)){
+    if (index>0 && grid_is_bottom(mangrid,grid)){
     ap_pkgrid_reduce_exit2:
       pk_free(manpoly,poly);
       poly = pk_bottom(manpoly,
@@ -76,11 +97,11 @@ void ap_pkgrid_reduce(ap_manager_t* manager,
      sup(a/m)*m <= e <= inf(a/m)*m
   */
   /* 2.1 Extract constraints */
-  ap_ppl_grid_canonicalize(mangrid,grid);
-  if (ap_ppl_grid_is_bottom(mangrid,grid)){
+  grid_canonicalize(mangrid,grid);
+  if (grid_is_bottom(mangrid,grid)){
     goto ap_pkgrid_reduce_exit2;
   }
-  array = ap_ppl_grid_to_lincons_array(mangrid,grid);
+  array = grid_to_lincons_array(mangrid,grid);
   array2 = ap_lincons0_array_make(2*array.size);
   index = 0;
   for (i=0; i<array.size; i++){
@@ -88,8 +109,11 @@ void ap_pkgrid_reduce(ap_manager_t* manager,
     ap_lincons0_t* cons2;
     switch (cons.constyp){
     case AP_CONS_EQ:
-      array2.p[index] = ap_lincons0_copy(&cons);
-      index++;
+      /* only the equalities poly does not already satisfy */
+      if (!pk_sat_lincons(manpoly,poly,&cons)){
+	array2.p[index] = ap_lincons0_copy(&cons);
+	index++;
+      }
       break;
     case AP_CONS_EQMOD:
       interval = pk_bound_linexpr(manpoly,poly,cons.linexpr0);
@@ -152,7 +176,8 @@ void ap_pkgrid_reduce(ap_manager_t* manager,
     }
   }
   array2.size = index;
-  poly = pk_meet_lincons_array(manpoly,true,poly,&array2);
+  if (index>0)
+    poly = pk_meet_lincons_array(manpoly,true,poly,&array2);
   ap_lincons0_array_clear(&array);
   ap_lincons0_array_clear(&array2);
 
@@ -169,29 +194,34 @@ void ap_pkgrid_approximate(ap_manager_t* manager,
   ap_reducedproduct_internal_t* intern =
     (ap_reducedproduct_internal_t*)manager->internal;
   ap_manager_t* manpoly = intern->tmanagers[0];
-  ap_manager_t* mangrid = intern->tmanagers[1];
   pk_t* poly = (pk_t*)a->p[0];
-  struct ppl_grid* grid = a->p[1];
   pk_approximate(manpoly,poly,n);
   ap_pkgrid_reduce(manager,a);
 }
 
-ap_manager_t* ap_pkgrid_manager_alloc(ap_manager_t* manpk, ap_manager_t* manpplgrid)
+ap_manager_t* ap_pkgrid_manager_alloc(ap_manager_t* manpk, ap_manager_t* mangrid)
 {
   ap_manager_t* tmanagers[2];
-  bool strict;
+  bool strict,ppl;
+  char* library;
 
   strict = (strcmp(manpk->library,"polka, strict mode")==0);
+  ppl = (strcmp(mangrid->library,"PPL::Grid")==0);
 
   if ( (strcmp(manpk->library,"polka, loose mode") && !strict) ||
-       strcmp(manpplgrid->library,"PPL::Grid") )
+       (strcmp(mangrid->library,"polka, grid mode") && !ppl) )
     return NULL;
 
   tmanagers[0] = manpk;
-  tmanagers[1] = manpplgrid;
-  char* library = strict ?
-    "pkgrid: polka, strict mode and PPL::Grid" :
-    "pkgrid: polka, loose mode and PPL::Grid";
+  tmanagers[1] = mangrid;
+  if (ppl)
+    library = strict ?
+      "pkgrid: polka, strict mode and PPL::Grid" :
+      "pkgrid: polka, loose mode and PPL::Grid";
+  else
+    library = strict ?
+      "pkgrid: polka, strict mode and polka, grid mode" :
+      "pkgrid: polka, loose mode and polka, grid mode";
 
   ap_manager_t* man = ap_reducedproduct_manager_alloc(library,
 						      tmanagers,2,
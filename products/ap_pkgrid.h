@@ -1,5 +1,5 @@
 /* ************************************************************************* */
-/* ap_poly_grid.h: reduced product of NewPolka polyhedra and PPL grids */
+/* ap_pkgrid.h: reduced product of NewPolka polyhedra and grids */
 /* ************************************************************************* */
 
 /* This file is part of the APRON Library, released under GPL license.  Please
@@ -14,11 +14,13 @@
 extern "C" {
 #endif
 
-ap_manager_t* ap_pkgrid_manager_alloc(ap_manager_t* manpk, ap_manager_t* manpplgrid);
+ap_manager_t* ap_pkgrid_manager_alloc(ap_manager_t* manpk, ap_manager_t* mangrid);
   /* Allocates a product managaer (see ap_reducedproduct.h header file
 
     Returns NULL if manpk is not a polka manager for loose or strict
-    polyhedra, or if manpplgrid is not a PPL manager for grids.
+    polyhedra, or if mangrid is neither a PPL manager for grids nor a polka
+    manager for grids (pkgrid.h). With the latter, the product does not
+    depend on PPL.
 
     The given managers are copied (reference count incremented) in the
     result.  So, if the argument managers are not needed any more, they
@@ -0,0 +1,266 @@
+/* ************************************************************************* */
+/* ap_pkoct.c: reduced product of octagons and NewPolka polyhedra */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "ap_global0.h"
+#include "ap_reducedproduct.h"
+#include "ap_pkoct.h"
+
+#include "pk.h"
+
+/* The octagon is accessed through the functions of its manager, so that any
+   numerical type of the octagon library can be used. */
+
+static inline ap_manager_t* manoct_of(ap_manager_t* manager)
+{
+  return ((ap_reducedproduct_internal_t*)manager->internal)->tmanagers[0];
+}
+static inline ap_manager_t* manpk_of(ap_manager_t* manager)
+{
+  return ((ap_reducedproduct_internal_t*)manager->internal)->tmanagers[1];
+}
+
+/* Set the result flags of manager from the ones of man */
+static void ap_pkoct_result(ap_manager_t* manager, ap_manager_t* man)
+{
+  manager->result.flag_exact = man->result.flag_exact;
+  manager->result.flag_best = man->result.flag_best;
+}
+
+/* Reduce a if it is not and the option of funid asks for it.
+   Returns true if a is reduced. */
+static bool ap_pkoct_reduced(ap_manager_t* manager, ap_funid_t funid,
+			     ap_reducedproduct_t* a)
+{
+  if (a->reduced==false && manager->option.funopt[funid].algorithm & 0x1){
+    ap_pkoct_reduce(manager,a);
+    a->reduced = true;
+  }
+  return a->reduced;
+}
+
+void ap_pkoct_reduce(ap_manager_t* manager,
+		     ap_reducedproduct_t* a)
+{
+  ap_manager_t* manoct = manoct_of(manager);
+  ap_manager_t* manpk = manpk_of(manager);
+  void* oct = a->p[0];
+  pk_t* poly = (pk_t*)a->p[1];
+  ap_lincons0_array_t array;
+  ap_interval_t** box;
+  void* octbox;
+  ap_dimension_t dimension;
+
+  bool (*oct_is_bottom)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_IS_BOTTOM];
+  void (*oct_free)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_FREE];
+  void* (*oct_bottom)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_BOTTOM];
+  void* (*oct_of_box)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_OF_BOX];
+  void* (*oct_meet)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_MEET];
+  void* (*oct_meet_lincons_array)(ap_manager_t*,...) =
+    manoct->funptr[AP_FUNID_MEET_LINCONS_ARRAY];
+  ap_lincons0_array_t (*oct_to_lincons_array)(ap_manager_t*,...) =
+    manoct->funptr[AP_FUNID_TO_LINCONS_ARRAY];
+
+  dimension = pk_dimension(manpk,poly);
+
+  /* 1. Reduction from octagon to poly:
+     one adds the constraints of the octagon to poly */
+  if (oct_is_bottom(manoct,oct)){
+  ap_pkoct_reduce_exit1:
+    pk_free(manpk,poly);
+    poly = pk_bottom(manpk,dimension.intdim,dimension.realdim);
+    goto ap_pkoct_reduce_exit;
+  }
+  array = oct_to_lincons_array(manoct,oct);
+  if (array.size>0)
+    poly = pk_meet_lincons_array(manpk,true,poly,&array);
+  ap_lincons0_array_clear(&array);
+  if (pk_is_bottom(manpk,poly)){
+    oct_free(manoct,oct);
+    oct = oct_bottom(manoct,dimension.intdim,dimension.realdim);
+    goto ap_pkoct_reduce_exit;
+  }
+  /* 2. Reduction from poly to octagon:
+     one adds the constraints of poly (the octagonal ones exactly, the other
+     ones approximated by the octagon), and the bounds of poly, which are
+     then exact in the octagon. */
+  array = pk_to_lincons_array(manpk,poly);
+  if (array.size>0)
+    oct = oct_meet_lincons_array(manoct,true,oct,&array);
+  ap_lincons0_array_clear(&array);
+  box = pk_to_box(manpk,poly);
+  octbox = oct_of_box(manoct,dimension.intdim,dimension.realdim,box);
+  oct = oct_meet(manoct,true,oct,octbox);
+  oct_free(manoct,octbox);
+  ap_interval_array_free(box,dimension.intdim+dimension.realdim);
+  if (oct_is_bottom(manoct,oct)){
+    /* may happen with an octagon on floating-point numbers */
+    goto ap_pkoct_reduce_exit1;
+  }
+
+ ap_pkoct_reduce_exit:
+  a->p[0] = oct;
+  a->p[1] = poly;
+}
+
+void ap_pkoct_approximate(ap_manager_t* manager,
+			  ap_reducedproduct_t* a,
+			  int n)
+{
+  ap_manager_t* manpk = manpk_of(manager);
+  pk_approximate(manpk,(pk_t*)a->p[1],n);
+  ap_pkoct_reduce(manager,a);
+}
+
+/* ============================================================ */
+/* Tests and queries decided by the octagon */
+/* ============================================================ */
+
+/* The octagon contains the product, so that it decides emptiness if it is
+   empty. Once reduced, the octagon is empty iff the product is empty, and
+   has the same bounds. */
+
+static bool ap_pkoct_is_bottom(ap_manager_t* manager, ap_reducedproduct_t* a)
+{
+  ap_manager_t* manoct = manoct_of(manager);
+  bool (*oct_is_bottom)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_IS_BOTTOM];
+  bool res;
+
+  res = oct_is_bottom(manoct,a->p[0]);
+  if (res || ap_pkoct_reduced(manager,AP_FUNID_IS_BOTTOM,a)){
+    if (!res) res = oct_is_bottom(manoct,a->p[0]);
+    ap_pkoct_result(manager,manoct);
+    return res;
+  }
+  return ap_reducedproduct_is_bottom(manager,a);
+}
+
+static bool ap_pkoct_sat_interval(ap_manager_t* manager, ap_reducedproduct_t* a,
+				  ap_dim_t dim, ap_interval_t* interval)
+{
+  ap_manager_t* manoct = manoct_of(manager);
+  bool (*oct_sat_interval)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_SAT_INTERVAL];
+  bool res;
+
+  res = oct_sat_interval(manoct,a->p[0],dim,interval);
+  if (res || ap_pkoct_reduced(manager,AP_FUNID_SAT_INTERVAL,a)){
+    if (!res) res = oct_sat_interval(manoct,a->p[0],dim,interval);
+    ap_pkoct_result(manager,manoct);
+    return res;
+  }
+  return ap_reducedproduct_sat_interval(manager,a,dim,interval);
+}
+
+static ap_interval_t* ap_pkoct_bound_dimension(ap_manager_t* manager,
+					       ap_reducedproduct_t* a, ap_dim_t dim)
+{
+  ap_manager_t* manoct = manoct_of(manager);
+  ap_interval_t* (*oct_bound_dimension)(ap_manager_t*,...) =
+    manoct->funptr[AP_FUNID_BOUND_DIMENSION];
+  ap_interval_t* res;
+
+  if (ap_pkoct_reduced(manager,AP_FUNID_BOUND_DIMENSION,a)){
+    res = oct_bound_dimension(manoct,a->p[0],dim);
+    ap_pkoct_result(manager,manoct);
+    return res;
+  }
+  return ap_reducedproduct_bound_dimension(manager,a,dim);
+}
+
+/* a1 is included in a2 iff the polyhedron of a1 is included in the one of
+   a2, once both are reduced. Before, the inclusion of the bounds of the
+   octagons, exact for a1 and sound for a2, rejects most of the negative
+   cases without calling polka. A rejection is confirmed, with its flags, by
+   the bound of the polyhedron of a1, which is tight unlike the one of an
+   octagon on imprecise numbers. */
+static bool ap_pkoct_is_leq(ap_manager_t* manager,
+			    ap_reducedproduct_t* a1, ap_reducedproduct_t* a2)
+{
+  ap_manager_t* manoct = manoct_of(manager);
+  ap_manager_t* manpk = manpk_of(manager);
+  bool (*oct_is_bottom)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_IS_BOTTOM];
+  ap_interval_t** (*oct_to_box)(ap_manager_t*,...) = manoct->funptr[AP_FUNID_TO_BOX];
+  ap_dimension_t dimension;
+  ap_interval_t** box1;
+  ap_interval_t** box2;
+  size_t i,size;
+  ap_interval_t* itv;
+  bool res;
+
+  if (oct_is_bottom(manoct,a1->p[0])){
+    ap_pkoct_result(manager,manoct);
+    return true;
+  }
+  if (!ap_pkoct_reduced(manager,AP_FUNID_IS_LEQ,a1) ||
+      !ap_pkoct_reduced(manager,AP_FUNID_IS_LEQ,a2)){
+    return ap_reducedproduct_is_leq(manager,a1,a2);
+  }
+  if (oct_is_bottom(manoct,a1->p[0])){
+    ap_pkoct_result(manager,manoct);
+    return true;
+  }
+  dimension = pk_dimension(manpk,(pk_t*)a1->p[1]);
+  size = dimension.intdim+dimension.realdim;
+  box1 = oct_to_box(manoct,a1->p[0]);
+  box2 = oct_to_box(manoct,a2->p[0]);
+  res = true;
+  for (i=0; i<size; i++){
+    if (!ap_interval_is_leq(box1[i],box2[i])){
+      itv = pk_bound_dimension(manpk,(pk_t*)a1->p[1],i);
+      res = ap_interval_is_leq(itv,box2[i]);
+      ap_interval_free(itv);
+      break;
+    }
+  }
+  ap_interval_array_free(box1,size);
+  ap_interval_array_free(box2,size);
+  if (!res){
+    ap_pkoct_result(manager,manpk);
+    return false;
+  }
+  res = pk_is_leq(manpk,(pk_t*)a1->p[1],(pk_t*)a2->p[1]);
+  ap_pkoct_result(manager,manpk);
+  return res;
+}
+
+/* ============================================================ */
+/* Manager */
+/* ============================================================ */
+
+ap_manager_t* ap_pkoct_manager_alloc(ap_manager_t* manoct, ap_manager_t* manpk)
+{
+  ap_manager_t* tmanagers[2];
+  ap_manager_t* man;
+  bool strict;
+
+  strict = (strcmp(manpk->library,"polka, strict mode")==0);
+
+  if ( (strcmp(manpk->library,"polka, loose mode") && !strict) ||
+       strcmp(manoct->library,"oct") )
+    return NULL;
+
+  tmanagers[0] = manoct;
+  tmanagers[1] = manpk;
+  char* library = strict ?
+    "pkoct: oct and polka, strict mode" :
+    "pkoct: oct and polka, loose mode";
+
+  man = ap_reducedproduct_manager_alloc(library,
+					tmanagers,2,
+					&ap_pkoct_reduce,
+					&ap_pkoct_approximate);
+  man->funptr[AP_FUNID_IS_BOTTOM] = &ap_pkoct_is_bottom;
+  man->funptr[AP_FUNID_IS_LEQ] = &ap_pkoct_is_leq;
+  man->funptr[AP_FUNID_SAT_INTERVAL] = &ap_pkoct_sat_interval;
+  man->funptr[AP_FUNID_BOUND_DIMENSION] = &ap_pkoct_bound_dimension;
+  return man;
+}
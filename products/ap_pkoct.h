@@ -0,0 +1,61 @@
+/* ************************************************************************* */
+/* ap_pkoct.h: reduced product of octagons and NewPolka polyhedra */
+/* ************************************************************************* */
+
+/* This file is part of the APRON Library, released under LGPL license
+   with an exception allowing the redistribution of statically linked
+   executables.
+
+   Please read the COPYING file packaged in the distribution */
+
+#ifndef _AP_PKOCT_H_
+#define _AP_PKOCT_H_
+
+#include "ap_reducedproduct.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+ap_manager_t* ap_pkoct_manager_alloc(ap_manager_t* manoct, ap_manager_t* manpk);
+  /* Allocates a product manager (see ap_reducedproduct.h header file),
+     the octagon being the first component and the polyhedron the second.
+
+     Returns NULL if manoct is not an octagon manager, or if manpk is not a
+     polka manager for loose or strict polyhedra.
+
+     The given managers are copied (reference count incremented) in the
+     result.  So, if the argument managers are not needed any more, they
+     should be freed with ap_manager_free.
+
+     is_bottom, sat_interval and bound_dimension are answered by the
+     octagon when it can decide, without reducing the product. is_leq
+     rejects with the bounds of the octagons before testing the inclusion
+     of the polyhedra. Such a rejection is checked against the bound of the
+     polyhedron of the first argument, and has the flags of that bound.
+  */
+
+void ap_pkoct_reduce(ap_manager_t* manager,
+		     ap_reducedproduct_t* a);
+  /* Reduction function between the two domains.
+
+     The constraints of the octagon are added to the polyhedron, then the
+     constraints and the bounds of the polyhedron are added to the octagon.
+     Once reduced, the octagon has the exact bounds of the product, and is
+     empty if the product is empty.
+  */
+
+void ap_pkoct_approximate(ap_manager_t* manager,
+			  ap_reducedproduct_t* a,
+			  int n);
+  /* Approximation function.
+
+     It consists in apply approximate to the Polka polyhedron, with the
+     argument n, and reducing the result.
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
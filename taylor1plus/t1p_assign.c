@@ -59,7 +59,7 @@ t1p_t* t1p_substitute_linexpr_array(ap_manager_t* man,
 }
 
 /* evaluate an apron tree expression */
-/* TODO: dest and destructive are not used */
+/* TODO: dest is not used */
 t1p_t* t1p_assign_texpr_array(ap_manager_t* man,
 			      bool destructive,
 			      t1p_t* a,
@@ -69,12 +69,15 @@ t1p_t* t1p_assign_texpr_array(ap_manager_t* man,
 			      t1p_t* dest)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_ASSIGN_TEXPR_ARRAY);
     /*
      * NOTA: si on initialise "pr" avant la copie, le pr contiendra la fonction "copy".
      * en mettant la copie avant, on s'assure que le pr contiendra reellement le bon funid.
      */
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_ASSIGN_TEXPR_ARRAY);
+    pr->sdpmul = man->option.funopt[AP_FUNID_ASSIGN_TEXPR_ARRAY].algorithm == INT_MAX;
     size_t i = 0;
+    t1p_aff_t* aff;
 #ifdef _T1P_DEBUG
     fprintf(stdout, "### ASSIGN TEXPR ARRAY (des %d) %tx ###\n", destructive,(intptr_t)a);
     //t1p_fprint(stdout, man, a, NULL);
@@ -88,26 +91,34 @@ t1p_t* t1p_assign_texpr_array(ap_manager_t* man,
     for (i=0; i<res->dims; i++) itv_set(res->paf[i]->itv, res->box[i]);
     for (i=0; i<size; i++) {
 	t1p_aff_check_free(pr, res->paf[tdim[i]]);
-	res->paf[tdim[i]] = t1p_aff_eval_ap_texpr0(pr, texpr[i], a);
-	t1p_aff_reduce(pr, res->paf[tdim[i]]);
-	if (t1p_aff_is_top(pr, res->paf[tdim[i]])) {
-	    t1p_aff_check_free(pr, res->paf[tdim[i]]);
-	    res->paf[tdim[i]] = pr->top;
-	} else if (t1p_aff_is_bottom(pr, res->paf[tdim[i]])) {
-	    t1p_aff_check_free(pr, res->paf[tdim[i]]);
-	    res->paf[tdim[i]] = pr->bot;
+	aff = t1p_aff_eval_ap_texpr0(pr, texpr[i], a);
+	/* the form of a variable is returned with a reference already taken,
+	   it is counted once below like any other form */
+	if (texpr[i]->discr == AP_TEXPR_DIM) aff->pby--;
+	t1p_aff_reduce(pr, aff);
+	/* a shared form is left untouched and a condensed copy is returned */
+	aff = t1p_aff_condense(pr, aff, res);
+	if (t1p_aff_is_top(pr, aff)) {
+	    if (aff->pby == 0) t1p_aff_check_free(pr, aff);
+	    aff = pr->top;
+	} else if (t1p_aff_is_bottom(pr, aff)) {
+	    if (aff->pby == 0) t1p_aff_check_free(pr, aff);
+	    aff = pr->bot;
 	}
+	res->paf[tdim[i]] = aff;
 	itv_set(res->box[tdim[i]],res->paf[tdim[i]]->itv);
 	res->paf[tdim[i]]->pby++;
     }
     /* TODO: mettre top pour le moment */
     man->result.flag_best = tbool_top;
     man->result.flag_exact = tbool_top;
+    if (destructive) t1p_free(man, a);
 #ifdef _T1P_DEBUG
     fprintf(stdout, "### RESULT OF ASSIGN TEXPR ARRAY (des %d) [%tx] ###\n", destructive, (intptr_t)res);
     t1p_fprint(stdout, man, res, NULL);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
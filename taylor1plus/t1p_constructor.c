@@ -152,6 +152,7 @@ tbool_t t1p_is_eq(ap_manager_t* man, t1p_t* a, t1p_t* b)
 tbool_t t1p_is_leq(ap_manager_t* man, t1p_t* a, t1p_t* b)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_IS_LEQ);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_IS_LEQ);
     arg_assert(a && b && (a->dims == b->dims), abort(););
 #ifdef _T1P_DEBUG
@@ -234,6 +235,7 @@ tbool_t t1p_is_leq(ap_manager_t* man, t1p_t* a, t1p_t* b)
     fprintf(stdout, "### RESULT of IS LESS or EQUAL ###\n");
     fprintf(stdout, "### %d ###\n",res);
 #endif
+    T1P_TRACE_END(pr, a->dims);
     return res;
 }
 
@@ -284,7 +286,6 @@ ap_interval_t* t1p_bound_dimension(ap_manager_t* man, t1p_t* a, ap_dim_t dim)
     //ap_interval_set_itv(pr->itv, ap_itv, tmp);
     ap_interval_set_itv(pr->itv, ap_itv, a->box[dim]);
     //itv_clear(tmp);
-    ap_interval_free(ap_itv);
     return ap_itv;
 }
 
@@ -19,78 +19,59 @@
 
 #include "ap_texpr0.h"
 #include "t1p_fun.h"
+#include "t1p_sdp.h"
 
 
 	/* pseudo-taken from http://kiwi.emse.fr/POLE/SDA/corr-iset.html */
-	/* we initialize p,q with the head of each list :
-	 * - if p and q are null pointers, we reach the halt condition;
-	 * - if one of p or q is a null pointer, we copy the non null list;
-	 * - else, p and q are non null pointers :
-	 *   - if nsym_index p = nsym_index q then 
+	/* we initialize i,j with the head of each array of terms :
+	 * - if i and j reached the end of the arrays, we reach the halt condition;
+	 * - if one of i or j reached the end, we copy the remaining terms of the other;
+	 * - else :
+	 *   - if nsym_index i = nsym_index j then 
 	 *    * add coeff, 
 	 *    * copy the index, 
-	 *    * increment p and q to p->next and q->next respectively.
-	 *   - if nsym_index p < nsymindex q then
-	 *    * copy coeff and nsym_index of p,
-	 *    * increment p.
+	 *    * increment i and j.
+	 *   - if nsym_index i < nsymindex j then
+	 *    * copy coeff and nsym_index of i,
+	 *    * increment i.
 	 *   - else :
-	 *    * copy coeff and nsym_index of q,
-	 *    * increment q.
+	 *    * copy coeff and nsym_index of j,
+	 *    * increment j.
+	 * The terms are written in place at the end of the result; a null
+	 * coefficient is simply overwritten by the next term.
 	 */
 t1p_aff_t* t1p_aff_add(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t1p_t* abs)
 {
     itv_t box; itv_init(box);
     itv_t tmp; itv_init(tmp);
     t1p_aff_t* res = t1p_aff_alloc_init(pr);
-    t1p_aaterm_t *p, *q, *ptr;
+    uint_t i, j, index;
     itv_add(res->c, exprA->c, exprB->c);
     itv_set(box, res->c);
-    if (exprA->q || exprB->q) {
-	ptr = t1p_aaterm_alloc_init();
-	for(p = exprA->q, q = exprB->q; p || q;) {
-	    if (p && q) {
-		if (p->pnsym->index == q->pnsym->index) {
-		    itv_add(ptr->coeff, p->coeff, q->coeff);
-		    ptr->pnsym = p->pnsym;
-		    p = p->n ;
-		    q = q->n ;
-		} else if (p->pnsym->index < q->pnsym->index) {
-		    itv_set(ptr->coeff, p->coeff);
-		    ptr->pnsym = p->pnsym;
-		    p = p->n ;
-		} else {
-		    itv_set(ptr->coeff, q->coeff);
-		    ptr->pnsym = q->pnsym;
-		    q = q->n ;
-		}
-	    } else if (p) {
-		itv_set(ptr->coeff, p->coeff);
-		ptr->pnsym = p->pnsym;
-		p = p->n ;
+    if (exprA->l || exprB->l) {
+	t1p_aff_reserve(pr, res, exprA->l + exprB->l);
+	for (i = 0, j = 0; i < exprA->l || j < exprB->l;) {
+	    if (i < exprA->l && j < exprB->l && exprA->index[i] == exprB->index[j]) {
+		itv_add(res->coeff[res->l], exprA->coeff[i], exprB->coeff[j]);
+		index = exprA->index[i];
+		i++;
+		j++;
+	    } else if (j == exprB->l || (i < exprA->l && exprA->index[i] < exprB->index[j])) {
+		itv_set(res->coeff[res->l], exprA->coeff[i]);
+		index = exprA->index[i];
+		i++;
 	    } else {
-		itv_set(ptr->coeff, q->coeff);
-		ptr->pnsym = q->pnsym;
-		q = q->n ;
+		itv_set(res->coeff[res->l], exprB->coeff[j]);
+		index = exprB->index[j];
+		j++;
 	    }
-	    if (itv_is_zero(ptr->coeff)) {
-		if (!(p||q)) {
-		    /* the last iteration */
-		    t1p_aaterm_free(pr, ptr);
-		    if (res->end) res->end->n = NULL;
-		}
-	    } else {
+	    if (!itv_is_zero(res->coeff[res->l])) {
 		/* keep this term */
-		if (!res->q) res->q = ptr;
-		res->end = ptr;
-		res->l++;
-		t1p_nsymcons_get_gamma(pr, tmp, ptr->pnsym->index, abs);
-		itv_mul(pr->itv, tmp, tmp, ptr->coeff);
+		res->index[res->l] = index;
+		t1p_nsymcons_get_gamma(pr, tmp, index, abs);
+		itv_mul(pr->itv, tmp, tmp, res->coeff[res->l]);
 		itv_add(box, box, tmp);
-		if (p||q) {
-		    /* continuing */
-		    ptr->n = t1p_aaterm_alloc_init();
-		    ptr=ptr->n;
-		}
+		res->l++;
 	    }
 	}
     }
@@ -106,58 +87,34 @@ t1p_aff_t* t1p_aff_sub(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t
     itv_t box; itv_init(box);
     itv_t tmp; itv_init(tmp);
     t1p_aff_t* res = t1p_aff_alloc_init(pr);
-    t1p_aaterm_t *p, *q, *ptr;
+    uint_t i, j, index;
     if (!itv_is_eq(exprA->c, exprB->c)) itv_sub(res->c, exprA->c, exprB->c);
     itv_set(box, res->c);
-    if (exprA->q || exprB->q) {
-	ptr = t1p_aaterm_alloc_init();
-	for(p = exprA->q, q = exprB->q; p || q;) {
-	    if (p && q) {
-		if (p->pnsym->index == q->pnsym->index) {
-		    if (!itv_is_eq(p->coeff, q->coeff)) itv_sub(ptr->coeff, p->coeff, q->coeff);
-		    ptr->pnsym = p->pnsym;
-		    p = p->n ;
-		    q = q->n ;
-		} else if (p->pnsym->index < q->pnsym->index) {
-		    itv_set(ptr->coeff, p->coeff);
-		    ptr->pnsym = p->pnsym;
-		    p = p->n ;
-		} else {
-		    itv_neg(ptr->coeff, q->coeff);
-		    ptr->pnsym = q->pnsym;
-		    q = q->n ;
-		}
-	    } else if (p) {
-		itv_set(ptr->coeff, p->coeff);
-		ptr->pnsym = p->pnsym;
-		p = p->n ;
+    if (exprA->l || exprB->l) {
+	t1p_aff_reserve(pr, res, exprA->l + exprB->l);
+	for (i = 0, j = 0; i < exprA->l || j < exprB->l;) {
+	    if (i < exprA->l && j < exprB->l && exprA->index[i] == exprB->index[j]) {
+		if (!itv_is_eq(exprA->coeff[i], exprB->coeff[j])) itv_sub(res->coeff[res->l], exprA->coeff[i], exprB->coeff[j]);
+		else itv_set_int(res->coeff[res->l], 0);
+		index = exprA->index[i];
+		i++;
+		j++;
+	    } else if (j == exprB->l || (i < exprA->l && exprA->index[i] < exprB->index[j])) {
+		itv_set(res->coeff[res->l], exprA->coeff[i]);
+		index = exprA->index[i];
+		i++;
 	    } else {
-		itv_neg(ptr->coeff, q->coeff);
-		ptr->pnsym = q->pnsym;
-		q = q->n ;
+		itv_neg(res->coeff[res->l], exprB->coeff[j]);
+		index = exprB->index[j];
+		j++;
 	    }
-	    if (itv_is_zero(ptr->coeff)) {
-		if (!(p||q)) {
-		    /* the last iteration */
-		    t1p_aaterm_free(pr, ptr);
-		    if (res->end) res->end->n = NULL;
-		}
-	    } else {
+	    if (!itv_is_zero(res->coeff[res->l])) {
 		/* keep this term */
-		if (!res->q) res->q = ptr;
-		res->end = ptr;
-		res->l++;
-		t1p_nsymcons_get_gamma(pr, tmp, ptr->pnsym->index, abs);
-		itv_mul(pr->itv, tmp, tmp, ptr->coeff);
+		res->index[res->l] = index;
+		t1p_nsymcons_get_gamma(pr, tmp, index, abs);
+		itv_mul(pr->itv, tmp, tmp, res->coeff[res->l]);
 		itv_add(box, box, tmp);
-		if (p||q) {
-		    /* continuing */
-		    ptr->n = t1p_aaterm_alloc_init();
-		    ptr=ptr->n;
-		} else {
-		    /* the last iteration */
-		    ptr->n = NULL;
-		}
+		res->l++;
 	    }
 	}
     }
@@ -178,26 +135,14 @@ t1p_aff_t* t1p_aff_mul_itv(t1p_internal_t* pr, t1p_aff_t* src, itv_t lambda)
 	return t1p_aff_top(pr);
     } else {
 	t1p_aff_t* dst = NULL;
-	t1p_aaterm_t *p,*q;
-	q = NULL;
+	uint_t p;
 	dst = t1p_aff_alloc_init(pr);
 	itv_mul(pr->itv, dst->c, lambda, src->c);
-	if (src->q) {
-	    dst->q = q = t1p_aaterm_alloc_init();
-	    for (p=src->q; p; p=p->n) {
-		/*if (p == src->lastu) {
-		    dst->lastu = q;
-		}*/
-		itv_mul(pr->itv, q->coeff, lambda, p->coeff);
-		q->pnsym = p->pnsym;
-		if (p->n) {
-		    /* continue */
-		    q->n = t1p_aaterm_alloc_init();
-		    q = q->n;
-		} else {
-		    /* the last iteration */
-		    dst->end = q; 
-		}
+	if (src->l) {
+	    t1p_aff_reserve(pr, dst, src->l);
+	    memcpy(dst->index, src->index, src->l*sizeof(uint_t));
+	    for (p=0; p<src->l; p++) {
+		itv_mul(pr->itv, dst->coeff[p], lambda, src->coeff[p]);
 	    }
 	}
 	dst->l = src->l;
@@ -217,10 +162,10 @@ void t1p_aff_mul_itv_inplace(t1p_internal_t* pr, t1p_aff_t* exprA, itv_t lambda)
 	t1p_aff_check_free(pr, exprA);
 	exprA = t1p_aff_top(pr);
     } else {
-	t1p_aaterm_t *p;
+	uint_t p;
 	itv_mul(pr->itv, exprA->c, exprA->c, lambda);
-	for (p=exprA->q; p; p=p->n) {
-	    itv_mul(pr->itv, p->coeff, p->coeff, lambda);
+	for (p=0; p<exprA->l; p++) {
+	    itv_mul(pr->itv, exprA->coeff[p], exprA->coeff[p], lambda);
 	}
 	itv_mul(pr->itv, exprA->itv, exprA->itv, lambda);
     }
@@ -249,7 +194,8 @@ t1p_aff_t* t1p_aff_mul(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t
 t1p_aff_t* t1p_aff_mul_constrained_backup(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t1p_t* env)
 {
     t1p_aff_t* res = t1p_aff_alloc_init(pr);
-    t1p_aaterm_t *p, *q, *ptr;
+    uint_t p, q;
+    t1p_aaterm_t *ptr;
     itv_t itv_nlin; itv_init(itv_nlin);
     int i = 0;
     int SDP_dim = 0;
@@ -291,105 +237,100 @@ t1p_aff_t* t1p_aff_mul_constrained_backup(t1p_internal_t* pr, t1p_aff_t* exprA,
     checked_malloc(nsym_shared_hash,int,2+pr->dim,abort(););
     ap_dim_t abs_dim = 0;
 
-    if (exprA->q || exprB->q) {
-	res->q = ptr = t1p_aaterm_alloc_init();
-	res->l++;
+    if (exprA->l || exprB->l) {
+	t1p_aff_reserve(pr, res, exprA->l + exprB->l);
+	ptr = t1p_aaterm_alloc_init();
 	/* linear part */
-	for(p = exprA->q, q = exprB->q; p || q;) {
+	for (p = 0, q = 0; p < exprA->l || q < exprB->l;) {
 	    dim += 1;	/* computes the number of different noise symbols */
-	    if (p && q) {
-		if (p->pnsym->index == q->pnsym->index) {
-		    itv_mul(pr->itv, tmp[3], p->coeff, mid2);
-		    itv_mul(pr->itv, tmp[4], q->coeff, mid1);
+	    if (p < exprA->l && q < exprB->l) {
+		if (exprA->index[p] == exprB->index[q]) {
+		    itv_mul(pr->itv, tmp[3], exprA->coeff[p], mid2);
+		    itv_mul(pr->itv, tmp[4], exprB->coeff[q], mid1);
 		    itv_add(ptr->coeff, tmp[3], tmp[4]);
-		    ptr->pnsym = p->pnsym;
-		    hash[p->pnsym->index] = dim;
-		    nsym_shared[p->pnsym->index] = true;
+		    ptr->pnsym = pr->epsilon[exprA->index[p]];
+		    hash[exprA->index[p]] = dim;
+		    nsym_shared[exprA->index[p]] = true;
 		    SDP_dim++;
-		    nsym_shared_hash[p->pnsym->index] = SDP_dim;
-		    if (env->hypercube) itv_set(gammabis[p->pnsym->index], pr->muu);
+		    nsym_shared_hash[exprA->index[p]] = SDP_dim;
+		    if (env->hypercube) itv_set(gammabis[exprA->index[p]], pr->muu);
 		    else {
-			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, p->pnsym->index, env)) {
+			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprA->index[p], env)) {
 			    itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			    itv_middev(pr->itv, midi, devi, eps_itv);
-			    itv_sub(gammabis[p->pnsym->index], eps_itv, midi);
+			    itv_sub(gammabis[exprA->index[p]], eps_itv, midi);
 			} else {
-			    itv_set(gammabis[p->pnsym->index], pr->muu);
+			    itv_set(gammabis[exprA->index[p]], pr->muu);
 			}
 		    }
-		    p = p->n ;
-		    q = q->n ;
-		} else if (p->pnsym->index < q->pnsym->index) {
-		    itv_mul(pr->itv, ptr->coeff, p->coeff, mid2);
-		    ptr->pnsym = p->pnsym;
-		    hash[p->pnsym->index] = dim;
-		    if (env->hypercube) itv_set(gammabis[p->pnsym->index], pr->muu);
+		    p++;
+		    q++;
+		} else if (exprA->index[p] < exprB->index[q]) {
+		    itv_mul(pr->itv, ptr->coeff, exprA->coeff[p], mid2);
+		    ptr->pnsym = pr->epsilon[exprA->index[p]];
+		    hash[exprA->index[p]] = dim;
+		    if (env->hypercube) itv_set(gammabis[exprA->index[p]], pr->muu);
 		    else {
-			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, p->pnsym->index, env)) {
+			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprA->index[p], env)) {
 			    itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			    itv_middev(pr->itv, midi, devi, eps_itv);
-			    itv_sub(gammabis[p->pnsym->index], eps_itv, midi);
+			    itv_sub(gammabis[exprA->index[p]], eps_itv, midi);
 			} else {
-			    itv_set(gammabis[p->pnsym->index], pr->muu);
+			    itv_set(gammabis[exprA->index[p]], pr->muu);
 			}
 		    }
-		    p = p->n ;
+		    p++;
 		} else {
-		    itv_mul(pr->itv, ptr->coeff, q->coeff, mid1);
-		    ptr->pnsym = q->pnsym;
-		    hash[q->pnsym->index] = dim;
-		    if (env->hypercube) itv_set(gammabis[q->pnsym->index], pr->muu);
+		    itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], mid1);
+		    ptr->pnsym = pr->epsilon[exprB->index[q]];
+		    hash[exprB->index[q]] = dim;
+		    if (env->hypercube) itv_set(gammabis[exprB->index[q]], pr->muu);
 		    else {
-			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, q->pnsym->index, env)) {
+			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprB->index[q], env)) {
 			    itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			    itv_middev(pr->itv, midi, devi, eps_itv);
-			    itv_sub(gammabis[q->pnsym->index], eps_itv, midi);
+			    itv_sub(gammabis[exprB->index[q]], eps_itv, midi);
 			} else {
-			    itv_set(gammabis[q->pnsym->index], pr->muu);
+			    itv_set(gammabis[exprB->index[q]], pr->muu);
 			}
 		    }
-		    q = q->n ;
+		    q++;
 		}
-	    } else if (p) {
-		itv_mul(pr->itv, ptr->coeff, p->coeff, exprB->c);
-		ptr->pnsym = p->pnsym;
-		hash[p->pnsym->index] = dim;
-		if (env->hypercube) itv_set(gammabis[p->pnsym->index], pr->muu);
+	    } else if (p < exprA->l) {
+		itv_mul(pr->itv, ptr->coeff, exprA->coeff[p], exprB->c);
+		ptr->pnsym = pr->epsilon[exprA->index[p]];
+		hash[exprA->index[p]] = dim;
+		if (env->hypercube) itv_set(gammabis[exprA->index[p]], pr->muu);
 		else {
-		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, p->pnsym->index, env)) {
+		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprA->index[p], env)) {
 			itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			itv_middev(pr->itv, midi, devi, eps_itv);
-			itv_sub(gammabis[p->pnsym->index], eps_itv, midi);
+			itv_sub(gammabis[exprA->index[p]], eps_itv, midi);
 		    } else {
-			itv_set(gammabis[p->pnsym->index], pr->muu);
+			itv_set(gammabis[exprA->index[p]], pr->muu);
 		    }
 		}
-		p = p->n ;
+		p++;
 	    } else {
-		itv_mul(pr->itv, ptr->coeff, q->coeff, exprA->c);
-		ptr->pnsym = q->pnsym;
-		hash[q->pnsym->index] = dim;
-		if (env->hypercube) itv_set(gammabis[q->pnsym->index], pr->muu);
+		itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], exprA->c);
+		ptr->pnsym = pr->epsilon[exprB->index[q]];
+		hash[exprB->index[q]] = dim;
+		if (env->hypercube) itv_set(gammabis[exprB->index[q]], pr->muu);
 		else {
-		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, q->pnsym->index, env)) {
+		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprB->index[q], env)) {
 			itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			itv_middev(pr->itv, midi, devi, eps_itv);
-			itv_sub(gammabis[q->pnsym->index], eps_itv, midi);
+			itv_sub(gammabis[exprB->index[q]], eps_itv, midi);
 		    } else {
-			itv_set(gammabis[q->pnsym->index], pr->muu);
+			itv_set(gammabis[exprB->index[q]], pr->muu);
 		    }
 		}
-		q = q->n ;
-	    }
-	    /* we don't create a new aaterm if p and q are null */
-	    if (p||q) {
-		ptr->n = t1p_aaterm_alloc_init();
-		res->l++;
-		ptr=ptr->n;
+		q++;
 	    }
+	    /* every term is kept, even with a null coefficient */
+	    t1p_aff_build(pr, res, ptr->coeff, ptr->pnsym->index);
 	}
-	ptr->n = NULL;
-	res->end = ptr;
+	t1p_aaterm_free(pr, ptr);
     }
     /* non linear part */
     /* Calling SDP solver (non guaranteed):
@@ -398,16 +339,15 @@ t1p_aff_t* t1p_aff_mul_constrained_backup(t1p_internal_t* pr, t1p_aff_t* exprA,
      * - objectif matrix (in primal form) is a 2 block matrix of dimension 2n. First block is deduced from the non linear (quadric) part of multiplication, we zero all values of the second block,
      * - objective vector (in dual form) is a one vector of dimension "n".
      */
-    if (exprA->q && exprB->q) {
-	ap_funopt_t option = ap_manager_get_funopt(pr->man, pr->funid);
-	cond_SDP = option.algorithm == INT_MAX ? true : false;
+    if (exprA->l && exprB->l) {
+	cond_SDP = pr->sdpmul;
 	itv_t itv1; itv_init(itv1);
 	itv_t itv2; itv_init(itv2);
 	if (cond_SDP) { 
-	    call_sdp(pr->itv, itv1, exprA->q, exprB->q, dim, hash, true);
+	    call_sdp(pr, itv1, exprA, exprB, dim, hash, true);
 	}
 	else 
-	    square_dep(pr, itv2, exprA->q, exprB->q, hash, dim, gammabis);
+	    square_dep(pr, itv2, exprA, exprB, hash, dim, gammabis);
 	if (exprA == exprB) {
 	    if (bound_sgn(itv1->inf) > 0) {bound_set_int(itv1->inf,0);}
 	    if (bound_sgn(itv2->inf) > 0) {bound_set_int(itv2->inf,0);}
@@ -434,7 +374,8 @@ t1p_aff_t* t1p_aff_mul_constrained_backup(t1p_internal_t* pr, t1p_aff_t* exprA,
 t1p_aff_t* t1p_aff_mul_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t1p_t* env)
 {
     t1p_aff_t* res = t1p_aff_alloc_init(pr);
-    t1p_aaterm_t *p, *q, *ptr;
+    uint_t p, q;
+    t1p_aaterm_t *ptr;
     itv_t itv_nlin; itv_init(itv_nlin);
     int i = 0;
     int SDP_dim = 0;
@@ -484,124 +425,111 @@ t1p_aff_t* t1p_aff_mul_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff
     checked_malloc(nsym_shared_hash,int,2+pr->dim,abort(););
     ap_dim_t abs_dim = 0;
 
-    if (exprA->q || exprB->q) {
+    if (exprA->l || exprB->l) {
+	t1p_aff_reserve(pr, res, exprA->l + exprB->l);
 	ptr = t1p_aaterm_alloc_init();
 	//res->l++;
 	/* linear part */
-	for(p = exprA->q, q = exprB->q; p || q;) {
+	for (p = 0, q = 0; p < exprA->l || q < exprB->l;) {
 	    dim += 1;	/* computes the number of different noise symbols */
-	    if (p && q) {
-		if (p->pnsym->index == q->pnsym->index) {
-		    itv_mul(pr->itv, tmp[3], p->coeff, mid2);
-		    itv_mul(pr->itv, tmp[4], q->coeff, mid1);
+	    if (p < exprA->l && q < exprB->l) {
+		if (exprA->index[p] == exprB->index[q]) {
+		    itv_mul(pr->itv, tmp[3], exprA->coeff[p], mid2);
+		    itv_mul(pr->itv, tmp[4], exprB->coeff[q], mid1);
 		    itv_add(ptr->coeff, tmp[3], tmp[4]);
-		    ptr->pnsym = p->pnsym;
-		    hash[p->pnsym->index] = dim;
-		    nsym_shared[p->pnsym->index] = true;
+		    ptr->pnsym = pr->epsilon[exprA->index[p]];
+		    hash[exprA->index[p]] = dim;
+		    nsym_shared[exprA->index[p]] = true;
 		    SDP_dim++;
-		    nsym_shared_hash[p->pnsym->index] = SDP_dim;
-		    if (env->hypercube) itv_set(gammabis[p->pnsym->index], pr->muu);
+		    nsym_shared_hash[exprA->index[p]] = SDP_dim;
+		    if (env->hypercube) itv_set(gammabis[exprA->index[p]], pr->muu);
 		    else {
-			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, p->pnsym->index, env)) {
+			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprA->index[p], env)) {
 			    itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			    itv_middev(pr->itv, midi, devi, eps_itv);
-			    itv_sub(gammabis[p->pnsym->index], eps_itv, midi);
+			    itv_sub(gammabis[exprA->index[p]], eps_itv, midi);
 			} else {
-			    itv_set(gammabis[p->pnsym->index], pr->muu);
+			    itv_set(gammabis[exprA->index[p]], pr->muu);
 			    itv_set(eps_itv,pr->muu);
 			}
 		    }
-		    p = p->n ;
-		    q = q->n ;
-		} else if (p->pnsym->index < q->pnsym->index) {
-		    itv_mul(pr->itv, ptr->coeff, p->coeff, mid2);
-		    ptr->pnsym = p->pnsym;
-		    hash[p->pnsym->index] = dim;
-		    if (env->hypercube) itv_set(gammabis[p->pnsym->index], pr->muu);
+		    p++;
+		    q++;
+		} else if (exprA->index[p] < exprB->index[q]) {
+		    itv_mul(pr->itv, ptr->coeff, exprA->coeff[p], mid2);
+		    ptr->pnsym = pr->epsilon[exprA->index[p]];
+		    hash[exprA->index[p]] = dim;
+		    if (env->hypercube) itv_set(gammabis[exprA->index[p]], pr->muu);
 		    else {
-			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, p->pnsym->index, env)) {
+			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprA->index[p], env)) {
 			    itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			    itv_middev(pr->itv, midi, devi, eps_itv);
-			    itv_sub(gammabis[p->pnsym->index], eps_itv, midi);
+			    itv_sub(gammabis[exprA->index[p]], eps_itv, midi);
 			} else {
-			    itv_set(gammabis[p->pnsym->index], pr->muu);
+			    itv_set(gammabis[exprA->index[p]], pr->muu);
 			    itv_set(eps_itv,pr->muu);
 			}
 		    }
-		    p = p->n ;
+		    p++;
 		} else {
-		    itv_mul(pr->itv, ptr->coeff, q->coeff, mid1);
-		    ptr->pnsym = q->pnsym;
-		    hash[q->pnsym->index] = dim;
-		    if (env->hypercube) itv_set(gammabis[q->pnsym->index], pr->muu);
+		    itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], mid1);
+		    ptr->pnsym = pr->epsilon[exprB->index[q]];
+		    hash[exprB->index[q]] = dim;
+		    if (env->hypercube) itv_set(gammabis[exprB->index[q]], pr->muu);
 		    else {
-			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, q->pnsym->index, env)) {
+			if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprB->index[q], env)) {
 			    itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			    itv_middev(pr->itv, midi, devi, eps_itv);
-			    itv_sub(gammabis[q->pnsym->index], eps_itv, midi);
+			    itv_sub(gammabis[exprB->index[q]], eps_itv, midi);
 			} else {
-			    itv_set(gammabis[q->pnsym->index], pr->muu);
+			    itv_set(gammabis[exprB->index[q]], pr->muu);
 			    itv_set(eps_itv,pr->muu);
 			}
 		    }
-		    q = q->n ;
+		    q++;
 		}
-	    } else if (p) {
-		itv_mul(pr->itv, ptr->coeff, p->coeff, mid2);
-		ptr->pnsym = p->pnsym;
-		hash[p->pnsym->index] = dim;
-		if (env->hypercube) itv_set(gammabis[p->pnsym->index], pr->muu);
+	    } else if (p < exprA->l) {
+		itv_mul(pr->itv, ptr->coeff, exprA->coeff[p], mid2);
+		ptr->pnsym = pr->epsilon[exprA->index[p]];
+		hash[exprA->index[p]] = dim;
+		if (env->hypercube) itv_set(gammabis[exprA->index[p]], pr->muu);
 		else {
-		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, p->pnsym->index, env)) {
+		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprA->index[p], env)) {
 			itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			itv_middev(pr->itv, midi, devi, eps_itv);
-			itv_sub(gammabis[p->pnsym->index], eps_itv, midi);
+			itv_sub(gammabis[exprA->index[p]], eps_itv, midi);
 		    } else {
-			itv_set(gammabis[p->pnsym->index], pr->muu);
+			itv_set(gammabis[exprA->index[p]], pr->muu);
 			itv_set(eps_itv,pr->muu);
 		    }
 		}
-		p = p->n ;
+		p++;
 	    } else {
-		itv_mul(pr->itv, ptr->coeff, q->coeff, mid1);
-		ptr->pnsym = q->pnsym;
-		hash[q->pnsym->index] = dim;
-		if (env->hypercube) itv_set(gammabis[q->pnsym->index], pr->muu);
+		itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], mid1);
+		ptr->pnsym = pr->epsilon[exprB->index[q]];
+		hash[exprB->index[q]] = dim;
+		if (env->hypercube) itv_set(gammabis[exprB->index[q]], pr->muu);
 		else {
-		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, q->pnsym->index, env)) {
+		    if (t1p_nsymcons_get_dimpos(pr, &abs_dim, exprB->index[q], env)) {
 			itv_set_ap_interval(pr->itv, eps_itv, env->gamma[abs_dim]);
 			itv_middev(pr->itv, midi, devi, eps_itv);
-			itv_sub(gammabis[q->pnsym->index], eps_itv, midi);
+			itv_sub(gammabis[exprB->index[q]], eps_itv, midi);
 		    } else {
-			itv_set(gammabis[q->pnsym->index], pr->muu);
+			itv_set(gammabis[exprB->index[q]], pr->muu);
 			itv_set(eps_itv,pr->muu);
 		    }
 		}
-		q = q->n ;
+		q++;
 	    }
-	    if (itv_is_zero(ptr->coeff)) {
-		if (!(p||q)) {
-		    /* the last iteration */
-		    t1p_aaterm_free(pr, ptr);
-		    if (res->end) res->end->n = NULL;
-		}
-	    } else {
+	    if (!itv_is_zero(ptr->coeff)) {
 		/* keep this term */
-		if (!res->q) res->q = ptr;
-		res->end = ptr;
-		res->l++;
+		t1p_aff_nsym_add(pr, res, ptr->coeff, ptr->pnsym);
 		itv_mul(pr->itv, eps_itv, eps_itv, ptr->coeff);
 		itv_add(res->itv, res->itv, eps_itv);
-		if (p||q) {
-		    /* continuing */
-		    ptr->n = t1p_aaterm_alloc_init();
-		    ptr=ptr->n;
-		} else {
-		    /* the last iteration */
-		    ptr->n = NULL;
-		}
+		itv_set_int(ptr->coeff, 0);
 	    }
 	}
+	t1p_aaterm_free(pr, ptr);
     }
     /* non linear part */
     /* Calling SDP solver (non guaranteed):
@@ -610,16 +538,15 @@ t1p_aff_t* t1p_aff_mul_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff
      * - objectif matrix (in primal form) is a 2 block matrix of dimension 2n. First block is deduced from the non linear (quadric) part of multiplication, we zero all values of the second block,
      * - objective vector (in dual form) is a one vector of dimension "n".
      */
-    if (exprA->q && exprB->q) {
-	ap_funopt_t option = ap_manager_get_funopt(pr->man, pr->funid);
-	cond_SDP = option.algorithm == INT_MAX ? true : false;
+    if (exprA->l && exprB->l) {
+	cond_SDP = pr->sdpmul;
 	itv_t itv1; itv_init(itv1);
 	itv_t itv2; itv_init(itv2);
 	if (cond_SDP) { 
-	    call_sdp(pr->itv, itv1, exprA->q, exprB->q, dim, hash, true);
+	    call_sdp(pr, itv1, exprA, exprB, dim, hash, true);
 	}
 	else 
-	    square_dep(pr, itv2, exprA->q, exprB->q, hash, dim, gammabis);
+	    square_dep(pr, itv2, exprA, exprB, hash, dim, gammabis);
 	if (exprA == exprB) {
 	    if (bound_sgn(itv1->inf) > 0) {bound_set_int(itv1->inf,0);}
 	    if (bound_sgn(itv2->inf) > 0) {bound_set_int(itv2->inf,0);}
@@ -646,7 +573,8 @@ t1p_aff_t* t1p_aff_mul_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff
 
 t1p_aff_t* t1p_aff_mul_non_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t1p_t* env)
 {
-    t1p_aaterm_t *p, *q, *ptr;
+    uint_t p, q;
+    t1p_aaterm_t *ptr;
     itv_t itv_nlin; itv_init(itv_nlin);
     int i = 0;
     int SDP_dim = 0;
@@ -670,70 +598,57 @@ t1p_aff_t* t1p_aff_mul_non_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p
     t1p_aff_t* res = t1p_aff_alloc_init(pr);
     itv_mul(pr->itv, res->c, exprA->c, exprB->c);
     itv_set(res->itv, res->c);
-    if (exprA->q || exprB->q) {
+    if (exprA->l || exprB->l) {
+	t1p_aff_reserve(pr, res, exprA->l + exprB->l);
 	ptr = t1p_aaterm_alloc_init();
-	for(p = exprA->q, q = exprB->q; p || q;) {
+	for (p = 0, q = 0; p < exprA->l || q < exprB->l;) {
 	    dim += 1;	/* compute the number of different noise symbols */
-	    if (p && q) {
-		if (p->pnsym->index == q->pnsym->index) {
-		    itv_mul(pr->itv, tmp, p->coeff, exprB->c);
-		    itv_mul(pr->itv, ptr->coeff, q->coeff, exprA->c);
+	    if (p < exprA->l && q < exprB->l) {
+		if (exprA->index[p] == exprB->index[q]) {
+		    itv_mul(pr->itv, tmp, exprA->coeff[p], exprB->c);
+		    itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], exprA->c);
 		    itv_add(ptr->coeff, ptr->coeff, tmp);
-		    ptr->pnsym = p->pnsym;
+		    ptr->pnsym = pr->epsilon[exprA->index[p]];
 
-		    hash[p->pnsym->index] = dim;
-		    nsym_shared[p->pnsym->index] = true;
+		    hash[exprA->index[p]] = dim;
+		    nsym_shared[exprA->index[p]] = true;
 		    SDP_dim++;
-		    nsym_shared_hash[p->pnsym->index] = SDP_dim;
-
-		    p = p->n ;
-		    q = q->n ;
-		} else if (p->pnsym->index < q->pnsym->index) {
-		    itv_mul(pr->itv, ptr->coeff, p->coeff, exprB->c);
-		    ptr->pnsym = p->pnsym;
-		    hash[p->pnsym->index] = dim;
-		    p = p->n ;
+		    nsym_shared_hash[exprA->index[p]] = SDP_dim;
+
+		    p++;
+		    q++;
+		} else if (exprA->index[p] < exprB->index[q]) {
+		    itv_mul(pr->itv, ptr->coeff, exprA->coeff[p], exprB->c);
+		    ptr->pnsym = pr->epsilon[exprA->index[p]];
+		    hash[exprA->index[p]] = dim;
+		    p++;
 		} else {
-		    itv_mul(pr->itv, ptr->coeff, q->coeff, exprA->c);
-		    ptr->pnsym = q->pnsym;
-		    hash[q->pnsym->index] = dim;
-		    q = q->n ;
+		    itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], exprA->c);
+		    ptr->pnsym = pr->epsilon[exprB->index[q]];
+		    hash[exprB->index[q]] = dim;
+		    q++;
 		}
-	    } else if (p) {
-		itv_mul(pr->itv, ptr->coeff, p->coeff, exprB->c);
-		ptr->pnsym = p->pnsym;
-		hash[p->pnsym->index] = dim;
-		p = p->n ;
+	    } else if (p < exprA->l) {
+		itv_mul(pr->itv, ptr->coeff, exprA->coeff[p], exprB->c);
+		ptr->pnsym = pr->epsilon[exprA->index[p]];
+		hash[exprA->index[p]] = dim;
+		p++;
 	    } else {
-		itv_mul(pr->itv, ptr->coeff, q->coeff, exprA->c);
-		ptr->pnsym = q->pnsym;
-		hash[q->pnsym->index] = dim;
-		q = q->n ;
+		itv_mul(pr->itv, ptr->coeff, exprB->coeff[q], exprA->c);
+		ptr->pnsym = pr->epsilon[exprB->index[q]];
+		hash[exprB->index[q]] = dim;
+		q++;
 	    }
-	    if (itv_is_zero(ptr->coeff)) {
-		if (!(p||q)) {
-		    /* the last iteration */
-		    t1p_aaterm_free(pr, ptr);
-		    if (res->end) res->end->n = NULL;
-		}
-	    } else {
+	    if (!itv_is_zero(ptr->coeff)) {
 		/* keep this term */
-		if (!res->q) res->q = ptr;
-		res->end = ptr;
-		res->l++;
+		t1p_aff_nsym_add(pr, res, ptr->coeff, ptr->pnsym);
 		t1p_nsymcons_get_gamma(pr, tmp, ptr->pnsym->index, env);
 		itv_mul(pr->itv, tmp, tmp, ptr->coeff);
 		itv_add(res->itv, res->itv, tmp);
-		if (p||q) {
-		    /* continuing */
-		    ptr->n = t1p_aaterm_alloc_init();
-		    ptr=ptr->n;
-		} else {
-		    /* the last iteration */
-		    ptr->n = NULL;
-		}
+		itv_set_int(ptr->coeff, 0);
 	    }
 	}
+	t1p_aaterm_free(pr, ptr);
     }
     /* non linear part */
     /* Calling SDP solver (non guaranteed):
@@ -742,23 +657,22 @@ t1p_aff_t* t1p_aff_mul_non_constrained(t1p_internal_t* pr, t1p_aff_t* exprA, t1p
      * - objectif matrix (in primal form) is a 2 block matrix of dimension 2n. First block is deduced from the non linear (quadric) part of multiplication, we zero all values of the second block,
      * - objective vector (in dual form) is a one vector of dimension "n".
      */
-    if (exprA->q && exprB->q) {
-	ap_funopt_t option = ap_manager_get_funopt(pr->man, pr->funid);
-	cond_SDP = option.algorithm == INT_MAX ? true : false;
+    if (exprA->l && exprB->l) {
+	cond_SDP = pr->sdpmul;
 	itv_t itv1; itv_init(itv1);
 	itv_t itv2; itv_init(itv2);
 	if (cond_SDP) { 
-	    call_sdp(pr->itv, itv1, exprA->q, exprB->q, dim, hash, true);
+	    call_sdp(pr, itv1, exprA, exprB, dim, hash, true);
 	    /* tentative de mise en place d'un solveur garantit, to be continued ... */
 	    //		    itv_t* array = itv_array_alloc(dim*(dim+1)/2);
-	    //		    buildIntervalUpperTriangle(pr, array, exprA->q, exprB->q, dim, hash);
+	    //		    buildIntervalUpperTriangle(pr, array, exprA, exprB, dim, hash);
 	    //		    double* phi = buildDoubleUpperTriangle(pr, array, dim);
 	    //		    call_sound_sdp(dim, phi);
 	    //		    free(phi);
 	    //		    itv_array_free(array,(dim*(dim+1)/2));
 	}
 	else 
-	    square_dep(pr, itv2, exprA->q, exprB->q, hash, dim, NULL);
+	    square_dep(pr, itv2, exprA, exprB, hash, dim, NULL);
 
 	if (exprA == exprB) {
 	    if (bound_sgn(itv1->inf) > 0) {bound_set_int(itv1->inf,0);}
@@ -810,7 +724,7 @@ t1p_aff_t* t1p_aff_div(t1p_internal_t* pr, t1p_aff_t* exprA, t1p_aff_t* exprB, t
 	itv_div(pr->itv, tmp, one, exprB->itv);
 	res = t1p_aff_mul_itv(pr, exprA, tmp);
     } else {
-	if (exprB->q == NULL) {
+	if (exprB->l == 0) {
 	    itv_div(pr->itv, tmp, one, exprB->c);
 	    res = t1p_aff_mul_itv(pr,exprA,tmp);
 	} else {
@@ -970,32 +884,26 @@ t1p_aff_t* t1p_aff_sqrt( t1p_internal_t* pr, t1p_aff_t* expr, t1p_t* env)
 t1p_aff_t* t1p_aff_neg(t1p_internal_t* pr, t1p_aff_t* b)
 {
     t1p_aff_t* res = t1p_aff_alloc_init(pr);
-    t1p_aaterm_t *p, *q;
+    uint_t p;
     itv_neg(res->c, b->c);
-    res->l = b->l;
-    if (b->q) {
-	res->q = t1p_aaterm_alloc_init();
-
-	for (p=b->q, q=res->q; p->n; p=p->n) {
-	    itv_neg(q->coeff, p->coeff);
-	    q->pnsym = p->pnsym;
-	    q->n = t1p_aaterm_alloc_init();
-	    q = q->n;
+    if (b->l) {
+	t1p_aff_reserve(pr, res, b->l);
+	memcpy(res->index, b->index, b->l*sizeof(uint_t));
+	for (p=0; p<b->l; p++) {
+	    itv_neg(res->coeff[p], b->coeff[p]);
 	}
-	itv_neg(q->coeff, p->coeff);
-	q->pnsym = p->pnsym;
-	res->end = q;
     }
+    res->l = b->l;
     itv_neg(res->itv, b->itv);
     return res;
 }
 
 void t1p_aff_neg_inplace(t1p_internal_t* pr, t1p_aff_t* b)
 {
-    t1p_aaterm_t *p;
+    uint_t p;
     itv_neg(b->c, b->c);
-    for (p=b->q; p->n; p=p->n) {
-	itv_neg(p->coeff, p->coeff);
+    for (p=0; p<b->l; p++) {
+	itv_neg(b->coeff[p], b->coeff[p]);
     }
     itv_neg(b->itv, b->itv);
 }
@@ -1139,10 +1047,10 @@ t1p_aff_t* t1p_aff_eval_ap_texpr0(t1p_internal_t* pr, ap_texpr0_t* expr, t1p_t*
  * => non linear part \in (itv1 + itv2)
  * add_itv(itv1 + itv2)
 */
-void square_dep(t1p_internal_t* pr, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q, int* hash, unsigned int dim, itv_t* gamma)
+void square_dep(t1p_internal_t* pr, itv_t res, t1p_aff_t* p, t1p_aff_t* q, int* hash, unsigned int dim, itv_t* gamma)
 {
-    t1p_aaterm_t* ptr_p; 
-    t1p_aaterm_t* ptr_q;
+    uint_t ptr_p;
+    uint_t ptr_q;
     itv_t tmp, tmp1, tmp2;
     itv_init(tmp); itv_init(tmp1); itv_init(tmp2);
     itv_t ** itv_matrix;
@@ -1156,10 +1064,10 @@ void square_dep(t1p_internal_t* pr, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q,
 	itv_set_int2(zeroone,(long int)0,(long int)1);
 	itv_set_int2(moneone,(long int)(-1),(long int)1);
 	for (i=0; i<dim; i++) itv_matrix[i] = itv_array_alloc(dim);
-	for (ptr_p=p; ptr_p; ptr_p = ptr_p->n) {
-	    for (ptr_q=q; ptr_q; ptr_q = ptr_q->n) {
-		itv_mul(pr->itv, tmp, ptr_p->coeff, ptr_q->coeff);
-		itv_set(itv_matrix[hash[ptr_p->pnsym->index]-1][hash[ptr_q->pnsym->index]-1], tmp);
+	for (ptr_p=0; ptr_p<p->l; ptr_p++) {
+	    for (ptr_q=0; ptr_q<q->l; ptr_q++) {
+		itv_mul(pr->itv, tmp, p->coeff[ptr_p], q->coeff[ptr_q]);
+		itv_set(itv_matrix[hash[p->index[ptr_p]]-1][hash[q->index[ptr_q]]-1], tmp);
 	    }
 	}
 	for (i=1; i<=dim; i++) {
@@ -1194,15 +1102,15 @@ void square_dep(t1p_internal_t* pr, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q,
 	    itv_matrix[i] = itv_array_alloc(dim);
 	    itv_matrix2[i] = itv_array_alloc(i+1);
 	}
-	for (ptr_p=p; ptr_p; ptr_p = ptr_p->n) {
-	    for (ptr_q=q; ptr_q; ptr_q = ptr_q->n) {
-		itv_mul(pr->itv, tmp, ptr_p->coeff, ptr_q->coeff);
-		itv_set(itv_matrix[hash[ptr_p->pnsym->index]-1][hash[ptr_q->pnsym->index]-1], tmp);
-		itv_mul(pr->itv, tmp, gamma[ptr_p->pnsym->index], gamma[ptr_q->pnsym->index]);
-		if (hash[ptr_p->pnsym->index]-1 < hash[ptr_q->pnsym->index]-1) {
-		    itv_set(itv_matrix2[hash[ptr_q->pnsym->index] -1][hash[ptr_p->pnsym->index] -1], tmp);
+	for (ptr_p=0; ptr_p<p->l; ptr_p++) {
+	    for (ptr_q=0; ptr_q<q->l; ptr_q++) {
+		itv_mul(pr->itv, tmp, p->coeff[ptr_p], q->coeff[ptr_q]);
+		itv_set(itv_matrix[hash[p->index[ptr_p]]-1][hash[q->index[ptr_q]]-1], tmp);
+		itv_mul(pr->itv, tmp, gamma[p->index[ptr_p]], gamma[q->index[ptr_q]]);
+		if (hash[p->index[ptr_p]]-1 < hash[q->index[ptr_q]]-1) {
+		    itv_set(itv_matrix2[hash[q->index[ptr_q]] -1][hash[p->index[ptr_p]] -1], tmp);
 		} else {
-		    itv_set(itv_matrix2[hash[ptr_p->pnsym->index]-1][hash[ptr_q->pnsym->index]-1], tmp);
+		    itv_set(itv_matrix2[hash[p->index[ptr_p]]-1][hash[q->index[ptr_q]]-1], tmp);
 		}
 	    }
 	}
@@ -1234,8 +1142,29 @@ void square_dep(t1p_internal_t* pr, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q,
     itv_clear(tmp); itv_clear(tmp1); itv_clear(tmp2);
 }
 
-    void buildIntervalUpperTriangle(t1p_internal_t* pr, itv_t* array, t1p_aaterm_t* p, t1p_aaterm_t* q, size_t dim, int* hash) 
+/* symmetric matrix of the quadratic form p*q - linear part, stored as an
+   upper triangle by columns (see T1P_UT); array is initialized to 0 */
+void buildIntervalUpperTriangle(t1p_internal_t* pr, itv_t* array, t1p_aff_t* p, t1p_aff_t* q, size_t dim, int* hash)
 {
+    uint_t ptr_p;
+    uint_t ptr_q;
+    size_t i, j;
+    itv_t tmp; itv_init(tmp);
+    for (ptr_p=0; ptr_p<p->l; ptr_p++) {
+	for (ptr_q=0; ptr_q<q->l; ptr_q++) {
+	    i = hash[p->index[ptr_p]]-1;
+	    j = hash[q->index[ptr_q]]-1;
+	    itv_mul(pr->itv, tmp, p->coeff[ptr_p], q->coeff[ptr_q]);
+	    if (i == j) {
+		itv_add(array[T1P_UT(i,i)], array[T1P_UT(i,i)], tmp);
+	    } else {
+		itv_mul_2exp(tmp, tmp, -1);
+		if (i < j) itv_add(array[T1P_UT(i,j)], array[T1P_UT(i,j)], tmp);
+		else itv_add(array[T1P_UT(j,i)], array[T1P_UT(j,i)], tmp);
+	    }
+	}
+    }
+    itv_clear(tmp);
 }
 
 double* buildDoubleUpperTriangle(t1p_internal_t* pr, itv_t* array, size_t dim) {
@@ -1243,26 +1172,30 @@ double* buildDoubleUpperTriangle(t1p_internal_t* pr, itv_t* array, size_t dim) {
     double dbl;
     size_t i;
     double* res = (double*)calloc((dim*(dim+1)/2),sizeof(double));
+    itv_init(mid); itv_init(dev);
     for (i=0; i<(dim*(dim+1)/2); i++) {
     	itv_middev(pr->itv, mid, dev, array[i]);
-    	double_set_num(&dbl, mid->sup);
+    	double_set_num(&dbl, bound_numref(mid->sup));
 	res[i] = dbl;
     }
+    itv_clear(mid); itv_clear(dev);
     return res;
 }
 
 #ifndef _USE_SDP
-bool call_sdp(itv_internal_t* itv, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q, size_t dim, int* hash, bool square) 
+bool call_sdp(t1p_internal_t* pr, itv_t res, t1p_aff_t* p, t1p_aff_t* q, size_t dim, int* hash, bool square) 
 {
-	printf("SDP not supported, you have to enable it and rebuild the library\n");
-	abort();
+    /* bundled solver */
+    t1p_sdp_bound(pr, res, p, q, dim, hash);
+    return true;
 }
 #else
-bool call_sdp(itv_internal_t* itv, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q, size_t dim, int* hash, bool square)
+bool call_sdp(t1p_internal_t* pr, itv_t res, t1p_aff_t* p, t1p_aff_t* q, size_t dim, int* hash, bool square)
 {
+    itv_internal_t* itv = pr->itv;
     //	printf("Calling SDP %d\n",dim);
-    t1p_aaterm_t* ptr_p; 
-    t1p_aaterm_t* ptr_q;
+    uint_t ptr_p;
+    uint_t ptr_q;
     itv_t tmp;
     itv_t mid, dev;
     itv_init(tmp);
@@ -1354,10 +1287,10 @@ bool call_sdp(itv_internal_t* itv, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q,
     num_t eps; num_init(eps);
     bound_t err; bound_init(err);
     num_set_double(eps,(double)30*1.11022302462515654042e-16);
-    for (ptr_p=p; ptr_p; ptr_p = ptr_p->n) {
-	for (ptr_q=q; ptr_q; ptr_q = ptr_q->n) {
+    for (ptr_p=0; ptr_p<p->l; ptr_p++) {
+	for (ptr_q=0; ptr_q<q->l; ptr_q++) {
 	    /* TODO: We shall resolve an interval SDP problem and not reduce the interval to tmp->sup */
-	    itv_mul(itv, tmp, ptr_p->coeff, ptr_q->coeff);
+	    itv_mul(itv, tmp, p->coeff[ptr_p], q->coeff[ptr_q]);
 	    if (itv_is_point(itv, tmp)) double_set_num(&dbl, tmp->sup); 
 	    else {
 		itv_range_rel(itv,err,tmp);
@@ -1374,11 +1307,11 @@ bool call_sdp(itv_internal_t* itv, itv_t res, t1p_aaterm_t* p, t1p_aaterm_t* q,
 		    printf("Warning: (SDP) "); itv_print(mid); printf("is taken instead of "); itv_print(tmp);printf(" continue ...\n");abort();
 		}
 	    }
-	    if (ptr_p->pnsym->index == ptr_q->pnsym->index) {
-		C.blocks[1].data.mat[ijtok(hash[ptr_p->pnsym->index],hash[ptr_q->pnsym->index],dim)]=dbl;
+	    if (p->index[ptr_p] == q->index[ptr_q]) {
+		C.blocks[1].data.mat[ijtok(hash[p->index[ptr_p]],hash[q->index[ptr_q]],dim)]=dbl;
 	    } else {
-		C.blocks[1].data.mat[ijtok(hash[ptr_p->pnsym->index],hash[ptr_q->pnsym->index],dim)] += dbl/2;
-		C.blocks[1].data.mat[ijtok(hash[ptr_q->pnsym->index],hash[ptr_p->pnsym->index],dim)] += dbl/2;
+		C.blocks[1].data.mat[ijtok(hash[p->index[ptr_p]],hash[q->index[ptr_q]],dim)] += dbl/2;
+		C.blocks[1].data.mat[ijtok(hash[q->index[ptr_q]],hash[p->index[ptr_p]],dim)] += dbl/2;
 	    }
 	}
     }
@@ -7,11 +7,7 @@
 
 #include <stdlib.h>
 #include <unistd.h>
-
-#include <sys/stat.h>
-#include <fcntl.h>
 #include <string.h>
-#include <sys/mman.h>
 
 #include "ap_generic.h"
 
@@ -40,6 +36,7 @@ ap_manager_t* t1p_manager_alloc(void)
 	//ap_manager_t* manNS = oct_manager_alloc();
 	//ap_manager_t* manNS = pk_manager_alloc(true);
 	t1p_internal_t *t1p = t1p_internal_alloc(manNS);
+	t1p_trace_init_from_env();
 
 	man = ap_manager_alloc("Taylor1+",/* Library name */
 			"0.8", /* version */
@@ -56,6 +53,7 @@ ap_manager_t* t1p_manager_alloc(void)
 	funptr[AP_FUNID_FREE] = &t1p_free;
 	/*funptr[AP_FUNID_SIZE] = &t1p_size;*/
 	funptr[AP_FUNID_ASIZE] = &t1p_size;
+	funptr[AP_FUNID_MEMORY_SIZE] = &t1p_memory_size;
 	/* 2.Control of internal representation */
 	funptr[AP_FUNID_MINIMIZE] = &t1p_minimize;
 	funptr[AP_FUNID_CANONICALIZE] = &t1p_canonicalize;
@@ -137,6 +135,7 @@ ap_manager_t* t1p_manager_alloc(void)
 	   AP_FUNID_SIZE2
 	 */
 	man->option.abort_if_exception[AP_EXC_INVALID_ARGUMENT] = false;
+	man->option.abort_if_exception[AP_EXC_TIMEOUT] = false;
 	return man;
 }
 
@@ -146,63 +145,167 @@ int ap_manager_t1p_get_nsym(ap_manager_t* man)
         return pr->dim;
 }
 
+void ap_manager_t1p_set_nsym_budget(ap_manager_t* man, unsigned int budget)
+{
+    t1p_internal_t * pr = t1p_init_from_manager(man, AP_FUNID_UNKNOWN);
+    pr->nsymbudget = budget;
+}
 
-int get_clk_tck (void)
+void ap_manager_t1p_set_join_threads(ap_manager_t* man, unsigned int nthreads)
 {
-#ifdef CLOCKS_PER_SEC
-	return CLOCKS_PER_SEC;
-#else
-	int value = sysconf (_SC_CLK_TCK);
-	if (value < 0) {
-		fprintf(stderr,"sysconf: %s\n", strerror (errno));
-		abort();
-	}
-	return value;
-#endif
+    t1p_internal_t * pr = t1p_init_from_manager(man, AP_FUNID_UNKNOWN);
+    pr->jointhreads = nthreads;
 }
 
-/* TODO: Actually, these are called when allocating the internal structure of Taylor1+ domain .
- * If we have a multithreaded library, we should share these logging info between all threads ! */
-void log_init(void* addr, uint_t length, int fd)
+/* contribution of a term to the concretisation of an affine form */
+typedef struct t1p_contrib_t {
+    bound_t mag;	/* magnitude of coeff*gamma */
+    uint_t k;		/* position of the term */
+} t1p_contrib_t;
+
+/* decreasing magnitudes, then increasing positions; sorts pointers, as
+   bound_cmp does not take const bounds */
+static int t1p_contrib_cmp(const void* pa, const void* pb)
 {
+    t1p_contrib_t* a = *(t1p_contrib_t* const*)pa;
+    t1p_contrib_t* b = *(t1p_contrib_t* const*)pb;
+    int cmp = bound_cmp(b->mag, a->mag);
+    if (cmp) return cmp;
+    else return (a->k > b->k) - (a->k < b->k);
+}
 
-#if (defined __CYGWIN__ || defined __MINGW32__)
-	uint_t page_size = 4096;
-#else
-	uint_t page_size = (uint_t) sysconf(_SC_PAGESIZE);
-#endif
-	char * path = getcwd(NULL, (uint_t)0);
-	if (!(path)) {
-		fprintf(stderr,"getcwd: %s\n",strerror(errno));
-		abort();
+t1p_aff_t* t1p_aff_condense(t1p_internal_t* pr, t1p_aff_t* expr, t1p_t* a)
+{
+    uint_t n = expr->l;
+    uint_t k, j;
+    t1p_contrib_t* tab;
+    t1p_contrib_t** order;
+    bool* keep;
+    itv_t tmp, sum;
+
+    if (pr->nsymbudget == 0 || n <= pr->nsymbudget) return expr;
+    if (expr->pby) expr = t1p_aff_copy(pr, expr);
+    itv_init(tmp); itv_init(sum);
+    tab = (t1p_contrib_t*)malloc(n*sizeof(t1p_contrib_t));
+    order = (t1p_contrib_t**)malloc(n*sizeof(t1p_contrib_t*));
+    keep = (bool*)calloc(n, sizeof(bool));
+    for (k=0; k<n; k++) {
+	t1p_nsymcons_get_gamma(pr, tmp, expr->index[k], a);
+	itv_mul(pr->itv, tmp, tmp, expr->coeff[k]);
+	bound_init(tab[k].mag);
+	itv_magnitude(tab[k].mag, tmp);
+	tab[k].k = k;
+	order[k] = &tab[k];
+    }
+    qsort(order, n, sizeof(t1p_contrib_t*), t1p_contrib_cmp);
+    /* the budget includes the fresh noise symbol */
+    for (k=0; k<pr->nsymbudget-1; k++) keep[order[k]->k] = true;
+    /* sum of the contributions of the merged terms */
+    for (k=0; k<n; k++) {
+	if (keep[k]) continue;
+	t1p_nsymcons_get_gamma(pr, tmp, expr->index[k], a);
+	itv_mul(pr->itv, tmp, tmp, expr->coeff[k]);
+	itv_add(sum, sum, tmp);
+    }
+    if (!itv_has_infty_bound(sum)) {
+	/* the kept terms remain sorted */
+	for (k=0, j=0; k<n; k++) {
+	    if (!keep[k]) continue;
+	    if (j != k) {
+		expr->index[j] = expr->index[k];
+		itv_swap(expr->coeff[j], expr->coeff[k]);
+	    }
+	    j++;
 	}
-	char * logfile = "/taylor1plus.log";
-	uint_t l = strlen(path) + strlen(logfile) + 1; /* +1 for the terminating null byte */
-	char * logpath = (char*)malloc(l*sizeof(char));
-	strcpy(logpath,path);
-	strcat(logpath,logfile);
-	fd = open(logpath, O_RDWR | O_CREAT, S_IRWXU);
-	if (fd == -1) {
-		fprintf(stderr,"open: %s\n",strerror(errno));
-		abort();
+	expr->l = j;
+	/* the fresh noise symbol has the highest index */
+	t1p_aff_add_itv(pr, expr, sum, UN);
+    }
+    for (k=0; k<n; k++) bound_clear(tab[k].mag);
+    free(order);
+    free(tab);
+    free(keep);
+    itv_clear(tmp); itv_clear(sum);
+    return expr;
+}
+
+static int t1p_aff_ptr_cmp(const void* pa, const void* pb)
+{
+    const t1p_aff_t* a = *(t1p_aff_t* const*)pa;
+    const t1p_aff_t* b = *(t1p_aff_t* const*)pb;
+    return (a > b) - (a < b);
+}
+
+/* increasing renumbering of the noise symbols used by tab, the other ones are freed */
+void ap_manager_t1p_collect_nsym(ap_manager_t* man, ap_abstract0_t** tab, size_t size)
+{
+    t1p_internal_t * pr = t1p_init_from_manager(man, AP_FUNID_UNKNOWN);
+    uint_t* map;		/* new index + 1, 0 for unused noise symbols */
+    t1p_aff_t** forms;
+    size_t nforms = 0;
+    size_t i;
+    uint_t j, k, n, cons;
+
+    map = (uint_t*)calloc(pr->dim+1, sizeof(uint_t));
+    for (i=0; i<size; i++) nforms += ((t1p_t*)tab[i]->value)->dims;
+    forms = (t1p_aff_t**)malloc((nforms+1)*sizeof(t1p_aff_t*));
+    /* mark the used noise symbols */
+    nforms = 0;
+    for (i=0; i<size; i++) {
+	t1p_t* a = (t1p_t*)tab[i]->value;
+	for (j=0; j<a->dims; j++) {
+	    t1p_aff_t* aff = a->paf[j];
+	    for (k=0; k<aff->l; k++) map[aff->index[k]] = 1;
+	    forms[nforms++] = aff;
 	}
-	length = (uint_t)(1*page_size);
-	addr = mmap (NULL, length, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, (off_t)(0*page_size));
-	if (addr == MAP_FAILED) {
-		fprintf(stderr,"mmap: %s\n",strerror(errno));
-		abort();
+	cons = t1p_nsymcons_get_dimension(pr, a);
+	for (k=0; k<cons; k++) map[a->nsymcons[k]] = 1;
+    }
+    /* compact pr->epsilon */
+    for (k=0, n=0; k<pr->dim; k++) {
+	if (map[k]) {
+	    pr->epsilon[n] = pr->epsilon[k];
+	    pr->epsilon[n]->index = n;
+	    n++;
+	    map[k] = n;
+	} else {
+	    free(pr->epsilon[k]);
+	    pr->epsilon[k] = NULL;
 	}
-	free(path);
-	free(logpath);
+    }
+    for (k=0, j=0; k<pr->epssize; k++) {
+	if (map[pr->inputns[k]]) pr->inputns[j++] = map[pr->inputns[k]]-1;
+    }
+    pr->epssize = j;
+    pr->dim = n;
+    /* renumber each affine form once, forms may be shared */
+    qsort(forms, nforms, sizeof(t1p_aff_t*), t1p_aff_ptr_cmp);
+    for (i=0; i<nforms; i++) {
+	if (i>0 && forms[i] == forms[i-1]) continue;
+	for (k=0; k<forms[i]->l; k++) forms[i]->index[k] = map[forms[i]->index[k]]-1;
+    }
+    for (i=0; i<size; i++) {
+	t1p_t* a = (t1p_t*)tab[i]->value;
+	cons = t1p_nsymcons_get_dimension(pr, a);
+	for (k=0; k<cons; k++) a->nsymcons[k] = map[a->nsymcons[k]]-1;
+    }
+    free(forms);
+    free(map);
 }
 
-void log_sync(void* addr, uint_t length, int fd)
+
+int get_clk_tck (void)
 {
-	if (munmap(addr, length) == -1) {
-		fprintf(stderr,"munmap: %s\n",strerror(errno));
+#ifdef CLOCKS_PER_SEC
+	return CLOCKS_PER_SEC;
+#else
+	int value = sysconf (_SC_CLK_TCK);
+	if (value < 0) {
+		fprintf(stderr,"sysconf: %s\n", strerror (errno));
 		abort();
 	}
-	close(fd);
+	return value;
+#endif
 }
 
 /*
@@ -978,26 +1081,16 @@ void optpr_solve(t1p_internal_t* pr, itv_t alpha0x, itv_t alpha0, itv_t midgx, i
     printf("\n");
     */
     /* construction de la forme finale */
-    t1p_aaterm_t *ptr = NULL;
     res = t1p_aff_alloc_init(pr);
-    res->q = ptr = t1p_aaterm_alloc_init();
+    t1p_aff_reserve(pr, res, opt->size+1);
     ap_interval_t* itv_dim = NULL;
     for (i=0;i<opt->size+1;i++) {
 	itv_dim = ap_abstract0_bound_dimension(pk, obj, (ap_dim_t)i);
 	itv_set_ap_interval(pr->itv, tmp1, itv_dim);
 	itv_middev(pr->itv, tmp2,tmp3,tmp1);
 	if (i==0) itv_set(res->c,tmp2);
-	else {
-	    itv_set(ptr->coeff,tmp2);
-	    ptr->pnsym = opt->T[i-1].pnsym;
-	    res->end = ptr;
-	    res->l++;
-	    ptr->n = t1p_aaterm_alloc_init();
-	    ptr=ptr->n;
-	}
+	else t1p_aff_build(pr, res, tmp2, opt->T[i-1].pnsym->index);
     }
-    t1p_aaterm_free(pr, ptr);
-    if (res->end) res->end->n = NULL;
 
     t1p_aff_nsym_create(pr, res, tauz, UN);
 
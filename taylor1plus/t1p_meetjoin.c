@@ -6,6 +6,7 @@
 
 
 #include <stdlib.h>
+#include <pthread.h>
 
 #include "num.h"
 #include "itv.h"
@@ -37,6 +38,7 @@ t1p_t* t1p_meet(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 /* TODO: destructive not used */
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_MEET);
     t1p_internal_t* pr = t1p_init_from_manager(man,AP_FUNID_MEET);
     arg_assert(a1->dims==a2->dims && a1->intdim==a2->intdim,abort(););
 #ifdef _T1P_DEBUG
@@ -132,7 +134,7 @@ t1p_t* t1p_meet(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 	for (i=0; i<intdim+realdim; i++) {
 	    /* update res->box */
 	    itv_meet(pr->itv, res->box[i], a1->box[i], a2->box[i]);
-	    if ((a1->paf[i]->q == NULL) && (a2->paf[i]->q == NULL)) {
+	    if ((a1->paf[i]->l == 0) && (a2->paf[i]->l == 0)) {
 		itv_meet(pr->itv, tmp, a1->paf[i]->c, a2->paf[i]->c);
 		if (itv_is_bottom(pr->itv, tmp)) {
 		    t1p_free(man, res);
@@ -171,6 +173,7 @@ t1p_t* t1p_meet(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
     t1p_fprint(stdout, man, res, 0x0);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
@@ -260,7 +263,7 @@ static inline bool t1p_eval_lincons_array(t1p_internal_t* pr, size_t* hash, t1p_
 		ap_coeff_set_itv(pr->itv, coeff, sum->c);
 		eps_linexpr0 = ap_linexpr0_alloc(AP_LINEXPR_SPARSE, 0);
 		ap_linexpr0_set_cst(eps_linexpr0, coeff);
-		t1p_aaterm_t *p;
+		uint_t p;
 		/* sum->l donne la taille de la forme affine (ne comptabilise pas la constante) */
 		size_t epscons_size = t1p_nsymcons_get_dimension(pr, a);
 		/* au pire tous les symboles de la contrainte seront  rajouter */
@@ -269,10 +272,10 @@ static inline bool t1p_eval_lincons_array(t1p_internal_t* pr, size_t* hash, t1p_
 		eps_linexpr0->size = sum->l;
 		size_t k = 0;
 		ap_dim_t dim = 0;
-		for (p=sum->q; p; p=p->n) {
+		for (p=0; p<sum->l; p++) {
 		    ap_coeff_init(&eps_linexpr0->p.linterm[k].coeff, AP_COEFF_INTERVAL);
-		    ap_coeff_set_itv(pr->itv, &eps_linexpr0->p.linterm[k].coeff, p->coeff);
-		    t1p_insert_constrained_nsym(pr, &dim, p->pnsym->index, a);
+		    ap_coeff_set_itv(pr->itv, &eps_linexpr0->p.linterm[k].coeff, sum->coeff[p]);
+		    t1p_insert_constrained_nsym(pr, &dim, sum->index[p], a);
 		    eps_linexpr0->p.linterm[k].dim = dim;
 		    k++;
 		}
@@ -296,6 +299,7 @@ static inline bool t1p_eval_lincons_array(t1p_internal_t* pr, size_t* hash, t1p_
 t1p_t* t1p_meet_lincons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_lincons0_array_t* array)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_MEET_LINCONS_ARRAY);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_MEET_LINCONS_ARRAY);
     arg_assert(a && array, abort(););
 #ifdef _T1P_DEBUG
@@ -319,6 +323,7 @@ t1p_t* t1p_meet_lincons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_
     t1p_fprint(stdout, man, res, NULL);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
@@ -328,7 +333,9 @@ t1p_t* t1p_meet_lincons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_
 t1p_t* t1p_meet_tcons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_tcons0_array_t* array)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_MEET_TCONS_ARRAY);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_MEET_TCONS_ARRAY);
+    pr->sdpmul = man->option.funopt[AP_FUNID_MEET_TCONS_ARRAY].algorithm == INT_MAX;
 #ifdef _T1P_DEBUG
     fprintf(stdout, "### MEET TCONS ARRAY (des %d) ###\n",destructive);
     t1p_fprint(stdout, man, a, NULL);
@@ -365,7 +372,7 @@ t1p_t* t1p_meet_tcons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_tc
 		    if (itv_is_bottom(pr->itv, res->box[i])) {
 			is_bottom = true;
 			break;
-		    } else if (res->paf[i]->q == NULL) {
+		    } else if (res->paf[i]->l == 0) {
 			t1p_aff_check_free(pr, res->paf[i]);
 			res->paf[i] = t1p_aff_alloc_init(pr);
 
@@ -404,7 +411,7 @@ t1p_t* t1p_meet_tcons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_tc
 	for (i=0; i<array->size; i++) {
 	    texpr0 = array->p[i].texpr0;
 	    aff[i] = t1p_aff_eval_ap_texpr0(pr, texpr0, a);
-	    if (aff[i]->q == NULL) {
+	    if (aff[i]->l == 0) {
 		/* only the centers are involved in this constraint, already treated while updating res->box */
 	    } else {
 		/* infer constraints on noise symbols */
@@ -433,7 +440,7 @@ t1p_t* t1p_meet_tcons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_tc
 		t1p_aff_t* tmp, *tmp1;
 		size_t j = 0;
 		for (j=0; j<res->dims; j++) {
-		    if (res->paf[j]->q) {
+		    if (res->paf[j]->l) {
 			t1p_aff_cons_eq_lambda(pr, &dummy, res->paf[j], aff[i], res);
 			tmp = t1p_aff_mul_itv(pr, aff[i], dummy);
 			itv_set(res->paf[j]->itv, res->box[j]);
@@ -474,17 +481,162 @@ t1p_t* t1p_meet_tcons_array(ap_manager_t* man, bool destructive, t1p_t* a, ap_tc
     t1p_fprint(stdout, man, res, NULL);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
 /************************************************/
 /* 2.Join					*/
 /************************************************/
+/* Parallel join: the variables whose affine forms have to be joined are
+   dispatched by chunks of T1P_JOIN_CHUNK to pr->jointhreads workers. Each
+   worker uses a shallow copy of pr with its own itv_internal_t, and the
+   variable i may only create the noise symbol pr->dim+i, reserved before
+   the parallel section. The constrained noise symbols of the result, the
+   fresh noise symbols and the condensation are then handled sequentially
+   in the order of the variables, so that the result is the one of the
+   sequential join.
+
+   The join checks the deadline armed from the timeout option of
+   AP_FUNID_JOIN before joining the affine forms of each variable. Once it
+   has expired, the remaining variables get the join of their boxes, i.e.
+   affine forms without noise symbols. */
+#define T1P_JOIN_CHUNK 16
+
+/* work accounted to the deadline for each term of the joined forms */
+#define T1P_JOIN_WORK(exp1,exp2) (256*((exp1)->l + (exp2)->l + 1))
+
+typedef struct t1p_join_task_t {
+    t1p_internal_t* pr;
+    t1p_t* a1;
+    t1p_t* a2;
+    t1p_t* res;
+    bool* join;		/* variables to join */
+    size_t size;	/* number of variables */
+    uint_t base;	/* first reserved noise symbol */
+    size_t next;	/* first variable not yet dispatched */
+    pthread_mutex_t mutex;
+} t1p_join_task_t;
+
+static void* t1p_join_worker(void* arg)
+{
+    t1p_join_task_t* task = (t1p_join_task_t*)arg;
+    t1p_internal_t wpr = *task->pr;
+    t1p_aff_t e1, e2, *aff;
+    size_t i, start, end;
+
+    wpr.itv = itv_internal_alloc();
+    for (;;) {
+	pthread_mutex_lock(&task->mutex);
+	start = task->next;
+	end = start + T1P_JOIN_CHUNK < task->size ? start + T1P_JOIN_CHUNK : task->size;
+	task->next = end;
+	pthread_mutex_unlock(&task->mutex);
+	if (start == end) break;
+	for (i=start; i<end; i++) {
+	    if (!task->join[i]) continue;
+	    if (ap_deadline_expired(&wpr.deadline, T1P_JOIN_WORK(task->a1->paf[i], task->a2->paf[i]))) {
+		/* left to t1p_join_parallel */
+		task->res->paf[i] = NULL;
+		continue;
+	    }
+	    /* the affine forms may be shared between variables: join private
+	       copies carrying the bounds of the variable */
+	    e1 = *task->a1->paf[i];
+	    e2 = *task->a2->paf[i];
+	    itv_init(e1.itv); itv_set(e1.itv, task->a1->box[i]);
+	    itv_init(e2.itv); itv_set(e2.itv, task->a2->box[i]);
+	    wpr.nsymnext = task->base + i;
+	    wpr.nsymend = task->base + i + 1;
+	    aff = t1p_aff_join_constrained6(&wpr, &e1, &e2, task->a1, task->a2, NULL);
+	    if (aff == &e1) aff = task->a1->paf[i];
+	    else if (aff == &e2) aff = task->a2->paf[i];
+	    task->res->paf[i] = aff;
+	    itv_clear(e1.itv);
+	    itv_clear(e2.itv);
+	}
+    }
+    itv_internal_free(wpr.itv);
+    return NULL;
+}
+
+/* update the constrained noise symbols of res as t1p_aff_join_constrained6
+   does, i.e. for the noise symbols of only one of exp1 and exp2 */
+static void t1p_join_delete_nsym(t1p_internal_t* pr, t1p_aff_t* exp1, t1p_aff_t* exp2, t1p_t* res)
+{
+    uint_t p = 0, q = 0;
+    while (p < exp1->l || q < exp2->l) {
+	if (q == exp2->l || (p < exp1->l && exp1->index[p] < exp2->index[q]))
+	    t1p_delete_constrained_nsym(pr, exp1->index[p++], res);
+	else if (p == exp1->l || exp2->index[q] < exp1->index[p])
+	    t1p_delete_constrained_nsym(pr, exp2->index[q++], res);
+	else {
+	    p++; q++;
+	}
+    }
+}
+
+/* return true if some workers ran out of time */
+static bool t1p_join_parallel(t1p_internal_t* pr, t1p_t* a1, t1p_t* a2, t1p_t* res, bool* join)
+{
+    t1p_join_task_t task;
+    pthread_t* threads;
+    t1p_aff_t* aff;
+    size_t i, k;
+    bool timeout = false;
+
+    task.pr = pr;
+    task.a1 = a1;
+    task.a2 = a2;
+    task.res = res;
+    task.join = join;
+    task.size = a1->dims;
+    task.base = pr->dim;
+    task.next = 0;
+    /* reserve one noise symbol per variable */
+    for (i=0; i<task.size; i++) t1p_nsym_add(pr, UN);
+    pthread_mutex_init(&task.mutex, NULL);
+    threads = (pthread_t*)malloc((pr->jointhreads-1)*sizeof(pthread_t));
+    for (k=0; k<pr->jointhreads-1; k++) {
+	if (pthread_create(&threads[k], NULL, t1p_join_worker, &task)) break;
+    }
+    t1p_join_worker(&task);
+    for (i=0; i<k; i++) pthread_join(threads[i], NULL);
+    free(threads);
+    pthread_mutex_destroy(&task.mutex);
+    /* release the reserved noise symbols */
+    for (i=0; i<task.size; i++) free(pr->epsilon[task.base+i]);
+    pr->dim = task.base;
+
+    for (i=0; i<task.size; i++) {
+	if (!join[i]) continue;
+	if (res->paf[i] == NULL) {
+	    timeout = true;
+	    res->paf[i] = t1p_aff_alloc_init(pr);
+	    itv_set(res->paf[i]->c, res->box[i]);
+	    res->paf[i]->pby++;
+	    continue;
+	}
+	itv_set(a1->paf[i]->itv, a1->box[i]);
+	itv_set(a2->paf[i]->itv, a2->box[i]);
+	t1p_join_delete_nsym(pr, a1->paf[i], a2->paf[i], res);
+	aff = res->paf[i];
+	if (aff != a1->paf[i] && aff != a2->paf[i] && aff->l && aff->index[aff->l-1] >= task.base)
+	    /* fresh noise symbol */
+	    aff->index[aff->l-1] = t1p_nsym_add(pr, UN)->index;
+	aff = t1p_aff_condense(pr, aff, res);
+	res->paf[i] = aff;
+	aff->pby++;
+    }
+    return timeout;
+}
+
 /* local join */
 t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
     /* TODO destructive not used  */
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_JOIN);
     size_t i = 0;
     t1p_internal_t* pr = (t1p_internal_t*)t1p_init_from_manager(man, AP_FUNID_JOIN);
     arg_assert(a1->dims==a2->dims && a1->intdim==a2->intdim,abort(););
@@ -523,9 +675,14 @@ t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
     } else {
 	/* TODO: destructive not yet supported */
 	itv_t tmp; itv_init(tmp);
+	/* armed here, as the tests above reset pr */
+	ap_deadline_init(&pr->deadline, &man->option.funopt[AP_FUNID_JOIN]);
 	res = t1p_alloc(man, intdim, realdim);
 	/* update res->box */
 	for (i=0; i<(intdim+realdim); i++) itv_join(res->box[i], a1->box[i], a2->box[i]);
+	/* variables whose affine forms are joined in parallel */
+	bool* join = NULL;
+	if (pr->jointhreads > 1 && intdim+realdim > T1P_JOIN_CHUNK) join = (bool*)calloc(intdim+realdim, sizeof(bool));
 
 	if (a1->hypercube && a2->hypercube) {
 	    for (i=0; i<(intdim+realdim); i++) {
@@ -547,24 +704,30 @@ t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 		    res->paf[i] = t1p_aff_alloc_init(pr);
 		    itv_set(res->paf[i]->c, a2->paf[i]->c);
 		    itv_set(res->paf[i]->itv, a2->paf[i]->itv);
-		    t1p_aaterm_t* p = NULL;
-		    for(p = a2->paf[i]->q; p; p=p->n) {
-			t1p_aff_nsym_add(pr, res->paf[i], p->coeff, p->pnsym);
-			if (p->pnsym->type == UN) {
-			    res->paf[i]->end->pnsym = pr->mubGlobal.p[p->pnsym->index].y;
+		    uint_t p;
+		    for(p = 0; p < a2->paf[i]->l; p++) {
+			t1p_aff_nsym_add(pr, res->paf[i], a2->paf[i]->coeff[p], pr->epsilon[a2->paf[i]->index[p]]);
+			if (pr->epsilon[a2->paf[i]->index[p]]->type == UN) {
+			    res->paf[i]->index[res->paf[i]->l-1] = pr->mubGlobal.p[a2->paf[i]->index[p]].y->index;
 			}
 		    }
 		    *
 		} */ else {
-		    if (itv_has_infty_bound(a1->box[i]) || itv_has_infty_bound(a2->box[i])) {
+		    if (itv_has_infty_bound(a1->box[i]) || itv_has_infty_bound(a2->box[i]) ||
+			(!join && ap_deadline_expired(&pr->deadline, T1P_JOIN_WORK(a1->paf[i], a2->paf[i])))) {
 			/* Do nothing, the join of concretisations is already done and stored in res->box */
 			res->paf[i] = t1p_aff_alloc_init(pr);
 			itv_set(res->paf[i]->c, res->box[i]);
+		    } else if (join) {
+			/* done by t1p_join_parallel */
+			join[i] = true;
+			continue;
 		    } else {
 			/* join two affine form expressions */
 			itv_set(a1->paf[i]->itv, a1->box[i]);
 			itv_set(a2->paf[i]->itv, a2->box[i]);
 			res->paf[i] = t1p_aff_join_constrained6(pr, a1->paf[i], a2->paf[i], a1, a2, res);
+			res->paf[i] = t1p_aff_condense(pr, res->paf[i], res);
 		    }
 		}
 		//printf("%d",i);itv_print(a1->box[i]); printf("\t");itv_print(a2->box[i]);printf("\n");
@@ -636,15 +799,21 @@ t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 		else if (t1p_aff_is_top(pr, a1->paf[i]) || t1p_aff_is_top(pr, a2->paf[i])) res->paf[i] = pr->top;
 		else if (t1p_aff_is_eq(pr, a1->paf[i], a2->paf[i])) res->paf[i] = a1->paf[i];
 		else {
-		    if (itv_has_infty_bound(a1->box[i]) || itv_has_infty_bound(a2->box[i])) {
+		    if (itv_has_infty_bound(a1->box[i]) || itv_has_infty_bound(a2->box[i]) ||
+			(!join && ap_deadline_expired(&pr->deadline, T1P_JOIN_WORK(a1->paf[i], a2->paf[i])))) {
 			/* Do nothing, the join of concretisations is already done and stored in res->box */
 			res->paf[i] = t1p_aff_alloc_init(pr);
 			itv_set(res->paf[i]->c, res->box[i]);
+		    } else if (join) {
+			/* done by t1p_join_parallel */
+			join[i] = true;
+			continue;
 		    } else {
 			/* join two affine form expressions */
 			itv_set(a1->paf[i]->itv, a1->box[i]);
 			itv_set(a2->paf[i]->itv, a2->box[i]);
 			res->paf[i] = t1p_aff_join_constrained6(pr, a1->paf[i], a2->paf[i], a1, a2, res);
+			res->paf[i] = t1p_aff_condense(pr, res->paf[i], res);
 		    }
 		}
 		res->paf[i]->pby++;
@@ -653,6 +822,10 @@ t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 	    man->result.flag_best = tbool_top;
 	    man->result.flag_exact = tbool_top;
 	}
+	if (join) {
+	    if (t1p_join_parallel(pr, a1, a2, res, join)) pr->deadline.end = -1.0;
+	    free(join);
+	}
 	pr->mubGlobal.cx = NULL;
 	pr->mubGlobal.cy = NULL;
 	free(pr->mubGlobal.p);
@@ -662,6 +835,10 @@ t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
     }
     man->result.flag_best = tbool_true;
     man->result.flag_exact = tbool_true;
+    if (pr->deadline.end < 0.0) {
+	ap_manager_raise_exception(man, AP_EXC_TIMEOUT, AP_FUNID_JOIN, "join of affine forms interrupted");
+	pr->deadline.end = 0.0;
+    }
 
 
 #ifdef _T1P_DEBUG
@@ -674,6 +851,7 @@ t1p_t* t1p_join(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
     /* fclose(stream); */
 #endif
 
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 /* pour essayer avec constrained8/8bis  */
@@ -724,29 +902,19 @@ t1p_t* t1p_join_faux(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 	for (i=0; i<(intdim+realdim); i++) itv_join(res->box[i], a1->box[i], a2->box[i]);
 
 	size_t old = pr->dim;
-	for (i=0;i<pr->epssize;i++) {
-	    if (i != pr->inputns[i]) {
-		t1p_nsym_t* tmp;
-		tmp = pr->epsilon[i];
-		pr->epsilon[i] = pr->epsilon[pr->inputns[i]];
-		pr->epsilon[pr->inputns[i]] = tmp;
-		pr->epsilon[i]->index = i;
-		pr->epsilon[pr->inputns[i]]->index = pr->inputns[i];
-		pr->inputns[i] = i;
-	    }
-	}
 	pr->mubGlobal.p = (Tobj1*)calloc(old,sizeof(Tobj1));
-	for (i=pr->epssize;i<old;i++) {
+	for (i=0;i<old;i++) {
+	    if (pr->epsilon[i]->type == IN) continue;
 	    pr->mubGlobal.p[i].x = pr->epsilon[i];
 	    pr->mubGlobal.p[i].y = t1p_nsym_add(pr, UN);
 	}
 	pr->mubGlobal.cx = t1p_nsym_add(pr, UN);
 	for (i=0;i<pr->epssize;i++) {
-	    pr->mubGlobal.p[i].x = t1p_nsym_add(pr, UN);
+	    pr->mubGlobal.p[pr->inputns[i]].x = t1p_nsym_add(pr, UN);
 	}
 	pr->mubGlobal.cy = t1p_nsym_add(pr, UN);
 	for (i=0;i<pr->epssize;i++) {
-	    pr->mubGlobal.p[i].y = t1p_nsym_add(pr, UN);
+	    pr->mubGlobal.p[pr->inputns[i]].y = t1p_nsym_add(pr, UN);
 	}
 	if (a1->hypercube && a2->hypercube) {
 	    for (i=0; i<(intdim+realdim); i++) {
@@ -770,11 +938,11 @@ t1p_t* t1p_join_faux(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 		    res->paf[i] = t1p_aff_alloc_init(pr);
 		    itv_set(res->paf[i]->c, a2->paf[i]->c);
 		    itv_set(res->paf[i]->itv, a2->paf[i]->itv);
-		    t1p_aaterm_t* p = NULL;
-		    for(p = a2->paf[i]->q; p; p=p->n) {
-			t1p_aff_nsym_add(pr, res->paf[i], p->coeff, p->pnsym);
-			if (p->pnsym->type == UN) {
-			    res->paf[i]->end->pnsym = pr->mubGlobal.p[p->pnsym->index].y;
+		    uint_t p;
+		    for(p = 0; p < a2->paf[i]->l; p++) {
+			t1p_aff_nsym_add(pr, res->paf[i], a2->paf[i]->coeff[p], pr->epsilon[a2->paf[i]->index[p]]);
+			if (pr->epsilon[a2->paf[i]->index[p]]->type == UN) {
+			    res->paf[i]->index[res->paf[i]->l-1] = pr->mubGlobal.p[a2->paf[i]->index[p]].y->index;
 			}
 		    }
 		    *
@@ -797,7 +965,7 @@ t1p_t* t1p_join_faux(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 	res->g = (itv_t**)calloc(1+pr->dim,sizeof(itv_t*)); /* centre + au max chaque symbole lui est associ un gnrateur */
 	res->gn = pr->dim;
 
-	t1p_aaterm_t *p = NULL;
+	uint_t p;
 	itv_t tmp1;
 	itv_init(tmp1);
 
@@ -806,10 +974,10 @@ t1p_t* t1p_join_faux(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 	    if (!res->g[0]) res->g[0] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
 	    itv_init(res->g[0][i]);
 	    itv_set(res->g[0][i],res->paf[i]->c);
-	    for(p=res->paf[i]->q;p;p=p->n) {
-		if (!res->g[1+p->pnsym->index]) res->g[1+p->pnsym->index] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
-		itv_init(res->g[1+p->pnsym->index][i]);
-		itv_set(res->g[1+p->pnsym->index][i],p->coeff);
+	    for(p=0;p<res->paf[i]->l;p++) {
+		if (!res->g[1+res->paf[i]->index[p]]) res->g[1+res->paf[i]->index[p]] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
+		itv_init(res->g[1+res->paf[i]->index[p]][i]);
+		itv_set(res->g[1+res->paf[i]->index[p]][i],res->paf[i]->coeff[p]);
 	    }
 	}
 	/* virer les vecteurs colineaires */
@@ -1014,32 +1182,22 @@ t1p_t* t1p_join_bub(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2)
 	for (i=0; i<(intdim+realdim); i++) itv_join(res->box[i], a1->box[i], a2->box[i]);
 
 	size_t old = pr->dim;
-	for (i=0;i<pr->epssize;i++) {
-	    if (i != pr->inputns[i]) {
-		t1p_nsym_t* tmp;
-		tmp = pr->epsilon[i];
-		pr->epsilon[i] = pr->epsilon[pr->inputns[i]];
-		pr->epsilon[pr->inputns[i]] = tmp;
-		pr->epsilon[i]->index = i;
-		pr->epsilon[pr->inputns[i]]->index = pr->inputns[i];
-		pr->inputns[i] = i;
-	    }
-	}
 	pr->mubGlobal.p = (Tobj1*)calloc(old,sizeof(Tobj1));
 	/*
-	for (i=pr->epssize;i<old;i++) {
+	for (i=0;i<old;i++) {
+	    if (pr->epsilon[i]->type == IN) continue;
 	    pr->mubGlobal.p[i].x = pr->epsilon[i];
 	    pr->mubGlobal.p[i].y = t1p_nsym_add(pr, UN);
 	}
 	*/
 	pr->mubGlobal.cx = t1p_nsym_add(pr, UN);
 	for (i=0;i<pr->epssize;i++) {
-	    pr->mubGlobal.p[i].x = t1p_nsym_add(pr, UN);
+	    pr->mubGlobal.p[pr->inputns[i]].x = t1p_nsym_add(pr, UN);
 	}
 	/*
 	pr->mubGlobal.cy = t1p_nsym_add(pr, UN);
 	for (i=0;i<pr->epssize;i++) {
-	    pr->mubGlobal.p[i].y = t1p_nsym_add(pr, UN);
+	    pr->mubGlobal.p[pr->inputns[i]].y = t1p_nsym_add(pr, UN);
 	}
 	*/
 	if (a1->hypercube && a2->hypercube) {
@@ -1228,48 +1386,38 @@ t1p_t* t1p_join_global(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2
 	res->g = (itv_t**)calloc(1+pr->dim,sizeof(itv_t*));
 	a1->gn = a2->gn = res->gn = pr->dim;
 
-	t1p_aaterm_t *p = NULL;
+	uint_t p;
 	for(i=0;i<intdim+realdim;i++) {
 	    if (!a1->g[0]) a1->g[0] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
 	    itv_init(a1->g[0][i]);
 	    itv_set(a1->g[0][i],a1->paf[i]->c);
-	    for(p=a1->paf[i]->q;p;p=p->n) {
-		if (!a1->g[p->pnsym->index]) a1->g[p->pnsym->index] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
-		itv_init(a1->g[p->pnsym->index][i]);
-		itv_set(a1->g[p->pnsym->index][i],p->coeff);
+	    for(p=0;p<a1->paf[i]->l;p++) {
+		if (!a1->g[a1->paf[i]->index[p]]) a1->g[a1->paf[i]->index[p]] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
+		itv_init(a1->g[a1->paf[i]->index[p]][i]);
+		itv_set(a1->g[a1->paf[i]->index[p]][i],a1->paf[i]->coeff[p]);
 	    }
 
 	    if (!a2->g[0]) a2->g[0] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
 	    itv_init(a2->g[0][i]);
 	    itv_set(a2->g[0][i],a2->paf[i]->c);
-	    for(p=a2->paf[i]->q;p;p=p->n) {
-		if (!a2->g[p->pnsym->index]) a2->g[p->pnsym->index] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
-		itv_init(a2->g[p->pnsym->index][i]);
-		itv_set(a2->g[p->pnsym->index][i],p->coeff);
+	    for(p=0;p<a2->paf[i]->l;p++) {
+		if (!a2->g[a2->paf[i]->index[p]]) a2->g[a2->paf[i]->index[p]] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
+		itv_init(a2->g[a2->paf[i]->index[p]][i]);
+		itv_set(a2->g[a2->paf[i]->index[p]][i],a2->paf[i]->coeff[p]);
 	    }
 	}
 	*/
 
 	size_t old = pr->dim;
-	for (i=0;i<pr->epssize;i++) {
-	    if (i != pr->inputns[i]) {
-		t1p_nsym_t* tmp;
-		tmp = pr->epsilon[i];
-		pr->epsilon[i] = pr->epsilon[pr->inputns[i]];
-		pr->epsilon[pr->inputns[i]] = tmp;
-		pr->epsilon[i]->index = i;
-		pr->epsilon[pr->inputns[i]]->index = pr->inputns[i];
-		pr->inputns[i] = i;
-	    }
-	}
 	pr->mubGlobal.p = (Tobj1*)calloc(old,sizeof(Tobj1));
-	for (i=pr->epssize;i<old;i++) {
+	for (i=0;i<old;i++) {
+	    if (pr->epsilon[i]->type == IN) continue;
 	    pr->mubGlobal.p[i].x = pr->epsilon[i]; /* P^X + P^Y */
 	    pr->mubGlobal.p[i].y = t1p_nsym_add(pr, UN); /* P^X - P^Y */
 	}
 	pr->mubGlobal.cx = t1p_nsym_add(pr, UN);
 	for (i=0;i<pr->epssize;i++) {
-	    pr->mubGlobal.p[i].x = t1p_nsym_add(pr, UN); /* C^X - C^Y */
+	    pr->mubGlobal.p[pr->inputns[i]].x = t1p_nsym_add(pr, UN); /* C^X - C^Y */
 	}
 	if (a1->hypercube && a2->hypercube) {
 	    for (i=0; i<(intdim+realdim); i++) {
@@ -1312,17 +1460,17 @@ t1p_t* t1p_join_global(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2
 	res->g = (itv_t**)calloc(1+pr->dim,sizeof(itv_t*)); /* centre + au max chaque symbole lui est associ un gnrateur */
 	res->gn = pr->dim;
 
-	t1p_aaterm_t *p = NULL;
+	uint_t p;
 
 	/* init res->g (structure creuse) */
 	for(i=0;i<intdim+realdim;i++) {
 	    if (!res->g[0]) res->g[0] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
 	    itv_init(res->g[0][i]);
 	    itv_set(res->g[0][i],res->paf[i]->c);
-	    for(p=res->paf[i]->q;p;p=p->n) {
-		if (!res->g[1+p->pnsym->index]) res->g[1+p->pnsym->index] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
-		itv_init(res->g[1+p->pnsym->index][i]);
-		itv_set(res->g[1+p->pnsym->index][i],p->coeff);
+	    for(p=0;p<res->paf[i]->l;p++) {
+		if (!res->g[1+res->paf[i]->index[p]]) res->g[1+res->paf[i]->index[p]] = (itv_t*)calloc(intdim+realdim,sizeof(itv_t));
+		itv_init(res->g[1+res->paf[i]->index[p]][i]);
+		itv_set(res->g[1+res->paf[i]->index[p]][i],res->paf[i]->coeff[p]);
 	    }
 	}
 	/* virer les vecteurs colineaires */
@@ -1491,8 +1639,10 @@ t1p_t* t1p_join_global(ap_manager_t* man, bool destructive, t1p_t* a1, t1p_t* a2
 t1p_t* t1p_join_array(ap_manager_t* man, t1p_t** tab, size_t size)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_JOIN_ARRAY);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_JOIN_ARRAY);
     t1p_t* res = (t1p_t*)ap_generic_join_array(man, (void**)tab, size);
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
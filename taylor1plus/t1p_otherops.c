@@ -23,6 +23,7 @@ t1p_t* t1p_forget_array(ap_manager_t* man,
 		bool project)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_FORGET_ARRAY);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_FORGET_ARRAY);
     t1p_t* res;
     size_t i;
@@ -45,6 +46,7 @@ t1p_t* t1p_forget_array(ap_manager_t* man,
 	    res->paf[tdim[i]]->pby++;
 	}
     }
+    T1P_TRACE_END(pr, res->dims);
     return res;
     //not_implemented();
 }
@@ -71,6 +73,7 @@ t1p_t t1p_fold(ap_manager_t* man,
 t1p_t* t1p_widening(ap_manager_t* man, t1p_t* a1, t1p_t* a2)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_WIDENING);
     size_t i = 0;
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_JOIN);
     arg_assert(a1->dims==a2->dims && a1->intdim==a2->intdim,abort(););
@@ -112,6 +115,7 @@ t1p_t* t1p_widening(ap_manager_t* man, t1p_t* a1, t1p_t* a2)
 		    itv_set(a1->paf[i]->itv, a1->box[i]);
 		    itv_set(a2->paf[i]->itv, a2->box[i]);
 		    res->paf[i] = t1p_aff_widening_constrained6(pr, a1->paf[i], a2->paf[i], a1, a2, res);
+		    res->paf[i] = t1p_aff_condense(pr, res->paf[i], res);
 		}
 	    }
 	    res->paf[i]->pby++;
@@ -129,6 +133,7 @@ t1p_t* t1p_widening(ap_manager_t* man, t1p_t* a1, t1p_t* a2)
     fprintf(stdout, "### ### ###\n");
 #endif
 
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
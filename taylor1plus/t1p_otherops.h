@@ -19,6 +19,37 @@ extern "C" {
 /*******************/
 
 int ap_manager_t1p_get_nsym(ap_manager_t* man);
+
+void ap_manager_t1p_set_nsym_budget(ap_manager_t* man, unsigned int budget);
+  /* Condensation policy: an affine form resulting from an assignment, a
+     join or a widening keeps at most budget noise symbols, the terms of
+     smallest contribution being merged into a fresh noise symbol. 0 (the
+     default) disables the condensation. */
+void ap_manager_t1p_set_join_threads(ap_manager_t* man, unsigned int nthreads);
+  /* Number of threads used by the join to compute the affine forms of the
+     variables, if there are more than 16 of them. 0 or 1 (the default)
+     for a sequential join. The result does not depend on nthreads. */
+void ap_manager_t1p_sdp_stats(ap_manager_t* man, size_t* calls, size_t* hits, double* time);
+  /* Statistics of the SDP solver bounding the non linear part of the
+     multiplications, enabled by setting the algorithm field of the
+     options of AP_FUNID_ASSIGN_TEXPR_ARRAY or AP_FUNID_MEET_TCONS_ARRAY
+     (also used by meet_lincons_array) to INT_MAX: number of quadratic
+     forms solved, number of cache hits, and cpu time in seconds. Without CSDP, the bundled
+     solver described in t1p_sdp.h is used. */
+void ap_manager_t1p_collect_nsym(ap_manager_t* man, ap_abstract0_t** tab, size_t size);
+  /* Reclaim the noise symbols which are not used by the abstract values of
+     tab, and renumber the other ones. tab must contain all the Taylor1+
+     abstract values still in use with this manager; the other ones become
+     invalid. */
+bool t1p_trace_start(const char* path);
+  /* Start tracing the operations of all the Taylor1+ managers of the
+     process to the binary file path, see t1p_trace.h for its format. The
+     trace is also started by t1p_manager_alloc if the environment variable
+     T1P_TRACE is set to a path. Returns false if a trace is already
+     started or the file cannot be created. */
+size_t t1p_trace_stop(void);
+  /* Write the pending records, close the trace file, and return the number
+     of records dropped because the drainer was too slow. */
  
 void ap_abstract1_aff_build(ap_manager_t* man, ap_abstract1_t * abstract, ap_var_t var, unsigned int index, ap_interval_t *itv, bool isunion);
 void ap_abstract1_ns_meet_lincons_array(ap_manager_t* man, ap_abstract1_t* abstract1, ap_lincons0_array_t* lincons);
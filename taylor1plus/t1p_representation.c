@@ -141,6 +141,37 @@ size_t t1p_size(ap_manager_t* man, t1p_t* a)
     return size + ap_abstract0_size(pr->manNS, a->abs);
 }
 
+static size_t t1p_aff_memory_size(t1p_aff_t* expr)
+{
+    size_t res = sizeof(t1p_aff_t) + expr->size*(sizeof(uint_t)+sizeof(itv_t));
+    res += itv_heap_size(expr->c) + itv_heap_size(expr->itv);
+    if (expr->coeff) res += itv_heap_size_array(expr->coeff, expr->size);
+    return res;
+}
+
+size_t t1p_memory_size(ap_manager_t* man, t1p_t* a)
+{
+    CALL();
+    /* the flags of the last operation are kept */
+    t1p_internal_t* pr = (t1p_internal_t*)man->internal;
+    size_t i;
+    size_t res = sizeof(t1p_t);
+    res += a->dims*(sizeof(t1p_aff_t*) + sizeof(itv_t));
+    res += itv_heap_size_array(a->box, a->dims);
+    for (i=0; i<a->dims; i++) {
+	if (a->paf[i]) res += t1p_aff_memory_size(a->paf[i]) / (a->paf[i]->pby ? a->paf[i]->pby : 1);
+    }
+    res += a->size*(sizeof(ap_dim_t) + sizeof(ap_interval_t*));
+    size_t nsymcons_size = t1p_nsymcons_get_dimension(pr, a);
+    for (i=0; i<nsymcons_size; i++) {
+	if (a->gamma[i] && a->gamma[i] != pr->ap_muu) {
+	    res += ap_interval_memory_size(a->gamma[i]);
+	}
+    }
+    res += ap_abstract0_memory_size(pr->manNS, a->abs);
+    return res;
+}
+
 /* ********************************************************************** */
 /* 2. Control of internal representation */
 /* ********************************************************************** */
@@ -33,6 +33,11 @@ void t1p_free(ap_manager_t* man, t1p_t* a);
 
 size_t t1p_size(ap_manager_t* man, t1p_t* a);
 
+/* Number of bytes allocated for the abstract value. An affine form shared
+ * by pby pointers is counted for 1/pby of its size, so that the sizes of
+ * all live values add up to the memory actually used. */
+size_t t1p_memory_size(ap_manager_t* man, t1p_t* a);
+
 /* ********************************************************************** */
 /* 2. Control of internal representation */
 /* ********************************************************************** */
@@ -22,6 +22,7 @@
 t1p_t* t1p_add_dimensions(ap_manager_t* man, bool destructive, t1p_t* a, ap_dimchange_t* dimchange, bool project)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_ADD_DIMENSIONS);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_ADD_DIMENSIONS);
 #ifdef _T1P_DEBUG
     fprintf(stdout, "### ADD DiMENSIONS (destructive %d) (project %d)###\n",destructive, project);
@@ -60,6 +61,7 @@ t1p_t* t1p_add_dimensions(ap_manager_t* man, bool destructive, t1p_t* a, ap_dimc
     t1p_fprint(stdout, man, res, 0x0);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 /*
@@ -119,6 +121,7 @@ bool is_in(size_t i, ap_dimchange_t* dimchange)
 t1p_t* t1p_remove_dimensions(ap_manager_t* man, bool destructive, t1p_t* a, ap_dimchange_t* dimchange)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_REMOVE_DIMENSIONS);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_REMOVE_DIMENSIONS);
 #ifdef _T1P_DEBUG
     fprintf(stdout, "### REMOVE DiMENSIONS (destructive %d) ###\n",destructive);
@@ -146,12 +149,14 @@ t1p_t* t1p_remove_dimensions(ap_manager_t* man, bool destructive, t1p_t* a, ap_d
     t1p_fprint(stdout, man, res, 0x0);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
 t1p_t* t1p_permute_dimensions(ap_manager_t* man, bool destructive, t1p_t* a, ap_dimperm_t* permutation)
 {
     CALL();
+    T1P_TRACE_BEGIN(AP_FUNID_PERMUTE_DIMENSIONS);
     t1p_internal_t* pr = t1p_init_from_manager(man, AP_FUNID_PERMUTE_DIMENSIONS);
 #ifdef _T1P_DEBUG
     fprintf(stdout, "### PERMUTE DiMENSIONS (destructive %d) ###\n",destructive);
@@ -173,6 +178,7 @@ t1p_t* t1p_permute_dimensions(ap_manager_t* man, bool destructive, t1p_t* a, ap_
     t1p_fprint(stdout, man, res, 0x0);
     fprintf(stdout, "### ### ###\n");
 #endif
+    T1P_TRACE_END(pr, res->dims);
     return res;
 }
 
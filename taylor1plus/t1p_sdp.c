@@ -0,0 +1,304 @@
+/*
+   APRON Library / Taylor1+ Domain (beta version)
+   Copyright (C) 2009-2011 Khalil Ghorbal
+
+*/
+
+
+#include <math.h>
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "t1p_internal.h"
+#include "t1p_fun.h"
+#include "t1p_sdp.h"
+
+/* Floating-point part */
+/***********************/
+/* eigenvalues w and eigenvectors (columns of v) of the symmetric matrix a
+   of size n, destroyed, by the cyclic Jacobi method */
+static void t1p_sdp_eig(size_t n, double* a, double* w, double* v)
+{
+    size_t i, j, k, sweep;
+    double off, norm, theta, t, c, s, x, y;
+
+    norm = 0;
+    for (i=0; i<n; i++) {
+	for (j=0; j<n; j++) {
+	    v[i*n+j] = (i==j) ? 1.0 : 0.0;
+	    norm += a[i*n+j]*a[i*n+j];
+	}
+    }
+    for (sweep=0; sweep<50; sweep++) {
+	off = 0;
+	for (i=0; i<n; i++)
+	    for (j=i+1; j<n; j++) off += a[i*n+j]*a[i*n+j];
+	if (off <= 1e-30*norm) break;
+	for (i=0; i<n; i++) {
+	    for (j=i+1; j<n; j++) {
+		if (a[i*n+j] == 0) continue;
+		theta = (a[j*n+j]-a[i*n+i])/(2*a[i*n+j]);
+		t = 1/(fabs(theta)+sqrt(theta*theta+1));
+		if (theta < 0) t = -t;
+		c = 1/sqrt(t*t+1);
+		s = t*c;
+		for (k=0; k<n; k++) {
+		    x = a[k*n+i]; y = a[k*n+j];
+		    a[k*n+i] = c*x - s*y;
+		    a[k*n+j] = s*x + c*y;
+		}
+		for (k=0; k<n; k++) {
+		    x = a[i*n+k]; y = a[j*n+k];
+		    a[i*n+k] = c*x - s*y;
+		    a[j*n+k] = s*x + c*y;
+		}
+		for (k=0; k<n; k++) {
+		    x = v[k*n+i]; y = v[k*n+j];
+		    v[k*n+i] = c*x - s*y;
+		    v[k*n+j] = s*x + c*y;
+		}
+	    }
+	}
+    }
+    for (i=0; i<n; i++) w[i] = a[i*n+i];
+}
+
+/* x'cx for x the sign vector of the column col of v */
+static double t1p_sdp_quad_sign(size_t n, double* c, double* v, size_t col)
+{
+    size_t i, j;
+    double res = 0;
+    for (i=0; i<n; i++)
+	for (j=0; j<n; j++)
+	    res += ((v[i*n+col] < 0) == (v[j*n+col] < 0) ? 1 : -1) * c[i*n+j];
+    return res;
+}
+
+/* y such that Diag(y)-c is positive semidefinite with sum(y) small, i.e. an
+   approximate solution of the dual of max{<c,X> | X psd, X_ii <= 1}. The
+   descent starts from the eigenvalue bound y_i = lambda_max(c), and uses
+   Polyak steps towards the value of the best sign vector found so far. */
+static void t1p_sdp_dual(size_t n, double* c, double* y)
+{
+    size_t i, j, k, imin, imax, stall;
+    double best, lb, lmin, g, t, norm2, mu;
+    double* m = (double*)malloc(n*n*sizeof(double));
+    double* v = (double*)malloc(n*n*sizeof(double));
+    double* w = (double*)malloc(n*sizeof(double));
+    double* s = (double*)malloc(n*sizeof(double));
+    double* yk = (double*)malloc(n*sizeof(double));
+
+    /* eigenvalue bound */
+    memcpy(m, c, n*n*sizeof(double));
+    t1p_sdp_eig(n, m, w, v);
+    imax = 0;
+    for (i=1; i<n; i++) if (w[i] > w[imax]) imax = i;
+    for (i=0; i<n; i++) y[i] = yk[i] = w[imax];
+    best = n*w[imax];
+    lb = t1p_sdp_quad_sign(n, c, v, imax);
+
+    mu = 1;
+    stall = 0;
+    for (k=0; k<T1P_SDP_ITER && best-lb > 1e-9*(fabs(best)+fabs(lb)); k++) {
+	for (i=0; i<n; i++) {
+	    for (j=0; j<n; j++) m[i*n+j] = -c[i*n+j];
+	    m[i*n+i] += yk[i];
+	}
+	t1p_sdp_eig(n, m, w, v);
+	imin = 0;
+	for (i=1; i<n; i++) if (w[i] < w[imin]) imin = i;
+	lmin = w[imin];
+	g = -(double)n*lmin;
+	for (i=0; i<n; i++) g += yk[i];
+	if (g < best) {
+	    best = g;
+	    for (i=0; i<n; i++) y[i] = yk[i] - lmin;
+	    stall = 0;
+	} else if (++stall >= 3) {
+	    mu /= 2;
+	    stall = 0;
+	}
+	t = t1p_sdp_quad_sign(n, c, v, imin);
+	if (t > lb) lb = t;
+	/* subgradient of sum(y) - n.lambda_min(Diag(y)-c) */
+	norm2 = 0;
+	for (i=0; i<n; i++) {
+	    s[i] = 1 - n*v[i*n+imin]*v[i*n+imin];
+	    norm2 += s[i]*s[i];
+	}
+	if (norm2 < 1e-24) break;
+	t = mu*(g-lb)/norm2;
+	for (i=0; i<n; i++) yk[i] -= t*s[i];
+    }
+    free(m); free(v); free(w); free(s); free(yk);
+}
+
+/* Verified part */
+/*****************/
+/* Upper bound of sign.x'Qx for x in [-1,1]^n, Q given by its upper
+   triangle q, from the certificate y+delta. Returns false if Diag(y+delta)
+   - sign.Q cannot be proved positive definite by an interval LDL'
+   factorisation. */
+static bool t1p_sdp_verify(t1p_internal_t* pr, bound_t res, itv_t* q, size_t n, double* y, double delta, int sign)
+{
+    size_t i, j, k;
+    size_t size = n*(n+1)/2;
+    bool ok = true;
+    num_t num;
+    itv_t tmp, f, sum;
+    itv_t* a = itv_array_alloc(size);
+    num_init(num);
+    itv_init(tmp); itv_init(f); itv_init(sum);
+
+    for (k=0; k<size; k++) {
+	if (sign > 0) itv_neg(a[k], q[k]);
+	else itv_set(a[k], q[k]);
+    }
+    for (i=0; i<n; i++) {
+	num_set_double(num, y[i]+delta);
+	itv_set_num(tmp, num);
+	itv_add(a[T1P_UT(i,i)], a[T1P_UT(i,i)], tmp);
+	if (num_sgn(num) > 0) itv_add(sum, sum, tmp);
+    }
+    /* symmetric elimination, the pivots shall be positive */
+    for (k=0; k<n && ok; k++) {
+	if (bound_sgn(a[T1P_UT(k,k)]->inf) >= 0) ok = false;
+	else {
+	    for (i=k+1; i<n; i++) {
+		itv_div(pr->itv, f, a[T1P_UT(k,i)], a[T1P_UT(k,k)]);
+		for (j=i; j<n; j++) {
+		    itv_mul(pr->itv, tmp, f, a[T1P_UT(k,j)]);
+		    itv_sub(a[T1P_UT(i,j)], a[T1P_UT(i,j)], tmp);
+		}
+	    }
+	}
+    }
+    if (ok) bound_set(res, sum->sup);
+    itv_array_free(a, size);
+    itv_clear(tmp); itv_clear(f); itv_clear(sum);
+    num_clear(num);
+    return ok;
+}
+
+/* as square_dep: sum(Q_ii.[0,1]) + sum_{i<j}(2Q_ij.[-1,1]) */
+static void t1p_sdp_interval_bound(t1p_internal_t* pr, itv_t res, itv_t* q, size_t n)
+{
+    size_t i, j;
+    itv_t tmp, zeroone;
+    itv_init(tmp); itv_init(zeroone);
+    itv_set_int2(zeroone, 0, 1);
+    itv_set_int(res, 0);
+    for (j=0; j<n; j++) {
+	for (i=0; i<j; i++) {
+	    itv_mul_2exp(tmp, q[T1P_UT(i,j)], 1);
+	    itv_mul(pr->itv, tmp, tmp, pr->muu);
+	    itv_add(res, res, tmp);
+	}
+	itv_mul(pr->itv, tmp, q[T1P_UT(j,j)], zeroone);
+	itv_add(res, res, tmp);
+    }
+    itv_clear(tmp); itv_clear(zeroone);
+}
+
+/* upper bound of sign.x'Qx, delta being enlarged while the certificate is
+   not verified */
+static bool t1p_sdp_certify(t1p_internal_t* pr, bound_t res, itv_t* q, double* key, size_t n, double* y, int sign)
+{
+    size_t i, tries;
+    double delta = 0;
+    for (i=0; i<n*(n+1)/2; i++) if (fabs(key[i]) > delta) delta = fabs(key[i]);
+    delta = delta > 0 ? 1e-12*n*delta : DBL_MIN;
+    for (tries=0; tries<4; tries++) {
+	if (t1p_sdp_verify(pr, res, q, n, y, delta, sign)) return true;
+	delta *= 1000;
+    }
+    return false;
+}
+
+static unsigned int t1p_sdp_hash(double* key, size_t size)
+{
+    size_t i;
+    unsigned char* b = (unsigned char*)key;
+    unsigned int res = 2166136261u;
+    for (i=0; i<size*sizeof(double); i++) res = (res ^ b[i]) * 16777619u;
+    return res;
+}
+
+void t1p_sdp_bound(t1p_internal_t* pr, itv_t res, t1p_aff_t* p, t1p_aff_t* q, size_t dim, int* hash)
+{
+    size_t n = dim;
+    size_t size = n*(n+1)/2;
+    size_t i, j;
+    clock_t start = clock();
+    itv_t* array;
+    double *key, *c;
+    unsigned int h;
+    t1p_sdp_entry_t* entry;
+    itv_t sdp;
+
+    if (pr->sdp == NULL) pr->sdp = (struct t1p_sdp_t*)calloc(1, sizeof(struct t1p_sdp_t));
+    array = itv_array_alloc(size);
+    buildIntervalUpperTriangle(pr, array, p, q, dim, hash);
+    t1p_sdp_interval_bound(pr, res, array, n);
+    if (n > 0 && n <= T1P_SDP_MAXDIM) {
+	pr->sdp->calls++;
+	key = buildDoubleUpperTriangle(pr, array, n);
+	h = t1p_sdp_hash(key, size);
+	entry = &pr->sdp->table[h % T1P_SDP_CACHE];
+	if (entry->dim == n && entry->hash == h && !memcmp(entry->key, key, size*sizeof(double))) {
+	    pr->sdp->hits++;
+	    free(key);
+	} else {
+	    /* solve the quadratic form and its opposite */
+	    c = (double*)malloc(n*n*sizeof(double));
+	    for (j=0; j<n; j++) {
+		for (i=0; i<=j; i++) c[i*n+j] = c[j*n+i] = key[T1P_UT(i,j)];
+	    }
+	    if (entry->dim) {
+		free(entry->key);
+		free(entry->y);
+	    }
+	    entry->dim = n;
+	    entry->hash = h;
+	    entry->key = key;
+	    entry->y = (double*)malloc(2*n*sizeof(double));
+	    t1p_sdp_dual(n, c, entry->y);
+	    for (i=0; i<n*n; i++) c[i] = -c[i];
+	    t1p_sdp_dual(n, c, entry->y+n);
+	    free(c);
+	}
+	itv_init(sdp);
+	itv_set(sdp, res);
+	if (!t1p_sdp_certify(pr, sdp->sup, array, entry->key, n, entry->y, 1)) bound_set(sdp->sup, res->sup);
+	if (!t1p_sdp_certify(pr, sdp->inf, array, entry->key, n, entry->y+n, -1)) bound_set(sdp->inf, res->inf);
+	itv_meet(pr->itv, res, res, sdp);
+	itv_clear(sdp);
+    }
+    itv_array_free(array, size);
+    pr->sdp->time += ((double)(clock() - start))/CLOCKS_PER_SEC;
+}
+
+void t1p_sdp_free(t1p_internal_t* pr)
+{
+    size_t i;
+    if (pr->sdp) {
+	for (i=0; i<T1P_SDP_CACHE; i++) {
+	    if (pr->sdp->table[i].dim) {
+		free(pr->sdp->table[i].key);
+		free(pr->sdp->table[i].y);
+	    }
+	}
+	free(pr->sdp);
+	pr->sdp = NULL;
+    }
+}
+
+void ap_manager_t1p_sdp_stats(ap_manager_t* man, size_t* calls, size_t* hits, double* time)
+{
+    t1p_internal_t * pr = t1p_init_from_manager(man, AP_FUNID_UNKNOWN);
+    *calls = pr->sdp ? pr->sdp->calls : 0;
+    *hits = pr->sdp ? pr->sdp->hits : 0;
+    *time = pr->sdp ? pr->sdp->time : 0;
+}
@@ -0,0 +1,63 @@
+/*
+   APRON Library / Taylor1+ Domain (beta version)
+   Copyright (C) 2009-2011 Khalil Ghorbal
+
+*/
+
+
+#ifndef _T1P_SDP_H_
+#define _T1P_SDP_H_
+
+#include "t1p_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bundled solver for the non linear part of the multiplication of two
+   affine forms, used when CSDP is not available.
+
+   The non linear part is the quadratic form x'Qx, x in [-1,1]^dim, where
+   Q is the interval matrix built by buildIntervalUpperTriangle. An upper
+   bound is given by any y such that Diag(y)-Q is positive semidefinite:
+   x'Qx <= sum(max(y_i,0)). Such a y is searched in double precision on the
+   middle of Q by a subgradient descent on the dual of the SDP relaxation,
+   starting from the eigenvalue bound, and is then verified with an
+   interval LDL' factorisation of Diag(y)-Q: the bound is sound whatever
+   the accuracy of the floating-point computations. The lower bound is
+   obtained in the same way with -Q. The result is intersected with the
+   bound of square_dep.
+
+   The certificates y are cached, the key being the middle of Q, so that
+   a quadratic form already seen only requires the verification step. */
+
+#define T1P_SDP_MAXDIM 64	/* beyond, only the bound of square_dep is used */
+#define T1P_SDP_ITER 40		/* iterations of the subgradient descent */
+#define T1P_SDP_CACHE 64	/* entries of the cache (direct mapped) */
+
+/* position of (i,j), i <= j, in an upper triangle stored by columns, as
+   filled by buildIntervalUpperTriangle */
+#define T1P_UT(i,j) ((j)*((j)+1)/2+(i))
+
+typedef struct t1p_sdp_entry_t {
+    size_t dim;		/* 0 if the entry is empty */
+    unsigned int hash;
+    double* key;	/* middle of the upper triangle of Q, dim(dim+1)/2 */
+    double* y;		/* certificates of the upper and lower bounds, 2dim */
+} t1p_sdp_entry_t;
+
+struct t1p_sdp_t {
+    t1p_sdp_entry_t table[T1P_SDP_CACHE];
+    size_t calls;	/* number of solved quadratic forms */
+    size_t hits;	/* number of cache hits */
+    double time;	/* cpu time spent in the solver, in seconds */
+};
+
+/* bound of x'Qx for x in [-1,1]^dim; p, q and hash as for square_dep */
+void t1p_sdp_bound(t1p_internal_t* pr, itv_t res, t1p_aff_t* p, t1p_aff_t* q, size_t dim, int* hash);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,204 @@
+/*
+   APRON Library / Taylor1+ Domain (beta version)
+   Copyright (C) 2009-2011 Khalil Ghorbal
+
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "t1p.h"
+#include "t1p_trace.h"
+
+typedef struct t1p_trace_ring_t {
+    uint64_t head;	/* next record to write, written by the owner only */
+    char pad1[56];
+    uint64_t tail;	/* next record to drain, written by the drainer only */
+    char pad2[56];
+    uint64_t dropped;	/* records lost because the ring was full */
+    int owned;		/* 0 once the owner has exited, the ring can be taken */
+    uint32_t thread;
+    struct t1p_trace_ring_t* next;
+    t1p_trace_record_t rec[T1P_TRACE_RING];
+} t1p_trace_ring_t;
+
+int t1p_trace_on = 0;
+
+/* the rings are never freed, the ring of an exited thread is reused by the
+   next thread */
+static t1p_trace_ring_t* t1p_trace_rings = NULL;
+static uint32_t t1p_trace_nrings = 0;
+static pthread_key_t t1p_trace_key;
+static pthread_once_t t1p_trace_once = PTHREAD_ONCE_INIT;
+
+/* state of the drainer, protected by t1p_trace_lock */
+static pthread_mutex_t t1p_trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static FILE* t1p_trace_file = NULL;
+static pthread_t t1p_trace_drainer;
+static int t1p_trace_stopping = 0;
+
+static void t1p_trace_release(void* arg)
+{
+    t1p_trace_ring_t* ring = (t1p_trace_ring_t*)arg;
+    __atomic_store_n(&ring->owned, 0, __ATOMIC_RELEASE);
+}
+
+static void t1p_trace_key_create(void)
+{
+    pthread_key_create(&t1p_trace_key, t1p_trace_release);
+}
+
+/* ring of the calling thread, NULL if it cannot be allocated */
+static t1p_trace_ring_t* t1p_trace_ring(void)
+{
+    t1p_trace_ring_t* ring = (t1p_trace_ring_t*)pthread_getspecific(t1p_trace_key);
+    if (ring) return ring;
+    for (ring = __atomic_load_n(&t1p_trace_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+	int unowned = 0;
+	if (__atomic_compare_exchange_n(&ring->owned, &unowned, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) break;
+    }
+    if (!ring) {
+	ring = (t1p_trace_ring_t*)calloc(1, sizeof(t1p_trace_ring_t));
+	if (!ring) return NULL;
+	ring->owned = 1;
+	ring->thread = __atomic_fetch_add(&t1p_trace_nrings, 1, __ATOMIC_RELAXED);
+	ring->next = __atomic_load_n(&t1p_trace_rings, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&t1p_trace_rings, &ring->next, ring, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+    pthread_setspecific(t1p_trace_key, ring);
+    return ring;
+}
+
+void t1p_trace_record(ap_funid_t funid, size_t dims, size_t nsym, uint64_t start)
+{
+    uint64_t end = t1p_trace_now();
+    t1p_trace_ring_t* ring;
+    t1p_trace_record_t* rec;
+    uint64_t head;
+    if (!__atomic_load_n(&t1p_trace_on, __ATOMIC_ACQUIRE)) return;
+    ring = t1p_trace_ring();
+    if (!ring) return;
+    head = ring->head;
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) >= T1P_TRACE_RING) {
+	__atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+	return;
+    }
+    rec = &ring->rec[head & (T1P_TRACE_RING-1)];
+    rec->start = start;
+    rec->duration = end - start;
+    rec->thread = ring->thread;
+    rec->funid = (uint16_t)funid;
+    rec->pad = 0;
+    rec->dims = (uint32_t)dims;
+    rec->nsym = (uint32_t)nsym;
+    __atomic_store_n(&ring->head, head+1, __ATOMIC_RELEASE);
+}
+
+/* moves the pending records of all the rings to the file; called by the
+   drainer, or by t1p_trace_stop once the drainer is joined */
+static void t1p_trace_drain(FILE* file)
+{
+    t1p_trace_ring_t* ring;
+    for (ring = __atomic_load_n(&t1p_trace_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+	uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	uint64_t tail = ring->tail;
+	while (tail < head) {
+	    size_t i = (size_t)(tail & (T1P_TRACE_RING-1));
+	    size_t n = T1P_TRACE_RING - i;
+	    if (n > head - tail) n = (size_t)(head - tail);
+	    fwrite(&ring->rec[i], sizeof(t1p_trace_record_t), n, file);
+	    tail += n;
+	}
+	__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+    fflush(file);
+}
+
+static void* t1p_trace_worker(void* arg)
+{
+    FILE* file = (FILE*)arg;
+    struct timespec period = { 0, T1P_TRACE_PERIOD*1000000L };
+    while (!__atomic_load_n(&t1p_trace_stopping, __ATOMIC_ACQUIRE)) {
+	t1p_trace_drain(file);
+	nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+
+bool t1p_trace_start(const char* path)
+{
+    t1p_trace_ring_t* ring;
+    t1p_trace_header_t header;
+    FILE* file;
+    pthread_mutex_lock(&t1p_trace_lock);
+    if (t1p_trace_file) {
+	pthread_mutex_unlock(&t1p_trace_lock);
+	return false;
+    }
+    file = fopen(path, "wb");
+    if (!file) {
+	pthread_mutex_unlock(&t1p_trace_lock);
+	return false;
+    }
+    pthread_once(&t1p_trace_once, t1p_trace_key_create);
+    /* forget the records of a previous trace */
+    for (ring = __atomic_load_n(&t1p_trace_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+	__atomic_store_n(&ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+	__atomic_store_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+    }
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "T1PTRACE", 8);
+    header.version = 1;
+    header.recsize = sizeof(t1p_trace_record_t);
+    header.origin = t1p_trace_now();
+    fwrite(&header, sizeof(header), 1, file);
+    t1p_trace_stopping = 0;
+    if (pthread_create(&t1p_trace_drainer, NULL, t1p_trace_worker, file)) {
+	fclose(file);
+	pthread_mutex_unlock(&t1p_trace_lock);
+	return false;
+    }
+    t1p_trace_file = file;
+    __atomic_store_n(&t1p_trace_on, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&t1p_trace_lock);
+    return true;
+}
+
+size_t t1p_trace_stop(void)
+{
+    t1p_trace_ring_t* ring;
+    size_t dropped = 0;
+    pthread_mutex_lock(&t1p_trace_lock);
+    if (!t1p_trace_file) {
+	pthread_mutex_unlock(&t1p_trace_lock);
+	return 0;
+    }
+    __atomic_store_n(&t1p_trace_on, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&t1p_trace_stopping, 1, __ATOMIC_RELEASE);
+    pthread_join(t1p_trace_drainer, NULL);
+    t1p_trace_drain(t1p_trace_file);
+    for (ring = __atomic_load_n(&t1p_trace_rings, __ATOMIC_ACQUIRE); ring; ring = ring->next) {
+	dropped += (size_t)__atomic_exchange_n(&ring->dropped, 0, __ATOMIC_RELAXED);
+    }
+    fclose(t1p_trace_file);
+    t1p_trace_file = NULL;
+    pthread_mutex_unlock(&t1p_trace_lock);
+    return dropped;
+}
+
+static void t1p_trace_atexit(void)
+{
+    t1p_trace_stop();
+}
+
+void t1p_trace_init_from_env(void)
+{
+    static int registered = 0;
+    const char* path = getenv("T1P_TRACE");
+    if (path && *path && !t1p_trace_enabled() && t1p_trace_start(path)) {
+	if (!__atomic_exchange_n(&registered, 1, __ATOMIC_RELAXED)) atexit(t1p_trace_atexit);
+    }
+}
@@ -0,0 +1,84 @@
+/*
+   APRON Library / Taylor1+ Domain (beta version)
+   Copyright (C) 2009-2011 Khalil Ghorbal
+
+*/
+
+
+#ifndef _T1P_TRACE_H_
+#define _T1P_TRACE_H_
+
+#include <stdint.h>
+#include <time.h>
+
+#include "ap_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Tracing of the operations of the Taylor1+ domain.
+
+   Each thread calling the domain owns a ring of T1P_TRACE_RING fixed size
+   records, written without lock nor system call: the owner is the only
+   writer of head, the drainer the only writer of tail. A background thread
+   started by t1p_trace_start moves the records of all the rings to the
+   trace file every T1P_TRACE_PERIOD milliseconds. When a ring is full, the
+   record is dropped and counted instead of waiting for the drainer.
+
+   The trace file is a t1p_trace_header_t followed by t1p_trace_record_t,
+   in the byte order of the host. The records of one thread are in order;
+   the records of different threads are interleaved by chunks. */
+
+#define T1P_TRACE_RING 4096	/* records per thread, a power of 2 */
+#define T1P_TRACE_PERIOD 10	/* milliseconds between two drains */
+
+typedef struct t1p_trace_header_t {
+    char magic[8];	/* "T1PTRACE" */
+    uint32_t version;	/* 1 */
+    uint32_t recsize;	/* sizeof(t1p_trace_record_t) */
+    uint64_t origin;	/* monotonic clock when the trace was started, in ns */
+} t1p_trace_header_t;
+
+typedef struct t1p_trace_record_t {
+    uint64_t start;	/* monotonic clock at the call, in ns */
+    uint64_t duration;	/* in ns */
+    uint32_t thread;	/* ring of the calling thread, reused after its exit */
+    uint16_t funid;	/* ap_funid_t of the operation */
+    uint16_t pad;
+    uint32_t dims;	/* dimensions of the result */
+    uint32_t nsym;	/* noise symbols of the manager after the call */
+} t1p_trace_record_t;
+
+extern int t1p_trace_on;
+
+static inline bool t1p_trace_enabled(void)
+{
+    return __atomic_load_n(&t1p_trace_on, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t t1p_trace_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec*1000000000 + (uint64_t)ts.tv_nsec;
+}
+
+void t1p_trace_record(ap_funid_t funid, size_t dims, size_t nsym, uint64_t start);
+
+/* starts the trace from T1P_TRACE if it is set in the environment and the
+   trace is not already started, the trace being stopped at exit */
+void t1p_trace_init_from_env(void);
+
+/* to be put at the beginning and before the return of a traced operation */
+#define T1P_TRACE_BEGIN(funid)						\
+    const uint64_t t1p_trace_start_ = t1p_trace_enabled() ? t1p_trace_now() : 0; \
+    const ap_funid_t t1p_trace_funid_ = (funid)
+#define T1P_TRACE_END(pr, dims)						\
+    do { if (t1p_trace_start_) t1p_trace_record(t1p_trace_funid_, (dims), (pr)->dim, t1p_trace_start_); } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ * ctest10.c
+ *
+ * Inclusion test of disjunctions of boxes. A true answer is exact, a false
+ * answer is exact only if the inclusion is disproved.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_disjunction.h"
+#include "box.h"
+
+/* inf <= x0 <= sup */
+static ap_abstract0_t* interval(ap_manager_t* man, int inf, int sup)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(2);
+  ap_linexpr0_t* e;
+  ap_abstract0_t* a;
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_CST_S_INT,-inf,AP_END);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,-1,0,AP_CST_S_INT,sup,AP_END);
+  array.p[1] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  a = ap_abstract0_top(man,0,1);
+  a = ap_abstract0_meet_lincons_array(man,true,a,&array);
+  ap_lincons0_array_clear(&array);
+  return a;
+}
+
+/* the union of [inf1,sup1] and [inf2,sup2] */
+static ap_abstract0_t* interval2(ap_manager_t* man,
+				 int inf1, int sup1, int inf2, int sup2)
+{
+  ap_abstract0_t* a = interval(man,inf1,sup1);
+  ap_abstract0_t* b = interval(man,inf2,sup2);
+  return ap_abstract0_join(man,true,a,b);
+}
+
+static int check(ap_manager_t* man, const char* name,
+		 ap_abstract0_t* a, ap_abstract0_t* b, bool leq, bool exact)
+{
+  bool res;
+
+  man->result.flag_exact = man->result.flag_best = !exact;
+  res = ap_abstract0_is_leq(man,a,b);
+  ap_abstract0_free(man,a);
+  ap_abstract0_free(man,b);
+  if (res!=leq || man->result.flag_exact!=exact || man->result.flag_best!=exact){
+    printf("disjunction is_leq, %s: got %d (exact %d, best %d), expected %d (exact %d)\n",
+	   name,res,man->result.flag_exact,man->result.flag_best,leq,exact);
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manbox = box_manager_alloc();
+  ap_manager_t* man = ap_disjunction_manager_alloc(manbox,NULL);
+  int nbfail = 0;
+
+  nbfail += check(man,"bottom",
+		  ap_abstract0_bottom(man,0,1),interval(man,0,1),
+		  true,true);
+  nbfail += check(man,"top",
+		  interval(man,0,1),ap_abstract0_top(man,0,1),
+		  true,true);
+  nbfail += check(man,"elementwise",
+		  interval2(man,0,1,4,5),interval2(man,-1,2,3,6),
+		  true,true);
+  /* [0,2] is included in the union, but in none of its elements */
+  nbfail += check(man,"covered by a union",
+		  interval(man,0,2),interval2(man,0,1,1,2),
+		  false,false);
+  nbfail += check(man,"not included",
+		  interval(man,0,3),interval2(man,0,1,4,5),
+		  false,false);
+  printf("disjunction is_leq: %d failures\n",nbfail);
+
+  ap_manager_free(man);
+  ap_manager_free(manbox);
+  return nbfail ? 1 : 0;
+}
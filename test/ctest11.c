@@ -0,0 +1,123 @@
+/*
+ * ctest11.c
+ *
+ * Cache of box operations. Repeated operations hit the cache, and nothing is
+ * cached, without failing, if the hash or the equality test is missing.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_cache.h"
+#include "box.h"
+
+/* inf <= x0 <= sup */
+static ap_lincons0_array_t interval_array(int inf, int sup)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(2);
+  ap_linexpr0_t* e;
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_CST_S_INT,-inf,AP_END);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,-1,0,AP_CST_S_INT,sup,AP_END);
+  array.p[1] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  return array;
+}
+
+static ap_abstract0_t* interval(ap_manager_t* man, int inf, int sup)
+{
+  ap_lincons0_array_t array = interval_array(inf,sup);
+  ap_abstract0_t* top = ap_abstract0_top(man,0,2);
+  ap_abstract0_t* a = ap_abstract0_meet_lincons_array(man,false,top,&array);
+  ap_abstract0_free(man,top);
+  ap_lincons0_array_clear(&array);
+  return a;
+}
+
+static bool has_bounds(ap_manager_t* man, ap_abstract0_t* a, int inf, int sup)
+{
+  ap_interval_t* itv = ap_abstract0_bound_dimension(man,a,0);
+  bool res = ap_scalar_cmp_int(itv->inf,inf)==0 && ap_scalar_cmp_int(itv->sup,sup)==0;
+  ap_interval_free(itv);
+  return res;
+}
+
+/* two joins, two inclusion tests and two meets with the same constraints,
+   which give the expected results and the expected number of hits and
+   misses */
+static int test_ops(const char* name, ap_manager_t* man,
+		    size_t nbhits, size_t nbmisses)
+{
+  ap_abstract0_t *a, *b, *j;
+  size_t hits, misses;
+  int k, nbfail = 0;
+
+  for (k=0;k<2;k++){
+    a = interval(man,0,1);
+    b = interval(man,2,3);
+    j = ap_abstract0_join(man,false,a,b);
+    if (!has_bounds(man,a,0,1) || !has_bounds(man,b,2,3) || !has_bounds(man,j,0,3)){
+      printf("cache, %s: wrong result of meet or join\n",name);
+      nbfail++;
+    }
+    if (!ap_abstract0_is_leq(man,a,j) || ap_abstract0_is_leq(man,j,b)){
+      printf("cache, %s: wrong result of is_leq\n",name);
+      nbfail++;
+    }
+    ap_abstract0_free(man,j);
+    ap_abstract0_free(man,b);
+    ap_abstract0_free(man,a);
+  }
+  ap_cache_manager_stats(man,&hits,&misses);
+  if (hits!=nbhits || misses!=nbmisses){
+    printf("cache, %s: %lu hits and %lu misses, expected %lu and %lu\n",name,
+	   (unsigned long)hits,(unsigned long)misses,
+	   (unsigned long)nbhits,(unsigned long)nbmisses);
+    nbfail++;
+  }
+  return nbfail;
+}
+
+/* a cache of a box manager without the function funid */
+static int test_missing(const char* name, ap_funid_t funid, bool before)
+{
+  ap_manager_t* manbox = box_manager_alloc();
+  ap_manager_t* man;
+  int nbfail;
+
+  if (before) manbox->funptr[funid] = NULL;
+  man = ap_cache_manager_alloc(manbox,16);
+  if (!before) manbox->funptr[funid] = NULL;
+  nbfail = test_ops(name,man,0,0);
+  ap_manager_free(man);
+  ap_manager_free(manbox);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manbox = box_manager_alloc();
+  ap_manager_t* man = ap_cache_manager_alloc(manbox,16);
+  int nbfail = 0;
+
+  /* 2 meets with constraints, a join and 2 tests, then all hits */
+  nbfail += test_ops("box",man,5,5);
+  ap_manager_free(man);
+  ap_manager_free(manbox);
+
+  nbfail += test_missing("no hash",AP_FUNID_HASH,true);
+  nbfail += test_missing("no is_eq",AP_FUNID_IS_EQ,true);
+  nbfail += test_missing("hash removed",AP_FUNID_HASH,false);
+  nbfail += test_missing("is_eq removed",AP_FUNID_IS_EQ,false);
+  printf("cache: %d failures\n",nbfail);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * ctest12.c
+ *
+ * Inclusion test of the product of octagons and polyhedra. A negative
+ * answer given by the bounds of the octagons is exact only if these bounds
+ * are the ones of the product.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_pkoct.h"
+#include "oct.h"
+#include "pk.h"
+
+/* the conjunction of the size constraints c[k][0]*x0 + c[k][1]*x1 +
+   c[k][2] >= 0 on 2 integer or real dimensions */
+static ap_abstract0_t* value(ap_manager_t* man, size_t intdim,
+			     int c[][3], size_t size)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(size);
+  ap_linexpr0_t* e;
+  ap_abstract0_t* a;
+  size_t k;
+
+  for (k=0;k<size;k++){
+    e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,c[k][0],0,AP_COEFF_S_INT,c[k][1],1,
+			 AP_CST_S_INT,c[k][2],AP_END);
+    array.p[k] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  }
+  a = ap_abstract0_top(man,intdim,2-intdim);
+  a = ap_abstract0_meet_lincons_array(man,true,a,&array);
+  ap_lincons0_array_clear(&array);
+  return a;
+}
+
+/* a1 <= a2 should be leq; a false answer is exact iff exact */
+static int check(ap_manager_t* man, const char* name,
+		 ap_abstract0_t* a1, ap_abstract0_t* a2, bool leq, bool exact)
+{
+  bool res;
+  int nbfail = 0;
+
+  res = ap_abstract0_is_leq(man,a1,a2);
+  if (res && !leq){
+    printf("pkoct is_leq, %s: unsound true answer\n",name);
+    nbfail++;
+  }
+  else if (!res && man->result.flag_exact!=exact){
+    printf("pkoct is_leq, %s: false answer with flag_exact %d, expected %d\n",
+	   name,man->result.flag_exact,exact);
+    nbfail++;
+  }
+  ap_abstract0_free(man,a1);
+  ap_abstract0_free(man,a2);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manoct = oct_manager_alloc();
+  ap_manager_t* manpk = pk_manager_alloc(false);
+  ap_manager_t* man = ap_pkoct_manager_alloc(manoct,manpk);
+  /* 0<=x0<=1, 0<=x1<=1 */
+  int small[4][3] = { {1,0,0}, {-1,0,1}, {0,1,0}, {0,-1,1} };
+  /* 0<=x0<=2, 0<=x1<=1 */
+  int large[4][3] = { {1,0,0}, {-1,0,2}, {0,1,0}, {0,-1,1} };
+  /* a triangle, of which the integer points are (-1,0), (-1,1) and (0,1),
+     but the rational ones go beyond x1=1 */
+  int triangle[3][3] = { {-1,1,-1}, {-4,-2,2}, {3,-2,3} };
+  /* -1<=x0<=0, 0<=x1<=1 */
+  int hull[4][3] = { {1,0,1}, {-1,0,0}, {0,1,0}, {0,-1,1} };
+  int nbfail = 0;
+
+  nbfail += check(man,"included",
+		  value(man,0,small,4),value(man,0,large,4),
+		  true,true);
+  nbfail += check(man,"real bounds",
+		  value(man,0,large,4),value(man,0,small,4),
+		  false,true);
+  nbfail += check(man,"integer bounds",
+		  value(man,2,triangle,3),value(man,2,hull,4),
+		  true,false);
+  printf("pkoct is_leq: %d failures\n",nbfail);
+
+  ap_manager_free(man);
+  ap_manager_free(manpk);
+  ap_manager_free(manoct);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * ctest13.c
+ *
+ * Disjunctions of polyhedra with worker threads. Meets, assignments and
+ * merges to a bounded size give the same results as without workers.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_disjunction.h"
+#include "pk.h"
+
+#define NBDIMS 3
+#define NBELTS 4
+#define NBWORKERS 3
+#define NBROUNDS 20
+
+/* the union of n polyhedra inf <= x0+k*x1 <= inf+3, x1 >= k, x2 = k*x0 */
+static ap_abstract0_t* value(ap_manager_t* man, int inf, size_t n)
+{
+  ap_abstract0_t* res = ap_abstract0_bottom(man,0,NBDIMS);
+  size_t k;
+
+  for (k=0;k<n;k++){
+    ap_lincons0_array_t array = ap_lincons0_array_make(4);
+    ap_linexpr0_t* e;
+    ap_abstract0_t* a;
+
+    e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_COEFF_S_INT,(int)k,1,AP_CST_S_INT,-inf,AP_END);
+    array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+    e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,-1,0,AP_COEFF_S_INT,-(int)k,1,AP_CST_S_INT,inf+3,AP_END);
+    array.p[1] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+    e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,1,AP_CST_S_INT,-(int)k,AP_END);
+    array.p[2] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+    e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,(int)k,0,AP_COEFF_S_INT,-1,2,AP_END);
+    array.p[3] = ap_lincons0_make(AP_CONS_EQ,e,NULL);
+    a = ap_abstract0_top(man,0,NBDIMS);
+    a = ap_abstract0_meet_lincons_array(man,true,a,&array);
+    res = ap_abstract0_join(man,true,res,a);
+    ap_abstract0_free(man,a);
+    ap_lincons0_array_clear(&array);
+  }
+  return res;
+}
+
+/* same number of disjuncts, pairwise equal */
+static bool equal(ap_manager_t* man, ap_abstract0_t* a, ap_abstract0_t* b)
+{
+  ap_manager_t* manpk = ((ap_disjunction_internal_t*)man->internal)->manager;
+  size_t sizea, sizeb, i;
+  void** ta = ap_disjunction_decompose(man,false,a->value,&sizea);
+  void** tb = ap_disjunction_decompose(man,false,b->value,&sizeb);
+  bool res = sizea==sizeb;
+
+  for (i=0; i<sizea; i++){
+    if (res && i<sizeb && !pk_is_eq(manpk,ta[i],tb[i])) res = false;
+    pk_free(manpk,ta[i]);
+  }
+  for (i=0; i<sizeb; i++) pk_free(manpk,tb[i]);
+  free(ta);
+  free(tb);
+  return res;
+}
+
+/* x0 := x0 + 2*x1 + 1 */
+static ap_abstract0_t* assign(ap_manager_t* man, ap_abstract0_t* a)
+{
+  ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+  ap_dim_t dim = 0;
+  ap_abstract0_t* res;
+
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_COEFF_S_INT,2,1,AP_CST_S_INT,1,AP_END);
+  res = ap_abstract0_assign_linexpr_array(man,false,a,&dim,&e,1,NULL);
+  ap_linexpr0_free(e);
+  return res;
+}
+
+/* the operations on man, with workers, against seq */
+static int test_ops(ap_manager_t* seq, ap_manager_t* man, int round)
+{
+  ap_abstract0_t* a[2];
+  ap_abstract0_t* b[2];
+  ap_abstract0_t* r[2];
+  ap_manager_t* tab[2] = { seq, man };
+  int k, nbfail = 0;
+
+  for (k=0;k<2;k++){
+    a[k] = value(tab[k],round,NBELTS);
+    b[k] = value(tab[k],round+2,NBELTS);
+  }
+  for (k=0;k<2;k++) r[k] = ap_abstract0_meet(tab[k],false,a[k],b[k]);
+  if (!equal(man,r[0],r[1])){
+    printf("disjunction workers, round %d: meet differs\n",round);
+    nbfail++;
+  }
+  for (k=0;k<2;k++) ap_abstract0_free(tab[k],r[k]);
+  for (k=0;k<2;k++) r[k] = assign(tab[k],a[k]);
+  if (!equal(man,r[0],r[1])){
+    printf("disjunction workers, round %d: assignment differs\n",round);
+    nbfail++;
+  }
+  for (k=0;k<2;k++){
+    ap_abstract0_free(tab[k],r[k]);
+    ap_abstract0_free(tab[k],a[k]);
+    ap_abstract0_free(tab[k],b[k]);
+  }
+  return nbfail;
+}
+
+/* joins merged to at most 2 disjuncts */
+static int test_maxsize(ap_manager_t* seq, ap_manager_t* man)
+{
+  ap_manager_t* tab[2] = { seq, man };
+  ap_abstract0_t* r[2];
+  ap_abstract0_t* a;
+  size_t size;
+  int k, nbfail = 0;
+
+  for (k=0;k<2;k++){
+    ap_disjunction_manager_set_maxsize(tab[k],2);
+    r[k] = value(tab[k],0,NBELTS);
+    a = value(tab[k],1,NBELTS);
+    r[k] = ap_abstract0_meet(tab[k],true,r[k],a);
+    ap_abstract0_free(tab[k],a);
+  }
+  size = ((ap_disjunction_t*)r[1]->value)->size;
+  if (size>2 || !equal(man,r[0],r[1])){
+    printf("disjunction workers: merge differs, %lu elements\n",(unsigned long)size);
+    nbfail++;
+  }
+  for (k=0;k<2;k++){
+    ap_abstract0_free(tab[k],r[k]);
+    ap_disjunction_manager_set_maxsize(tab[k],0);
+  }
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manpk = pk_manager_alloc(false);
+  ap_manager_t* seq = ap_disjunction_manager_alloc(manpk,NULL);
+  ap_manager_t* man = ap_disjunction_manager_alloc(manpk,NULL);
+  ap_manager_t* tman[NBWORKERS];
+  int i, nbfail = 0;
+
+  for (i=0;i<NBWORKERS;i++) tman[i] = pk_manager_alloc(false);
+  if (!ap_disjunction_manager_set_workers(man,tman,NBWORKERS)){
+    printf("disjunction workers: cannot start the workers\n");
+    nbfail++;
+  }
+  for (i=0;i<NBWORKERS;i++) ap_manager_free(tman[i]);
+  for (i=0;i<NBROUNDS;i++) nbfail += test_ops(seq,man,i);
+  nbfail += test_maxsize(seq,man);
+  printf("disjunction workers: %d failures\n",nbfail);
+
+  ap_manager_free(man);
+  ap_manager_free(seq);
+  ap_manager_free(manpk);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+/*
+ * ctest14.c
+ *
+ * Lazy reduction of products. The result of a join is reduced again
+ * before it is used, even if the arguments of the join were reduced.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_reducedproduct.h"
+#include "box.h"
+#include "oct.h"
+
+static int nbreduce = 0;
+
+/* counts the reductions, the components are left unchanged */
+static void reduce(ap_manager_t* man, ap_reducedproduct_t* a)
+{
+  nbreduce++;
+}
+static void approximate(ap_manager_t* man, ap_reducedproduct_t* a, int n)
+{
+}
+
+/* inf <= x0 <= inf+1 */
+static ap_abstract0_t* value(ap_manager_t* man, int inf)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(2);
+  ap_linexpr0_t* e;
+  ap_abstract0_t* a;
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_CST_S_INT,-inf,AP_END);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,-1,0,AP_CST_S_INT,inf+1,AP_END);
+  array.p[1] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  a = ap_abstract0_top(man,0,2);
+  a = ap_abstract0_meet_lincons_array(man,true,a,&array);
+  ap_lincons0_array_clear(&array);
+  /* is_bottom reduces its argument */
+  ap_abstract0_is_bottom(man,a);
+  return a;
+}
+
+static bool reduced(ap_abstract0_t* a)
+{
+  return ((ap_reducedproduct_t*)a->value)->reduced;
+}
+
+/* the result of the join of a and b is not reduced, and is reduced once
+   when tested */
+static int check(ap_manager_t* man, const char* name, ap_abstract0_t* r)
+{
+  int n = nbreduce;
+  int nbfail = 0;
+
+  if (reduced(r)){
+    printf("reduced product, %s: the result is marked reduced\n",name);
+    nbfail++;
+  }
+  ap_abstract0_is_bottom(man,r);
+  ap_abstract0_is_bottom(man,r);
+  if (nbreduce!=n+1 || !reduced(r)){
+    printf("reduced product, %s: %d reductions of the result, expected 1\n",
+	   name,nbreduce-n);
+    nbfail++;
+  }
+  ap_abstract0_free(man,r);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manbox = box_manager_alloc();
+  ap_manager_t* manoct = oct_manager_alloc();
+  ap_manager_t* tab[2] = { manbox, manoct };
+  ap_manager_t* man =
+    ap_reducedproduct_manager_alloc("box x oct",tab,2,&reduce,&approximate);
+  ap_abstract0_t* v[2];
+  int nbfail = 0;
+
+  v[0] = value(man,0);
+  v[1] = value(man,4);
+  if (!reduced(v[0]) || !reduced(v[1])){
+    printf("reduced product: the arguments are not reduced\n");
+    nbfail++;
+  }
+  nbfail += check(man,"join",ap_abstract0_join(man,false,v[0],v[1]));
+  nbfail += check(man,"join_array",ap_abstract0_join_array(man,v,2));
+  printf("reduced product: %d failures\n",nbfail);
+
+  ap_abstract0_free(man,v[1]);
+  ap_abstract0_free(man,v[0]);
+  ap_manager_free(man);
+  ap_manager_free(manoct);
+  ap_manager_free(manbox);
+  return nbfail ? 1 : 0;
+}
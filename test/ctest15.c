@@ -0,0 +1,104 @@
+/*
+ * ctest15.c
+ *
+ * SDP bound of the Taylor1+ multiplication. It is used when the algorithm
+ * option of the assignment is INT_MAX, and is sound.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#include "ap_global0.h"
+#include "t1p.h"
+
+#define NBSTEPS 20
+
+/* x0 in [-1,1], x1 = x0 + [0,1], x2 := x0*x1 */
+static ap_interval_t* product(ap_manager_t* man)
+{
+  ap_abstract0_t* a = ap_abstract0_top(man,0,3);
+  ap_texpr0_t* e;
+  ap_interval_t* res;
+
+  e = ap_texpr0_cst_interval_int(-1,1);
+  a = ap_abstract0_assign_texpr(man,true,a,0,e,NULL);
+  ap_texpr0_free(e);
+  e = ap_texpr0_binop(AP_TEXPR_ADD,ap_texpr0_dim(0),ap_texpr0_cst_interval_int(0,1),
+		      AP_RTYPE_REAL,AP_RDIR_RND);
+  a = ap_abstract0_assign_texpr(man,true,a,1,e,NULL);
+  ap_texpr0_free(e);
+  e = ap_texpr0_binop(AP_TEXPR_MUL,ap_texpr0_dim(0),ap_texpr0_dim(1),
+		      AP_RTYPE_REAL,AP_RDIR_RND);
+  a = ap_abstract0_assign_texpr(man,true,a,2,e,NULL);
+  ap_texpr0_free(e);
+  res = ap_abstract0_bound_dimension(man,a,2);
+  ap_abstract0_free(man,a);
+  return res;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* man = t1p_manager_alloc();
+  ap_funopt_t funopt = ap_manager_get_funopt(man,AP_FUNID_ASSIGN_TEXPR_ARRAY);
+  ap_interval_t* itv;
+  ap_interval_t* ref;
+  ap_scalar_t* x;
+  size_t calls, hits;
+  double time;
+  int i, j, nbfail = 0;
+
+  ref = product(man);
+  ap_manager_t1p_sdp_stats(man,&calls,&hits,&time);
+  if (calls!=0){
+    printf("t1p sdp: %lu solves without the option\n",(unsigned long)calls);
+    nbfail++;
+  }
+  funopt.algorithm = INT_MAX;
+  ap_manager_set_funopt(man,AP_FUNID_ASSIGN_TEXPR_ARRAY,&funopt);
+  itv = product(man);
+  ap_manager_t1p_sdp_stats(man,&calls,&hits,&time);
+  if (calls==0){
+    printf("t1p sdp: no solve with the option\n");
+    nbfail++;
+  }
+  /* the bound is at least as tight as the default one, and contains x0*x1
+     for x0 in [-1,1] and x1-x0 in [0,1] */
+  if (!ap_interval_is_leq(itv,ref)){
+    printf("t1p sdp: bound larger than the default one\n");
+    nbfail++;
+  }
+  x = ap_scalar_alloc();
+  for (i=0;i<=NBSTEPS;i++){
+    for (j=0;j<=NBSTEPS;j++){
+      double x0 = -1.0 + 2.0*i/NBSTEPS;
+      double x1 = x0 + (double)j/NBSTEPS;
+      ap_scalar_set_double(x,x0*x1);
+      if (ap_scalar_cmp(itv->inf,x)>0 || ap_scalar_cmp(itv->sup,x)<0){
+	printf("t1p sdp: %g*%g not in the bound ",x0,x1);
+	ap_interval_fprint(stdout,itv);
+	printf("\n");
+	nbfail++;
+	i = NBSTEPS;
+	break;
+      }
+    }
+  }
+  ap_scalar_free(x);
+  printf("t1p sdp: %lu solves, bound ",(unsigned long)calls);
+  ap_interval_fprint(stdout,itv);
+  printf(", default ");
+  ap_interval_fprint(stdout,ref);
+  printf(", %d failures\n",nbfail);
+
+  ap_interval_free(itv);
+  ap_interval_free(ref);
+  ap_manager_free(man);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * ctest16.c
+ *
+ * Policy iteration with octagons and boxes on the loops
+ *   x:=0; y:=0; while (x<=99) { x++; y+=2; }
+ *   x:=0; y:=0; while (x<=99) { x++; y:=2x; }
+ * against the same resolution with exact meets, that is, upward iterations
+ * with widening followed by descending iterations.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_policy_iteration.h"
+#include "box.h"
+#include "box_policy.h"
+#include "oct.h"
+#include "oct_policy.h"
+
+typedef struct env_t {
+  ap_manager_t* man;
+  bool exact;  /* exact meets instead of policy meets */
+  bool dbl;    /* y:=2x instead of y+=2 */
+} env_t;
+
+/* unknowns: 0 the head of the loop, 1 its exit */
+static ap_policy_transition_t trans[2] = { {0,0}, {0,1} };
+
+/* x>=100 if exit, x<=99 otherwise */
+static ap_lincons0_array_t guard(bool exit)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(1);
+  ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+
+  if (exit)
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_CST_S_INT,-100,AP_END);
+  else
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,-1,0,AP_CST_S_INT,99,AP_END);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  return array;
+}
+
+/* the transition k from a */
+static ap_abstract0_t* transfer(ap_policy_iteration_t* pit, void* penv,
+				size_t k, ap_abstract0_t* a)
+{
+  env_t* env = (env_t*)penv;
+  ap_manager_t* man = env->man;
+  ap_lincons0_array_t array = guard(k==1);
+  ap_abstract0_t* res;
+
+  res = env->exact ?
+    ap_abstract0_meet_lincons_array(man,false,a,&array) :
+    ap_policy_iteration_meet_lincons_array(pit,false,a,&array);
+  ap_lincons0_array_clear(&array);
+  if (k==0){
+    ap_linexpr0_t* e[2];
+    ap_dim_t dim[2] = { 0, 1 };
+    e[0] = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+    ap_linexpr0_set_list(e[0],AP_COEFF_S_INT,1,0,AP_CST_S_INT,1,AP_END);
+    e[1] = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+    if (env->dbl)
+      ap_linexpr0_set_list(e[1],AP_COEFF_S_INT,2,0,AP_CST_S_INT,2,AP_END);
+    else
+      ap_linexpr0_set_list(e[1],AP_COEFF_S_INT,1,1,AP_CST_S_INT,2,AP_END);
+    res = ap_abstract0_assign_linexpr_array(man,true,res,dim,e,2,NULL);
+    ap_linexpr0_free(e[0]);
+    ap_linexpr0_free(e[1]);
+  }
+  return res;
+}
+
+/* x=0, y=0 */
+static ap_abstract0_t* init(ap_manager_t* man)
+{
+  ap_abstract0_t* a = ap_abstract0_top(man,0,2);
+  ap_linexpr0_t* e[2];
+  ap_dim_t dim[2] = { 0, 1 };
+
+  e[0] = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,0);
+  ap_linexpr0_set_cst_scalar_int(e[0],0);
+  e[1] = ap_linexpr0_copy(e[0]);
+  a = ap_abstract0_assign_linexpr_array(man,true,a,dim,e,2,NULL);
+  ap_linexpr0_free(e[0]);
+  ap_linexpr0_free(e[1]);
+  return a;
+}
+
+/* 0<=x<=100 at the head of the loop, and x=100 at its exit */
+static bool bounded(ap_manager_t* man, ap_abstract0_t** x)
+{
+  ap_interval_t* head = ap_abstract0_bound_dimension(man,x[0],0);
+  ap_interval_t* exit = ap_abstract0_bound_dimension(man,x[1],0);
+  bool res =
+    ap_scalar_equal_int(head->inf,0) && ap_scalar_equal_int(head->sup,100) &&
+    ap_scalar_equal_int(exit->inf,100) && ap_scalar_equal_int(exit->sup,100);
+  ap_interval_free(head);
+  ap_interval_free(exit);
+  return res;
+}
+
+static ap_abstract0_t** solve(ap_policy_manager_t* pman, env_t* env,
+			      size_t descending, size_t* steps)
+{
+  ap_abstract0_t* tinit[2];
+  ap_policy_system_t system;
+  ap_policy_iteration_option_t option;
+  ap_policy_iteration_stats_t stats;
+  ap_abstract0_t** x;
+
+  tinit[0] = init(env->man);
+  tinit[1] = NULL;
+  system.size = 2;
+  system.intdim = 0;
+  system.realdim = 2;
+  system.init = tinit;
+  system.trans = trans;
+  system.nbtrans = 2;
+  system.transfer = &transfer;
+  system.env = env;
+  ap_policy_iteration_option_init(&option);
+  option.descending = descending;
+  x = ap_policy_iteration_solve(pman,&system,&option,&stats);
+  ap_abstract0_free(env->man,tinit[0]);
+  *steps = stats.steps;
+  return x;
+}
+
+/* the policies give the bounds of the widening and descending iterations,
+   with descending iterations or not, in no more steps, and in less steps
+   if strict */
+static int test(ap_policy_manager_t* pman, bool dbl, bool strict)
+{
+  ap_manager_t* man = pman->man;
+  const char* name = dbl ? "y:=2x" : "y+=2";
+  env_t env;
+  ap_policy_iteration_option_t option;
+  ap_abstract0_t** x;
+  ap_abstract0_t** w;
+  size_t wsteps, steps, descending;
+  int i, nbfail = 0;
+
+  env.man = man;
+  env.dbl = dbl;
+  env.exact = true;
+  ap_policy_iteration_option_init(&option);
+  w = solve(pman,&env,option.descending,&wsteps);
+  if (!bounded(man,w)){
+    printf("policy iteration, %s, %s: x not bounded by 100 with widening\n",
+	   man->library,name);
+    nbfail++;
+  }
+  env.exact = false;
+  for (descending=0; descending<=option.descending; descending+=option.descending){
+    x = solve(pman,&env,descending,&steps);
+    printf("policy iteration, %s, %s, descending %lu: %lu steps, widening %lu steps\n",
+	   man->library,name,(unsigned long)descending,
+	   (unsigned long)steps,(unsigned long)wsteps);
+    if (!bounded(man,x)){
+      printf("policy iteration, %s, %s, descending %lu: x not bounded by 100\n",
+	     man->library,name,(unsigned long)descending);
+      nbfail++;
+    }
+    for (i=0;i<2;i++){
+      if (!ap_abstract0_is_leq(man,x[i],w[i])){
+	printf("policy iteration, %s, %s: unknown %d less precise than with widening\n",
+	       man->library,name,i);
+	nbfail++;
+      }
+    }
+    if (steps>wsteps || (strict && steps==wsteps)){
+      printf("policy iteration, %s, %s: %s steps than with widening\n",
+	     man->library,name,steps>wsteps ? "more" : "as many");
+      nbfail++;
+    }
+    for (i=0;i<2;i++) ap_abstract0_free(man,x[i]);
+    free(x);
+  }
+  for (i=0;i<2;i++) ap_abstract0_free(man,w[i]);
+  free(w);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manoct = oct_manager_alloc();
+  ap_manager_t* manbox = box_manager_alloc();
+  ap_policy_manager_t* pmanoct = oct_policy_manager_alloc(manoct);
+  ap_policy_manager_t* pmanbox = box_policy_manager_alloc(manbox);
+  int nbfail = 0;
+
+  /* the bound of x given by the relational entries of octagons still needs
+     widening */
+  nbfail += test(pmanoct,false,false);
+  nbfail += test(pmanoct,true,false);
+  nbfail += test(pmanbox,false,true);
+  nbfail += test(pmanbox,true,true);
+  printf("policy iteration: %d failures\n",nbfail);
+
+  ap_policy_manager_free(pmanbox);
+  ap_policy_manager_free(pmanoct);
+  ap_manager_free(manbox);
+  ap_manager_free(manoct);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,118 @@
+/*
+ * ctest17.c
+ *
+ * Meet and join of abstract values of level 1 defined on different
+ * environments: they are embedded in the least common environment, of
+ * which no reference is lost.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global1.h"
+#include "box.h"
+
+/* inf <= var <= sup on env */
+static ap_abstract1_t value(ap_manager_t* man, ap_environment_t* env,
+			    char* var, int inf, int sup)
+{
+  ap_var_t tvar[1] = { var };
+  ap_interval_t* titv[1];
+  ap_abstract1_t a;
+
+  titv[0] = ap_interval_alloc();
+  ap_interval_set_int(titv[0],inf,sup);
+  a = ap_abstract1_of_box(man,env,tvar,titv,1);
+  ap_interval_free(titv[0]);
+  return a;
+}
+
+/* the bounds of var in a are inf and sup */
+static bool bounds(ap_manager_t* man, ap_abstract1_t* a, char* var,
+		   int inf, int sup)
+{
+  ap_interval_t* itv = ap_abstract1_bound_variable(man,a,var);
+  bool res =
+    ap_scalar_equal_int(itv->inf,inf) && ap_scalar_equal_int(itv->sup,sup);
+  ap_interval_free(itv);
+  return res;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* man = box_manager_alloc();
+  ap_var_t txy[2] = { "x", "y" };
+  ap_var_t tx[1] = { "x" };
+  ap_environment_t* envxy = ap_environment_alloc(NULL,0,txy,2);
+  ap_environment_t* envx = ap_environment_alloc(NULL,0,tx,1);
+  ap_environment_t* envi = ap_environment_alloc(tx,1,NULL,0);
+  ap_abstract1_t a1, a2, r;
+  size_t count;
+  int nbfail = 0;
+
+  /* destructive meet, of which the result is the first argument */
+  a1 = value(man,envxy,"y",0,1);
+  a2 = value(man,envx,"x",2,3);
+  count = envxy->count;
+  a1 = ap_abstract1_meet(man,true,&a1,&a2);
+  if (man->result.exn!=AP_EXC_NONE){
+    printf("abstract1 meet: exception on different environments\n");
+    nbfail++;
+  }
+  if (a1.env!=envxy || envxy->count!=count){
+    printf("abstract1 meet: %lu references to the environment, expected %lu\n",
+	   (unsigned long)envxy->count,(unsigned long)count);
+    nbfail++;
+  }
+  if (!bounds(man,&a1,"x",2,3) || !bounds(man,&a1,"y",0,1)){
+    printf("abstract1 meet: wrong bounds\n");
+    nbfail++;
+  }
+  ap_abstract1_clear(man,&a1);
+
+  /* join, the first argument being embedded */
+  a1 = value(man,envxy,"y",0,1);
+  r = ap_abstract1_join(man,false,&a2,&a1);
+  if (man->result.exn!=AP_EXC_NONE){
+    printf("abstract1 join: exception on different environments\n");
+    nbfail++;
+  }
+  /* y is unconstrained in a2 once embedded */
+  if (!ap_environment_is_eq(r.env,envxy) || !ap_abstract1_is_top(man,&r)){
+    printf("abstract1 join: wrong result\n");
+    nbfail++;
+  }
+  ap_abstract1_clear(man,&r);
+  ap_abstract1_clear(man,&a1);
+  ap_abstract1_clear(man,&a2);
+
+  /* no least common environment */
+  a1 = value(man,envx,"x",0,1);
+  a2 = value(man,envi,"x",0,1);
+  r = ap_abstract1_meet(man,false,&a1,&a2);
+  if (man->result.exn!=AP_EXC_INVALID_ARGUMENT){
+    printf("abstract1 meet: no exception on incompatible environments\n");
+    nbfail++;
+  }
+  ap_abstract1_clear(man,&r);
+  ap_abstract1_clear(man,&a1);
+  ap_abstract1_clear(man,&a2);
+
+  if (envxy->count!=1 || envx->count!=1 || envi->count!=1){
+    printf("abstract1: references to the environments left\n");
+    nbfail++;
+  }
+  printf("abstract1 meet and join: %d failures\n",nbfail);
+
+  ap_environment_free(envi);
+  ap_environment_free(envx);
+  ap_environment_free(envxy);
+  ap_manager_free(man);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * ctest18.c
+ *
+ * NewPolka grids, against their definition by congruences: random grids
+ * of dimension 2 are defined by congruences, and the integer points of the
+ * results of the operations, read from their constraints, are compared
+ * with the ones given by the congruences of the arguments.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "pkgrid.h"
+
+#define NBROUNDS 40
+#define WINDOW 10  /* the points tested are in [-WINDOW,WINDOW]^2 */
+#define MAXCONS 2
+
+/* c[0]*x + c[1]*y + c[2] = 0 mod c[3] (c[3]==0 for an equality) */
+typedef struct grid_t {
+  int size;
+  int c[MAXCONS][4];
+} grid_t;
+
+static unsigned int seed = 1;
+
+static int rnd(int n)
+{
+  seed = seed*1103515245 + 12345;
+  return (int)((seed>>16) % n);
+}
+
+static grid_t random_grid(void)
+{
+  static const int mod[5] = { 0, 2, 3, 4, 6 };
+  grid_t g;
+  int i;
+
+  g.size = 1+rnd(MAXCONS);
+  for (i=0;i<g.size;i++){
+    do {
+      g.c[i][0] = rnd(3)-1;
+      g.c[i][1] = rnd(3)-1;
+    } while (g.c[i][0]==0 && g.c[i][1]==0);
+    g.c[i][3] = mod[rnd(5)];
+    g.c[i][2] = rnd(g.c[i][3] ? g.c[i][3] : 5);
+  }
+  return g;
+}
+
+/* the integer point (x,y) belongs to g */
+static bool grid_sat(grid_t* g, int x, int y)
+{
+  int i;
+  for (i=0;i<g->size;i++){
+    int v = g->c[i][0]*x + g->c[i][1]*y + g->c[i][2];
+    if (g->c[i][3] ? v % g->c[i][3] != 0 : v!=0) return false;
+  }
+  return true;
+}
+
+static ap_abstract0_t* grid_abstract(ap_manager_t* man, grid_t* g)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(g->size);
+  ap_abstract0_t* a;
+  int i;
+
+  for (i=0;i<g->size;i++){
+    ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_DENSE,2);
+    ap_linexpr0_set_list(e,AP_COEFF_S_INT,g->c[i][0],0,AP_COEFF_S_INT,g->c[i][1],1,
+			 AP_CST_S_INT,g->c[i][2],AP_END);
+    if (g->c[i][3]){
+      ap_scalar_t* mod = ap_scalar_alloc();
+      ap_scalar_set_int(mod,g->c[i][3]);
+      array.p[i] = ap_lincons0_make(AP_CONS_EQMOD,e,mod);
+    }
+    else
+      array.p[i] = ap_lincons0_make(AP_CONS_EQ,e,NULL);
+  }
+  a = ap_abstract0_top(man,0,2);
+  a = ap_abstract0_meet_lincons_array(man,true,a,&array);
+  ap_lincons0_array_clear(&array);
+  return a;
+}
+
+/* the integer point (x,y) satisfies the constraint, exactly */
+static bool lincons_sat(ap_lincons0_t* cons, int x, int y)
+{
+  mpq_t v, c, val;
+  size_t i;
+  ap_dim_t dim;
+  ap_coeff_t* coeff;
+  int sgn;
+  bool res;
+
+  mpq_init(v); mpq_init(c); mpq_init(val);
+  ap_mpq_set_scalar(v,cons->linexpr0->cst.val.scalar,0);
+  ap_linexpr0_ForeachLinterm(cons->linexpr0,i,dim,coeff){
+    ap_mpq_set_scalar(c,coeff->val.scalar,0);
+    mpq_set_si(val,dim==0 ? x : y,1);
+    mpq_mul(c,c,val);
+    mpq_add(v,v,c);
+  }
+  sgn = mpq_sgn(v);
+  switch (cons->constyp){
+  case AP_CONS_EQ: res = sgn==0; break;
+  case AP_CONS_SUPEQ: res = sgn>=0; break;
+  case AP_CONS_SUP: res = sgn>0; break;
+  case AP_CONS_DISEQ: res = sgn!=0; break;
+  case AP_CONS_EQMOD:
+    ap_mpq_set_scalar(c,cons->scalar,0);
+    if (mpq_sgn(c)==0)
+      res = sgn==0;
+    else {
+      mpq_div(v,v,c);
+      res = mpz_cmp_ui(mpq_denref(v),1)==0;
+    }
+    break;
+  default: abort();
+  }
+  mpq_clear(v); mpq_clear(c); mpq_clear(val);
+  return res;
+}
+
+/* the integer point (x,y) belongs to a, according to its constraints */
+static bool abstract_sat(ap_lincons0_array_t* array, int x, int y)
+{
+  size_t i;
+  for (i=0;i<array->size;i++){
+    if (!lincons_sat(&array->p[i],x,y)) return false;
+  }
+  return true;
+}
+
+/* the points of a are the ones of the predicate, or include them if
+   !exact */
+typedef bool (*pred_t)(grid_t* g1, grid_t* g2, int x, int y);
+
+static int check(ap_manager_t* man, const char* name, ap_abstract0_t* a,
+		 pred_t pred, grid_t* g1, grid_t* g2, bool exact)
+{
+  ap_lincons0_array_t array = ap_abstract0_to_lincons_array(man,a);
+  int x, y, nbfail = 0;
+
+  for (x=-WINDOW; x<=WINDOW && !nbfail; x++){
+    for (y=-WINDOW; y<=WINDOW && !nbfail; y++){
+      bool p = pred(g1,g2,x,y);
+      bool s = abstract_sat(&array,x,y);
+      if (p ? !s : (exact && s)){
+	printf("pkgrid %s: point (%d,%d) %s\n",name,x,y,
+	       p ? "missing" : "not expected");
+	ap_lincons0_array_fprint(stdout,&array,NULL);
+	nbfail++;
+      }
+    }
+  }
+  ap_lincons0_array_clear(&array);
+  ap_abstract0_free(man,a);
+  return nbfail;
+}
+
+static bool pred_id(grid_t* g1, grid_t* g2, int x, int y)
+{ return grid_sat(g1,x,y); }
+static bool pred_meet(grid_t* g1, grid_t* g2, int x, int y)
+{ return grid_sat(g1,x,y) && grid_sat(g2,x,y); }
+static bool pred_join(grid_t* g1, grid_t* g2, int x, int y)
+{ return grid_sat(g1,x,y) || grid_sat(g2,x,y); }
+/* x := x+2y+1, of inverse x := x-2y-1 */
+static bool pred_assign(grid_t* g1, grid_t* g2, int x, int y)
+{ return grid_sat(g1,x-2*y-1,y); }
+static bool pred_substitute(grid_t* g1, grid_t* g2, int x, int y)
+{ return grid_sat(g1,x+2*y+1,y); }
+/* the coefficients of x are 1, 0 or -1, so that an integer x fits if any */
+static bool pred_forget(grid_t* g1, grid_t* g2, int x, int y)
+{
+  int x1;
+  for (x1=-WINDOW-12; x1<=WINDOW+12; x1++){
+    if (grid_sat(g1,x1,y)) return true;
+  }
+  return false;
+}
+
+static ap_abstract0_t* asssub(ap_manager_t* man, bool assign, ap_abstract0_t* a)
+{
+  ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+  ap_dim_t dim = 0;
+  ap_abstract0_t* res;
+
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_COEFF_S_INT,2,1,AP_CST_S_INT,1,AP_END);
+  res = assign ?
+    ap_abstract0_assign_linexpr_array(man,false,a,&dim,&e,1,NULL) :
+    ap_abstract0_substitute_linexpr_array(man,false,a,&dim,&e,1,NULL);
+  ap_linexpr0_free(e);
+  return res;
+}
+
+static int test(ap_manager_t* man)
+{
+  grid_t g1 = random_grid();
+  grid_t g2 = random_grid();
+  ap_abstract0_t* a1 = grid_abstract(man,&g1);
+  ap_abstract0_t* a2 = grid_abstract(man,&g2);
+  ap_abstract0_t* join;
+  ap_abstract0_t* widening;
+  ap_dim_t dim = 0;
+  bool leq, subset;
+  int x, y, nbfail = 0;
+
+  nbfail += check(man,"to_lincons",ap_abstract0_copy(man,a1),&pred_id,&g1,&g2,true);
+  nbfail += check(man,"meet",ap_abstract0_meet(man,false,a1,a2),&pred_meet,&g1,&g2,true);
+  join = ap_abstract0_join(man,false,a1,a2);
+  nbfail += check(man,"assign",asssub(man,true,a1),&pred_assign,&g1,&g2,true);
+  nbfail += check(man,"substitute",asssub(man,false,a1),&pred_substitute,&g1,&g2,true);
+  nbfail += check(man,"forget",ap_abstract0_forget_array(man,false,a1,&dim,1,false),
+		  &pred_forget,&g1,&g2,true);
+  /* the join and the widening include the arguments */
+  if (!ap_abstract0_is_leq(man,a1,join) || !ap_abstract0_is_leq(man,a2,join)){
+    printf("pkgrid join: not an upper bound\n");
+    nbfail++;
+  }
+  widening = ap_abstract0_widening(man,a1,join);
+  if (!ap_abstract0_is_leq(man,join,widening)){
+    printf("pkgrid widening: not an upper bound\n");
+    nbfail++;
+  }
+  nbfail += check(man,"join",join,&pred_join,&g1,&g2,false);
+  nbfail += check(man,"widening",widening,&pred_join,&g1,&g2,false);
+  /* is_leq is true only if the points of a1 are in a2, and false if an
+     integer point of a1 is not in a2 */
+  leq = ap_abstract0_is_leq(man,a1,a2);
+  subset = true;
+  for (x=-WINDOW; x<=WINDOW; x++){
+    for (y=-WINDOW; y<=WINDOW; y++){
+      if (grid_sat(&g1,x,y) && !grid_sat(&g2,x,y)) subset = false;
+    }
+  }
+  if (leq && !subset){
+    printf("pkgrid is_leq: true but not included\n");
+    nbfail++;
+  }
+  ap_abstract0_free(man,a1);
+  ap_abstract0_free(man,a2);
+  return nbfail;
+}
+
+/* x = 0 mod 4 join x = 2 mod 4 is x = 0 mod 2 */
+static int test_join(ap_manager_t* man)
+{
+  grid_t g1 = { 1, { { 1,0,0,4 } } };
+  grid_t g2 = { 1, { { 1,0,2,4 } } };
+  grid_t g = { 1, { { 1,0,0,2 } } };
+  ap_abstract0_t* a1 = grid_abstract(man,&g1);
+  ap_abstract0_t* a2 = grid_abstract(man,&g2);
+  ap_abstract0_t* a = grid_abstract(man,&g);
+  ap_abstract0_t* join = ap_abstract0_join(man,false,a1,a2);
+  int nbfail = 0;
+
+  if (!ap_abstract0_is_eq(man,join,a)){
+    printf("pkgrid join: not the least upper bound\n");
+    nbfail++;
+  }
+  if (ap_abstract0_is_leq(man,a,a1)){
+    printf("pkgrid is_leq: x = 0 mod 2 included in x = 0 mod 4\n");
+    nbfail++;
+  }
+  ap_abstract0_free(man,join);
+  ap_abstract0_free(man,a);
+  ap_abstract0_free(man,a2);
+  ap_abstract0_free(man,a1);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* man = pkgrid_manager_alloc();
+  int i, nbfail = 0;
+
+  nbfail += test_join(man);
+  for (i=0;i<NBROUNDS;i++) nbfail += test(man);
+  printf("pkgrid: %d failures\n",nbfail);
+
+  ap_manager_free(man);
+  return nbfail ? 1 : 0;
+}
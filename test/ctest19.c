@@ -0,0 +1,121 @@
+/*
+ * ctest19.c
+ *
+ * Profiling of a manager: the calls of each function are counted with the
+ * dimensions of their arguments and results, the statistics are reset when
+ * profiling is enabled again, and are not available when it is disabled.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ap_global0.h"
+#include "box.h"
+
+/* inf <= x0 on dimension 3 */
+static ap_abstract0_t* value(ap_manager_t* man, ap_abstract0_t* top, int inf)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(1);
+  ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_abstract0_t* a;
+
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_CST_S_INT,-inf,AP_END);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  a = ap_abstract0_meet_lincons_array(man,false,top,&array);
+  ap_lincons0_array_clear(&array);
+  return a;
+}
+
+/* funid was called ncalls times, on arguments (and with results if
+   result) of dimension 3, that is, in the bucket 2 of [2,4[ */
+static int check(ap_manager_t* man, ap_funid_t funid, unsigned long ncalls,
+		 bool result)
+{
+  const ap_funprofile_t* f = ap_manager_profile_get(man,funid);
+  unsigned long ndimout = result ? ncalls : 0;
+  int nbfail = 0;
+
+  if (f==NULL){
+    printf("profile %s: no statistics\n",ap_name_of_funid[funid]);
+    return 1;
+  }
+  if (f->ncalls!=ncalls){
+    printf("profile %s: %lu calls, expected %lu\n",
+	   ap_name_of_funid[funid],f->ncalls,ncalls);
+    nbfail++;
+  }
+  if (f->dimin[2]!=ncalls || f->dimout[2]!=ndimout){
+    printf("profile %s: %lu arguments and %lu results of dimension 3, expected %lu and %lu\n",
+	   ap_name_of_funid[funid],f->dimin[2],f->dimout[2],ncalls,ndimout);
+    nbfail++;
+  }
+  if (f->nexact>f->ncalls || f->nbest>f->ncalls || f->time_max>f->time){
+    printf("profile %s: inconsistent statistics\n",ap_name_of_funid[funid]);
+    nbfail++;
+  }
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* man = box_manager_alloc();
+  ap_abstract0_t* top;
+  ap_abstract0_t* a1;
+  ap_abstract0_t* a2;
+  ap_abstract0_t* join;
+  char* json;
+  int nbfail = 0;
+
+  ap_manager_profile_disable(man);
+  top = ap_abstract0_top(man,0,3);
+  if (ap_manager_profile_get(man,AP_FUNID_TOP)){
+    printf("profile: statistics while disabled\n");
+    nbfail++;
+  }
+  ap_manager_profile_enable(man,NULL);
+  a1 = value(man,top,0);
+  a2 = value(man,top,2);
+  join = ap_abstract0_join(man,false,a1,a2);
+  ap_abstract0_is_leq(man,a2,join);
+  ap_abstract0_is_leq(man,join,a2);
+  ap_abstract0_is_leq(man,a1,join);
+  nbfail += check(man,AP_FUNID_TOP,0,true);
+  nbfail += check(man,AP_FUNID_MEET_LINCONS_ARRAY,2,true);
+  nbfail += check(man,AP_FUNID_JOIN,1,true);
+  nbfail += check(man,AP_FUNID_IS_LEQ,3,false);
+  nbfail += check(man,AP_FUNID_WIDENING,0,true);
+  json = ap_manager_profile_sprint_json(man);
+  if (strstr(json,"\"join\":{\"calls\":1,")==NULL ||
+      strstr(json,"\"is_leq\":{\"calls\":3,")==NULL ||
+      strstr(json,"\"widening\"")!=NULL){
+    printf("profile: wrong JSON %s\n",json);
+    nbfail++;
+  }
+  free(json);
+
+  /* enabling again resets the statistics */
+  ap_manager_profile_enable(man,NULL);
+  ap_abstract0_is_leq(man,a1,join);
+  nbfail += check(man,AP_FUNID_JOIN,0,true);
+  nbfail += check(man,AP_FUNID_IS_LEQ,1,false);
+  ap_manager_profile_disable(man);
+  if (ap_manager_profile_get(man,AP_FUNID_IS_LEQ)){
+    printf("profile: statistics after disabling\n");
+    nbfail++;
+  }
+  printf("profile: %d failures\n",nbfail);
+
+  ap_abstract0_free(man,join);
+  ap_abstract0_free(man,a2);
+  ap_abstract0_free(man,a1);
+  ap_abstract0_free(man,top);
+  ap_manager_free(man);
+  return nbfail ? 1 : 0;
+}
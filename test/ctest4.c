@@ -0,0 +1,158 @@
+/*
+ * ctest4.c
+ *
+ * Stress testing. Concurrent analyses with manager pools
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <pthread.h>
+
+#include "../apron/ap_global0.h"
+
+#include "../newpolka/pk.h"
+#include "../octagons/oct.h"
+
+#define NBDIMS 6
+#define NJOBS 64
+#define NTHREADS 8
+#define NITER 12
+
+typedef struct pool_test_t {
+  const char* name;
+  ap_manager_pool_t* pool;
+  ap_abstract0_t* base[NJOBS]; /* copies of the same value */
+  ap_abstract0_t* res[NJOBS];  /* computed by the threads */
+  unsigned next;               /* next job */
+} pool_test_t;
+
+static ap_manager_t* alloc_pk(void* arg)
+{ return pk_manager_alloc(false); }
+static ap_manager_t* alloc_oct(void* arg)
+{ return oct_manager_alloc(); }
+
+/* random constraints a*xi + b*xj + c >= 0 */
+static ap_lincons0_array_t random_array(unsigned* seed, size_t size)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(size);
+  size_t k;
+  for (k=0;k<size;k++){
+    ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    e->p.linterm[0].dim = rand_r(seed)%(NBDIMS/2);
+    e->p.linterm[1].dim = NBDIMS/2 + rand_r(seed)%(NBDIMS/2);
+    ap_coeff_set_scalar_int(&e->p.linterm[0].coeff,rand_r(seed)%3-1);
+    ap_coeff_set_scalar_int(&e->p.linterm[1].coeff,rand_r(seed)%3-1);
+    ap_coeff_set_scalar_int(&e->cst,rand_r(seed)%20);
+    array.p[k] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  }
+  return array;
+}
+
+/* the analysis of a job depends only on its number */
+static ap_abstract0_t* job(ap_manager_t* man, ap_abstract0_t* base, unsigned k)
+{
+  unsigned seed = k;
+  ap_abstract0_t* acc = ap_abstract0_copy(man,base);
+  int i;
+  for (i=0;i<NITER;i++){
+    ap_lincons0_array_t array = random_array(&seed,3);
+    ap_abstract0_t* a = ap_abstract0_meet_lincons_array(man,false,base,&array);
+    ap_abstract0_t* j = ap_abstract0_join(man,false,acc,a);
+    ap_abstract0_t* w = ap_abstract0_widening(man,acc,j);
+    ap_lincons0_array_t cons = ap_abstract0_to_lincons_array(man,w);
+    ap_abstract0_free(man,acc);
+    acc = ap_abstract0_meet_lincons_array(man,false,j,&cons);
+    ap_lincons0_array_clear(&cons);
+    ap_abstract0_free(man,w);
+    ap_abstract0_free(man,j);
+    ap_abstract0_free(man,a);
+    ap_lincons0_array_clear(&array);
+  }
+  return acc;
+}
+
+static void* worker(void* arg)
+{
+  pool_test_t* t = (pool_test_t*)arg;
+  unsigned k;
+  while ((k=__atomic_fetch_add(&t->next,1,__ATOMIC_RELAXED))<NJOBS){
+    ap_manager_t* man = ap_manager_pool_get(t->pool);
+    t->res[k] = job(man,t->base[k],k);
+    /* give back the manager from time to time, so that it is reused */
+    if (k%3==0) ap_manager_pool_release(t->pool);
+  }
+  return NULL;
+}
+
+static int test_pool(const char* name, ap_manager_t* man,
+		     ap_manager_t* (*alloc)(void*))
+{
+  pool_test_t t;
+  pthread_t threads[NTHREADS];
+  ap_manager_t* mine;
+  unsigned seed = 42;
+  ap_lincons0_array_t array;
+  ap_abstract0_t *top, *base;
+  int i, nbfail = 0;
+  unsigned k;
+
+  t.name = name;
+  t.pool = ap_manager_pool_alloc(man,alloc,NULL);
+  t.next = 0;
+  top = ap_abstract0_top(man,NBDIMS,0);
+  array = random_array(&seed,NBDIMS);
+  base = ap_abstract0_meet_lincons_array(man,false,top,&array);
+  ap_lincons0_array_clear(&array);
+  ap_abstract0_free(man,top);
+  /* threads should not operate on the same value at the same time,
+     as some libraries update their arguments in place */
+  for (k=0;k<NJOBS;k++)
+    t.base[k] = ap_abstract0_copy(man,base);
+
+  for (i=0;i<NTHREADS;i++)
+    pthread_create(&threads[i],NULL,worker,&t);
+  for (i=0;i<NTHREADS;i++)
+    pthread_join(threads[i],NULL);
+
+  /* values computed by the threads are checked with yet another member */
+  mine = ap_manager_pool_get(t.pool);
+  for (k=0;k<NJOBS;k++){
+    ap_abstract0_t* copy = ap_abstract0_copy(man,base);
+    ap_abstract0_t* ref = job(man,copy,k);
+    if (!ap_abstract0_is_eq(mine,ref,t.res[k])){
+      printf("%s: job %u differs from the sequential analysis\n",name,k);
+      nbfail++;
+    }
+    ap_abstract0_free(man,ref);
+    ap_abstract0_free(man,copy);
+    ap_abstract0_free(mine,t.res[k]);
+    ap_abstract0_free(mine,t.base[k]);
+  }
+  printf("%s: %d jobs on %d threads, %lu managers, %d failures\n",
+	 name,NJOBS,NTHREADS,(unsigned long)ap_manager_pool_size(t.pool),nbfail);
+  if (ap_manager_pool_size(t.pool)>NTHREADS+1){
+    printf("%s: managers released by threads are not reused\n",name);
+    nbfail++;
+  }
+  ap_manager_pool_release(t.pool);
+  ap_abstract0_free(man,base);
+  ap_manager_pool_free(t.pool);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* pk = pk_manager_alloc(false);
+  ap_manager_t* oct = oct_manager_alloc();
+  int nbfail;
+
+  nbfail = test_pool("polka",pk,alloc_pk);
+  nbfail += test_pool("oct",oct,alloc_oct);
+  ap_manager_free(pk);
+  ap_manager_free(oct);
+  return nbfail ? 1 : 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * ctest5.c
+ *
+ * Timeouts. Interrupted operations should return correct results.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include "../apron/ap_global0.h"
+
+#include "../newpolka/pk.h"
+#include "../octagons/oct.h"
+
+#define PK_DIMS 18
+#define OCT_DIMS 100
+
+static void set_funopt(ap_manager_t* man, ap_funid_t funid,
+		       int algorithm, size_t timeout)
+{
+  ap_funopt_t opt = ap_manager_get_funopt(man,funid);
+  opt.algorithm = algorithm;
+  opt.timeout = timeout;
+  ap_manager_set_funopt(man,funid,&opt);
+}
+
+static bool check_timeout(const char* name, ap_manager_t* man)
+{
+  if (ap_manager_get_exception(man)!=AP_EXC_TIMEOUT){
+    printf("%s: no timeout exception\n",name);
+    return false;
+  }
+  if (ap_manager_get_flag_exact(man) || ap_manager_get_flag_best(man)){
+    printf("%s: interrupted result flagged exact or best\n",name);
+    return false;
+  }
+  return true;
+}
+
+/* the join of two hypercubes of dimension PK_DIMS has 2^PK_DIMS vertices:
+   the conversion to generators is interrupted, and the result is top */
+static int test_pk(void)
+{
+  ap_manager_t* man = pk_manager_alloc(false);
+  ap_interval_t** box = ap_interval_array_alloc(PK_DIMS);
+  ap_abstract0_t *a, *b, *r;
+  size_t i;
+  int nbfail = 0;
+
+  for (i=0;i<PK_DIMS;i++) ap_interval_set_int(box[i],0,1);
+  a = ap_abstract0_of_box(man,0,PK_DIMS,box);
+  for (i=0;i<PK_DIMS;i++) ap_interval_set_int(box[i],2,3);
+  b = ap_abstract0_of_box(man,0,PK_DIMS,box);
+
+  set_funopt(man,AP_FUNID_JOIN,0,1);
+  r = ap_abstract0_join(man,false,a,b);
+  if (!check_timeout("polka join",man)) nbfail++;
+  /* checking the inclusion of a and b would take long */
+  if (!ap_abstract0_is_top(man,r)){
+    printf("polka join: result is not top\n");
+    nbfail++;
+  }
+
+  ap_abstract0_free(man,r);
+  ap_abstract0_free(man,b);
+  ap_abstract0_free(man,a);
+  ap_interval_array_free(box,PK_DIMS);
+  ap_manager_free(man);
+  return nbfail;
+}
+
+/* chain x0 <= x1 <= ... with bounded ends: closure is needed to bound the
+   inner variables, but is interrupted */
+static int test_oct(void)
+{
+  ap_manager_t* man = oct_manager_alloc();
+  ap_manager_t* ref = oct_manager_alloc();
+  ap_lincons0_array_t array = ap_lincons0_array_make(OCT_DIMS+1);
+  ap_abstract0_t *top, *a, *aref;
+  ap_interval_t *itv, *itvref;
+  size_t i;
+  int nbfail = 0;
+
+  for (i=0;i+1<OCT_DIMS;i++){
+    ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    e->p.linterm[0].dim = i;
+    ap_coeff_set_scalar_int(&e->p.linterm[0].coeff,-1);
+    e->p.linterm[1].dim = i+1;
+    ap_coeff_set_scalar_int(&e->p.linterm[1].coeff,1);
+    array.p[i] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  }
+  for (i=0;i<2;i++){
+    ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+    e->p.linterm[0].dim = i ? OCT_DIMS-1 : 0;
+    ap_coeff_set_scalar_int(&e->p.linterm[0].coeff,i ? -1 : 1);
+    ap_coeff_set_scalar_int(&e->cst,i ? 10 : 0);
+    array.p[OCT_DIMS-1+i] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  }
+  /* without closure */
+  set_funopt(man,AP_FUNID_MEET_LINCONS_ARRAY,-1,0);
+  top = ap_abstract0_top(man,0,OCT_DIMS);
+  a = ap_abstract0_meet_lincons_array(man,false,top,&array);
+  aref = ap_abstract0_copy(man,a);
+
+  set_funopt(man,AP_FUNID_BOUND_DIMENSION,0,1);
+  itv = ap_abstract0_bound_dimension(man,a,OCT_DIMS/2);
+  if (!check_timeout("oct bound_dimension",man)) nbfail++;
+  itvref = ap_abstract0_bound_dimension(ref,aref,OCT_DIMS/2);
+  if (!ap_interval_is_leq(itvref,itv)){
+    printf("oct bound_dimension: incorrect result\n");
+    nbfail++;
+  }
+  printf("oct bound of x%d, interrupted: ",OCT_DIMS/2);
+  ap_interval_fprint(stdout,itv);
+  printf(", complete: ");
+  ap_interval_fprint(stdout,itvref);
+  printf("\n");
+
+  ap_interval_free(itvref);
+  ap_interval_free(itv);
+  ap_abstract0_free(man,aref);
+  ap_abstract0_free(man,a);
+  ap_abstract0_free(man,top);
+  ap_lincons0_array_clear(&array);
+  ap_manager_free(ref);
+  ap_manager_free(man);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  int nbfail;
+
+  nbfail = test_pk();
+  nbfail += test_oct();
+  return nbfail ? 1 : 0;
+}
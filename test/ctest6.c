@@ -0,0 +1,226 @@
+/*
+ * ctest6.c
+ *
+ * Checkpoint files. Saved values are loaded back equal, and loaded values
+ * can be modified without changing the file. Corrupted files are rejected
+ * or loaded without reading out of the values.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../apron/ap_global1.h"
+
+#include "../box/box.h"
+#include "../newpolka/pk.h"
+#include "../octagons/oct.h"
+
+#define NBVALS 8
+#define FILENAME "ctest6.ckp"
+#define CORRUPTED "ctest6c.ckp"
+
+/* random constraints a*xi + b*xj + c >= 0 */
+static ap_lincons0_array_t random_array(unsigned* seed, size_t nbdims, size_t size)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(size);
+  size_t k;
+  for (k=0;k<size;k++){
+    ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+    e->p.linterm[0].dim = rand_r(seed)%nbdims;
+    e->p.linterm[1].dim = (e->p.linterm[0].dim+1+rand_r(seed)%(nbdims-1))%nbdims;
+    ap_coeff_set_scalar_int(&e->p.linterm[0].coeff,rand_r(seed)%3-1);
+    ap_coeff_set_scalar_int(&e->p.linterm[1].coeff,rand_r(seed)%3-1);
+    ap_coeff_set_scalar_int(&e->cst,rand_r(seed)%20);
+    array.p[k] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  }
+  return array;
+}
+
+/* values over two environments, including bottom and top */
+static void make_values(ap_manager_t* man, ap_abstract1_t* tab)
+{
+  ap_var_t var1[3] = { "x", "y", "z" };
+  ap_var_t var2[4] = { "n", "a", "b", "x" };
+  ap_environment_t* env1 = ap_environment_alloc(NULL,0,var1,3);
+  ap_environment_t* env2 = ap_environment_alloc(var2,1,var2+1,3);
+  unsigned seed = 1;
+  size_t i;
+
+  for (i=0;i<NBVALS;i++){
+    ap_environment_t* env = i%2 ? env2 : env1;
+    size_t nbdims = env->intdim+env->realdim;
+    tab[i].env = ap_environment_copy(env);
+    if (i==0)
+      tab[i].abstract0 = ap_abstract0_bottom(man,env->intdim,env->realdim);
+    else {
+      ap_abstract0_t* top = ap_abstract0_top(man,env->intdim,env->realdim);
+      ap_lincons0_array_t array = random_array(&seed,nbdims,i==1 ? 0 : 4);
+      tab[i].abstract0 = ap_abstract0_meet_lincons_array(man,false,top,&array);
+      ap_lincons0_array_clear(&array);
+      ap_abstract0_free(man,top);
+    }
+  }
+  ap_environment_free(env1);
+  ap_environment_free(env2);
+}
+
+static bool is_eq(ap_manager_t* man, ap_abstract1_t* a, ap_abstract1_t* b)
+{
+  return ap_environment_is_eq(a->env,b->env) &&
+    ap_abstract1_is_eq(man,a,b);
+}
+
+static int test(const char* name, ap_manager_t* man, ap_manager_t* other)
+{
+  ap_abstract1_t tab[NBVALS], load[NBVALS];
+  ap_checkpoint_t* ck;
+  size_t i;
+  int nbfail = 0;
+
+  make_values(man,tab);
+  if (!ap_checkpoint_save(man,FILENAME,tab,NBVALS)){
+    printf("%s: save failed\n",name);
+    nbfail++;
+    goto test_exit;
+  }
+  ck = ap_checkpoint_open(man,FILENAME,NULL);
+  if (ck==NULL || ap_checkpoint_size(ck)!=NBVALS){
+    printf("%s: open failed\n",name);
+    nbfail++;
+    if (ck) ap_checkpoint_free(ck);
+    goto test_exit;
+  }
+  for (i=0;i<NBVALS;i++)
+    load[i] = ap_checkpoint_load(man,ck,i);
+  /* the loaded values keep the file mapped */
+  ap_checkpoint_free(ck);
+  for (i=0;i<NBVALS;i++){
+    if (!is_eq(man,&tab[i],&load[i])){
+      printf("%s: value %lu differs\n",name,(unsigned long)i);
+      nbfail++;
+    }
+  }
+  /* destructive updates of loaded values do not change the file */
+  for (i=0;i<NBVALS;i++){
+    unsigned seed = 2;
+    ap_lincons0_array_t array =
+      random_array(&seed,load[i].env->intdim+load[i].env->realdim,4);
+    load[i].abstract0 = ap_abstract0_meet_lincons_array(man,true,load[i].abstract0,&array);
+    ap_lincons0_array_clear(&array);
+    ap_abstract1_clear(man,&load[i]);
+  }
+  ck = ap_checkpoint_open(man,FILENAME,NULL);
+  for (i=0;ck && i<NBVALS;i++){
+    ap_abstract1_t a = ap_checkpoint_load(man,ck,i);
+    if (!is_eq(man,&tab[i],&a)){
+      printf("%s: value %lu modified in the file\n",name,(unsigned long)i);
+      nbfail++;
+    }
+    ap_abstract1_clear(man,&a);
+  }
+  if (ck) ap_checkpoint_free(ck);
+  /* files of another library are rejected */
+  ck = ap_checkpoint_open(other,FILENAME,NULL);
+  if (ck || ap_manager_get_exception(other)!=AP_EXC_INVALID_ARGUMENT){
+    printf("%s: file accepted by %s\n",name,ap_manager_get_library(other));
+    nbfail++;
+    if (ck) ap_checkpoint_free(ck);
+  }
+  ap_manager_clear_exclog(other);
+  printf("%s: %d values saved and loaded, %d failures\n",name,NBVALS,nbfail);
+
+ test_exit:
+  for (i=0;i<NBVALS;i++)
+    ap_abstract1_clear(man,&tab[i]);
+  remove(FILENAME);
+  return nbfail;
+}
+
+/* flip bits of every byte of a saved file, then open it and load all its
+   values */
+static int test_corrupt(const char* name, ap_manager_t* man)
+{
+  ap_abstract1_t tab[NBVALS];
+  unsigned char *data, *copy;
+  unsigned char masks[2] = { 0x80, 0x01 };
+  size_t size, pos, i, m;
+  size_t nbopen = 0, nbload = 0, nbrejected = 0;
+  FILE* f;
+
+  make_values(man,tab);
+  ap_checkpoint_save(man,FILENAME,tab,NBVALS);
+  for (i=0;i<NBVALS;i++)
+    ap_abstract1_clear(man,&tab[i]);
+  f = fopen(FILENAME,"rb");
+  fseek(f,0,SEEK_END);
+  size = (size_t)ftell(f);
+  rewind(f);
+  data = malloc(size);
+  copy = malloc(size);
+  if (fread(data,1,size,f)!=size) size = 0;
+  fclose(f);
+  remove(FILENAME);
+  for (pos=0;pos<size;pos++){
+    for (m=0;m<2;m++){
+      ap_checkpoint_t* ck;
+      memcpy(copy,data,size);
+      copy[pos] ^= masks[m];
+      f = fopen(CORRUPTED,"wb");
+      fwrite(copy,1,size,f);
+      fclose(f);
+      ck = ap_checkpoint_open(man,CORRUPTED,NULL);
+      if (ck==NULL){
+	ap_manager_clear_exclog(man);
+	continue;
+      }
+      nbopen++;
+      for (i=0;i<ap_checkpoint_size(ck);i++){
+	ap_abstract1_t a;
+	man->result.exn = AP_EXC_NONE;
+	a = ap_checkpoint_load(man,ck,i);
+	if (ap_manager_get_exception(man)==AP_EXC_INVALID_ARGUMENT) nbrejected++;
+	else nbload++;
+	ap_manager_clear_exclog(man);
+	ap_abstract1_clear(man,&a);
+      }
+      ap_checkpoint_free(ck);
+    }
+  }
+  remove(CORRUPTED);
+  free(data);
+  free(copy);
+  printf("%s: %lu corrupted files opened, %lu values loaded, %lu rejected\n",
+	 name,(unsigned long)nbopen,(unsigned long)nbload,(unsigned long)nbrejected);
+  /* corruptions of the dimensions of the values are caught */
+  return nbrejected>0 ? 0 : 1;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* man[3] = { box_manager_alloc(), oct_manager_alloc(), pk_manager_alloc(false) };
+  ap_funopt_t opt;
+  int i, nbfail = 0;
+
+  /* the rejection of files is checked through the exception */
+  for (i=0;i<3;i++)
+    ap_manager_set_abort_if_exception(man[i],AP_EXC_INVALID_ARGUMENT,false);
+  nbfail += test("box",man[0],man[1]);
+  nbfail += test("oct",man[1],man[2]);
+  nbfail += test_corrupt("box",man[0]);
+  nbfail += test_corrupt("oct",man[1]);
+  /* flat matrices, which can be used in place */
+  opt = ap_manager_get_funopt(man[1],AP_FUNID_SERIALIZE_RAW);
+  opt.algorithm = 1;
+  ap_manager_set_funopt(man[1],AP_FUNID_SERIALIZE_RAW,&opt);
+  nbfail += test("oct flat",man[1],man[2]);
+  nbfail += test_corrupt("oct flat",man[1]);
+  nbfail += test("polka",man[2],man[0]);
+  for (i=0;i<3;i++) ap_manager_free(man[i]);
+  return nbfail ? 1 : 0;
+}
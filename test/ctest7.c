@@ -0,0 +1,165 @@
+/*
+ * ctest7.c
+ *
+ * Taylor1+ noise symbol budget and collection. Condensed values stay
+ * sound, and the arguments of non destructive operations are unchanged.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdlib.h>
+
+#include "../apron/ap_global0.h"
+
+#include "../taylor1plus/t1p.h"
+
+#define NBDIMS 5
+#define NBVALS 4
+#define NBSTEPS 400
+
+static ap_texpr0_t* add(ap_texpr0_t* a, ap_texpr0_t* b)
+{
+  return ap_texpr0_binop(AP_TEXPR_ADD,a,b,AP_RTYPE_REAL,AP_RDIR_RND);
+}
+
+/* x := e, e is freed */
+static ap_abstract0_t* assign(ap_manager_t* man, bool destructive,
+			      ap_abstract0_t* a, ap_dim_t x, ap_texpr0_t* e)
+{
+  ap_abstract0_t* r = ap_abstract0_assign_texpr(man,destructive,a,x,e,NULL);
+  ap_texpr0_free(e);
+  return r;
+}
+
+/* -bound <= x-y <= bound in a, computed in the unused dimension 1 */
+static bool diff_within(ap_manager_t* man, ap_abstract0_t* a,
+			ap_dim_t x, ap_dim_t y, int bound)
+{
+  ap_texpr0_t* e = ap_texpr0_binop(AP_TEXPR_SUB,ap_texpr0_dim(x),ap_texpr0_dim(y),
+				   AP_RTYPE_REAL,AP_RDIR_RND);
+  ap_abstract0_t* r = assign(man,false,a,1,e);
+  ap_interval_t* itv = ap_abstract0_bound_dimension(man,r,1);
+  bool res = ap_scalar_cmp_int(itv->inf,-bound)>=0 && ap_scalar_cmp_int(itv->sup,bound)<=0;
+  ap_interval_free(itv);
+  ap_abstract0_free(man,r);
+  return res;
+}
+
+/* x4 := x0 + eps + eps, then x3 := x4 with a budget of 1 noise symbol */
+static int test_shared(void)
+{
+  ap_manager_t* man = t1p_manager_alloc();
+  ap_abstract0_t *a, *b;
+  int nbfail = 0;
+
+  a = ap_abstract0_top(man,0,NBDIMS);
+  a = assign(man,true,a,0,ap_texpr0_cst_interval_int(-1,1));
+  a = assign(man,true,a,4,add(ap_texpr0_dim(0),
+			      add(ap_texpr0_cst_interval_int(-1,1),
+				  ap_texpr0_cst_interval_int(-1,1))));
+  ap_manager_t1p_set_nsym_budget(man,1);
+  b = assign(man,false,a,3,ap_texpr0_dim(4));
+  if (!diff_within(man,a,4,0,2)) {
+    printf("t1p budget: argument of a non destructive assignment modified\n");
+    nbfail++;
+  }
+  if (!diff_within(man,b,4,0,2)) {
+    printf("t1p budget: unassigned variable condensed\n");
+    nbfail++;
+  }
+  if (!diff_within(man,b,3,4,6)) {
+    printf("t1p budget: unsound condensation\n");
+    nbfail++;
+  }
+  ap_abstract0_free(man,b);
+  ap_abstract0_free(man,a);
+  ap_manager_free(man);
+  return nbfail;
+}
+
+/* random assignments and joins on NBVALS values, with a budget and
+   periodic collections; each value is checked against a concrete state it
+   contains */
+static int test_random(void)
+{
+  ap_manager_t* man = t1p_manager_alloc();
+  ap_abstract0_t* tab[NBVALS];
+  long val[NBVALS][NBDIMS];
+  unsigned seed = 11;
+  size_t i, k, step;
+  int nbfail = 0;
+
+  ap_manager_t1p_set_nsym_budget(man,2);
+  for (i=0;i<NBVALS;i++) {
+    tab[i] = ap_abstract0_top(man,0,NBDIMS);
+    for (k=0;k<NBDIMS;k++) {
+      tab[i] = assign(man,true,tab[i],k,ap_texpr0_cst_interval_int(-1,1));
+      val[i][k] = 0;
+    }
+  }
+  for (step=0;step<NBSTEPS;step++) {
+    size_t p = rand_r(&seed)%NBVALS, q = rand_r(&seed)%NBVALS;
+    ap_dim_t x = rand_r(&seed)%NBDIMS, y = rand_r(&seed)%NBDIMS;
+    ap_abstract0_t* r;
+    switch (rand_r(&seed)%3) {
+    case 0:
+      /* tab[q] := tab[p] with x := y */
+      r = assign(man,false,tab[p],x,ap_texpr0_dim(y));
+      val[q][x] = val[p][y];
+      for (k=0;k<NBDIMS;k++) if (k!=x) val[q][k] = val[p][k];
+      break;
+    case 1:
+      /* tab[q] := tab[p] with x := y + [-1,1] */
+      {
+	long c = (long)(rand_r(&seed)%3)-1;
+	r = assign(man,false,tab[p],x,add(ap_texpr0_dim(y),ap_texpr0_cst_interval_int(-1,1)));
+	val[q][x] = val[p][y]+c;
+	for (k=0;k<NBDIMS;k++) if (k!=x) val[q][k] = val[p][k];
+      }
+      break;
+    default:
+      /* tab[q] := tab[p] join tab[q], containing the state of tab[q] */
+      r = ap_abstract0_join(man,false,tab[p],tab[q]);
+      break;
+    }
+    ap_abstract0_free(man,tab[q]);
+    tab[q] = r;
+    if (step%10==9) {
+      ap_manager_t1p_collect_nsym(man,tab,NBVALS);
+      if ((size_t)ap_manager_t1p_get_nsym(man)>2*NBDIMS*NBVALS) {
+	printf("t1p collect: %d noise symbols left\n",ap_manager_t1p_get_nsym(man));
+	nbfail++;
+      }
+    }
+    for (i=0;i<NBVALS;i++)
+      for (k=0;k<NBDIMS;k++) {
+	ap_interval_t* itv = ap_abstract0_bound_dimension(man,tab[i],k);
+	if (ap_scalar_cmp_int(itv->inf,val[i][k])>0 || ap_scalar_cmp_int(itv->sup,val[i][k])<0) {
+	  printf("t1p budget: step %lu, value %lu, x%lu=%ld not in ",
+		 (unsigned long)step,(unsigned long)i,(unsigned long)k,val[i][k]);
+	  ap_interval_fprint(stdout,itv);
+	  printf("\n");
+	  nbfail++;
+	}
+	ap_interval_free(itv);
+      }
+    if (nbfail) break;
+  }
+  for (i=0;i<NBVALS;i++) ap_abstract0_free(man,tab[i]);
+  ap_manager_free(man);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  int nbfail;
+
+  nbfail = test_shared();
+  nbfail += test_random();
+  printf("t1p budget and collection: %d failures\n",nbfail);
+  return nbfail ? 1 : 0;
+}
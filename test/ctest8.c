@@ -0,0 +1,124 @@
+/*
+ * ctest8.c
+ *
+ * Memory size queries. They leave the values and the result of the last
+ * operation unchanged.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ap_global0.h"
+#include "ap_reducedproduct.h"
+#include "ap_cache.h"
+#include "box.h"
+#include "oct.h"
+#include "t1p.h"
+
+static int nbreduce = 0;
+
+/* counts the reductions, the components are left unchanged */
+static void reduce(ap_manager_t* man, ap_reducedproduct_t* a)
+{
+  nbreduce++;
+}
+static void approximate(ap_manager_t* man, ap_reducedproduct_t* a, int n)
+{
+}
+
+/* x0 in [0,1], x0+x1 in [0,2] */
+static ap_abstract0_t* value(ap_manager_t* man)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(3);
+  ap_linexpr0_t* e;
+  ap_abstract0_t* a;
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_CST_S_INT,0,AP_END);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,-1,0,AP_CST_S_INT,1,AP_END);
+  array.p[1] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+  ap_linexpr0_set_list(e,AP_COEFF_S_INT,1,0,AP_COEFF_S_INT,1,1,AP_CST_S_INT,0,AP_END);
+  array.p[2] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  a = ap_abstract0_top(man,0,3);
+  a = ap_abstract0_meet_lincons_array(man,true,a,&array);
+  ap_lincons0_array_clear(&array);
+  return a;
+}
+
+/* the flags set before the query are still there after it */
+static int test_flags(ap_manager_t* man)
+{
+  ap_abstract0_t* a = value(man);
+  int nbfail = 0;
+
+  man->result.flag_exact = false;
+  man->result.flag_best = false;
+  if (ap_abstract0_memory_size(man,a)<=sizeof(ap_abstract0_t)) {
+    printf("%s: memory_size too small\n",man->library);
+    nbfail++;
+  }
+  if (man->result.flag_exact || man->result.flag_best) {
+    printf("%s: memory_size changed the flags\n",man->library);
+    nbfail++;
+  }
+  ap_abstract0_free(man,a);
+  return nbfail;
+}
+
+/* a product that is not reduced stays so */
+static int test_reduced(ap_manager_t* man)
+{
+  ap_abstract0_t* a = value(man);
+  ap_reducedproduct_t* p = (ap_reducedproduct_t*)a->value;
+  int nbfail = 0;
+  int n;
+
+  if (p->reduced) {
+    printf("reduced product: the result of a meet is already reduced\n");
+    nbfail++;
+  }
+  n = nbreduce;
+  ap_abstract0_memory_size(man,a);
+  if (nbreduce!=n || p->reduced) {
+    printf("reduced product: memory_size reduced its argument\n");
+    nbfail++;
+  }
+  ap_abstract0_free(man,a);
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  ap_manager_t* manbox = box_manager_alloc();
+  ap_manager_t* manoct = oct_manager_alloc();
+  ap_manager_t* mant1p = t1p_manager_alloc();
+  ap_manager_t* tab[2] = { manbox, manoct };
+  ap_manager_t* manprod =
+    ap_reducedproduct_manager_alloc("box x oct",tab,2,&reduce,&approximate);
+  ap_manager_t* mancache = ap_cache_manager_alloc(manoct,16);
+  int nbfail = 0;
+
+  nbfail += test_flags(manbox);
+  nbfail += test_flags(manoct);
+  nbfail += test_flags(mant1p);
+  nbfail += test_flags(mancache);
+  nbfail += test_flags(manprod);
+  nbfail += test_reduced(manprod);
+  printf("memory_size: %d failures\n",nbfail);
+
+  ap_manager_free(mancache);
+  ap_manager_free(manprod);
+  ap_manager_free(mant1p);
+  ap_manager_free(manoct);
+  ap_manager_free(manbox);
+  return nbfail ? 1 : 0;
+}
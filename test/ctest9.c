@@ -0,0 +1,269 @@
+/*
+ * ctest9.c
+ *
+ * Packed arrays. Arrays are unpacked equal, and corrupted buffers are
+ * rejected or unpacked without reading out of the buffer. Constraints
+ * that are not valid, with a misplaced modulo or terms not sorted, are
+ * rejected.
+ *
+ */
+
+/* This file is part of the APRON Library, released under GPL license
+
+   Please read the COPYING file packaged in the distribution.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ap_global0.h"
+#include "ap_packed.h"
+
+/* offset of the scalar of the constant of the first constraint, when it has
+   no term: header, one offset, constyp, nbterms, discr, tag */
+#define CST_TAG (16+8+4+4+1)
+
+/* constraints with double, small and big MPQ, infinite and MPFR scalars */
+static ap_lincons0_array_t make(void)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(5);
+  ap_linexpr0_t* e;
+  mpq_t q;
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,0);
+  ap_scalar_set_frac(e->cst.val.scalar,-3,4);
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+  ap_linexpr0_set_list(e,AP_COEFF_S_DOUBLE,0.5,0,AP_COEFF_I_INT,-1,2,2,
+		       AP_CST_S_INT,7,AP_END);
+  array.p[1] = ap_lincons0_make(AP_CONS_EQMOD,e,ap_scalar_alloc_set_double(2.0));
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,1);
+  mpq_init(q);
+  mpq_set_str(q,"123456789012345678901234567891/7",10);
+  ap_coeff_set_scalar_mpq(&e->p.linterm[0].coeff,q);
+  e->p.linterm[0].dim = 1;
+  ap_coeff_reinit(&e->cst,AP_COEFF_INTERVAL,AP_SCALAR_MPQ);
+  ap_interval_set_top(e->cst.val.interval);
+  mpq_clear(q);
+  array.p[2] = ap_lincons0_make(AP_CONS_SUP,e,NULL);
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,0);
+  ap_coeff_reinit(&e->cst,AP_COEFF_SCALAR,AP_SCALAR_MPFR);
+  mpfr_set_prec(e->cst.val.scalar->val.mpfr,100);
+  mpfr_set_d(e->cst.val.scalar->val.mpfr,-1.0/3,GMP_RNDU);
+  array.p[3] = ap_lincons0_make(AP_CONS_DISEQ,e,NULL);
+
+  e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,0);
+  ap_coeff_reinit(&e->cst,AP_COEFF_INTERVAL,AP_SCALAR_MPFR);
+  mpfr_set_inf(e->cst.val.interval->inf->val.mpfr,-1);
+  mpfr_set_ui(e->cst.val.interval->sup->val.mpfr,0,GMP_RNDU);
+  array.p[4] = ap_lincons0_make(AP_CONS_SUPEQ,e,NULL);
+  return array;
+}
+
+static bool lincons0_equal(ap_lincons0_t* a, ap_lincons0_t* b)
+{
+  return a->constyp==b->constyp &&
+    ap_linexpr0_equal(a->linexpr0,b->linexpr0) &&
+    ((a->scalar==NULL && b->scalar==NULL) ||
+     (a->scalar && b->scalar && ap_scalar_equal(a->scalar,b->scalar)));
+}
+
+static int test_roundtrip(void)
+{
+  ap_lincons0_array_t array = make();
+  ap_lincons0_array_t res;
+  size_t size, i;
+  void* buf = ap_lincons0_array_pack(&array,&size);
+  int nbfail = 0;
+
+  if (!ap_lincons0_array_unpack(&res,buf,size) || res.size!=array.size){
+    printf("packed: round trip failed\n");
+    nbfail++;
+  }
+  else {
+    for (i=0;i<array.size;i++){
+      if (!lincons0_equal(&array.p[i],&res.p[i])){
+	printf("packed: constraint %lu differs\n",(unsigned long)i);
+	ap_lincons0_fprint(stdout,&array.p[i],NULL); printf(" / ");
+	ap_lincons0_fprint(stdout,&res.p[i],NULL); printf("\n");
+	nbfail++;
+      }
+    }
+    ap_lincons0_array_clear(&res);
+  }
+  free(buf);
+  ap_lincons0_array_clear(&array);
+  return nbfail;
+}
+
+/* every single bit flip is either rejected or unpacked, ASan checks the
+   accesses */
+static int test_bitflip(void)
+{
+  ap_lincons0_array_t array = make();
+  ap_lincons0_array_t res;
+  size_t size, i;
+  int bit, nbrejected = 0;
+  unsigned char* buf = ap_lincons0_array_pack(&array,&size);
+  /* exact size, so that reads past the end are detected */
+  unsigned char* copy = malloc(size);
+
+  for (i=0;i<size;i++){
+    for (bit=0;bit<8;bit++){
+      memcpy(copy,buf,size);
+      copy[i] ^= (unsigned char)(1<<bit);
+      if (ap_lincons0_array_unpack(&res,copy,size))
+	ap_lincons0_array_clear(&res);
+      else
+	nbrejected++;
+    }
+  }
+  printf("packed: %d of %lu bit flips rejected\n",nbrejected,(unsigned long)(8*size));
+  free(copy);
+  free(buf);
+  ap_lincons0_array_clear(&array);
+  return nbrejected>0 ? 0 : 1;
+}
+
+/* one constraint 0>=0 whose constant is patched */
+static bool unpack_patched(ap_scalar_discr_t discr, size_t offset,
+			   const void* patch, size_t n, ap_scalar_t* scalar)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(1);
+  ap_lincons0_array_t res;
+  unsigned char* buf;
+  size_t size;
+  bool ok;
+
+  array.p[0] = ap_lincons0_make(AP_CONS_SUPEQ,ap_linexpr0_alloc(AP_LINEXPR_SPARSE,0),NULL);
+  ap_coeff_reinit(&array.p[0].linexpr0->cst,AP_COEFF_SCALAR,discr);
+  if (discr==AP_SCALAR_MPFR)
+    mpfr_set_si(array.p[0].linexpr0->cst.val.scalar->val.mpfr,1,GMP_RNDU);
+  buf = ap_lincons0_array_pack(&array,&size);
+  memcpy(buf+offset,patch,n);
+  ok = ap_lincons0_array_unpack(&res,buf,size);
+  if (ok){
+    ap_scalar_set(scalar,res.p[0].linexpr0->cst.val.scalar);
+    ap_lincons0_array_clear(&res);
+  }
+  free(buf);
+  ap_lincons0_array_clear(&array);
+  return ok;
+}
+
+static int test_scalars(void)
+{
+  ap_scalar_t* scalar = ap_scalar_alloc();
+  int64_t frac[2];
+  uint64_t prec;
+  int nbfail = 0;
+
+  frac[0] = 1; frac[1] = -2;
+  if (unpack_patched(AP_SCALAR_MPQ,CST_TAG+1,frac,sizeof(frac),scalar)){
+    printf("packed: negative denominator accepted\n");
+    nbfail++;
+  }
+  frac[0] = 2; frac[1] = 0;
+  if (unpack_patched(AP_SCALAR_MPQ,CST_TAG+1,frac,sizeof(frac),scalar)){
+    printf("packed: 2/0 accepted\n");
+    nbfail++;
+  }
+  frac[0] = -1; frac[1] = 0;
+  if (!unpack_patched(AP_SCALAR_MPQ,CST_TAG+1,frac,sizeof(frac),scalar) ||
+      ap_scalar_infty(scalar)!=-1){
+    printf("packed: -1/0 not unpacked as -oo\n");
+    nbfail++;
+  }
+  frac[0] = 6; frac[1] = 4;
+  if (!unpack_patched(AP_SCALAR_MPQ,CST_TAG+1,frac,sizeof(frac),scalar) ||
+      mpz_cmp_si(mpq_numref(scalar->val.mpq),3) ||
+      mpz_cmp_si(mpq_denref(scalar->val.mpq),2)){
+    printf("packed: 6/4 not canonicalized\n");
+    nbfail++;
+  }
+  prec = (uint64_t)1<<40;
+  if (unpack_patched(AP_SCALAR_MPFR,CST_TAG+1,&prec,sizeof(prec),scalar)){
+    printf("packed: huge MPFR precision accepted\n");
+    nbfail++;
+  }
+  /* 1 is packed with a mantissa of 53 bits */
+  prec = 1000;
+  if (unpack_patched(AP_SCALAR_MPFR,CST_TAG+1,&prec,sizeof(prec),scalar)){
+    printf("packed: MPFR precision larger than the mantissa accepted\n");
+    nbfail++;
+  }
+  ap_scalar_free(scalar);
+  return nbfail;
+}
+
+/* the constraint is rejected, by both unpacking functions */
+static int reject(const char* name, ap_lincons0_t cons)
+{
+  ap_lincons0_array_t array = ap_lincons0_array_make(1);
+  ap_lincons0_array_t res;
+  ap_lincons0_t nth;
+  size_t size;
+  void* buf;
+  int nbfail = 0;
+
+  array.p[0] = cons;
+  buf = ap_lincons0_array_pack(&array,&size);
+  if (ap_lincons0_array_unpack(&res,buf,size)){
+    printf("packed: %s accepted\n",name);
+    ap_lincons0_array_clear(&res);
+    nbfail++;
+  }
+  if (ap_lincons0_unpack_nth(&nth,buf,size,0)){
+    printf("packed: %s accepted by unpack_nth\n",name);
+    ap_lincons0_clear(&nth);
+    nbfail++;
+  }
+  free(buf);
+  ap_lincons0_array_clear(&array);
+  return nbfail;
+}
+
+/* x1 + x<dim> >= 0, sparse */
+static ap_linexpr0_t* sparse(ap_dim_t dim)
+{
+  ap_linexpr0_t* e = ap_linexpr0_alloc(AP_LINEXPR_SPARSE,2);
+  e->p.linterm[0].dim = 1;
+  ap_coeff_set_scalar_int(&e->p.linterm[0].coeff,1);
+  e->p.linterm[1].dim = dim;
+  ap_coeff_set_scalar_int(&e->p.linterm[1].coeff,1);
+  return e;
+}
+
+static int test_invalid(void)
+{
+  int nbfail = 0;
+
+  nbfail += reject("EQMOD without modulo",
+		   ap_lincons0_make(AP_CONS_EQMOD,sparse(2),NULL));
+  nbfail += reject("SUPEQ with a modulo",
+		   ap_lincons0_make(AP_CONS_SUPEQ,sparse(2),ap_scalar_alloc_set_double(2.0)));
+  nbfail += reject("EQ with a modulo",
+		   ap_lincons0_make(AP_CONS_EQ,sparse(2),ap_scalar_alloc_set_double(0.0)));
+  nbfail += reject("unsorted dimensions",
+		   ap_lincons0_make(AP_CONS_SUPEQ,sparse(0),NULL));
+  nbfail += reject("duplicate dimensions",
+		   ap_lincons0_make(AP_CONS_SUPEQ,sparse(1),NULL));
+  return nbfail;
+}
+
+int main(int argc, char** argv)
+{
+  int nbfail = 0;
+
+  nbfail += test_roundtrip();
+  nbfail += test_bitflip();
+  nbfail += test_scalars();
+  nbfail += test_invalid();
+  printf("packed arrays: %d failures\n",nbfail);
+  return nbfail ? 1 : 0;
+}